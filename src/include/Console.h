@@ -38,6 +38,7 @@
    ParseTree *_prelations;
    std::vector<ParseTree*> *_pvariables;
    std::vector<std::string> _array_names;
+   std::vector<std::pair<std::string, double> > _compile_times;
    static unsigned int &rngSeed();
  public:
    /**
@@ -69,10 +70,15 @@
     * @param gendata Boolean flag indicating whether the data generation
     * sub-model should be run, if there is one.
     *
+    * @param worklist Boolean flag indicating whether nodes should be
+    * allocated in worklist mode.
+    *
     * @return true on success or false on error.
+    *
+    * @see Compiler#writeRelations
     */
    bool compile(std::map<std::string, SArray> &data_table, unsigned int nchain,
-		bool gendata);
+		bool gendata, bool worklist = false);
    /**
     * @short Sets the parameters (unobserved variables) of the model.  
     * 
@@ -116,9 +122,14 @@
     *
     * @param n Number of iterations of the Markov chain.
     *
+    * @param parallel Indicates whether the chains should be updated
+    * in parallel, each in its own thread.
+    *
     * @returns true on success, false on failure.
+    *
+    * @see Model#update
     */ 
-   bool update (unsigned int n);
+   bool update (unsigned int n, bool parallel = false);
    /**
     * Sets a monitor for a subset of the given node array
     *
@@ -182,15 +193,58 @@
     * is empty then ALL monitored nodes will be dumped.
     * 
     * @param prefix Prefix to be prepended to the output file names
+    *
+    * @param binary Write output in binary format. The output files
+    * are kept open and further samples are appended to them as the
+    * model is updated.
+    *
+    * @see CODAStream
     */
    bool coda(std::vector<std::pair<std::string, Range> > const &nodes,
-	     std::string const &prefix);
-   bool coda(std::string const &prefix);
+	     std::string const &prefix, bool binary = false);
+   bool coda(std::string const &prefix, bool binary = false);
+   /**
+    * Writes a binary checkpoint of the full state of the model,
+    * including the samplers and monitors, to the given file.
+    *
+    * @see Model#checkpoint
+    */
+   bool checkpoint(std::string const &file);
+   /**
+    * Restores the state of the model from a checkpoint file. The
+    * model must be compiled and initialized in the same way as the
+    * model that wrote the checkpoint. If restoration fails, the
+    * model is left unchanged.
+    *
+    * @see Model#restore
+    */
+   bool restore(std::string const &file);
    BUGSModel const *model();
    unsigned int nchain() const;
    bool dumpMonitors(std::map<std::string,SArray> &data_table,
 		     std::string const &type, bool flat);
    bool dumpSamplers(std::vector<std::vector<std::string> > &sampler_list);
+   /**
+    * Writes the time, in seconds, that each sampler factory spent
+    * choosing samplers during initialization.
+    *
+    * @see Model#samplerFactoryTimes
+    */
+   bool dumpSamplerTimes(std::vector<std::pair<std::string, double> > &times);
+   /**
+    * Writes the time, in seconds, taken by each phase of the last
+    * call to compile. Each element pairs the name of a phase with its
+    * time, in the order that the phases were run.
+    */
+   bool dumpCompileTimes(std::vector<std::pair<std::string, double> > &times);
+   /**
+    * Writes the number of node log densities calculated by each
+    * sampler when evaluating the log full conditional density, in
+    * the same order as the list written by dumpSamplers.
+    *
+    * @see Model#samplerEvaluations
+    */
+   bool dumpSamplerEvaluations(std::vector<unsigned long> &counts);
    /** Turns off adaptive mode of the model */
    bool adaptOff();
    /** Checks whether adaptation is complete */
@@ -16,6 +16,7 @@
 #include <list>
 #include <utility>
 #include <set>
+#include <deque>
 
 namespace jags {
 
@@ -48,8 +49,33 @@ class Compiler {
   std::map<std::string, std::vector<int> > _node_array_bounds;
   std::map<std::pair<std::string, Range>, std::set<int> > _umap;
   std::set<std::string> _lhs_vars;
-  std::map<std::pair<std::vector<unsigned int>, std::vector<double> >,
-      ConstantNode *> _cnode_map;
+  /* Constant nodes are keyed by their dimension and values */
+  typedef std::pair<std::vector<unsigned int>, std::vector<double> > CNodeKey;
+  struct CNodeHash {
+      void operator()(FuzzyHash &h, CNodeKey const &k) const;
+  };
+  struct CNodeLess {
+      bool operator()(CNodeKey const &k1, CNodeKey const &k2) const;
+  };
+  InternTable<CNodeKey, ConstantNode *, CNodeHash, CNodeLess> _cnode_map;
+  /* 
+     State of the worklist compiler. A dependency is the name of a
+     variable and the offset of an element, or -1 for the whole
+     variable.
+  */
+  typedef std::pair<std::string, int> Dependency;
+  struct LoopRelation {
+      ParseTree const *relation;
+      std::vector<std::pair<ParseTree const *, int> > counters;
+  };
+  bool _worklist;
+  std::vector<LoopRelation> _loop_relations;
+  std::vector<Dependency> _missing;
+  std::map<Dependency, std::vector<std::pair<unsigned int, unsigned int> > >
+      _waiting;
+  std::vector<unsigned int> _nwaiting;
+  std::vector<unsigned int> _generation;
+  std::deque<unsigned int> _ready;
   
   Node *getArraySubset(ParseTree const *t);
   SimpleRange VariableSubsetRange(ParseTree const *var);
@@ -76,6 +102,11 @@ class Compiler {
 		    std::vector<double> const &value,
 		    unsigned int nchain, bool observed);
   void getLHSVars(ParseTree const *rel);
+  void expandRelations(ParseTree const *relations,
+		       std::vector<std::pair<ParseTree const*, int> > &counters);
+  bool allocateRelation(unsigned int k);
+  void allocateWorklist(ParseTree const *relations);
+  void setDefined(NodeArray const *array, SimpleRange const &range);
 public:
   bool indexExpression(ParseTree const *t, std::vector<int> &value);
   BUGSModel &model() const;
@@ -107,9 +138,19 @@ public:
   /**
    * Traverses the ParseTree creating nodes.
    *
+   * By default, the relations are swept repeatedly, forwards and
+   * backwards, until no more nodes can be created. In worklist mode,
+   * each for loop is expanded only once, and a relation that cannot
+   * be allocated is tried again only when all of the nodes that it
+   * was waiting for have been defined. This is faster for large
+   * models that are not written in topological order, but nodes may
+   * be created in a different order.
+   *
    * @param prelations ParseTree corresponding to a parsed model block
+   *
+   * @param worklist Flag indicating whether to use worklist mode
    */
-  void writeRelations(ParseTree const *prelations);
+  void writeRelations(ParseTree const *prelations, bool worklist = false);
   /**
    * The function table used by the compiler to look up functions by
    * name.  It is shared by all Compiler objects.
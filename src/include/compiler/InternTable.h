@@ -0,0 +1,118 @@
+#ifndef INTERN_TABLE_H_
+#define INTERN_TABLE_H_
+
+#include <compiler/NodeFactory.h>
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+namespace jags {
+
+/**
+ * @short Hash table used by the node factories
+ *
+ * An InternTable maps keys to values, where keys are considered equal
+ * if they are equivalent under a fuzzy less than function. It is used
+ * in place of an STL map, to avoid O(log n) comparisons per lookup when
+ * the table is large.
+ *
+ * Entries are stored in insertion order, and are indexed by an open
+ * addressing table with linear probing. Entries cannot be removed.
+ *
+ * @param Hash Function object that adds a key to a FuzzyHash. Keys
+ * that are equivalent must share a candidate hash value.
+ *
+ * @param Less Fuzzy less than function for keys.
+ */
+template<typename K, typename V, typename Hash, typename Less>
+class InternTable
+{
+    std::vector<std::pair<K, V> > _entries;
+    std::vector<std::uint64_t> _hashes;
+    std::vector<unsigned int> _slots; //Entry index + 1, or 0 if empty
+    Hash _hash;
+    Less _less;
+
+    /* Beyond this many ambiguous values, use a linear search */
+    static const unsigned int MAX_AMBIGUOUS = 8;
+
+    bool equal(K const &key1, K const &key2) const {
+	return !_less(key1, key2) && !_less(key2, key1);
+    }
+
+    void place(unsigned int e) {
+	std::uint64_t mask = _slots.size() - 1;
+	std::uint64_t i = _hashes[e] & mask;
+	while (_slots[i] != 0) {
+	    i = (i + 1) & mask;
+	}
+	_slots[i] = e + 1;
+    }
+public:
+    /**
+     * Returns a pointer to the value associated with a key that is
+     * equivalent to the given key, or a NULL pointer if there is
+     * none.
+     */
+    V *find(K const &key) {
+	if (_entries.empty()) {
+	    return 0;
+	}
+	FuzzyHash h;
+	_hash(h, key);
+	if (h.nambiguous() > MAX_AMBIGUOUS) {
+	    for (unsigned int e = 0; e < _entries.size(); ++e) {
+		if (equal(key, _entries[e].first)) {
+		    return &_entries[e].second;
+		}
+	    }
+	    return 0;
+	}
+	std::uint64_t mask = _slots.size() - 1;
+	unsigned long ncand = 1UL << h.nambiguous();
+	for (unsigned long c = 0; c < ncand; ++c) {
+	    std::uint64_t hc = h.candidate(c);
+	    for (std::uint64_t i = hc & mask; _slots[i] != 0;
+		 i = (i + 1) & mask)
+	    {
+		unsigned int e = _slots[i] - 1;
+		if (_hashes[e] == hc && equal(key, _entries[e].first)) {
+		    return &_entries[e].second;
+		}
+	    }
+	}
+	return 0;
+    }
+    /**
+     * Adds a new entry. There must not already be an entry with an
+     * equivalent key.
+     */
+    void insert(K const &key, V const &value) {
+	FuzzyHash h;
+	_hash(h, key);
+	_entries.push_back(std::pair<K, V>(key, value));
+	_hashes.push_back(h.candidate(0));
+	if (2 * _entries.size() > _slots.size()) {
+	    //Keep the load factor below 1/2
+	    unsigned long n = _slots.empty() ? 16 : 2 * _slots.size();
+	    _slots.assign(n, 0);
+	    for (unsigned int e = 0; e < _entries.size(); ++e) {
+		place(e);
+	    }
+	}
+	else {
+	    place(_entries.size() - 1);
+	}
+    }
+    /**
+     * Returns the number of entries
+     */
+    unsigned int size() const {
+	return _entries.size();
+    }
+};
+
+} /* namespace jags */
+
+#endif /* INTERN_TABLE_H_ */
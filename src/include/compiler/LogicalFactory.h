@@ -3,11 +3,11 @@
 
 #include <vector>
 #include <utility>
-#include <map>
 #include <cfloat>
 
 #include <function/FunctionPtr.h>
 #include <compiler/NodeFactory.h>
+#include <compiler/InternTable.h>
 
 namespace jags {
 
@@ -37,6 +37,17 @@ typedef std::pair<FunctionPtr,std::vector<Node const *> > LogicalPair;
  */
 bool lt(LogicalPair const &arg1, LogicalPair const &arg2);
 
+/**
+ * @short Hash function for LogicalPair objects
+ *
+ * The hash value is calculated from the address of the function and
+ * the parameters, and is compatible with the ordering given by lt.
+ */
+struct LogicalPairHash
+{
+    void operator()(FuzzyHash &h, LogicalPair const &lpair) const;
+};
+
 /**
  * @short Factory object for logical nodes 
  *
@@ -48,7 +59,8 @@ bool lt(LogicalPair const &arg1, LogicalPair const &arg2);
  */
 class LogicalFactory 
 { 
-    std::map<LogicalPair, Node*, fuzzy_less<LogicalPair> > _logicalmap;
+    InternTable<LogicalPair, Node*, LogicalPairHash, fuzzy_less<LogicalPair> >
+    _logicalmap;
 	
 public:
     /**
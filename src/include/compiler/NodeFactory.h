@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <cfloat>
+#include <cstdint>
 
 namespace jags {
 
@@ -65,6 +66,47 @@ namespace jags {
 	}
     };
 
+    /**
+     * @short Hash function compatible with the fuzzy comparisons
+     *
+     * A FuzzyHash accumulates a hash value from a sequence of
+     * integers, doubles and Nodes. Any two sequences that are
+     * equivalent under the fuzzy less than functions above share at
+     * least one candidate hash value.
+     *
+     * Doubles are hashed by rounding them to a grid that is much
+     * coarser than the numerical tolerance. A value that lies within
+     * the tolerance of a grid boundary is ambiguous, as an equivalent
+     * value may be rounded the other way, and each ambiguous value
+     * doubles the number of candidate hash values. In practice this
+     * is very rare, and there is a single candidate. 
+     *
+     * Fixed nodes are hashed by their dimension and values, and
+     * non-fixed nodes by their id.
+     */
+    class FuzzyHash {
+	std::uint64_t _hash;
+	std::vector<std::uint64_t> _alt;
+	unsigned int _n;
+    public:
+	FuzzyHash();
+	void add(std::uint64_t x);
+	void add(double x);
+	void add(Node const *node);
+	void add(std::vector<Node const *> const &nodes);
+	/**
+	 * Returns the number of ambiguous values that have been added
+	 */
+	unsigned int nambiguous() const;
+	/**
+	 * Returns a candidate hash value. Candidate 0 is the hash value
+	 * obtained by rounding all doubles to the nearest grid point.
+	 * The other 2^nambiguous() - 1 candidates are obtained by
+	 * rounding the ambiguous values the other way.
+	 */
+	std::uint64_t candidate(unsigned long i) const;
+    };
+
 } /* namespace jags */
 
 #endif /* NODE_FACTORY_H_ */
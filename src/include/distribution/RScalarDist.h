@@ -41,6 +41,12 @@ public:
     double logDensity(double x, PDFType type,
 		      std::vector<double const *> const &parameters,
 		      double const *lower, double const *upper) const;
+    /**
+     * Calls the density function d directly for each value, skipping
+     * the checks for truncation in logDensity.
+     */
+    double logDensitySum(double const *x, double const * const *par,
+			 unsigned int n, PDFType type) const;
     double randomSample(std::vector<double const *> const &parameters,
 			double const *lower, double const *upper,
 			RNG *rng) const;
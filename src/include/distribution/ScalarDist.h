@@ -76,6 +76,34 @@ class ScalarDist : public Distribution
 			    std::vector<double const *> const &parameters,
 			    double const *lbound, double const *ubound)
       const = 0;
+  /**
+   * Calculates the sum of the log densities of n values, each with
+   * its own parameters and without bounds. The result is the same as
+   * the sum of the log densities of the corresponding
+   * ScalarStochasticNodes: a term is JAGS_NEGINF if its parameter
+   * values are invalid.
+   *
+   * The result is equal to the node-by-node sum only up to rounding
+   * error. Overloads may rearrange the calculation, and callers may
+   * add up the sums for several groups of values in a different
+   * order from the nodes, so the last few bits can differ.
+   *
+   * The default implementation calls logDensity for each value.
+   * Distributions that are frequently used for the stochastic
+   * children of a sampled node may overload it with a tighter loop
+   * that avoids a virtual function call for each value.
+   *
+   * @param x Array of n values
+   *
+   * @param par Array of n * npar() pointers, in which the parameters
+   * of x[i] are given by par[i * npar()], ... , par[(i+1) * npar() - 1]
+   *
+   * @param n Number of values
+   *
+   * @param type Type of density calculation
+   */
+  virtual double logDensitySum(double const *x, double const * const *par,
+			       unsigned int n, PDFType type) const;
   /**
    * Draws a random sample 
    */
@@ -127,7 +155,28 @@ class ScalarDist : public Distribution
    */
   virtual double KL(std::vector<double const *> const &par1,
 		    std::vector<double const *> const &par2) const;
-  
+  /**
+   * Calculates the exact Kullback-Leibler divergences for n pairs of
+   * parameter values. This is equivalent to calling KL for each
+   * pair, and element i of kl is set to JAGS_NA if there is no
+   * exact calculation.
+   *
+   * The default implementation calls KL for each pair. Distributions
+   * that are frequently used for observed nodes may overload it with
+   * a tighter loop.
+   *
+   * @param kl Array of length n in which the divergences are written
+   *
+   * @param par1 Array of n * npar() pointers to the first set of
+   * parameters, laid out as in logDensitySum
+   *
+   * @param par2 Array of n * npar() pointers to the second set of
+   * parameters
+   *
+   * @param n Number of pairs
+   */
+  virtual void KLBatch(double *kl, double const * const *par1,
+		       double const * const *par2, unsigned int n) const;
 };
 
 } /* namespace jags */
@@ -13,11 +13,18 @@ namespace jags {
  * be used to aggregate several small nodes into a larger one, or to take
  * a subset of a larger node, or some combination of the two.
  *
+ * When the values it copies are stored contiguously, for example
+ * when it takes a contiguous slice of a single parent, or when its
+ * parents are adjacent in the storage allocated by the Model, an
+ * aggregate node is a view: it uses the storage of its parents for
+ * its values and does not need to copy them.
  */
 class AggNode : public DeterministicNode {
     std::vector<unsigned int> _offsets;
     std::vector<double const *>  _parent_values;
     bool _discrete;
+    bool _view;
+    void setParentValues();
     /* Forbid copying */
     AggNode(AggNode const &orig);
     AggNode &operator=(AggNode const &rhs);
@@ -54,9 +61,20 @@ public:
 	    std::vector<unsigned int> const &offsets);
     ~AggNode();
     /**
-     * Copies values from parents.
+     * Copies values from parents. This does nothing if the node is a
+     * view.
      */
     void deterministicSample(unsigned int chain);
+    /**
+     * Refreshes the pointers to the parent values, and checks whether
+     * the node can be a view of its parents' storage.
+     */
+    void resetParentValues();
+    /**
+     * Indicates whether the node is a view, which shares the storage
+     * of its parents instead of copying their values.
+     */
+    bool isView() const;
     /**
      * An aggregate node is discrete valued if all of its parents are.
      */
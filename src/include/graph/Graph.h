@@ -1,33 +1,87 @@
 #ifndef GRAPH_H_
 #define GRAPH_H_
 
-#include <set>
 #include <vector>
 
 namespace jags {
 
 class Node;
+class GraphAdjacency;
 
 /**
  * A graph is a container class for (pointers to) Nodes. A Node may
  * belong to several Graphs. Further, if Node N is in graph G, then
  * there is no requirement that the parents or children of N lie in G.
  *
+ * Nodes are stored in a vector, in the order that they were inserted,
+ * and each node is given a position within the graph.  Membership is
+ * recorded in a table indexed by the id of the node (see Node#id) so
+ * that it can be tested in constant time.  Consequently, only nodes
+ * that have been added to a Model may be inserted into a Graph.
+ *
  * @short Container class for nodes
  */
-class Graph : public std::set<Node*> {
-  /* forbid copying */
-  Graph(Graph const &orig);
-  Graph &operator=(Graph const &rhs);
+class Graph {
+    std::vector<Node*> _nodes;
+    std::vector<unsigned int> _position;
+    mutable GraphAdjacency *_adjacency;
+    void invalidate();
+    /* forbid copying */
+    Graph(Graph const &orig);
+    Graph &operator=(Graph const &rhs);
 public:
-  /**
-   * Creates an empty graph
-   */
-  Graph();
-  /**
-   * Checks to see whether the node is contained in the Graph.
-   */
-  bool contains(Node const *node) const;
+    typedef std::vector<Node*>::const_iterator const_iterator;
+    typedef std::vector<Node*>::const_iterator iterator;
+    /**
+     * Creates an empty graph
+     */
+    Graph();
+    ~Graph();
+    /**
+     * Adds a node to the graph. If the node is already in the graph,
+     * this does nothing. A logic_error is thrown if the node does not
+     * have an id.
+     */
+    void insert(Node *node);
+    /**
+     * Removes a node from the graph. The last node in the graph takes
+     * the position of the removed node.
+     */
+    void erase(Node *node);
+    /**
+     * Removes all nodes from the graph
+     */
+    void clear();
+    /**
+     * Checks to see whether the node is contained in the Graph.
+     */
+    bool contains(Node const *node) const;
+    /**
+     * Returns the position of the node in the graph, a number between
+     * 0 and size() - 1. A logic_error is thrown if the node is not in
+     * the graph.
+     */
+    unsigned int position(Node const *node) const;
+    /**
+     * Returns the node at the given position.
+     */
+    Node *node(unsigned int position) const;
+    /**
+     * Returns the number of nodes in the graph
+     */
+    unsigned int size() const;
+    /**
+     * Indicates whether the graph is empty
+     */
+    bool empty() const;
+    const_iterator begin() const;
+    const_iterator end() const;
+    /**
+     * Returns the adjacency structure of the graph. This is created
+     * on first use and discarded when the graph is modified, so it
+     * should only be used when the graph is no longer changing.
+     */
+    GraphAdjacency const &adjacency() const;
 };
 
 } /* namespace jags */
@@ -0,0 +1,69 @@
+#ifndef GRAPH_ADJACENCY_H_
+#define GRAPH_ADJACENCY_H_
+
+#include <vector>
+
+namespace jags {
+
+class Graph;
+class StochasticNode;
+class DeterministicNode;
+
+/**
+ * @short Compressed adjacency lists for the nodes in a Graph
+ *
+ * A GraphAdjacency holds the parents and children of every node in a
+ * Graph in compressed sparse row format: the neighbours of the node
+ * at position i in the graph are stored contiguously, between
+ * offsets[i] and offsets[i+1].  Only parents and children that are
+ * themselves in the graph are included.  Traversing the graph with a
+ * GraphAdjacency avoids both repeated membership tests and walking
+ * the linked lists of children held by each Node.
+ *
+ * A GraphAdjacency is a snapshot: it is not updated if the graph is
+ * subsequently modified.
+ *
+ * @see Graph#adjacency
+ */
+class GraphAdjacency {
+    std::vector<unsigned int> _parent_offsets;
+    std::vector<unsigned int> _parents;
+    std::vector<unsigned int> _schild_offsets;
+    std::vector<StochasticNode*> _schildren;
+    std::vector<unsigned int> _dchild_offsets;
+    std::vector<DeterministicNode*> _dchildren;
+public:
+    typedef std::vector<unsigned int>::const_iterator parent_iterator;
+    typedef std::vector<StochasticNode*>::const_iterator schild_iterator;
+    typedef std::vector<DeterministicNode*>::const_iterator dchild_iterator;
+    /**
+     * Constructs the adjacency lists for the given graph
+     */
+    GraphAdjacency(Graph const &graph);
+    /**
+     * Returns the number of nodes
+     */
+    unsigned int size() const;
+    /**
+     * Iterators over the positions in the graph of the parents of the
+     * node at position i.
+     */
+    parent_iterator parentsBegin(unsigned int i) const;
+    parent_iterator parentsEnd(unsigned int i) const;
+    /**
+     * Iterators over the stochastic children of the node at
+     * position i.
+     */
+    schild_iterator stochasticChildrenBegin(unsigned int i) const;
+    schild_iterator stochasticChildrenEnd(unsigned int i) const;
+    /**
+     * Iterators over the deterministic children of the node at
+     * position i.
+     */
+    dchild_iterator deterministicChildrenBegin(unsigned int i) const;
+    dchild_iterator deterministicChildrenEnd(unsigned int i) const;
+};
+
+} /* namespace jags */
+
+#endif /* GRAPH_ADJACENCY_H_ */
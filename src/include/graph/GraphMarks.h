@@ -1,8 +1,6 @@
 #ifndef GRAPH_MARKS_H_
 #define GRAPH_MARKS_H_
 
-#include <map>
-#include <set>
 #include <vector>
 
 namespace jags {
@@ -23,11 +21,15 @@ enum LogicalMark {MARK_NULL=0, MARK_TRUE=1, MARK_FALSE=2};
  * as an argument, the supplied node must belong to the marked graph,
  * or a logic_error exception is thrown.
  *
+ * Marks are held in a vector indexed by node id (see Node#id), which
+ * grows as non-zero marks are set.
+ *
  * @see Graph
  */
 class GraphMarks {
     Graph const &_graph;
-    std::map<Node const*,int> _marks;
+    std::vector<int> _marks;
+    void setMark(Node const *node, int m);
   public:
     /**
      * Constructor. Each node in the graph initially has mark zero 
@@ -67,6 +69,13 @@ class GraphMarks {
      * graph.
      */
     void markAncestors(std::vector<Node const *> const &nodes, int m);
+    /**
+     * Marks the descendants of the nodes in the graph, i.e. every
+     * node N for which there is a directed path from one of the given
+     * nodes to N within the graph. As with markAncestors, the given
+     * nodes are also marked if they are in the graph.
+     */
+    void markDescendants(std::vector<Node const *> const &nodes, int m);
 };
 
 } /* namespace jags */
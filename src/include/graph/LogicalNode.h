@@ -19,7 +19,7 @@ class LogicalNode : public DeterministicNode {
     Function const * const _func;
     bool _discrete;
 protected:
-    const std::vector<std::vector<double const*> > _parameters;
+    std::vector<std::vector<double const*> > _parameters;
 public:
     /**
      * A logical node is defined by a function (which may be an inline
@@ -43,6 +43,7 @@ public:
     bool isClosed(std::set<Node const *> const &ancestors, 
 		  ClosedFuncClass fc, bool fixed) const;
     std::string deparse(std::vector<std::string> const &) const;
+    void resetParentValues();
 };
 
 } /* namespace jags */
@@ -32,6 +32,19 @@ namespace jags {
 	 * pointer is returned.
 	 */
 	Node const * getNode(std::vector<int> const &index) const;
+	/**
+	 * Returns a pointer to the node corresponding to the current
+	 * values of the given index nodes in the given chain.  This is
+	 * equivalent to calling getNode with the index values, but
+	 * does not allocate a vector to hold them. If there is no
+	 * matching node, or the index values are out of range, a NULL
+	 * pointer is returned.
+	 *
+	 * @param index Array of scalar index nodes, of length equal to
+	 * the number of dimensions of the range.
+	 */
+	Node const * getNode(Node const * const *index,
+			     unsigned int chain) const;
 	/**
 	 * Returns the range covered by the indices
 	 */
@@ -31,13 +31,19 @@ namespace jags {
  * y[i] is a mixture node if ind[i] is unobserved.  If the possible
  * values of ind[i] are 1...M, then the parents of y[i] are ind[i],
  * x[1], ... x[M].
+ *
+ * In index-only mode, a mixture node keeps only the active parent
+ * selected from its MixTab, and its value reads through to the value
+ * of the active parent instead of holding a copy.
  */
 class MixtureNode : public DeterministicNode {
     MixTab const *_table;
     unsigned int _Nindex;
     bool _discrete;
+    bool _index_only;
     std::vector<Node const *> _active_parents;
     void updateActive(unsigned int chain);
+    void readActive(unsigned int chain);
 public:
     /**
      * Constructs a MixtureNode. 
@@ -54,9 +60,33 @@ public:
 		unsigned int nchain, MixMap const &mixmap);
     ~MixtureNode();
     /**
-     * Copies the value of the active parent
+     * Copies the value of the active parent. In index-only mode, the
+     * value is not copied: the mixture node and its stochastic
+     * children read through to the value of the active parent
+     * whenever it changes.
      */
     void deterministicSample(unsigned int chain);
+    /**
+     * Switches index-only mode on or off. In index-only mode, the
+     * stochastic children of the mixture node hold pointers to the
+     * value of the active parent, which move whenever the index
+     * changes. Any other class that keeps pointers to the parameters
+     * of these children must check for them with hasIndexOnlyParent.
+     *
+     * A logic_error is thrown if index-only mode is requested for a
+     * node with deterministic children, which keep pointers to the
+     * value of the mixture node.
+     */
+    void setIndexOnly(bool flag);
+    /**
+     * Indicates whether the node is in index-only mode
+     */
+    bool isIndexOnly() const;
+    /**
+     * In index-only mode, refreshes the pointer to the value of the
+     * active parent.
+     */
+    void resetParentValues();
     /**
      * Returns a pointer to the currently active parent (i.e. the one
      * determined by the current index values) in the given chain.
@@ -107,6 +137,12 @@ public:
 
 bool isMixture(Node const *);
 MixtureNode const * asMixture(Node const *);
+/**
+ * Returns true if any parent of the node is a mixture node in
+ * index-only mode.  The values of these parents move when their
+ * index changes.
+ */
+bool hasIndexOnlyParent(Node const *node);
 
 } /* namespace jags */
 
@@ -31,6 +31,8 @@ class Node {
     std::vector<Node const *> _parents;
     std::list<StochasticNode*> *_stoch_children;
     std::list<DeterministicNode *> *_dtrm_children;
+    bool _own_data;
+    unsigned int _id;
 
     /* Forbid copying of Node objects */
     Node(Node const &orig);
@@ -40,9 +42,33 @@ protected:
     std::vector<unsigned int> const &_dim;
     const unsigned int _length;
     const unsigned int _nchain;
+    //The values for chain n start at _data + n * _stride
     double *_data;
+    unsigned int _stride;
+    //If not null, non-null entries override the values for each chain
+    double const **_read_through;
+    /**
+     * Makes the node use storage owned by another node, normally one
+     * of its parents, for its values. Any storage owned by the node
+     * is released, and the values for chain n subsequently start at
+     * data + n * stride. The node must not modify its values after
+     * this call, as they belong to the other node.
+     */
+    void shareValue(double const *data, unsigned int stride);
+    /**
+     * Makes the value of the node in the given chain read through to
+     * an array held by another node, normally one of its parents,
+     * without copying it. The value function then returns the given
+     * pointer. A null pointer restores the node's own storage, which
+     * is left unchanged while the node reads through.
+     */
+    void readThrough(double const *value, unsigned int chain);
 
 public:
+    /**
+     * Value of the id for a node that has not been added to a Model
+     */
+    static const unsigned int NO_ID = ~0U;
     /**
      * Constucts a Node with no parents.
      * @param dim Dimension of new Node.
@@ -141,6 +167,8 @@ public:
     /**
      * Returns a pointer to the start of the array of values for 
      * the given chain.
+     *
+     * @see Node#readThrough
      */
     double const *value(unsigned int chain) const;
     /**
@@ -155,6 +183,49 @@ public:
      * Swaps the values in the given chains
      */
     void swapValue(unsigned int chain1, unsigned int chain2);
+    /**
+     * Moves the values of the node to external storage, which is
+     * normally a block allocated by the Model.  The current values
+     * are copied, and the values for chain n subsequently start at
+     * data + n * stride.  The storage is not owned by the node, and
+     * must remain valid for its lifetime.
+     *
+     * Since the children of the node may keep pointers to its values,
+     * the function resetParentValues must be called on each child
+     * after the storage has been moved.
+     *
+     * @param data Pointer to the values for the first chain
+     *
+     * @param stride Distance between the values of successive
+     * chains. This must not be less than the length of the node.
+     */
+    void moveValue(double *data, unsigned int stride);
+    /**
+     * Indicates whether the node owns the storage for its values
+     * or whether they have been moved with moveValue.
+     */
+    bool ownsValue() const;
+    /**
+     * Refreshes any pointers to the values of the parents that are
+     * held by the node. This must be called after the values of a
+     * parent have been moved. The default implementation does nothing.
+     *
+     * @see Node#moveValue
+     */
+    virtual void resetParentValues();
+    /**
+     * Returns the id of the node. Nodes are given dense integer ids,
+     * counting from zero, in the order that they are added to a
+     * Model, so the id may be used to index a vector of node
+     * attributes in place of a map keyed by node pointers.  A node
+     * that has not been added to a Model has id NO_ID.
+     */
+    unsigned int id() const;
+    /**
+     * Sets the id of the node. This is called by Model#addNode, and a
+     * logic_error is thrown if the node already has an id.
+     */
+    void setId(unsigned int id);
 
     void addChild(StochasticNode *node) const;
     void removeChild(StochasticNode *node) const;
@@ -75,6 +75,11 @@ public:
      * Returns a pointer to the Distribution.
      */
     Distribution const *distribution() const;
+    /**
+     * Returns pointers to the values of the parameters for the given
+     * chain, in the form used by Distribution member functions.
+     */
+    std::vector<double const *> const &parameters(unsigned int chain) const;
     /**
      * Returns the log of the prior density of the StochasticNode
      * given the current parameter values.
@@ -174,6 +179,15 @@ public:
     virtual double KL(unsigned int chain1, unsigned int chain2, RNG *rng,
 		      unsigned int nrep) const = 0;
     void unlinkParents();
+    void resetParentValues();
+    /**
+     * Refreshes the pointers to the values of the parameters in the
+     * given chain.  This is called by a mixture node in index-only
+     * mode when its value moves to another parent.
+     *
+     * @see MixtureNode#setIndexOnly
+     */
+    void resetParentValues(unsigned int chain);
 };
 
 /**
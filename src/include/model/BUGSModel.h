@@ -24,6 +24,23 @@ class BUGSModel : public Model
     SymTab _symtab;
     //std::map<Node const*, std::pair<std::string, Range> > _node_map;
     std::list<MonitorInfo> _bugs_monitors;
+    void codaStream(std::vector<MonitorControl const *> const &controls,
+		    std::string const &stem, std::string &warn);
+    Monitor *newMonitor(std::string const &name, Range const &range,
+			std::string const &type, std::string &msg);
+protected:
+    /**
+     * Appends the name, range and type of each monitor created by
+     * setMonitor, together with its thinning interval, progress
+     * and state.
+     */
+    void checkpointMonitors(std::vector<CheckpointMonitor> &entries) const;
+    /**
+     * Creates the monitors in the checkpoint and sets their states.
+     * If this succeeds, all monitors created by setMonitor are
+     * deleted and replaced by the new ones.
+     */
+    void restoreMonitors(std::vector<CheckpointMonitor> const &entries);
 public:
     BUGSModel(unsigned int nchain);
     ~BUGSModel();
@@ -44,14 +61,22 @@ public:
      * @param warn String that will contain any warning messages on
      * exit. It is cleared on entry.
      *
+     * @param binary If true, monitors that do not pool over iterations
+     * are written in binary format, and their values continue to be
+     * streamed to disk as the model is updated.
+     *
      * @exception logic_error
+     *
+     * @see CODAStream
      */
     void coda(std::vector<std::pair<std::string,Range> > const &nodes, 
-	      std::string const &prefix, std::string &warn);
+	      std::string const &prefix, std::string &warn,
+	      bool binary = false);
     /**
      * Write out all monitors in CODA format
      */
-    void coda(std::string const &prefix, std::string &warn);
+    void coda(std::string const &prefix, std::string &warn,
+	      bool binary = false);
     /**
      * Sets the state of the RNG, and the values of the unobserved
      * stochastic nodes in the model, for a given chain.
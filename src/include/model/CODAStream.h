@@ -0,0 +1,101 @@
+#ifndef CODA_STREAM_H_
+#define CODA_STREAM_H_
+
+#include <vector>
+#include <string>
+#include <fstream>
+
+namespace jags {
+
+class Monitor;
+class MonitorControl;
+
+/**
+ * @short Binary CODA output written while the model is updated
+ *
+ * A CODAStream writes the values of a set of monitors to disk in a
+ * binary format, with one file for each chain.  The values already
+ * held by the monitors are written when the stream is created, and
+ * new values are appended as the monitors are updated, so that the
+ * output is streamed to disk during sampling.
+ *
+ * Each file contains, in little-endian byte order:
+ * - the 8 characters "JAGSCODA"
+ * - the format version (uint32, currently 1), the number of
+ *   variables nvar (uint32), and the number of rows of data (uint64).
+ *   The number of rows is brought up to date whenever the stream is
+ *   flushed.
+ * - the variable names, each given by its length (uint32) followed
+ *   by its characters.
+ * - the index, which gives the first iteration and the thinning
+ *   interval (uint32 each) of every variable.
+ * - the data, a row-major matrix of float64 values with nvar + 1
+ *   columns and one row for each monitored iteration. The first
+ *   column holds the iteration number and the remaining columns hold
+ *   the values of the variables.
+ *
+ * A variable has no value in a row if its monitor has a different
+ * start or thinning interval from the monitor that defines the row.
+ * Such values, and missing values, are written as NA, using the bit
+ * pattern of NA_real_ in R.
+ */
+class CODAStream {
+    std::vector<MonitorControl const *> _controls;
+    std::vector<unsigned int> _nwritten;
+    std::vector<std::string> _files;
+    std::vector<std::ofstream*> _output;
+    unsigned int _nvar;
+    unsigned long _nrow;
+    std::vector<unsigned char> _buffer;
+    std::vector<double> _row;
+    void writeHeader(std::ofstream &out) const;
+    void writePending();
+    void writeRowCount();
+    void close();
+    /* forbid copying */
+    CODAStream(CODAStream const &orig);
+    CODAStream &operator=(CODAStream const &rhs);
+public:
+    /**
+     * Creates the output files and writes out the current values of
+     * the monitors. A runtime_error is thrown if any of the files
+     * cannot be opened.
+     *
+     * @param controls Monitors to be written. None of the monitors
+     * may pool over iterations, and they must either all pool over
+     * chains or all have a separate value for each chain. The
+     * MonitorControl objects must remain valid while the stream
+     * is open.
+     *
+     * @param files Names of the output files, one for each chain,
+     * or a single name if the monitors pool over chains.
+     */
+    CODAStream(std::vector<MonitorControl const *> const &controls,
+	       std::vector<std::string> const &files);
+    /**
+     * Flushes and closes the output files
+     */
+    ~CODAStream();
+    /**
+     * Appends any values added to the monitors since the last call.
+     * This is called by the Model after its monitors are updated.
+     */
+    void update();
+    /**
+     * Updates the number of rows in the header of each file and
+     * flushes the output.
+     */
+    void flush();
+    /**
+     * Indicates whether the given monitor is written by the stream
+     */
+    bool isWriting(Monitor const *monitor) const;
+    /**
+     * Returns the names of the output files
+     */
+    std::vector<std::string> const &files() const;
+};
+
+} /* namespace jags */
+
+#endif /* CODA_STREAM_H_ */
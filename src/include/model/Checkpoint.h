@@ -0,0 +1,118 @@
+#ifndef CHECKPOINT_H_
+#define CHECKPOINT_H_
+
+#include <vector>
+#include <string>
+#include <iosfwd>
+
+namespace jags {
+
+/**
+ * @short Writes a binary checkpoint of the model state
+ *
+ * A checkpoint holds everything needed to continue sampling from a
+ * freshly compiled and initialized copy of the same model, so that a
+ * restored model produces exactly the same samples as one that was
+ * not interrupted. Sample methods that keep information which is not
+ * part of their state say so in their getState function.
+ *
+ * All values are written in little-endian byte order.  Integers are
+ * written as uint32 (or int32 for RNG states), and doubles as
+ * float64 with their bit patterns preserved. Strings and vectors are
+ * written as their length (uint32) followed by their elements.
+ *
+ * A checkpoint file contains:
+ * - the 8 characters "JAGSCKPT" and the format version (uint32,
+ *   currently 1)
+ * - the number of chains, the current iteration, and the adaptive
+ *   mode flag
+ * - the values of all nodes that are not fixed, for each chain
+ * - for each chain, the name and state of the RNG, followed by the
+ *   states of any RNG substreams
+ * - for each sampler, its name and its state for each chain
+ * - for each monitor created by name, its name, range, type,
+ *   thinning interval, first iteration, number of stored iterations
+ *   and its state
+ *
+ * The number of nodes and the lengths of their values, and the
+ * names of the samplers, are checked when the checkpoint is
+ * restored, so that a checkpoint cannot be loaded into a different
+ * model.
+ *
+ * @see Model#checkpoint, Model#restore
+ */
+class CheckpointWriter {
+    std::ostream &_out;
+public:
+    /**
+     * Writes the file header to the given stream, which should be
+     * opened in binary mode.
+     */
+    CheckpointWriter(std::ostream &out);
+    void putUInt(unsigned int x);
+    void putDouble(double x);
+    void putString(std::string const &x);
+    void putInts(std::vector<int> const &x);
+    void putDoubles(std::vector<double> const &x);
+    /**
+     * Writes n doubles from the array x without a length prefix
+     */
+    void putDoubles(double const *x, unsigned int n);
+};
+
+/**
+ * @short Monitor in a checkpoint
+ *
+ * A CheckpointMonitor holds the entry for one monitor in the monitor
+ * section of a checkpoint.
+ */
+struct CheckpointMonitor {
+    /** Name of the monitored variable */
+    std::string name;
+    /** Scope of the monitored range, or empty for the whole variable */
+    std::vector<std::vector<int> > scope;
+    /** Monitor type */
+    std::string type;
+    /** Thinning interval */
+    unsigned int thin;
+    /** First monitored iteration */
+    unsigned int start;
+    /** Number of stored iterations */
+    unsigned int niter;
+    /** State of the monitor */
+    std::vector<double> state;
+};
+
+/**
+ * @short Reads a binary checkpoint of the model state
+ *
+ * The member functions read the values written by the corresponding
+ * member functions of CheckpointWriter. A runtime_error is thrown if
+ * the stream ends prematurely.
+ *
+ * @see CheckpointWriter
+ */
+class CheckpointReader {
+    std::istream &_in;
+    void read(unsigned char *buf, unsigned int n);
+public:
+    /**
+     * Reads the file header from the given stream, which should be
+     * opened in binary mode. A runtime_error is thrown if the stream
+     * is not a checkpoint, or has an unsupported format version.
+     */
+    CheckpointReader(std::istream &in);
+    unsigned int getUInt();
+    double getDouble();
+    std::string getString();
+    std::vector<int> getInts();
+    std::vector<double> getDoubles();
+    /**
+     * Reads n doubles into the array x. There is no length prefix.
+     */
+    void getDoubles(double *x, unsigned int n);
+};
+
+} /* namespace jags */
+
+#endif /* CHECKPOINT_H_ */
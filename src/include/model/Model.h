@@ -6,6 +6,7 @@
 #include <vector>
 #include <list>
 #include <string>
+#include <iosfwd>
 
 namespace jags {
 
@@ -18,6 +19,8 @@ class Node;
 class StochasticNode;
 class DeterministicNode;
 class ConstantNode;
+class CODAStream;
+struct CheckpointMonitor;
 
 /**
  * @short Graphical model 
@@ -28,9 +31,33 @@ class ConstantNode;
 class Model {
 protected:
   std::vector<Sampler*> _samplers;
+  /**
+   * Appends the monitors to be written to a checkpoint. Monitors
+   * can only be recreated by a subclass that knows how they were
+   * created, so the default implementation appends nothing.
+   */
+  virtual void checkpointMonitors(std::vector<CheckpointMonitor> &monitors)
+      const;
+  /**
+   * Replaces the monitors of the model with those read from a
+   * checkpoint. Either all monitors are replaced or, if an exception
+   * is thrown, the monitors are left unchanged.  The default
+   * implementation throws a runtime_error if there are any monitors
+   * to restore.
+   */
+  virtual void restoreMonitors(std::vector<CheckpointMonitor> const &monitors);
+  /**
+   * Adds a monitor restored from a checkpoint, with its thinning
+   * interval, first iteration and number of stored iterations.
+   * Unlike addMonitor, this may be called in adaptive mode, since
+   * the adaptive mode of the model is restored afterwards.
+   */
+  void addRestoredMonitor(Monitor *monitor, unsigned int thin,
+			  unsigned int start, unsigned int niter);
 private:
   unsigned int _nchain;
   std::vector<RNG *> _rng;
+  std::vector<std::vector<RNG *> > _substreams;
   unsigned int _iteration;
   std::vector<Node*> _nodes;
   std::vector<Node*> _extra_nodes;
@@ -40,10 +67,23 @@ private:
   bool _is_initialized;
   bool _adapt;
   bool _data_gen;
+  bool _index_only_mixtures;
+  double *_values;
+  unsigned long _value_stride;
+  std::vector<std::pair<std::string, double> > _factory_times;
+  std::list<CODAStream*> _coda_streams;
+  void allocateValues();
   void initializeNodes();
   void chooseRNGs();
   void chooseSamplers();
   void setSampledExtra();
+  void updateSamplers(unsigned int chain, unsigned int first,
+		      unsigned int last);
+  void sampleExtra(unsigned int chain);
+  void updateChain(unsigned int chain, unsigned int niter);
+  void updateParallel(unsigned int niter);
+  void updateCODAStreams();
+  void flushCODAStreams();
 public:
   /**
    * @param nchain Number of parallel chains in the model.
@@ -71,6 +111,17 @@ public:
    * @see Node#initialize, Model#rngFactories
    */
   void initialize(bool datagen);
+  /**
+   * Sets whether mixture nodes are put in index-only mode when the
+   * model is initialized, so that they read through to the value of
+   * their active parent instead of copying it.  This only applies to
+   * mixture nodes with no deterministic children. If a deterministic
+   * child is added later, the mixture node returns to copying.  This
+   * must be called before the model is initialized.
+   *
+   * @see MixtureNode#setIndexOnly
+   */
+  void setIndexOnlyMixtures(bool flag);
   /** Returns true if the model has been initialized */
   bool isInitialized();
   /**
@@ -78,8 +129,18 @@ public:
    * logic_error is thrown if the model is uninitialized.
    *
    * @param niter Number of iterations to run
+   *
+   * @param parallel Indicates whether chains should be updated in
+   * parallel, with one thread per chain.  The threads are
+   * synchronized whenever a monitor needs to be updated, so that
+   * monitored values are the same as in a serial update.  Given the
+   * same RNG states, a parallel update produces exactly the same
+   * samples as a serial update. Samplers that are not thread-safe
+   * are updated for all chains by the calling thread.
+   *
+   * @see Sampler#isThreadSafe
    */
-  void update(unsigned int niter);
+  void update(unsigned int niter, bool parallel = false);
   /**
    * Returns the current iteration number 
    */
@@ -96,6 +157,15 @@ public:
    * model, this function has no effect.
    */
   void removeMonitor(Monitor *monitor);
+  /**
+   * Adds a stream of binary CODA output. The model takes ownership
+   * of the stream, which is updated each time the monitors are
+   * updated and flushed at the end of each call to Model#update. Any
+   * existing stream that writes to the same files is closed.  The
+   * stream is closed when any of its monitors is removed, or when
+   * the model is destroyed.
+   */
+  void addCODAStream(CODAStream *stream);
   /**
    * Returns the list of Monitors 
    */
@@ -104,14 +174,19 @@ public:
    * Adds a stochastic node to the model.  The node must be
    * dynamically allocated.  The model is responsible for memory
    * management of the added node and will delete the node when it is
-   * destroyed.
+   * destroyed. The node is given an id equal to the number of nodes
+   * previously added.
+   *
+   * @see Node#id
    */
   void addNode(StochasticNode *node);
   /**
    * Adds a deterministc node to the model.  The node must be
    * dynamically allocated.  The model is responsible for memory
    * management of the added node and will delete the node when it is
-   * destroyed.
+   * destroyed.  Any parents of the node that are mixture nodes in
+   * index-only mode return to copying the value of their active
+   * parent.
    */
   void addNode(DeterministicNode *node);
   /**
@@ -162,6 +237,17 @@ public:
    * @return success indicator
    */
   bool setRNG(RNG *rng, unsigned int chain);
+  /**
+   * Returns an RNG object for the given substream of a chain, which
+   * may be used by a thread other than the one updating the chain.
+   * Substreams are created on first request by the first active RNG
+   * factory that can make substreams of the chain's RNG, and are
+   * discarded if a new RNG is assigned to the chain.
+   *
+   * @return the substream, or a NULL pointer if no RNG factory can
+   * make one.
+   */
+  RNG *substreamRNG(unsigned int chain, unsigned int index);
   /**
    * Tests whether all samplers in adaptive mode have passed the
    * efficiency test that allows adaptive mode to be switched off
@@ -188,6 +274,61 @@ public:
    * Returns a vector of all nodes in the model
    */ 
   std::vector<Node*> const &nodes() const;
+  /**
+   * Returns statistics on the memory used to store the values of
+   * the nodes in the model. When the model is initialized, the
+   * values of all nodes are moved into a single block owned by the
+   * Model, so the number of blocks is reduced to one, plus any nodes
+   * that are added after initialization.
+   *
+   * @param nblock Number of separately allocated blocks of values
+   *
+   * @param nbytes Total size of the blocks in bytes
+   */
+  void allocationStats(unsigned long &nblock, unsigned long &nbytes) const;
+  /**
+   * Returns the time, in seconds, spent by each active sampler
+   * factory in choosing samplers when the model was initialized.
+   * Each element pairs the name of a factory with its time, in the
+   * order that the factories were tried.
+   */
+  std::vector<std::pair<std::string, double> > const &
+      samplerFactoryTimes() const;
+  /**
+   * Returns the number of node log densities calculated by each
+   * sampler when evaluating the log full conditional density, in
+   * the same order as the samplers are updated.
+   *
+   * @see Sampler#evaluations
+   */
+  std::vector<unsigned long> samplerEvaluations() const;
+  /**
+   * Writes a binary checkpoint of the state of the model to the
+   * given stream, which should be opened in binary mode. The
+   * checkpoint holds the current iteration, the values of all
+   * unobserved stochastic nodes, the states of the RNGs, the
+   * samplers and the monitors.  A logic_error is thrown if the
+   * model is not initialized.
+   *
+   * @see CheckpointWriter
+   */
+  void checkpoint(std::ostream &out) const;
+  /**
+   * Restores the state of the model from a checkpoint written by an
+   * identical model.  The model must be initialized, and is
+   * normally a freshly compiled copy of the model that wrote the
+   * checkpoint. Any existing monitors are replaced by those in the
+   * checkpoint. Deterministic nodes are recalculated from the
+   * restored values of their parents.
+   *
+   * The whole checkpoint is read, and its structure is checked
+   * against the model, before the model is modified. The states of
+   * the RNGs, samplers and monitors are then set, and if any of
+   * them is rejected they are all put back as they were. A
+   * runtime_error is thrown if the checkpoint cannot be restored,
+   * in which case the model is unchanged.
+   */
+  void restore(std::istream &in);
 };
 
 } /* namespace jags */
@@ -62,6 +62,16 @@ public:
      * The vector of monitored values for the given chain
      */
     virtual std::vector<double> const &value(unsigned int chain) const = 0;
+    /**
+     * Copies n elements of the monitored values for the given chain,
+     * starting at the given offset, to the array x. The default
+     * implementation copies them from the vector returned by the
+     * value member function. Monitors that do not keep their values
+     * in memory should override it, so that recent values can be
+     * read without reading all of them.
+     */
+    virtual void getValue(double *x, unsigned int chain,
+			  unsigned long offset, unsigned int n) const;
      /**
       * Dumps the monitored values to an SArray. 
       *
@@ -93,6 +103,24 @@ public:
       * dim1 member function.
       */
      void setElementNames(std::vector<std::string> const &names);
+     /**
+      * Writes the internal state of the monitor, from which its
+      * values can be reconstructed, to the given vector, which is
+      * cleared on entry. The default implementation writes nothing,
+      * so a monitor that does not override it starts again with no
+      * stored values when it is restored.
+      *
+      * @see Model#checkpoint
+      */
+     virtual void getState(std::vector<double> &state) const;
+     /**
+      * Restores a state previously written by getState for an
+      * identical monitor.
+      *
+      * @return false if the state does not conform to the monitor,
+      * in which case the monitor is not modified.
+      */
+     virtual bool setState(std::vector<double> const &state);
 };
 
 } /* namespace jags */
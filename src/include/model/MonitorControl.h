@@ -31,6 +31,13 @@ public:
      * @param iteration The current iteration number.
      */
     void update(unsigned int iteration);
+    /**
+     * Returns the first iteration, not before the given one, at which
+     * the monitor will be updated.
+     *
+     * @param iteration The iteration from which to start counting.
+     */
+    unsigned int nextUpdate(unsigned int iteration) const;
     /**
      * Reserves enough memory for a further niter iterations, taking
      * account of the thinning interval of the monitor.
@@ -61,6 +68,11 @@ public:
      * Equality operator
      */
     bool operator==(MonitorControl const &rhs) const;
+    /**
+     * Sets the first iteration and the number of stored iterations,
+     * when the monitor is restored from a checkpoint.
+     */
+    void restore(unsigned int start, unsigned int niter);
 };
 
 } /* namespace jags */
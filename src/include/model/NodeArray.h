@@ -65,6 +65,12 @@ public:
    * returned.
    */
   Node* getSubset(Range const &range, Model &model);
+  /**
+   * Returns the offsets of the elements of the given range that are
+   * not yet covered by an inserted node. Offsets are counted from the
+   * start of the NodeArray, in column-major order.
+   */
+  std::vector<unsigned int> missingOffsets(Range const &range) const;
   /**
    * Sets the values of the nodes in the array. 
    *
@@ -20,6 +20,13 @@ namespace jags {
 	unsigned int _nchain;
 	std::vector<Node *> _node_pointers;
 	std::vector<unsigned int> _offsets;
+	struct GatherRun {
+	    Node const *node;
+	    unsigned int offset;
+	    unsigned int length;
+	};
+	std::vector<GatherRun> _gather;
+	void makeGatherList();
       public:
 	/**
 	 * Constructor. Creates a NodeArraySubset from a NodeArray
@@ -33,6 +40,19 @@ namespace jags {
 	 * @param chain Index number of chain to read.
 	 */
 	std::vector<double> value(unsigned int chain) const;
+	/**
+	 * Copies the values of the nodes in the range covered by the
+	 * NodeArraySubset, in column major order, into a buffer
+	 * supplied by the caller. Unlike the value member function,
+	 * this does not allocate any memory, and it is intended for
+	 * Monitors that are updated at every iteration.
+	 *
+	 * @param value Pointer to the start of a buffer of at least
+	 * length() elements.
+	 *
+	 * @param chain Index number of chain to read.
+	 */
+	void getValue(double *value, unsigned int chain) const;
 	/**
 	 * Returns the dimension of the subset
 	 */
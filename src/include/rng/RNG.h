@@ -54,6 +54,32 @@ struct RNG
      * Generates are andom value with an exponential distribution
      */
     virtual double exponential() = 0;
+    /**
+     * Generates n random values with a uniform distribution on (0,1).
+     * The values are the same as those from n successive calls to
+     * uniform(), and the RNG is left in the same state. The default
+     * implementation calls uniform() n times. Subclasses may override
+     * it with a faster implementation.
+     *
+     * @param x Array of length n that is overwritten with the values
+     * @param n Number of values to generate
+     */
+    virtual void uniform(double *x, unsigned int n);
+    /**
+     * Generates n standard normal random values, which are the same
+     * as those from n successive calls to normal().
+     *
+     * @see uniform(double*, unsigned int)
+     */
+    virtual void normal(double *x, unsigned int n);
+    /**
+     * Generates n random values with an exponential distribution,
+     * which are the same as those from n successive calls to
+     * exponential().
+     *
+     * @see uniform(double*, unsigned int)
+     */
+    virtual void exponential(double *x, unsigned int n);
     /**
      * This static utility function may be used by an RNG object to coerce
      * values in the range [0,1] to the open range (0,1)
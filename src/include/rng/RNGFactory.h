@@ -44,6 +44,23 @@ class RNGFactory
      * way will generate independent streams.
      */
     virtual RNG * makeRNG(std::string const &name) = 0;
+    /**
+     * Returns a newly allocated RNG object that generates a substream
+     * of the given RNG. Substreams with different indices must be
+     * independent of each other and of the original RNG, so that they
+     * can be used by different threads working on the same chain.
+     *
+     * The default implementation returns a NULL pointer, meaning that
+     * the factory cannot make substreams. A factory should also
+     * return a NULL pointer if the RNG was not made by it.
+     *
+     * @param rng RNG previously generated by this factory
+     * @param index Index of the substream
+     */
+    virtual RNG * makeSubstream(RNG const *rng, unsigned int index) 
+    {
+	return 0;
+    }
     /**
      * Returns the name of the RNG factory
      */
@@ -2,11 +2,10 @@
 #define RMATH_RNG_H_
 
 #include <rng/RNG.h>
+#include <rng/RmathGenerators.h>
 
 namespace jags {
 
-enum NormKind {AHRENS_DIETER, BOX_MULLER, KINDERMAN_RAMAGE};
-
 /**
  * @short RNG object based on the R math library
  * 
@@ -17,6 +16,26 @@ class RmathRNG : public RNG
 {
     NormKind _N01_kind;
     double _BM_norm_keep;
+protected:
+    /**
+     * Generates n standard normal random values using uniform random
+     * values from the function object unif. This allows a subclass
+     * with an inline uniform generator to implement the bulk normal
+     * member function without a virtual function call for each
+     * uniform value. The values are the same as those from n calls
+     * to normal() provided that unif returns the same values as
+     * uniform().
+     */
+    template<class Uniform> 
+    void normal(double *x, unsigned int n, Uniform &unif);
+    /**
+     * Generates n exponential random values using uniform random
+     * values from the function object unif.
+     *
+     * @see normal(double*, unsigned int, Uniform&)
+     */
+    template<class Uniform>
+    void exponential(double *x, unsigned int n, Uniform &unif);
 public:
     /**
      * @param norm_kind Defines the algorithm for producing normal random
@@ -25,8 +44,43 @@ public:
     RmathRNG(std::string const &name, NormKind norm_kind);
     double normal();
     double exponential();
+    void normal(double *x, unsigned int n);
+    void exponential(double *x, unsigned int n);
+};
+
+/**
+ * @short Function object calling an inline uniform generator
+ *
+ * An InlineUniform object returns values from the member function
+ * Generate of an RNG. Since the member function is a template
+ * parameter, the call is inlined when the bulk normal and exponential
+ * algorithms of RmathRNG are instantiated with this object, so there
+ * is no virtual function call for each uniform value.
+ */
+template<class T, double (T::*Generate)()>
+class InlineUniform {
+    T *_rng;
+public:
+    InlineUniform(T *rng) : _rng(rng) {}
+    double operator()() { return (_rng->*Generate)(); }
 };
 
+template<class Uniform>
+void RmathRNG::normal(double *x, unsigned int n, Uniform &unif)
+{
+    for (unsigned int i = 0; i < n; ++i) {
+	x[i] = rmath_normal(unif, _N01_kind, _BM_norm_keep);
+    }
+}
+
+template<class Uniform>
+void RmathRNG::exponential(double *x, unsigned int n, Uniform &unif)
+{
+    for (unsigned int i = 0; i < n; ++i) {
+	x[i] = rmath_exponential(unif);
+    }
+}
+
 } /* namespace jags */
 
 #endif /* RMATH_RNG_H_ */
@@ -0,0 +1,73 @@
+#ifndef FREE_NODE_SET_H_
+#define FREE_NODE_SET_H_
+
+#include <list>
+#include <vector>
+
+namespace jags {
+
+class Node;
+class StochasticNode;
+
+/**
+ * @short Set of stochastic nodes that do not yet have a sampler
+ *
+ * A FreeNodeSet holds the stochastic nodes that are waiting for a
+ * sampler while the Model is choosing samplers.  It is passed to each
+ * SamplerFactory, which may iterate over the nodes in the order that
+ * they were inserted, and may test whether a given node is still free
+ * in constant time.  Nodes are removed, also in constant time, as
+ * samplers are created for them.
+ *
+ * Membership is recorded in a table indexed by node id, so only nodes
+ * that have been added to a Model may be inserted.
+ *
+ * @see SamplerFactory#makeSamplers, Node#id
+ */
+class FreeNodeSet {
+    std::list<StochasticNode*> _nodes;
+    std::vector<std::list<StochasticNode*>::iterator> _index;
+    std::vector<bool> _free;
+    /* forbid copying */
+    FreeNodeSet(FreeNodeSet const &orig);
+    FreeNodeSet &operator=(FreeNodeSet const &rhs);
+public:
+    typedef std::list<StochasticNode*>::const_iterator const_iterator;
+    /**
+     * Creates an empty set
+     */
+    FreeNodeSet();
+    /**
+     * Adds a node to the end of the set. If the node is already in
+     * the set, this does nothing.
+     */
+    void insert(StochasticNode *node);
+    /**
+     * Removes a node from the set. A logic_error is thrown if the
+     * node is not in the set.
+     */
+    void erase(Node const *node);
+    /**
+     * Tests whether the node is in the set
+     */
+    bool contains(Node const *node) const;
+    /**
+     * Returns a pointer to the given node if it is in the set, or a
+     * NULL pointer otherwise.
+     */
+    StochasticNode *find(Node const *node) const;
+    /**
+     * Returns the number of nodes in the set
+     */
+    unsigned int size() const;
+    /**
+     * Indicates whether the set is empty
+     */
+    bool empty() const;
+    const_iterator begin() const;
+    const_iterator end() const;
+};
+
+} /* namespace jags */
+
+#endif /* FREE_NODE_SET_H_ */
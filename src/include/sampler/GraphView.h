@@ -11,6 +11,7 @@ class StochasticNode;
 class DeterministicNode;
 class Node;
 class Graph;
+class ScalarDist;
 struct RNG;
 
 /**
@@ -44,6 +45,38 @@ class GraphView {
   std::vector<StochasticNode *> _stoch_children;
   std::vector<DeterministicNode*> _determ_children;
   bool _multilevel;
+  std::vector<std::vector<double const *> > _child_values;
+  mutable std::vector<std::vector<std::vector<double const *> > >
+      _child_params;
+  std::vector<unsigned int> _index_only_children;
+  std::vector<unsigned int> _child_lengths;
+  std::vector<double const *> _null_params;
+  struct ChildGroup {
+      ScalarDist const *dist;
+      std::vector<unsigned int> members;
+      std::vector<std::vector<double const *> > values;
+      std::vector<std::vector<double const *> > params;
+  };
+  std::vector<ChildGroup> _child_groups;
+  std::vector<StochasticNode const *> _other_children;
+  mutable std::vector<std::vector<double> > _xbuffer;
+  mutable std::vector<unsigned long> _nevaluations;
+  // Incremental evaluation
+  bool _incremental;
+  std::vector<std::vector<unsigned int> > _affected_determ;
+  std::vector<std::vector<unsigned int> > _affected_terms;
+  mutable std::vector<std::vector<double> > _terms;
+  mutable std::vector<std::vector<bool> > _dirty;
+  mutable std::vector<std::vector<bool> > _stale;
+  mutable std::vector<std::vector<double> > _oldvalue;
+  std::vector<bool> _is_view;
+  void makeChildTables();
+  void groupChildren();
+  double groupLogDensity(ChildGroup const &group, unsigned int chain) const;
+  double sumLogLikelihood(unsigned int chain) const;
+  void sumTerms(unsigned int chain, double &lprior, double &llike) const;
+  void markChanged(unsigned int i, unsigned int chain) const;
+  void setValueIncremental(double const *value, unsigned int chain) const;
   void classifyChildren(std::vector<StochasticNode *> const &nodes,
 			Graph const &graph,
 			std::vector<StochasticNode *> &stoch_nodes,
@@ -87,6 +120,36 @@ public:
   void setValue(double const * value, unsigned int length, unsigned int chain)
       const;
   void setValue(std::vector<double> const &value, unsigned int chain) const;
+  /**
+   * Turns on incremental evaluation of the log full conditional
+   * density.  In incremental mode, setValue only recalculates the
+   * deterministic descendants of the nodes whose values have
+   * changed, skipping those whose parents are all unchanged, and
+   * logFullConditional only recalculates the log density terms of
+   * the sampled nodes and stochastic children that depend on a
+   * changed node.  The other terms are taken from the previous
+   * evaluation.
+   *
+   * Cached terms are only valid as long as no other part of the
+   * graph is modified, so a sample method that uses incremental
+   * evaluation must call invalidate at the start of each update.
+   */
+  void setIncremental();
+  /**
+   * In incremental mode, marks all cached log density terms for the
+   * given chain as out of date, so that the next call to
+   * logFullConditional calculates them all.  This has no effect if
+   * incremental mode is not on.
+   */
+  void invalidate(unsigned int chain) const;
+  /**
+   * Returns the number of node log densities calculated by
+   * logFullConditional, summed over chains.  Each call adds one for
+   * every sampled node and every stochastic child, except in
+   * incremental mode, where only the terms that are recalculated
+   * are counted.
+   */
+  unsigned long evaluations() const;
   void getValue(std::vector<double> &value, unsigned int chain) const;
   /**
    * Returns the total length of the sampled nodes.
@@ -101,6 +164,35 @@ public:
    * nodes, in topological order
    */
   std::vector<DeterministicNode*> const &deterministicChildren() const;
+  /**
+   * Returns pointers to the values of the stochastic children in
+   * the given chain, in the same order as stochasticChildren.
+   *
+   * These pointers, and those returned by childParameters, are
+   * gathered when the GraphView is constructed, so that an update
+   * method can walk packed arrays instead of following pointers
+   * through each child and its parents. They remain valid as long as
+   * the node values are not moved, which only happens before the
+   * samplers are created (see Model#allocateValues).  The exception
+   * is a parameter that is a mixture node in index-only mode, which
+   * moves whenever its index changes. Pointers to these are
+   * refreshed by each call to childParameters.
+   *
+   * @see MixtureNode#setIndexOnly
+   */
+  std::vector<double const *> const &childValues(unsigned int chain) const;
+  /**
+   * Returns pointers to the values of parameter k of the stochastic
+   * children in the given chain, in the same order as
+   * stochasticChildren.  The pointer is null for a child with fewer
+   * than k + 1 parameters.
+   */
+  std::vector<double const *> const &
+      childParameters(unsigned int k, unsigned int chain) const;
+  /**
+   * Returns the lengths of the stochastic children
+   */
+  std::vector<unsigned int> const &childLengths() const;
   /**
    * Tests whether the node depends deterministically on any of the
    * sampled nodes.  This function may be used by SamplerFactory
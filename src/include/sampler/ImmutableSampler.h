@@ -45,6 +45,16 @@ namespace jags {
 	 * provided to the constructor
 	 */
 	void update(std::vector<RNG*> const &rngs);
+	/**
+	 * Updates a single chain using the update method provided
+	 * to the constructor
+	 */
+	void updateChain(unsigned int chain, RNG *rng);
+	/**
+	 * Returns true. The update method is const, so chains may
+	 * be updated concurrently.
+	 */
+	bool isThreadSafe() const;
 	/**
 	 * The sampler is not adaptive
 	 */
@@ -72,6 +72,11 @@ public:
      * length of the value vector
      */
     unsigned int length() const;
+    /**
+     * Appends the adaptive mode flag and the last accepted value
+     */
+    void getState(std::vector<double> &state) const;
+    void setState(std::vector<double> const &state, unsigned int &pos);
 };
 
 } /* namespace jags */
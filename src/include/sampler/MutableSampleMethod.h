@@ -1,6 +1,8 @@
 #ifndef MUTABLE_SAMPLE_METHOD_H_
 #define MUTABLE_SAMPLE_METHOD_H_
 
+#include <vector>
+
 namespace jags {
 
 struct RNG;
@@ -28,6 +30,26 @@ public:
      * Checks adaptation 
      */
     virtual bool checkAdaptation() const = 0;
+    /**
+     * Appends the state of the sample method to the given vector.
+     * Sample methods that keep information between updates, such as
+     * adaptive step sizes, should override this function, and
+     * subclasses should call the getState function of their parent
+     * class before appending their own state. The default
+     * implementation appends nothing.
+     *
+     * @see Sampler#getState
+     */
+    virtual void getState(std::vector<double> &state) const;
+    /**
+     * Restores the state written by getState, starting at the given
+     * position of the state vector. On exit, pos is the position
+     * after the last element read.  The caller checks that the
+     * state vector has the same length as that given by getState,
+     * so the sample method need not check bounds.
+     */
+    virtual void setState(std::vector<double> const &state,
+			  unsigned int &pos);
 };
 
 } /* namespace jags */
@@ -39,9 +39,25 @@ namespace jags {
 		       std::string const &name);
 	~MutableSampler();
 	void update(std::vector<RNG*> const &rngs);
+	void updateChain(unsigned int chain, RNG *rng);
+	/**
+	 * Returns true. Each chain has its own sample method, so
+	 * chains may be updated concurrently.
+	 */
+	bool isThreadSafe() const;
 	bool isAdaptive() const;
 	void adaptOff();
 	bool checkAdaptation() const;
+	/**
+	 * Writes the state of the sample method for the given chain
+	 */
+	void getState(unsigned int chain, std::vector<double> &state) const;
+	/**
+	 * Restores the state of the sample method for the given
+	 * chain, after checking that it has the length given by
+	 * getState.
+	 */
+	bool setState(unsigned int chain, std::vector<double> const &state);
 	/**
 	 * Returns the name of the sampler, as given to the constructor
 	 */
@@ -75,6 +75,12 @@ public:
      * distribution at the current value.
      */
     virtual double logDensity() const = 0;
+    /**
+     * Appends the state of the step adapter and the running mean of
+     * the acceptance probability to the state of the parent class.
+     */
+    void getState(std::vector<double> &state) const;
+    void setState(std::vector<double> const &state, unsigned int &pos);
 };
 
 } /* namespace jags */
@@ -49,6 +49,37 @@ public:
      * @param rng vector of Pseudo-random number generator functions.
      */
     virtual void update(std::vector<RNG *> const &rng) = 0;
+    /**
+     * Updates a single chain. This is used by Model#update when
+     * chains are run in parallel, in which case it may be called for
+     * different chains at the same time from different threads.  It
+     * is only called for samplers that are thread-safe, which must
+     * override the default implementation. This throws a
+     * logic_error.
+     *
+     * @param chain Number of the chain (starting from zero) to update
+     *
+     * @param rng Pseudo-random number generator for the chain
+     */
+    virtual void updateChain(unsigned int chain, RNG *rng);
+    /**
+     * Indicates whether updateChain may be called concurrently for
+     * different chains. Samplers that share workspace between chains
+     * should return false, in which case a parallel update calls the
+     * update function for all chains from a single thread.  The
+     * default implementation returns false.
+     */
+    virtual bool isThreadSafe() const;
+    /**
+     * Returns the number of node log densities calculated when
+     * evaluating the log full conditional density of the sampled
+     * nodes, summed over chains.  This is a measure of the work done
+     * by samplers, such as slice samplers, that evaluate the density
+     * repeatedly at each update.
+     *
+     * @see GraphView#evaluations
+     */
+    unsigned long evaluations() const;
     /**
      * When a sampler is constructed, it may be in adaptive mode, which
      * allows it to adapt its behaviour for increased
@@ -71,6 +102,27 @@ public:
      * Indicates whether the sampler has an adaptive mode.
      */
     virtual bool isAdaptive() const = 0;
+    /**
+     * Writes the state of the sampler for the given chain to the
+     * vector, which is cleared on entry.  The state includes
+     * everything, apart from the values of the sampled nodes, that
+     * determines future updates, such as step sizes tuned in
+     * adaptive mode. The default implementation writes nothing,
+     * which is correct for samplers that have no state.
+     *
+     * @see Model#checkpoint
+     */
+    virtual void getState(unsigned int chain, std::vector<double> &state)
+	const;
+    /**
+     * Restores a state previously written by getState for an
+     * identical sampler.
+     *
+     * @return false if the state does not conform to the sampler,
+     * in which case the sampler is not modified.
+     */
+    virtual bool setState(unsigned int chain,
+			  std::vector<double> const &state);
     /**
      * Returns a name for the sampler which should describe the method
      * it uses to update the nodes.
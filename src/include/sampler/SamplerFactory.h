@@ -1,8 +1,9 @@
 #ifndef SAMPLER_FACTORY_H_
 #define SAMPLER_FACTORY_H_
 
+#include <sampler/FreeNodeSet.h>
+
 #include <vector>
-#include <list>
 #include <string>
 
 namespace jags {
@@ -19,13 +20,16 @@ class SamplerFactory
 public:
     virtual ~SamplerFactory();
     /**
-     * Finds nodes in the list of stochastic nodes that can be sampled
-     * within the given graph, and returns a vector of newly allocated
-     * samplers for them.  If no sampler can be created, an empty
-     * vector is returned.
+     * Finds nodes in the set of free stochastic nodes that can be
+     * sampled within the given graph, and returns a vector of newly
+     * allocated samplers for them.  If no sampler can be created, an
+     * empty vector is returned.
+     *
+     * @param nodes Set of stochastic nodes that do not yet have a
+     * sampler. Membership of the set may be tested in constant time.
      */
     virtual std::vector<Sampler*> 
-	makeSamplers(std::list<StochasticNode*> const &nodes, 
+	makeSamplers(FreeNodeSet const &nodes, 
 		     Graph const &graph) const = 0;
     /**
       * Returns the name of the sampler factory
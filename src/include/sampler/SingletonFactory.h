@@ -32,7 +32,7 @@ public:
      * This traverses the list of available nodes, creating a Sampler,
      * when possible, for each individual StochasticNode.
      */
-    std::vector<Sampler*> makeSamplers(std::list<StochasticNode*> const &nodes, 
+    std::vector<Sampler*> makeSamplers(FreeNodeSet const &nodes, 
 				       Graph const &graph) const;
 };
 
@@ -102,6 +102,12 @@ public:
      * Returns the state of the sampler.
      */
     SlicerState state() const;
+    /**
+     * Appends the adaptive mode flag, the width of the slice, and
+     * the running sums used to adapt it.
+     */
+    void getState(std::vector<double> &state) const;
+    void setState(std::vector<double> const &state, unsigned int &pos);
 };
 
 } /* namespace jags */
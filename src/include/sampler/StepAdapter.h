@@ -41,6 +41,17 @@ public:
      * p and the target acceptance probability.
      */
     double logitDeviation(double p) const;
+    /**
+     * Appends the state of the StepAdapter to the given vector
+     *
+     * @see MutableSampleMethod#getState
+     */
+    void getState(std::vector<double> &state) const;
+    /**
+     * Restores the state written by getState, starting at position
+     * pos of the state vector, and advances pos past it.
+     */
+    void setState(std::vector<double> const &state, unsigned int &pos);
 };
 
 } /* namespace jags */
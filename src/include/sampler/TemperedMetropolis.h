@@ -121,6 +121,15 @@ public:
      * This function calculates the log Jacobian at the given value.
      */
     virtual double logJacobian(std::vector<double> const &value) const;
+    /**
+     * Appends the current maximum temperature level, the running
+     * mean of the acceptance probability and the step adapters for
+     * each level to the state of the parent class. Levels that have
+     * not yet been reached are padded, so that the length of the
+     * state does not change as the sampler adapts.
+     */
+    void getState(std::vector<double> &state) const;
+    void setState(std::vector<double> const &state, unsigned int &pos);
 };
 
 } /* namespace jags */
@@ -54,6 +54,17 @@ public:
      * Sets the value of an SArray to an integer vector
      */
     void setValue(std::vector<int> const &value);
+    /**
+     * Sets the value of an SArray from an array of doubles
+     *
+     * @param value Pointer to the start of the array
+     *
+     * @param length Length of the array, which must match the length
+     * of the SArray or a length_error exception will be thrown.
+     *
+     * @exception length_error
+     */
+    void setValue(double const *value, unsigned long length);
     /**
      * Sets the value of a single element of SArray
      *
@@ -0,0 +1,61 @@
+#ifndef THREAD_POOL_H_
+#define THREAD_POOL_H_
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+namespace jags {
+
+    /**
+     * @short Pool of worker threads
+     *
+     * A ThreadPool runs a job on a fixed number of workers. Worker 0
+     * is the calling thread, and each other worker has its own thread,
+     * which is created with the pool and reused for every job, so
+     * that the cost of starting and joining threads is paid only once.
+     */
+    class ThreadPool {
+	std::vector<std::thread> _threads;
+	std::vector<std::exception_ptr> _errors;
+	std::mutex _mutex;
+	std::condition_variable _start;
+	std::condition_variable _done;
+	std::function<void(unsigned int)> _job;
+	unsigned int _generation;
+	unsigned int _pending;
+	bool _stop;
+	void work(unsigned int worker);
+	void runWorker(unsigned int worker);
+	/* Forbid copying */
+	ThreadPool(ThreadPool const &);
+	ThreadPool &operator=(ThreadPool const &);
+      public:
+	/**
+	 * Constructs a pool with the given number of workers, starting
+	 * a thread for each worker except the first.
+	 */
+	ThreadPool(unsigned int nworker);
+	/**
+	 * Stops and joins the threads of the pool.
+	 */
+	~ThreadPool();
+	/**
+	 * Returns the number of workers, including the calling thread.
+	 */
+	unsigned int size() const;
+	/**
+	 * Calls job(i) for each worker i, and returns when all calls
+	 * have completed.  If any calls throw an exception, the
+	 * exception thrown by the lowest-numbered worker is rethrown
+	 * after all the others have been discarded.
+	 */
+	void run(std::function<void(unsigned int)> const &job);
+    };
+
+} /* namespace jags */
+
+#endif /* THREAD_POOL_H_ */
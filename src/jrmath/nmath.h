@@ -48,6 +48,19 @@
 
 #include <JRmath.h>
 
+/* Thread-local storage for the state variables that the random
+   variate generators keep between calls. This allows chains to be
+   updated in parallel */
+#if defined(__GNUC__) || defined(__clang__)
+# define JR_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+# define JR_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+# define JR_THREAD_LOCAL _Thread_local
+#else
+# define JR_THREAD_LOCAL
+#endif
+
 /* Used internally only */
 double  jags_d1mach(int);
 double	jags_gamma_cody(double);
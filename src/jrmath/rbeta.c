@@ -47,11 +47,10 @@ double rbeta(double aa, double bb, JRNG *rng)
     double a, b, alpha;
     double r, s, t, u1, u2, v, w, y, z;
     int qsame;
-    /* FIXME:  Keep Globals (properly) for threading */
-    /* Uses these GLOBALS to save time when many rv's are generated : */
-    static double beta, gamma, delta, k1, k2;
-    static double olda = -1.0;
-    static double oldb = -1.0;
+    /* Uses these thread-local GLOBALS to save time when many rv's are generated : */
+    static JR_THREAD_LOCAL double beta, gamma, delta, k1, k2;
+    static JR_THREAD_LOCAL double olda = -1.0;
+    static JR_THREAD_LOCAL double oldb = -1.0;
 
     /* Test if we need new "initializing" */
     qsame = (olda == aa) && (oldb == bb);
@@ -44,14 +44,14 @@
 
 double rbinom(double nin, double pp, JRNG *rng)
 {
-    /* FIXME: These should become THREAD_specific globals : */
+    /* These are thread-specific globals : */
 
-    static double c, fm, npq, p1, p2, p3, p4, qn;
-    static double xl, xll, xlr, xm, xr;
+    static JR_THREAD_LOCAL double c, fm, npq, p1, p2, p3, p4, qn;
+    static JR_THREAD_LOCAL double xl, xll, xlr, xm, xr;
 
-    static double psave = -1.0;
-    static int nsave = -1;
-    static int m;
+    static JR_THREAD_LOCAL double psave = -1.0;
+    static JR_THREAD_LOCAL int nsave = -1;
+    static JR_THREAD_LOCAL int m;
 
     double f, f1, f2, u, v, w, w2, x, x1, x2, z, z2;
     double p, q, np, g, r, al, alv, amaxp, ffm, ynorm;
@@ -96,15 +96,15 @@ double rhyper(double nn1in, double nn2in, double kkin, JRNG *rng)
     double de, dg, dr, ds, dt, gl, gu, nk, nm, ub;
     double xk, xm, xn, y1, ym, yn, yk, alv;
 
-    /* These should become `thread_local globals' : */
-    static int ks = -1;
-    static int n1s = -1, n2s = -1;
+    /* These are `thread_local globals' : */
+    static JR_THREAD_LOCAL int ks = -1;
+    static JR_THREAD_LOCAL int n1s = -1, n2s = -1;
 
-    static int k, m;
-    static int minjx, maxjx, n1, n2;
+    static JR_THREAD_LOCAL int k, m;
+    static JR_THREAD_LOCAL int minjx, maxjx, n1, n2;
 
-    static double a, d, s, w;
-    static double tn, xl, xr, kl, kr, lamdl, lamdr, p1, p2, p3;
+    static JR_THREAD_LOCAL double a, d, s, w;
+    static JR_THREAD_LOCAL double tn, xl, xr, kl, kr, lamdl, lamdr, p1, p2, p3;
 
 
     /* check parameter validity */
@@ -23,6 +23,7 @@
 #include <stdexcept>
 #include <fstream>
 #include <vector>
+#include <chrono>
 
 using std::ostream;
 using std::endl;
@@ -34,6 +35,8 @@ using std::list;
 using std::set;
 using std::pair;
 using std::FILE;
+using std::chrono::steady_clock;
+using std::chrono::duration;
 
 // Need to distinguish between errors that delete the model
 // and errors that don't delete the model (in update)
@@ -213,8 +216,17 @@ bool Console::checkModel(FILE *file)
 }
 
 
+/* Returns the time in seconds since start, and resets start */
+static double lap(steady_clock::time_point &start)
+{
+    steady_clock::time_point now = steady_clock::now();
+    duration<double> elapsed = now - start;
+    start = now;
+    return elapsed.count();
+}
+
 bool Console::compile(map<string, SArray> &data_table, unsigned int nchain,
-                      bool gendata)
+                      bool gendata, bool worklist)
 {
     if (nchain == 0) {
 	_err << "You must have at least one chain" << endl;
@@ -225,6 +237,9 @@ bool Console::compile(map<string, SArray> &data_table, unsigned int nchain,
 	clearModel();
     }
 
+    _compile_times.clear();
+    steady_clock::time_point start = steady_clock::now();
+
     RNG *datagen_rng = 0;
     if (_pdata && gendata) {
 	_model = new BUGSModel(1);
@@ -239,7 +254,7 @@ bool Console::compile(map<string, SArray> &data_table, unsigned int nchain,
 	    _out << "   Resolving undeclared variables" << endl;
 	    compiler.undeclaredVariables(_pdata);
 	    _out << "   Allocating nodes" << endl;
-	    compiler.writeRelations(_pdata);
+	    compiler.writeRelations(_pdata, worklist);
       
 	    /* Check validity of data generating model */
 	    for (vector<Node*>::const_iterator r = _model->nodes().begin();
@@ -275,6 +290,8 @@ bool Console::compile(map<string, SArray> &data_table, unsigned int nchain,
 	    _model = 0;
 	}
 	CATCH_ERRORS;
+	_compile_times.push_back(pair<string, double>("data graph",
+						      lap(start)));
     }
 
     _model = new BUGSModel(nchain);
@@ -285,12 +302,19 @@ bool Console::compile(map<string, SArray> &data_table, unsigned int nchain,
 	if (_pvariables) {
 	    _out << "   Declaring variables" << endl;
 	    compiler.declareVariables(*_pvariables);
+	    _compile_times.push_back(pair<string, double>("declare variables",
+							  lap(start)));
 	}
 	if (_prelations) {
 	    _out << "   Resolving undeclared variables" << endl;
 	    compiler.undeclaredVariables(_prelations);
+	    _compile_times.push_back(pair<string, double>
+				     ("resolve undeclared variables",
+				      lap(start)));
 	    _out << "   Allocating nodes" << endl;
-	    compiler.writeRelations(_prelations);
+	    compiler.writeRelations(_prelations, worklist);
+	    _compile_times.push_back(pair<string, double>("allocate nodes",
+							  lap(start)));
 	}
 	else {
 	    _err << "Nothing to compile" << endl;
@@ -389,7 +413,7 @@ bool Console::setRNGname(string const &name, unsigned int chain)
     return true;
 }
 
-bool Console::update(unsigned int n)
+bool Console::update(unsigned int n, bool parallel)
 {
     if (_model == 0) {
 	_err << "Can't update. No model!" << endl;    
@@ -400,7 +424,7 @@ bool Console::update(unsigned int n)
 	return false;
     }
     try {
-	_model->update(n);
+	_model->update(n, parallel);
     }
     CATCH_ERRORS_DUMP;
 
@@ -559,7 +583,7 @@ bool Console::dumpMonitors(map<string,SArray> &data_table,
 }
 
 
-bool Console::coda(string const &prefix)
+bool Console::coda(string const &prefix, bool binary)
 {
     if (!_model) {
 	_err << "Can't dump CODA output. No model!" << endl;
@@ -568,7 +592,7 @@ bool Console::coda(string const &prefix)
 
     try {
         string warn;
-	_model->coda(prefix, warn);
+	_model->coda(prefix, warn, binary);
         if (!warn.empty()) {
             _err << "WARNING:\n" << warn;
         }
@@ -578,8 +602,56 @@ bool Console::coda(string const &prefix)
     return true;
 }
 
+bool Console::checkpoint(string const &file)
+{
+    if (!_model) {
+	_err << "Can't write checkpoint. No model!" << endl;
+	return false;
+    }
+    if (!_model->isInitialized()) {
+	_err << "Model not initialized" << endl;
+	return false;
+    }
+
+    std::ofstream out(file.c_str(), std::ios::out | std::ios::binary);
+    if (!out) {
+	_err << "Failed to open file " << file << endl;
+	return false;
+    }
+    try {
+	_model->checkpoint(out);
+    }
+    CATCH_ERRORS_DUMP;
+
+    return true;
+}
+
+bool Console::restore(string const &file)
+{
+    if (!_model) {
+	_err << "Can't restore checkpoint. No model!" << endl;
+	return false;
+    }
+    if (!_model->isInitialized()) {
+	_err << "Model not initialized" << endl;
+	return false;
+    }
+
+    std::ifstream in(file.c_str(), std::ios::in | std::ios::binary);
+    if (!in) {
+	_err << "Failed to open file " << file << endl;
+	return false;
+    }
+    try {
+	_model->restore(in);
+    }
+    CATCH_ERRORS_DUMP;
+
+    return true;
+}
+
 bool Console::coda(vector<pair<string, Range> > const &nodes,
-		   string const &prefix)
+		   string const &prefix, bool binary)
 {
     if (!_model) {
 	_err << "Can't dump CODA output. No model!" << endl;
@@ -589,7 +661,7 @@ bool Console::coda(vector<pair<string, Range> > const &nodes,
 
     try {
         string warn;
-	_model->coda(nodes, prefix, warn);
+	_model->coda(nodes, prefix, warn, binary);
         if (!warn.empty()) {
             _err << "WARNINGS:\n" << warn;
         }
@@ -681,6 +753,47 @@ bool Console::dumpSamplers(vector<vector<string> > &sampler_names)
     return true;
 }
 
+bool Console::dumpSamplerTimes(vector<pair<string, double> > &times)
+{
+    if (_model == 0) {
+	_err << "Can't dump sampler times. No model!" << endl;    
+	return false;
+    }
+    if (!_model->isInitialized()) {
+	_err << "Model not initialized" << endl;
+	return false;
+    }
+
+    times = _model->samplerFactoryTimes();
+    return true;
+}
+
+bool Console::dumpCompileTimes(vector<pair<string, double> > &times)
+{
+    if (_model == 0) {
+	_err << "Can't dump compile times. No model!" << endl;    
+	return false;
+    }
+
+    times = _compile_times;
+    return true;
+}
+
+bool Console::dumpSamplerEvaluations(vector<unsigned long> &counts)
+{
+    if (_model == 0) {
+	_err << "Can't dump sampler evaluations. No model!" << endl;    
+	return false;
+    }
+    if (!_model->isInitialized()) {
+	_err << "Model not initialized" << endl;
+	return false;
+    }
+
+    counts = _model->samplerEvaluations();
+    return true;
+}
+
 bool Console::loadModule(string const &name)
 {
     list<Module*>::const_iterator p;
@@ -32,6 +32,7 @@
 #include <set>
 #include <sstream>
 #include <map>
+#include <cstdint>
 
 using std::string;
 using std::vector;
@@ -47,13 +48,17 @@ using std::max;
 using std::set;
 using std::fabs;
 using std::max_element;
+using std::sort;
+using std::unique;
+using std::uint64_t;
 
 
 
 namespace jags {
 
-    typedef pair<vector<unsigned int>, vector<double> > CNodeKey;
-    bool lt(CNodeKey const &k1, CNodeKey const &k2) {
+    bool Compiler::CNodeLess::operator()(CNodeKey const &k1,
+					 CNodeKey const &k2) const
+    {
 	//Sort first on dimension
 	if (k1.first < k2.first) {
 	    return true;
@@ -65,9 +70,19 @@ namespace jags {
 	    //Fuzzy sort on values
 	    return lt(&k1.second[0], &k2.second[0], k1.second.size());
 	}
+    }
 
+    void Compiler::CNodeHash::operator()(FuzzyHash &h,
+					 CNodeKey const &k) const
+    {
+	h.add(static_cast<uint64_t>(k.first.size()));
+	for (unsigned int i = 0; i < k.first.size(); ++i) {
+	    h.add(static_cast<uint64_t>(k.first[i]));
+	}
+	for (unsigned int i = 0; i < k.second.size(); ++i) {
+	    h.add(k.second[i]);
+	}
     }
-    typedef map<CNodeKey, ConstantNode *, fuzzy_less<CNodeKey> > CNodeMap;
 
 #include <sstream>
 template<class T> 
@@ -554,14 +569,14 @@ Range Compiler::CounterRange(ParseTree const *var)
 	    _index_nodes.push_back(cnode);
 	}
 	else {
-	    CNodeMap::key_type k(dim, value);
-	    CNodeMap::const_iterator p = _cnode_map.find(k);
-	    if (p != _cnode_map.end()) {
-		cnode = p->second;
+	    CNodeKey k(dim, value);
+	    ConstantNode **p = _cnode_map.find(k);
+	    if (p) {
+		cnode = *p;
 	    }
 	    else {
 		cnode = new ConstantNode(dim, value, nchain, observed);
-		_cnode_map[k] = cnode;
+		_cnode_map.insert(k, cnode);
 		_model.addNode(cnode);
 	    }
 	}
@@ -598,6 +613,14 @@ Node *Compiler::getArraySubset(ParseTree const *p)
 				 print(subset_range));
 		}
 		node = array->getSubset(subset_range, _model);
+		if (node == 0 && _worklist) {
+		    //Wait for the missing elements to be defined
+		    vector<unsigned int> offsets =
+			array->missingOffsets(subset_range);
+		    for (unsigned int i = 0; i < offsets.size(); ++i) {
+			_missing.push_back(Dependency(p->name(), offsets[i]));
+		    }
+		}
 		if (node == 0 && _resolution_level == 1) {
 		    /* At resolution level 1 we make a note of all
 		       subsets that could not be resolved.
@@ -652,7 +675,12 @@ Node *Compiler::getArraySubset(ParseTree const *p)
 	    }
 	    else if (!_index_expression) {
 		//A stochastic subset
+		unsigned int nmissing = _missing.size();
 		node = getMixtureNode(p, this);
+		if (node == 0 && _worklist && _missing.size() == nmissing) {
+		    //Nothing more specific to wait for
+		    _missing.push_back(Dependency(p->name(), -1));
+		}
 		if (node == 0 && _resolution_level == 1) {
 		    getMissingMixParams(p, _umap, this);
 		}
@@ -669,6 +697,10 @@ Node *Compiler::getArraySubset(ParseTree const *p)
 		p->name();
 	    CompileError(p, msg);
 	}
+	else if (_worklist) {
+	    //Wait for the variable to be created
+	    _missing.push_back(Dependency(p->name(), -1));
+	}
 	
 
     }
@@ -711,6 +743,9 @@ Node *Compiler::getLength(ParseTree const *p, SymTab const &symtab)
 	}
     }
     else {
+	if (_worklist) {
+	    _missing.push_back(Dependency(var->name(), -1));
+	}
 	return 0;
     }
 }
@@ -743,6 +778,9 @@ Node *Compiler::getDim(ParseTree const *p, SymTab const &symtab)
 	}
     }
     else {
+	if (_worklist) {
+	    _missing.push_back(Dependency(var->name(), -1));
+	}
 	return 0;
     }
 }
@@ -1068,6 +1106,9 @@ void Compiler::allocate(ParseTree const *rel)
 	    symtab.addVariable(var->name(), dim);
 	    array = symtab.getVariable(var->name());
 	    array->insert(node, array->range());
+	    if (_worklist) {
+		setDefined(array, array->range());
+	    }
 	}
 	else {
 	    // Check if a node is already inserted into this range
@@ -1077,6 +1118,9 @@ void Compiler::allocate(ParseTree const *rel)
 			     var->name() + print(range));
 	    }
 	    array->insert(node, range);
+	    if (_worklist) {
+		setDefined(array, range);
+	    }
 	}
 	_n_resolved++;
 	_is_resolved[_n_relations] = true;
@@ -1216,23 +1260,28 @@ void Compiler::writeConstantData(ParseTree const *relations)
     _model.symtab().writeData(temp_data_table);
 }
 
-void Compiler::writeRelations(ParseTree const *relations)
+void Compiler::writeRelations(ParseTree const *relations, bool worklist)
 {
     writeConstantData(relations);
     traverseTree(relations, &Compiler::getLHSVars);
 
     _is_resolved = vector<bool>(_n_relations, false);
-    for (unsigned long N = _n_relations; N > 0; N -= _n_resolved) {
-	_n_resolved = 0;
-	/* 
-	   Here we use the abilitiy to sweep forwards and backwards
-	   through the relations, allowing rapid compilation of models
-	   written in both topological order and reverse topological
-	   order. Without this facility, compilation of some large
-	   models can be very slow.
-	*/
-	traverseTree(relations, &Compiler::allocate, true, true);
-	if (_n_resolved == 0) break;
+    if (worklist) {
+	allocateWorklist(relations);
+    }
+    else {
+	for (unsigned long N = _n_relations; N > 0; N -= _n_resolved) {
+	    _n_resolved = 0;
+	    /* 
+	       Here we use the abilitiy to sweep forwards and backwards
+	       through the relations, allowing rapid compilation of
+	       models written in both topological order and reverse
+	       topological order. Without this facility, compilation of
+	       some large models can be very slow.
+	    */
+	    traverseTree(relations, &Compiler::allocate, true, true);
+	    if (_n_resolved == 0) break;
+	}
     }
     _is_resolved.clear();
 
@@ -1398,12 +1447,177 @@ void Compiler::traverseTree(ParseTree const *relations, CompilerMemFn fun,
   
 }
 
+void Compiler::expandRelations(ParseTree const *relations,
+			       vector<pair<ParseTree const *, int> > &counters)
+{
+    /*
+      Expands the for loops once, adding each relation to
+      _loop_relations along with the values of the counters of the
+      enclosing loops. Relations are visited in the same order as
+      traverseTree, so the index of a relation in _loop_relations is
+      the relation number used by allocate.
+    */
+    
+    vector<ParseTree*> const &relation_list = relations->parameters();
+    for (vector<ParseTree*>::const_reverse_iterator p = relation_list.rbegin(); 
+	 p != relation_list.rend(); ++p) 
+    {
+	switch ((*p)->treeClass()) {
+	case P_FOR:
+	    break;
+	case P_STOCHREL: case P_DETRMREL:
+	    _loop_relations.push_back(LoopRelation());
+	    _loop_relations.back().relation = *p;
+	    _loop_relations.back().counters = counters;
+	    break;
+	default:
+	    throw logic_error("Malformed parse tree in expandRelations");
+	}
+    }
+
+    for (vector<ParseTree*>::const_reverse_iterator p = relation_list.rbegin(); 
+	 p != relation_list.rend(); ++p) 
+    {
+	if ((*p)->treeClass() == P_FOR) {
+	    ParseTree const *var = (*p)->parameters()[0];
+	    Range range = CounterRange(var);
+	    if (!isNULL(range)) {
+		Counter *counter = _countertab.pushCounter(var->name(), range);
+		for (; !counter->atEnd(); counter->next()) {
+		    int value = (*counter)[0];
+		    counters.push_back(pair<ParseTree const*, int>(var, value));
+		    expandRelations((*p)->parameters()[1], counters);
+		    counters.pop_back();
+		}
+		_countertab.popCounter();
+	    }
+	}
+    }
+}
+
+bool Compiler::allocateRelation(unsigned int k)
+{
+    /*
+      Tries to allocate relation k with the counters of its enclosing
+      loops set. If it cannot be allocated, it waits for the
+      elements recorded in _missing to be defined.
+    */
+    
+    LoopRelation const &lrel = _loop_relations[k];
+    for (unsigned int i = 0; i < lrel.counters.size(); ++i) {
+	vector<vector<int> > scope(1, vector<int>(1, lrel.counters[i].second));
+	_countertab.pushCounter(lrel.counters[i].first->name(), Range(scope));
+    }
+    _n_relations = k;
+    _missing.clear();
+    allocate(lrel.relation);
+    for (unsigned int i = 0; i < lrel.counters.size(); ++i) {
+	_countertab.popCounter();
+    }
+    if (_is_resolved[k]) {
+	return true;
+    }
+
+    sort(_missing.begin(), _missing.end());
+    _missing.erase(unique(_missing.begin(), _missing.end()), _missing.end());
+    /* Any previous waits for this relation are now out of date */
+    ++_generation[k];
+    _nwaiting[k] = _missing.size();
+    for (unsigned int i = 0; i < _missing.size(); ++i) {
+	_waiting[_missing[i]].push_back(pair<unsigned int, unsigned int>
+					(k, _generation[k]));
+    }
+    return false;
+}
+
+void Compiler::setDefined(NodeArray const *array, SimpleRange const &range)
+{
+    /*
+      Called when a node is inserted into the given range of an
+      array. Relations that are no longer waiting for anything are
+      added to the ready queue.
+    */
+
+    if (_waiting.empty()) return;
+
+    vector<int> offsets(1, -1); //Whole variable
+    for (RangeIterator r(range); !r.atEnd(); r.nextLeft()) {
+	offsets.push_back(array->range().leftOffset(r));
+    }
+    for (unsigned int i = 0; i < offsets.size(); ++i) {
+	map<Dependency, vector<pair<unsigned int, unsigned int> > >::iterator
+	    p = _waiting.find(Dependency(array->name(), offsets[i]));
+	if (p == _waiting.end()) continue;
+	vector<pair<unsigned int, unsigned int> > const &waiters = p->second;
+	for (unsigned int j = 0; j < waiters.size(); ++j) {
+	    unsigned int k = waiters[j].first;
+	    if (waiters[j].second == _generation[k] && --_nwaiting[k] == 0) {
+		_ready.push_back(k);
+	    }
+	}
+	_waiting.erase(p);
+    }
+}
+
+void Compiler::allocateWorklist(ParseTree const *relations)
+{
+    /* 
+       Allocates relations from a ready queue. On the first sweep,
+       every relation is tried once. After that, a relation is only
+       tried again when the elements that it was waiting for have been
+       defined, so that most relations are allocated on their first or
+       second attempt, however the model is ordered.
+
+       If the queue empties with relations still unresolved, another
+       sweep is made through them, in case one is waiting for the
+       wrong thing. This stops when a sweep resolves nothing, leaving
+       _n_resolved equal to zero as in the default mode.
+    */
+    
+    vector<pair<ParseTree const *, int> > counters;
+    expandRelations(relations, counters);
+    unsigned int n = _loop_relations.size();
+    if (n != _is_resolved.size()) {
+	throw logic_error("Relation count mismatch in allocateWorklist");
+    }
+    _nwaiting.assign(n, 0);
+    _generation.assign(n, 0);
+    _worklist = true;
+
+    unsigned int nleft = n;
+    for (bool progress = true; nleft > 0 && progress; ) {
+	progress = false;
+	for (unsigned int k = 0; k < n; ++k) {
+	    if (!_is_resolved[k] && allocateRelation(k)) {
+		--nleft;
+		progress = true;
+	    }
+	}
+	while (!_ready.empty()) {
+	    unsigned int k = _ready.front();
+	    _ready.pop_front();
+	    if (!_is_resolved[k] && allocateRelation(k)) {
+		--nleft;
+		progress = true;
+	    }
+	}
+    }
+    _n_resolved = (nleft == 0) ? n : 0;
+    _n_relations = n;
+
+    _worklist = false;
+    _loop_relations.clear();
+    _missing.clear();
+    _waiting.clear();
+    _nwaiting.clear();
+    _generation.clear();
+}
 
 Compiler::Compiler(BUGSModel &model, map<string, SArray> const &data_table)
     : _model(model), _countertab(), 
       _data_table(data_table), _n_resolved(0), 
       _n_relations(0), _is_resolved(0), _resolution_level(0),
-      _index_expression(0), _index_nodes()
+      _index_expression(0), _index_nodes(), _worklist(false)
 {
     if (_model.nodes().size() != 0)
 	throw invalid_argument("Non empty graph in Compiler constructor");
@@ -14,9 +14,9 @@
 
 #include <stdexcept>
 #include <string>
+#include <cstdint>
 
 using std::pair;
-using std::map;
 using std::vector;
 using std::invalid_argument;
 using std::runtime_error;
@@ -36,6 +36,14 @@ bool lt(LogicalPair const &arg1, LogicalPair const &arg2)
     }
 }
 
+void LogicalPairHash::operator()(FuzzyHash &h,
+				 LogicalPair const &lpair) const
+{
+    h.add(static_cast<std::uint64_t>(
+	      reinterpret_cast<std::uintptr_t>(FUNC(lpair.first))));
+    h.add(lpair.second);
+}
+
 LogicalNode* LogicalFactory::newNode(FunctionPtr const &func, 
 				     vector<Node const *> const &parents,
 				     unsigned int nchain)
@@ -98,14 +106,14 @@ Node* LogicalFactory::getNode(FunctionPtr const &func,
     }
     
     LogicalPair lpair(func, parents);
-    map<LogicalPair, Node*, fuzzy_less<LogicalPair> >::iterator i = _logicalmap.find(lpair);
+    Node **p = _logicalmap.find(lpair);
 
-    if (i != _logicalmap.end()) {
-	return i->second;
+    if (p) {
+	return *p;
     }
     else {
 	LogicalNode *lnode = newNode(func, parents, model.nchain());
-	_logicalmap[lpair] = lnode;
+	_logicalmap.insert(lpair, lnode);
 	model.addNode(lnode);
 	return lnode;
     }
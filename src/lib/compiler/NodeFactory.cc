@@ -4,8 +4,44 @@
 
 #include <cfloat>
 #include <cmath>
+#include <cstring>
 
 using std::vector;
+using std::uint64_t;
+
+/* Grid used to round doubles in FuzzyHash */
+static const double GRID = 1048576; //2^20
+
+/* 
+   Margin used to detect ambiguous values in FuzzyHash. This is twice
+   the tolerance of the fuzzy comparison, to allow for rounding error.
+*/
+static const double MARGIN = 32 * DBL_EPSILON;
+
+static uint64_t mix(uint64_t x)
+{
+    //Finalizer of the SplitMix64 generator
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/* Hash of element x at position n of a sequence */
+static uint64_t element(uint64_t x, unsigned int n)
+{
+    return mix(x + 0x9e3779b97f4a7c15ULL * n);
+}
+
+static uint64_t gridPoint(double x)
+{
+    double y = std::floor(x * GRID + 0.5) + 0.0; //Adding 0 removes -0
+    uint64_t bits;
+    std::memcpy(&bits, &y, sizeof(bits));
+    return bits;
+}
 
 namespace jags {
 
@@ -90,4 +126,85 @@ bool lt(vector<Node const *> const &par1, vector<Node const *> const &par2)
     }
 }
 
+/*
+  The hash value is the exclusive or of the hashes of the individual
+  elements, each combined with its position in the sequence. This
+  allows the candidates to be calculated by flipping the contribution
+  of each ambiguous value.
+*/
+
+FuzzyHash::FuzzyHash()
+    : _hash(0), _n(0)
+{
+}
+
+void FuzzyHash::add(uint64_t x)
+{
+    _hash ^= element(x, ++_n);
+}
+
+void FuzzyHash::add(double x)
+{
+    if (x != x) {
+	//NaN
+	add(static_cast<uint64_t>(0));
+	return;
+    }
+    uint64_t g = gridPoint(x);
+    uint64_t glo = gridPoint(x - MARGIN);
+    uint64_t ghi = gridPoint(x + MARGIN);
+    uint64_t h = element(g, ++_n);
+    _hash ^= h;
+    if (glo != g) {
+	_alt.push_back(h ^ element(glo, _n));
+    }
+    else if (ghi != g) {
+	_alt.push_back(h ^ element(ghi, _n));
+    }
+}
+
+void FuzzyHash::add(Node const *node)
+{
+    if (node->isFixed()) {
+	add(static_cast<uint64_t>(1));
+	vector<unsigned int> const &dim = node->dim();
+	add(static_cast<uint64_t>(dim.size()));
+	for (unsigned int i = 0; i < dim.size(); ++i) {
+	    add(static_cast<uint64_t>(dim[i]));
+	}
+	double const *value = node->value(0);
+	for (unsigned int i = 0; i < node->length(); ++i) {
+	    add(value[i]);
+	}
+    }
+    else {
+	add(static_cast<uint64_t>(2));
+	add(static_cast<uint64_t>(node->id()));
+    }
+}
+
+void FuzzyHash::add(vector<Node const *> const &nodes)
+{
+    add(static_cast<uint64_t>(nodes.size()));
+    for (unsigned int i = 0; i < nodes.size(); ++i) {
+	add(nodes[i]);
+    }
+}
+
+unsigned int FuzzyHash::nambiguous() const
+{
+    return _alt.size();
+}
+
+uint64_t FuzzyHash::candidate(unsigned long i) const
+{
+    uint64_t h = _hash;
+    for (unsigned int j = 0; i != 0; ++j, i >>= 1) {
+	if (i & 1) {
+	    h ^= _alt[j];
+	}
+    }
+    return h;
+}
+
 }
@@ -98,6 +98,24 @@ RScalarDist::logDensity(double x, PDFType type,
     return loglik;
 }
 
+double
+RScalarDist::logDensitySum(double const *x, double const * const *par,
+			   unsigned int n, PDFType type) const
+{
+    unsigned int np = npar();
+    vector<double const *> parameters(np);
+    double ans = 0;
+    for (unsigned int i = 0; i < n; ++i) {
+	std::copy(par + i * np, par + (i + 1) * np, parameters.begin());
+	if (checkParameterValue(parameters)) {
+	    ans += d(x[i], type, parameters, true);
+	}
+	else {
+	    ans += JAGS_NEGINF;
+	}
+    }
+    return ans;
+}
 
 double 
 RScalarDist::randomSample(vector<double const *> const &parameters,
@@ -14,6 +14,7 @@ using std::vector;
 using std::length_error;
 using std::logic_error;
 using std::count_if;
+using std::copy;
 
 namespace jags {
 
@@ -65,6 +66,24 @@ bool ScalarDist::isSupportFixed(vector<bool> const &fixmask) const
     }
 }
 
+double ScalarDist::logDensitySum(double const *x, double const * const *par,
+				 unsigned int n, PDFType type) const
+{
+    unsigned int np = npar();
+    vector<double const *> parameters(np);
+    double ans = 0;
+    for (unsigned int i = 0; i < n; ++i) {
+	copy(par + i * np, par + (i + 1) * np, parameters.begin());
+	if (checkParameterValue(parameters)) {
+	    ans += logDensity(x[i], type, parameters, 0, 0);
+	}
+	else {
+	    ans += JAGS_NEGINF;
+	}
+    }
+    return ans;
+}
+
 unsigned int ScalarDist::df() const
 {
     return 1;
@@ -90,5 +109,17 @@ unsigned int ScalarDist::df() const
     {
 	return JAGS_NA;
     }
+
+    void ScalarDist::KLBatch(double *kl, double const * const *par1,
+			     double const * const *par2, unsigned int n) const
+    {
+	unsigned int np = npar();
+	vector<double const *> p1(np), p2(np);
+	for (unsigned int i = 0; i < n; ++i) {
+	    copy(par1 + i * np, par1 + (i + 1) * np, p1.begin());
+	    copy(par2 + i * np, par2 + (i + 1) * np, p2.begin());
+	    kl[i] = KL(p1, p2);
+	}
+    }
     
 } //namespace jags
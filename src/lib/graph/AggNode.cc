@@ -6,6 +6,8 @@
 
 #include <vector>
 #include <stdexcept>
+#include <cstddef>
+#include <climits>
 
 using std::vector;
 using std::set;
@@ -69,7 +71,7 @@ AggNode::AggNode(vector<unsigned int> const &dim,
                  vector<unsigned int> const &offsets)
     : DeterministicNode(dim, nchain, sub_parents(parents, offsets)), 
       _offsets(sub_offsets(parents, offsets)),
-      _parent_values(_length * nchain), _discrete(true)
+      _discrete(true), _view(false)
 {
     // Check argument lengths
     if (_length != parents.size() || _length != offsets.size()) {
@@ -88,12 +90,7 @@ AggNode::AggNode(vector<unsigned int> const &dim,
 	    throw out_of_range("Invalid offset in Aggregate Node constructor");
     }
   
-    // Setup parent values
-    for (unsigned int ch = 0; ch < _nchain; ++ch) {
-	for (unsigned int i = 0; i < _length; ++i) {
-	    _parent_values[i + ch * _length] = par[i]->value(ch) + _offsets[i];
-	}
-    }
+    setParentValues();
 
     // Check discreteness
     for (unsigned int i = 0; i < par.size(); ++i) {
@@ -116,14 +113,83 @@ AggNode::~AggNode()
 {
 }
 
+/*
+  Returns the location of the first value copied by an AggNode if
+  the values copied for each chain are contiguous, with a constant
+  stride between chains. Otherwise returns a NULL pointer.
+*/
+static double const *contiguous(vector<Node const *> const &par,
+				vector<unsigned int> const &offsets,
+				unsigned int nchain, unsigned int &stride)
+{
+    double const *base = par[0]->value(0) + offsets[0];
+    stride = offsets.size();
+    if (nchain > 1) {
+	std::ptrdiff_t d = par[0]->value(1) - par[0]->value(0);
+	if (d < static_cast<std::ptrdiff_t>(offsets.size()) || d > UINT_MAX) {
+	    return 0;
+	}
+	stride = d;
+    }
+    for (unsigned int ch = 0; ch < nchain; ++ch) {
+	double const *v = base + ch * stride;
+	for (unsigned int i = 0; i < par.size(); ++i) {
+	    if (par[i]->value(ch) + offsets[i] != v + i) {
+		return 0;
+	    }
+	}
+    }
+    return base;
+}
+
+void AggNode::setParentValues()
+{
+    vector<Node const *> const &par = parents();
+    unsigned int stride = 0;
+    double const *base = contiguous(par, _offsets, _nchain, stride);
+    if (base) {
+	shareValue(base, stride);
+	_view = true;
+	vector<double const *>().swap(_parent_values);
+    }
+    else {
+	/* 
+	   The parent values only move when the Model allocates storage
+	   for all nodes, which gives this node its own storage first.
+	   So if it was a view, it is safe to start copying values again.
+	*/
+	_view = false;
+	_parent_values.resize(_length * _nchain);
+	for (unsigned int ch = 0; ch < _nchain; ++ch) {
+	    for (unsigned int i = 0; i < _length; ++i) {
+		_parent_values[i + ch * _length] =
+		    par[i]->value(ch) + _offsets[i];
+	    }
+	}
+    }
+}
+
 void AggNode::deterministicSample(unsigned int chain)
 {
+    if (_view) return;
+    
     unsigned int N = _length * chain;
+    double *value = _data + _stride * chain;
     for (unsigned int i = 0; i < _length; ++i) {
-	_data[i + N] = *_parent_values[i + N];
+	value[i] = *_parent_values[i + N];
     }
 }
 
+void AggNode::resetParentValues()
+{
+    setParentValues();
+}
+
+bool AggNode::isView() const
+{
+    return _view;
+}
+
 AggNode const *asAggregate(Node *node)
 {
   return dynamic_cast<AggNode const*>(node);
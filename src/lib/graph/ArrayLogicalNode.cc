@@ -74,7 +74,7 @@ ArrayLogicalNode::ArrayLogicalNode(ArrayFunction const *function,
 
 void ArrayLogicalNode::deterministicSample(unsigned int chain)
 {
-    _func->evaluate(_data + chain * _length, _parameters[chain], _dims);
+    _func->evaluate(_data + chain * _stride, _parameters[chain], _dims);
 }
 
 bool ArrayLogicalNode::checkParentValues(unsigned int chain) const
@@ -66,14 +66,14 @@ double ArrayStochasticNode::logDensity(unsigned int chain, PDFType type) const
     if(!_dist->checkParameterValue(_parameters[chain], _dims))
 	return JAGS_NEGINF;
     
-    return _dist->logDensity(_data + _length * chain, _length, type,
+    return _dist->logDensity(_data + _stride * chain, _length, type,
 			     _parameters[chain], _dims,
 			     lowerLimit(chain), upperLimit(chain));
 }
 
 void ArrayStochasticNode::randomSample(RNG *rng, unsigned int chain)
 {
-    _dist->randomSample(_data + _length * chain, _length,
+    _dist->randomSample(_data + _stride * chain, _length,
 			_parameters[chain], _dims, 
 			lowerLimit(chain), upperLimit(chain), rng);
 }  
@@ -122,7 +122,7 @@ void ArrayStochasticNode::truncatedSample(RNG *rng, unsigned int chain,
 	    copy(upper, upper + _length, uv);
 	}
     }
-    _dist->randomSample(_data + _length * chain, _length,
+    _dist->randomSample(_data + _stride * chain, _length,
 			_parameters[chain], _dims, lv, uv, rng);
 
     delete [] lv;
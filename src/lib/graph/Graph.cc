@@ -1,28 +1,123 @@
 #include <config.h>
 #include <graph/Graph.h>
-#include <graph/GraphMarks.h>
+#include <graph/GraphAdjacency.h>
 #include <graph/Node.h>
-#include <graph/StochasticNode.h>
-#include <graph/DeterministicNode.h>
 
 #include <stdexcept>
 #include <vector>
-#include <set>
-#include <algorithm>
 
 using std::vector;
-using std::set;
-using std::invalid_argument;
 using std::logic_error;
-using std::reverse;
 
 namespace jags {
 
-    Graph::Graph() {}
+    /*
+       The vector _position is indexed by node id. It holds one plus
+       the position of the node in the vector _nodes, or zero if the
+       node is not in the graph. Since ids are only unique within a
+       model, contains() also checks the node pointer.
+    */
+
+    Graph::Graph() : _adjacency(0) {}
+
+    Graph::~Graph()
+    {
+	delete _adjacency;
+    }
+
+    void Graph::invalidate()
+    {
+	delete _adjacency;
+	_adjacency = 0;
+    }
 
     bool Graph::contains(Node const *node) const
     {
-	return find(const_cast<Node*>(node)) != end();
+	unsigned int id = node->id();
+	if (id >= _position.size() || _position[id] == 0) {
+	    return false;
+	}
+	return _nodes[_position[id] - 1] == node;
+    }
+
+    void Graph::insert(Node *node)
+    {
+	if (contains(node)) return;
+
+	unsigned int id = node->id();
+	if (id == Node::NO_ID) {
+	    throw logic_error("Attempt to insert node without id in Graph");
+	}
+	if (id >= _position.size()) {
+	    _position.resize(id + 1, 0);
+	}
+	else if (_position[id] != 0) {
+	    throw logic_error("Node id clash in Graph");
+	}
+	_nodes.push_back(node);
+	_position[id] = _nodes.size();
+	invalidate();
+    }
+
+    void Graph::erase(Node *node)
+    {
+	if (!contains(node)) return;
+
+	unsigned int i = _position[node->id()] - 1;
+	Node *last = _nodes.back();
+	_nodes[i] = last;
+	_position[last->id()] = i + 1;
+	_nodes.pop_back();
+	_position[node->id()] = 0;
+	invalidate();
+    }
+
+    void Graph::clear()
+    {
+	_nodes.clear();
+	_position.clear();
+	invalidate();
+    }
+
+    unsigned int Graph::position(Node const *node) const
+    {
+	if (!contains(node)) {
+	    throw logic_error("Attempt to get position of node not in Graph");
+	}
+	return _position[node->id()] - 1;
+    }
+
+    Node *Graph::node(unsigned int position) const
+    {
+	return _nodes[position];
+    }
+
+    unsigned int Graph::size() const
+    {
+	return _nodes.size();
+    }
+
+    bool Graph::empty() const
+    {
+	return _nodes.empty();
     }
- 
+
+    Graph::const_iterator Graph::begin() const
+    {
+	return _nodes.begin();
+    }
+
+    Graph::const_iterator Graph::end() const
+    {
+	return _nodes.end();
+    }
+
+    GraphAdjacency const &Graph::adjacency() const
+    {
+	if (!_adjacency) {
+	    _adjacency = new GraphAdjacency(*this);
+	}
+	return *_adjacency;
+    }
+
 }
@@ -0,0 +1,101 @@
+#include <config.h>
+#include <graph/GraphAdjacency.h>
+#include <graph/Graph.h>
+#include <graph/StochasticNode.h>
+#include <graph/DeterministicNode.h>
+
+#include <vector>
+#include <list>
+
+using std::vector;
+using std::list;
+
+namespace jags {
+
+GraphAdjacency::GraphAdjacency(Graph const &graph)
+{
+    unsigned int N = graph.size();
+
+    _parent_offsets.reserve(N + 1);
+    _schild_offsets.reserve(N + 1);
+    _dchild_offsets.reserve(N + 1);
+
+    _parent_offsets.push_back(0);
+    _schild_offsets.push_back(0);
+    _dchild_offsets.push_back(0);
+
+    for (unsigned int i = 0; i < N; ++i) {
+	Node *node = graph.node(i);
+
+	vector<Node const *> const &par = node->parents();
+	for (unsigned int j = 0; j < par.size(); ++j) {
+	    if (graph.contains(par[j])) {
+		_parents.push_back(graph.position(par[j]));
+	    }
+	}
+	_parent_offsets.push_back(_parents.size());
+
+	list<StochasticNode*> const *sch = node->stochasticChildren();
+	for (list<StochasticNode*>::const_iterator p = sch->begin();
+	     p != sch->end(); ++p)
+	{
+	    if (graph.contains(*p)) {
+		_schildren.push_back(*p);
+	    }
+	}
+	_schild_offsets.push_back(_schildren.size());
+
+	list<DeterministicNode*> const *dch = node->deterministicChildren();
+	for (list<DeterministicNode*>::const_iterator p = dch->begin();
+	     p != dch->end(); ++p)
+	{
+	    if (graph.contains(*p)) {
+		_dchildren.push_back(*p);
+	    }
+	}
+	_dchild_offsets.push_back(_dchildren.size());
+    }
+}
+
+unsigned int GraphAdjacency::size() const
+{
+    return _parent_offsets.size() - 1;
+}
+
+GraphAdjacency::parent_iterator
+GraphAdjacency::parentsBegin(unsigned int i) const
+{
+    return _parents.begin() + _parent_offsets[i];
+}
+
+GraphAdjacency::parent_iterator
+GraphAdjacency::parentsEnd(unsigned int i) const
+{
+    return _parents.begin() + _parent_offsets[i+1];
+}
+
+GraphAdjacency::schild_iterator
+GraphAdjacency::stochasticChildrenBegin(unsigned int i) const
+{
+    return _schildren.begin() + _schild_offsets[i];
+}
+
+GraphAdjacency::schild_iterator
+GraphAdjacency::stochasticChildrenEnd(unsigned int i) const
+{
+    return _schildren.begin() + _schild_offsets[i+1];
+}
+
+GraphAdjacency::dchild_iterator
+GraphAdjacency::deterministicChildrenBegin(unsigned int i) const
+{
+    return _dchildren.begin() + _dchild_offsets[i];
+}
+
+GraphAdjacency::dchild_iterator
+GraphAdjacency::deterministicChildrenEnd(unsigned int i) const
+{
+    return _dchildren.begin() + _dchild_offsets[i+1];
+}
+
+} //namespace jags
@@ -1,45 +1,18 @@
 #include <config.h>
 #include <graph/GraphMarks.h>
+#include <graph/GraphAdjacency.h>
 #include <graph/Graph.h>
-#include <graph/Node.h>
+#include <graph/StochasticNode.h>
+#include <graph/DeterministicNode.h>
 
 #include <vector>
-#include <set>
 #include <stdexcept>
-#include <utility>
-#include <list>
 
-using std::map;
 using std::vector;
-using std::set;
 using std::logic_error;
-using std::pair;
-using std::list;
 
 namespace jags {
 
-
-    /* 
-       This is a helper class for the markAncestors member function. A
-       GMIterator moves across a vector of Nodes. A dereferencing
-       operator and a prefix increment operator are provided so that
-       it behaves like an STL iterator.
-
-       Unlike an STL iterator, however, a GMIterator stores its end
-       position.  The atEnd member function can be used to test
-       whether the iterator has moved beyond the last element of the
-       vector.
-    */
-    class GMIterator {
-	vector<Node const*>::const_iterator _begin, _end;
-    public:
-	GMIterator(vector<Node const*> const &v)
-	    : _begin(v.begin()), _end(v.end()) {}
-	inline Node const * operator*() const { return *_begin; }
-	inline bool atEnd() const { return _begin == _end; }
-	inline void operator++() { ++_begin; }
-    };
-
 GraphMarks::GraphMarks(Graph const &graph)
     : _graph(graph)
 {
@@ -53,17 +26,22 @@ Graph const &GraphMarks::graph() const
     return _graph;
 }
 
+void GraphMarks::setMark(Node const *node, int m)
+{
+    unsigned int id = node->id();
+    if (id >= _marks.size()) {
+	if (m == 0) return;
+	_marks.resize(id + 1, 0);
+    }
+    _marks[id] = m;
+}
+
 void GraphMarks::mark(Node const *node, int m)
 {
     if (!_graph.contains(node)) {
 	throw logic_error("Attempt to set mark of node not in graph");
     }
-    if (m == 0) {
-	_marks.erase(node);
-    }
-    else {
-	_marks[node] = m;
-    }
+    setMark(node, m);
 }
 
 int GraphMarks::mark(Node const *node) const
@@ -72,13 +50,8 @@ int GraphMarks::mark(Node const *node) const
 	throw logic_error("Attempt to get mark of node not in Graph");	    
     }
     
-    map<Node const*, int>::const_iterator i = _marks.find(node);
-    if (i == _marks.end()) {
-	return 0;
-    }
-    else {
-	return i->second;
-    }
+    unsigned int id = node->id();
+    return id < _marks.size() ? _marks[id] : 0;
 }
 
 void GraphMarks::clear()
@@ -97,7 +70,7 @@ void GraphMarks::markParents(Node const *node, int m)
 	     p != parents.end(); ++p) 
 	{
 	    if (_graph.contains(*p)) {
-		_marks[*p] = m;
+		setMark(*p, m);
 	    }
 	}
     }
@@ -120,7 +93,7 @@ GraphMarks::markParents(Node const *node, bool (*test)(Node const *), int m)
 	Node const *parent = *p;
 	if (_graph.contains(parent)) {
 	    if (test(parent)) {
-		_marks[parent] = m;
+		setMark(parent, m);
 	    }
 	    else {
 		markParents(parent, test, m);
@@ -131,54 +104,87 @@ GraphMarks::markParents(Node const *node, bool (*test)(Node const *), int m)
 
 void GraphMarks::markAncestors(vector<Node const *> const &nodes, int m)
 {
-    set<Node const*> visited; //visited nodes
-    vector<Node const*> ancestors; //ancestor nodes
-    
     /* 
        Do a depth-first search of the graph to find all the ancestors
-       of the given Nodes in the graph. The set "visited" keeps track
-       of previously visited nodes for efficiency. Ancestors are
-       pushed back on to the vector "ancestors" in the order they are
-       found.
-
-       We could do this with a recursive helper function, but it is
-       safer to iterate. So we keep our own stack of GMIterators to
-       record the current position on the graph.
-
-       The GMIterator class is defined above.
+       of the given Nodes in the graph, using the adjacency lists of
+       the graph.  Nodes are identified by their position in the
+       graph, and the vector "visited" keeps track of previously
+       visited nodes.  We keep our own stack rather than using a
+       recursive helper function.
     */
-  
-    vector<GMIterator> stack;
-    stack.push_back(GMIterator(nodes));
-
-    while (!stack.empty()) {
+    GraphAdjacency const &adj = _graph.adjacency();
+    vector<bool> visited(_graph.size(), false);
+    vector<unsigned int> stack;
 
-	for (GMIterator &p = stack.back(); !p.atEnd(); ++p) {
-	    if (visited.count(*p) == 0 && _graph.contains(*p)) {
-		visited.insert(*p);
-		ancestors.push_back(*p);
-		stack.push_back(GMIterator((*p)->parents()));
-		break;
+    for (vector<Node const*>::const_iterator p = nodes.begin();
+	 p != nodes.end(); ++p)
+    {
+	if (_graph.contains(*p)) {
+	    unsigned int i = _graph.position(*p);
+	    if (!visited[i]) {
+		visited[i] = true;
+		stack.push_back(i);
 	    }
 	}
-	
-	if (stack.back().atEnd()) {
-	    stack.pop_back();
+    }
+
+    while (!stack.empty()) {
+	unsigned int i = stack.back();
+	stack.pop_back();
+	setMark(_graph.node(i), m);
+	for (GraphAdjacency::parent_iterator q = adj.parentsBegin(i);
+	     q != adj.parentsEnd(i); ++q)
+	{
+	    if (!visited[*q]) {
+		visited[*q] = true;
+		stack.push_back(*q);
+	    }
 	}
     }
+}
 
-    /* Now set the marks of all ancestors */
-    for(vector<Node const*>::const_iterator p = ancestors.begin();
-	p != ancestors.end(); ++p)
+void GraphMarks::markDescendants(vector<Node const *> const &nodes, int m)
+{
+    GraphAdjacency const &adj = _graph.adjacency();
+    vector<bool> visited(_graph.size(), false);
+    vector<unsigned int> stack;
+
+    for (vector<Node const*>::const_iterator p = nodes.begin();
+	 p != nodes.end(); ++p)
     {
-	if (m == 0) {
-	    _marks.erase(*p);
-	}
-	else {
-	    _marks[*p] = m;
+	if (_graph.contains(*p)) {
+	    unsigned int i = _graph.position(*p);
+	    if (!visited[i]) {
+		visited[i] = true;
+		stack.push_back(i);
+	    }
 	}
     }
 
+    while (!stack.empty()) {
+	unsigned int i = stack.back();
+	stack.pop_back();
+	setMark(_graph.node(i), m);
+	for (GraphAdjacency::schild_iterator q = adj.stochasticChildrenBegin(i);
+	     q != adj.stochasticChildrenEnd(i); ++q)
+	{
+	    unsigned int j = _graph.position(*q);
+	    if (!visited[j]) {
+		visited[j] = true;
+		stack.push_back(j);
+	    }
+	}
+	for (GraphAdjacency::dchild_iterator q = 
+		 adj.deterministicChildrenBegin(i);
+	     q != adj.deterministicChildrenEnd(i); ++q)
+	{
+	    unsigned int j = _graph.position(*q);
+	    if (!visited[j]) {
+		visited[j] = true;
+		stack.push_back(j);
+	    }
+	}
+    }
 }
 
 } //namespace jags
@@ -37,7 +37,7 @@ LinkNode::LinkNode(LinkFunction const *function, unsigned int nchain,
 
 void LinkNode::deterministicSample(unsigned int chain)
 {
-    _data[chain] = _func->inverseLink(*_parameters[chain][0]);
+    _data[chain * _stride] = _func->inverseLink(*_parameters[chain][0]);
 }
 
 bool LinkNode::checkParentValues(unsigned int chain) const
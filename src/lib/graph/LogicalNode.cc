@@ -106,6 +106,11 @@ bool LogicalNode::isClosed(set<Node const *> const &ancestors,
     return false; //Wall
 }
 
+void LogicalNode::resetParentValues()
+{
+    _parameters = mkParams(parents(), _nchain);
+}
+
 bool LogicalNode::isDiscreteValued() const
 {
     return _discrete;
@@ -51,6 +51,25 @@ namespace jags {
 	return _nodes[offset];
     }
 
+    Node const * MixTab::getNode(Node const * const *index,
+				 unsigned int chain) const
+    {
+	vector<int> const &first = _range.first();
+	vector<int> const &last = _range.last();
+	vector<unsigned int> const &dim = _range.dim(false);
+
+	unsigned int offset = 0;
+	unsigned int step = 1;
+	for (unsigned int j = 0; j < first.size(); ++j) {
+	    int i = static_cast<int>(*index[j]->value(chain));
+	    if (i < first[j] || i > last[j]) {
+		return 0;
+	    }
+	    offset += step * (i - first[j]);
+	    step *= dim[j];
+	}
+	return _nodes[offset];
+    }
     
     Range const &MixTab::range() const
     {
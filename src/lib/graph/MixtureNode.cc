@@ -3,10 +3,12 @@
 #include <graph/GraphMarks.h>
 #include <graph/Graph.h>
 #include <graph/MixTab.h>
+#include <graph/StochasticNode.h>
 
 #include <utility>
 #include <vector>
 #include <stdexcept>
+#include <algorithm>
 
 #include <graph/NodeError.h>
 
@@ -17,6 +19,8 @@ using std::logic_error;
 using std::set;
 using std::string;
 using std::pair;
+using std::copy;
+using std::list;
 
 
 namespace jags {
@@ -134,7 +138,7 @@ MixtureNode::MixtureNode (vector<Node const *> const &index,
 			  MixMap const &mixmap)
     : DeterministicNode(mkDim(mixmap), nchain, mkParents(index, mixmap)),
       _table(getTable(mixmap)), _Nindex(index.size()), _discrete(true),
-      _active_parents(nchain)
+      _index_only(false), _active_parents(nchain)
 {
     // Check validity of index argument
 
@@ -185,13 +189,7 @@ MixtureNode::~MixtureNode()
 */
 void MixtureNode::updateActive(unsigned int chain)
 {
-    vector<int> i(_Nindex);
-    vector <Node const*> const &par = parents();
-    for (unsigned int j = 0; j < _Nindex; ++j) {
-	i[j] = static_cast<int>(*par[j]->value(chain));
-    }
-
-    _active_parents[chain] = _table->getNode(i);
+    _active_parents[chain] = _table->getNode(&parents()[0], chain);
     if (_active_parents[chain] == 0) {
 	/*
 	std::cout << "Got " << print(Range(i)) << "\nOriginally\n";
@@ -205,10 +203,67 @@ void MixtureNode::updateActive(unsigned int chain)
     }
 }
 
+void MixtureNode::readActive(unsigned int chain)
+{
+    Node const *active = _active_parents[chain];
+    readThrough(_index_only && active ? active->value(chain) : 0, chain);
+
+    //The stochastic children keep pointers to our value
+    list<StochasticNode*> const *children = stochasticChildren();
+    for (list<StochasticNode*>::const_iterator p = children->begin();
+	 p != children->end(); ++p)
+    {
+	(*p)->resetParentValues(chain);
+    }
+}
+
 void MixtureNode::deterministicSample(unsigned int chain)
 {
-    updateActive(chain);
-    setValue(_active_parents[chain]->value(chain), length(), chain);	
+    if (_index_only) {
+	Node const *active = _active_parents[chain];
+	updateActive(chain);
+	if (_active_parents[chain] != active) {
+	    readActive(chain);
+	}
+    }
+    else {
+	updateActive(chain);
+	double const *x = _active_parents[chain]->value(chain);
+	copy(x, x + _length, _data + _stride * chain);
+    }
+}
+
+void MixtureNode::setIndexOnly(bool flag)
+{
+    if (flag == _index_only) return;
+    if (flag && !deterministicChildren()->empty()) {
+	throw logic_error("Index-only MixtureNode with deterministic children");
+    }
+
+    _index_only = flag;
+    for (unsigned int ch = 0; ch < _nchain; ++ch) {
+	Node const *active = _active_parents[ch];
+	if (!flag && active) {
+	    //Our own storage is out of date
+	    double const *x = active->value(ch);
+	    copy(x, x + _length, _data + _stride * ch);
+	}
+	readActive(ch);
+    }
+}
+
+bool MixtureNode::isIndexOnly() const
+{
+    return _index_only;
+}
+
+void MixtureNode::resetParentValues()
+{
+    if (_index_only) {
+	for (unsigned int ch = 0; ch < _nchain; ++ch) {
+	    readActive(ch);
+	}
+    }
 }
 
 Node const *MixtureNode::activeParent(unsigned int chain) const
@@ -259,6 +314,18 @@ bool isMixture(Node const *node)
   return dynamic_cast<MixtureNode const*>(node);
 }
 
+bool hasIndexOnlyParent(Node const *node)
+{
+    vector<Node const *> const &par = node->parents();
+    for (unsigned int i = 0; i < par.size(); ++i) {
+	MixtureNode const *m = asMixture(par[i]);
+	if (m && m->isIndexOnly()) {
+	    return true;
+	}
+    }
+    return false;
+}
+
 
 bool MixtureNode::isClosed(set<Node const *> const &ancestors, 
 			   ClosedFuncClass fc, bool fixed) const
@@ -20,8 +20,9 @@ class DeterminsticNode;
 class StochasticNode;
 
 Node::Node(vector<unsigned int> const &dim, unsigned int nchain)
-    : _parents(0), _stoch_children(0), _dtrm_children(0), 
-      _dim(getUnique(dim)), _length(product(dim)), _nchain(nchain), _data(0)
+    : _parents(0), _stoch_children(0), _dtrm_children(0), _own_data(true),
+      _id(NO_ID), _dim(getUnique(dim)), _length(product(dim)),
+      _nchain(nchain), _data(0), _stride(_length), _read_through(0)
 {
     if (nchain==0)
 	throw logic_error("Node must have at least one chain");
@@ -39,8 +40,9 @@ Node::Node(vector<unsigned int> const &dim, unsigned int nchain)
 Node::Node(vector<unsigned int> const &dim, unsigned int nchain,
 	   vector<Node const *> const &parents)
     : _parents(parents), _stoch_children(0), _dtrm_children(0), 
-      _dim(getUnique(dim)), _length(product(dim)),
-      _nchain(nchain), _data(0)
+      _own_data(true), _id(NO_ID), _dim(getUnique(dim)),
+      _length(product(dim)), _nchain(nchain), _data(0), _stride(_length),
+      _read_through(0)
 {
     if (nchain==0)
 	throw logic_error("Node must have at least one chain");
@@ -57,7 +59,10 @@ Node::Node(vector<unsigned int> const &dim, unsigned int nchain,
 
 Node::~Node()
 {
-    delete [] _data;
+    if (_own_data) {
+	delete [] _data;
+    }
+    delete [] _read_through;
     delete _stoch_children;
     delete _dtrm_children;
 }
@@ -131,13 +136,13 @@ void Node::setValue(double const *value, unsigned int length, unsigned int chain
    if (chain >= _nchain)
       throw NodeError(this, "Invalid chain in Node::setValue");
 
-   copy(value, value + _length, _data + chain * _length);
+   copy(value, value + _length, _data + chain * _stride);
 }
 
 void Node::swapValue(unsigned int chain1, unsigned int chain2)
 {
-    double *value1 = _data + chain1 * _length;
-    double *value2 = _data + chain2 * _length;
+    double *value1 = _data + chain1 * _stride;
+    double *value2 = _data + chain2 * _stride;
     for (unsigned int i = 0; i < _length; ++i) {
 	double v = value1[i];
 	value1[i] = value2[i];
@@ -145,9 +150,72 @@ void Node::swapValue(unsigned int chain1, unsigned int chain2)
     }
 }
 
+void Node::moveValue(double *data, unsigned int stride)
+{
+    if (stride < _length)
+	throw logic_error("Invalid stride in Node::moveValue");
+
+    for (unsigned int ch = 0; ch < _nchain; ++ch) {
+	copy(_data + ch * _stride, _data + ch * _stride + _length,
+	     data + ch * stride);
+    }
+    if (_own_data) {
+	delete [] _data;
+    }
+    _data = data;
+    _stride = stride;
+    _own_data = false;
+}
+
+void Node::shareValue(double const *data, unsigned int stride)
+{
+    if (_own_data) {
+	delete [] _data;
+    }
+    _data = const_cast<double*>(data);
+    _stride = stride;
+    _own_data = false;
+}
+
+void Node::readThrough(double const *value, unsigned int chain)
+{
+    if (!_read_through) {
+	_read_through = new double const *[_nchain];
+	for (unsigned int ch = 0; ch < _nchain; ++ch) {
+	    _read_through[ch] = 0;
+	}
+    }
+    _read_through[chain] = value;
+}
+
+bool Node::ownsValue() const
+{
+    return _own_data;
+}
+
+void Node::resetParentValues()
+{
+}
+
+unsigned int Node::id() const
+{
+    return _id;
+}
+
+void Node::setId(unsigned int id)
+{
+    if (_id != NO_ID) {
+	throw logic_error("Node already has an id");
+    }
+    _id = id;
+}
+
 double const *Node::value(unsigned int chain) const
 {
-    return _data + chain * _length;
+    if (_read_through && _read_through[chain]) {
+	return _read_through[chain];
+    }
+    return _data + chain * _stride;
 }
 
 vector<unsigned int> const &Node::dim() const
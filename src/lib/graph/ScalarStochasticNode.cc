@@ -40,14 +40,15 @@ double ScalarStochasticNode::logDensity(unsigned int chain, PDFType type) const
     if(!_dist->checkParameterValue(_parameters[chain]))
 	return JAGS_NEGINF;
     
-    return _dist->logDensity(_data[chain], type, _parameters[chain], 
+    return _dist->logDensity(_data[chain * _stride], type, _parameters[chain], 
 			     lowerLimit(chain), upperLimit(chain));
 }
 
 void ScalarStochasticNode::randomSample(RNG *rng, unsigned int chain)
 {
-    _data[chain] = _dist->randomSample(_parameters[chain], lowerLimit(chain),
-				       upperLimit(chain), rng);
+    _data[chain * _stride] = _dist->randomSample(_parameters[chain],
+						 lowerLimit(chain),
+						 upperLimit(chain), rng);
 }  
 
 void ScalarStochasticNode::truncatedSample(RNG *rng, unsigned int chain,
@@ -63,7 +64,7 @@ void ScalarStochasticNode::truncatedSample(RNG *rng, unsigned int chain,
 	if (u == 0 || (u && (*ub > *u)))
 	    u = ub;
     }
-    _data[chain] = _dist->randomSample(_parameters[chain], l, u, rng);
+    _data[chain * _stride] = _dist->randomSample(_parameters[chain], l, u, rng);
 }  
 
 bool ScalarStochasticNode::checkParentValues(unsigned int chain) const
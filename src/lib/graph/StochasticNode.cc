@@ -99,11 +99,36 @@ StochasticNode::~StochasticNode()
 {
 }
 
+void StochasticNode::resetParentValues()
+{
+    //The parameters are the leading parents: bounds come last
+    vector<Node const *> const &par = parents();
+    for (unsigned int n = 0; n < _nchain; ++n) {
+	for (unsigned int i = 0; i < _parameters[n].size(); ++i) {
+	    _parameters[n][i] = par[i]->value(n);
+	}
+    }
+}
+
+void StochasticNode::resetParentValues(unsigned int chain)
+{
+    vector<Node const *> const &par = parents();
+    for (unsigned int i = 0; i < _parameters[chain].size(); ++i) {
+	_parameters[chain][i] = par[i]->value(chain);
+    }
+}
+
 Distribution const *StochasticNode::distribution() const
 {
     return _dist;
 }
 
+vector<double const *> const &StochasticNode::parameters(unsigned int chain)
+    const
+{
+    return _parameters[chain];
+}
+
 bool StochasticNode::isDiscreteValued() const
 {
     return _discrete;
@@ -53,7 +53,7 @@ VSLogicalNode::VSLogicalNode(ScalarFunction const *function,
 
 void VSLogicalNode::deterministicSample(unsigned int chain)
 {
-    double *ans = _data + chain * _length;
+    double *ans = _data + chain * _stride;
     vector<double const *> par(_parameters[chain]);
 	
     for (unsigned int i = 0; i < _length; ++i) {
@@ -81,7 +81,7 @@ VectorLogicalNode::VectorLogicalNode(VectorFunction const *function,
 
 void VectorLogicalNode::deterministicSample(unsigned int chain)
 {
-    _func->evaluate(_data + chain * _length, _parameters[chain], _lengths);
+    _func->evaluate(_data + chain * _stride, _parameters[chain], _lengths);
 }
 
 bool VectorLogicalNode::checkParentValues(unsigned int chain) const
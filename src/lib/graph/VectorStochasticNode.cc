@@ -66,14 +66,14 @@ double VectorStochasticNode::logDensity(unsigned int chain, PDFType type) const
     if(!_dist->checkParameterValue(_parameters[chain], _lengths))
 	return JAGS_NEGINF;
     
-    return _dist->logDensity(_data + _length * chain, _length, type,
+    return _dist->logDensity(_data + _stride * chain, _length, type,
 			     _parameters[chain], _lengths,
 			     lowerLimit(chain), upperLimit(chain));
 }
 
 void VectorStochasticNode::randomSample(RNG *rng, unsigned int chain)
 {
-    _dist->randomSample(_data + _length * chain, _length, 
+    _dist->randomSample(_data + _stride * chain, _length, 
 			_parameters[chain], _lengths, 
 			lowerLimit(chain), upperLimit(chain), rng);
 }  
@@ -116,7 +116,7 @@ void VectorStochasticNode::truncatedSample(RNG *rng, unsigned int chain,
 	    copy(upper, upper + _length, uv);
 	}
     }
-    _dist->randomSample(_data + _length * chain, _length, 
+    _dist->randomSample(_data + _stride * chain, _length, 
 			_parameters[chain], _lengths, lv, uv, rng);
 
     delete [] lv;
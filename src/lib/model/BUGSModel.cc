@@ -5,6 +5,8 @@
 #include <model/Monitor.h>
 #include <model/NodeArray.h>
 #include <model/MonitorFactory.h>
+#include <model/CODAStream.h>
+#include <model/Checkpoint.h>
 #include <graph/StochasticNode.h>
 #include <graph/GraphMarks.h>
 #include <graph/Node.h>
@@ -16,10 +18,12 @@
 #include <utility>
 #include <stdexcept>
 #include <fstream>
+#include <sstream>
 #include <cmath>
 
 using std::vector;
 using std::ofstream;
+using std::ostringstream;
 using std::list;
 using std::pair;
 using std::string;
@@ -57,11 +61,12 @@ SymTab &BUGSModel::symtab()
 }
 
 void BUGSModel::coda(vector<NodeId> const &node_ids, string const &stem,
-		     string &warn)
+		     string &warn, bool binary)
 {
     warn.clear();
 
     list<MonitorControl> dump_nodes;
+    vector<MonitorControl const *> controls;
     for (unsigned int i = 0; i < node_ids.size(); ++i) {
 	string const &name = node_ids[i].first;
 	Range const &range = node_ids[i].second;
@@ -81,6 +86,7 @@ void BUGSModel::coda(vector<NodeId> const &node_ids, string const &stem,
 	    for (q = monitors().begin(); q != monitors().end(); ++q) {
 		if (q->monitor() == p->monitor()) {
 		    dump_nodes.push_back(*q);		    
+		    controls.push_back(&*q);
 		    break;
 		}
 	    }
@@ -96,13 +102,18 @@ void BUGSModel::coda(vector<NodeId> const &node_ids, string const &stem,
 	return;
     }
 
-    CODA0(dump_nodes, stem, warn);    
-    CODA(dump_nodes, stem, nchain(), warn);
+    if (binary) {
+	codaStream(controls, stem, warn);
+    }
+    else {
+	CODA0(dump_nodes, stem, warn);    
+	CODA(dump_nodes, stem, nchain(), warn);
+    }
     TABLE0(dump_nodes, stem, warn);    
     TABLE(dump_nodes, stem, nchain(), warn);
 }
 
-void BUGSModel::coda(string const &stem, string &warn)
+void BUGSModel::coda(string const &stem, string &warn, bool binary)
 {
     warn.clear();
     
@@ -111,12 +122,62 @@ void BUGSModel::coda(string const &stem, string &warn)
 	return;
     }
     
-    CODA0(monitors(), stem, warn);    
-    CODA(monitors(), stem, nchain(), warn);
+    if (binary) {
+	vector<MonitorControl const *> controls;
+	list<MonitorControl>::const_iterator q; 
+	for (q = monitors().begin(); q != monitors().end(); ++q) {
+	    controls.push_back(&*q);
+	}
+	codaStream(controls, stem, warn);
+    }
+    else {
+	CODA0(monitors(), stem, warn);    
+	CODA(monitors(), stem, nchain(), warn);
+    }
     TABLE0(monitors(), stem, warn);    
     TABLE(monitors(), stem, nchain(), warn);
 }
 
+void BUGSModel::codaStream(vector<MonitorControl const *> const &controls,
+			   string const &stem, string &warn)
+{
+    /* 
+       Monitors that pool over chains are written to the file
+       "<stem>chain0.bin" and the others to "<stem>chain1.bin" ...
+       "<stem>chain<nchain>.bin". Monitors that pool over iterations
+       are not written.
+    */
+    vector<MonitorControl const *> pooled, unpooled;
+    for (unsigned int i = 0; i < controls.size(); ++i) {
+	Monitor const *monitor = controls[i]->monitor();
+	if (monitor->poolIterations()) continue;
+	if (monitor->poolChains()) {
+	    pooled.push_back(controls[i]);
+	}
+	else {
+	    unpooled.push_back(controls[i]);
+	}
+    }
+
+    try {
+	if (!pooled.empty()) {
+	    vector<string> files(1, stem + "chain0.bin");
+	    addCODAStream(new CODAStream(pooled, files));
+	}
+	if (!unpooled.empty()) {
+	    vector<string> files;
+	    for (unsigned int n = 0; n < nchain(); ++n) {
+		ostringstream oname;
+		oname << stem << "chain" << n + 1 << ".bin";
+		files.push_back(oname.str());
+	    }
+	    addCODAStream(new CODAStream(unpooled, files));
+	}
+    }
+    catch (runtime_error const &except) {
+	warn.append(string(except.what()) + "\n");
+    }
+}
 
 void BUGSModel::setParameters(map<string, SArray> const &param_table,
 			      unsigned int chain)
@@ -159,19 +220,9 @@ void BUGSModel::setParameters(map<string, SArray> const &param_table,
 }
 
 
-bool BUGSModel::setMonitor(string const &name, Range const &range,
-			   unsigned int thin, string const &type,
-			   string &msg)
+Monitor *BUGSModel::newMonitor(string const &name, Range const &range,
+			       string const &type, string &msg)
 {
-    for (list<MonitorInfo>::const_iterator i = _bugs_monitors.begin();
-	 i != _bugs_monitors.end(); ++i)
-    {
-	if (i->name() == name && i->range() == range && i->type() == type) {
-	    msg = "Monitor already exists and cannot be duplicated";
-	    return false; 
-	}
-    }
-
     msg.clear();
     Monitor *monitor = 0;
 
@@ -185,7 +236,23 @@ bool BUGSModel::setMonitor(string const &name, Range const &range,
 		break;
 	}
     }
+    return monitor;
+}
 
+bool BUGSModel::setMonitor(string const &name, Range const &range,
+			   unsigned int thin, string const &type,
+			   string &msg)
+{
+    for (list<MonitorInfo>::const_iterator i = _bugs_monitors.begin();
+	 i != _bugs_monitors.end(); ++i)
+    {
+	if (i->name() == name && i->range() == range && i->type() == type) {
+	    msg = "Monitor already exists and cannot be duplicated";
+	    return false; 
+	}
+    }
+
+    Monitor *monitor = newMonitor(name, range, type, msg);
     if (monitor) {
 	addMonitor(monitor, thin);
 	_bugs_monitors.push_back(MonitorInfo(monitor, name, range, type));
@@ -232,4 +299,67 @@ void BUGSModel::samplerNames(vector<vector<string> > &sampler_names) const
     }    
 }
 
+void BUGSModel::checkpointMonitors(vector<CheckpointMonitor> &entries)
+    const
+{
+    for (list<MonitorInfo>::const_iterator i = _bugs_monitors.begin();
+	 i != _bugs_monitors.end(); ++i)
+    {
+	list<MonitorControl>::const_iterator p = monitors().begin();
+	while (p != monitors().end() && p->monitor() != i->monitor()) {
+	    ++p;
+	}
+	if (p == monitors().end()) {
+	    throw logic_error("Monitor not found in BUGSModel::checkpoint");
+	}
+
+	CheckpointMonitor m;
+	m.name = i->name();
+	m.scope = i->range().scope();
+	m.type = i->type();
+	m.thin = p->thin();
+	m.start = p->start();
+	m.niter = p->niter();
+	i->monitor()->getState(m.state);
+	entries.push_back(m);
+    }
+}
+
+void BUGSModel::restoreMonitors(vector<CheckpointMonitor> const &entries)
+{
+    // Create all the monitors before deleting the existing ones
+    vector<Monitor*> created;
+    for (unsigned int k = 0; k < entries.size(); ++k) {
+	CheckpointMonitor const &m = entries[k];
+	Range range = m.scope.empty() ? Range() : Range(m.scope);
+	string msg;
+	Monitor *monitor = newMonitor(m.name, range, m.type, msg);
+	if (monitor && !monitor->setState(m.state)) {
+	    delete monitor;
+	    monitor = 0;
+	    msg = "Invalid monitor state";
+	}
+	if (!monitor) {
+	    for (unsigned int j = 0; j < created.size(); ++j) {
+		delete created[j];
+	    }
+	    throw runtime_error(string("Failed to restore ") + m.type +
+				" monitor for " + m.name + ". " + msg);
+	}
+	created.push_back(monitor);
+    }
+
+    while (!_bugs_monitors.empty()) {
+	MonitorInfo info = _bugs_monitors.front();
+	deleteMonitor(info.name(), info.range(), info.type());
+    }
+    for (unsigned int k = 0; k < entries.size(); ++k) {
+	CheckpointMonitor const &m = entries[k];
+	Range range = m.scope.empty() ? Range() : Range(m.scope);
+	addRestoredMonitor(created[k], m.thin, m.start, m.niter);
+	_bugs_monitors.push_back(MonitorInfo(created[k], m.name, range,
+					     m.type));
+    }
+}
+
 } //namespace jags
@@ -0,0 +1,241 @@
+#include <config.h>
+#include <model/CODAStream.h>
+#include <model/MonitorControl.h>
+#include <model/Monitor.h>
+#include <util/nainf.h>
+#include <util/dim.h>
+
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+
+using std::vector;
+using std::string;
+using std::ofstream;
+using std::ios;
+using std::runtime_error;
+using std::logic_error;
+using std::uint32_t;
+using std::uint64_t;
+
+/* Bit pattern used by R for NA_real_ */
+static const uint64_t R_NA_BITS = 0x7FF00000000007A2ULL;
+
+/* Offset of the row count in the file header */
+static const unsigned int NROW_OFFSET = 16;
+
+static void putBytes(vector<unsigned char> &buf, uint64_t x, unsigned int n)
+{
+    //Appends the n low-order bytes of x in little-endian order
+    for (unsigned int i = 0; i < n; ++i) {
+	buf.push_back(static_cast<unsigned char>(x >> (8 * i)));
+    }
+}
+
+static void putDouble(vector<unsigned char> &buf, double x)
+{
+    uint64_t bits;
+    if (x == JAGS_NA) {
+	bits = R_NA_BITS;
+    }
+    else {
+	std::memcpy(&bits, &x, sizeof(bits));
+    }
+    putBytes(buf, bits, 8);
+}
+
+static void writeBuffer(ofstream &out, vector<unsigned char> const &buf)
+{
+    out.write(reinterpret_cast<char const*>(&buf[0]), buf.size());
+}
+
+namespace jags {
+
+CODAStream::CODAStream(vector<MonitorControl const *> const &controls,
+		       vector<string> const &files)
+    : _controls(controls), _nwritten(controls.size(), 0), _files(files),
+      _nvar(0), _nrow(0)
+{
+    if (files.empty()) {
+	throw logic_error("No output files in CODAStream");
+    }
+    bool pooled = !controls.empty() && controls[0]->monitor()->poolChains();
+    if (pooled && files.size() != 1) {
+	throw logic_error("Chain mismatch in CODAStream");
+    }
+    for (unsigned int m = 0; m < _controls.size(); ++m) {
+	Monitor const *monitor = _controls[m]->monitor();
+	if (monitor->poolIterations()) {
+	    throw logic_error("Invalid monitor in CODAStream");
+	}
+	if (monitor->poolChains() != pooled) {
+	    throw logic_error("Chain mismatch in CODAStream");
+	}
+	_nvar += product(monitor->dim());
+    }
+
+    for (unsigned int ch = 0; ch < _files.size(); ++ch) {
+	ofstream *out = new ofstream(_files[ch].c_str(),
+				     ios::out | ios::binary | ios::trunc);
+	if (!*out) {
+	    delete out;
+	    close();
+	    throw runtime_error(string("Failed to open file ") + _files[ch]);
+	}
+	_output.push_back(out);
+	writeHeader(*out);
+    }
+
+    writePending();
+    flush();
+}
+
+CODAStream::~CODAStream()
+{
+    writeRowCount();
+    close();
+}
+
+void CODAStream::close()
+{
+    for (unsigned int ch = 0; ch < _output.size(); ++ch) {
+	_output[ch]->close();
+	delete _output[ch];
+    }
+    _output.clear();
+}
+
+void CODAStream::writeHeader(ofstream &out) const
+{
+    vector<unsigned char> buf;
+    char const *magic = "JAGSCODA";
+    buf.insert(buf.end(), magic, magic + 8);
+    putBytes(buf, 1, 4); //version
+    putBytes(buf, _nvar, 4);
+    putBytes(buf, 0, 8); //number of rows, written by flush
+
+    //Variable names
+    for (unsigned int m = 0; m < _controls.size(); ++m) {
+	vector<string> const &enames = _controls[m]->monitor()->elementNames();
+	for (unsigned int v = 0; v < enames.size(); ++v) {
+	    putBytes(buf, enames[v].size(), 4);
+	    buf.insert(buf.end(), enames[v].begin(), enames[v].end());
+	}
+    }
+
+    //Index
+    for (unsigned int m = 0; m < _controls.size(); ++m) {
+	unsigned int nvar = product(_controls[m]->monitor()->dim());
+	for (unsigned int v = 0; v < nvar; ++v) {
+	    putBytes(buf, _controls[m]->start(), 4);
+	    putBytes(buf, _controls[m]->thin(), 4);
+	}
+    }
+
+    writeBuffer(out, buf);
+}
+
+void CODAStream::writePending()
+{
+    /*
+      Writes one row for each iteration at which at least one monitor
+      has a value that has not yet been written, in increasing order
+      of iteration.
+    */
+    unsigned int M = _controls.size();
+    vector<bool> hit(M);
+    while (true) {
+	bool found = false;
+	unsigned int iter = 0;
+	for (unsigned int m = 0; m < M; ++m) {
+	    MonitorControl const *c = _controls[m];
+	    if (_nwritten[m] < c->niter()) {
+		unsigned int it = c->start() + _nwritten[m] * c->thin();
+		if (!found || it < iter) {
+		    iter = it;
+		    found = true;
+		}
+	    }
+	}
+	if (!found) break;
+
+	for (unsigned int m = 0; m < M; ++m) {
+	    MonitorControl const *c = _controls[m];
+	    hit[m] = _nwritten[m] < c->niter() &&
+		c->start() + _nwritten[m] * c->thin() == iter;
+	}
+
+	for (unsigned int ch = 0; ch < _output.size(); ++ch) {
+	    _buffer.clear();
+	    putDouble(_buffer, iter);
+	    for (unsigned int m = 0; m < M; ++m) {
+		Monitor const *monitor = _controls[m]->monitor();
+		unsigned int nvar = product(monitor->dim());
+		if (hit[m]) {
+		    _row.resize(nvar);
+		    monitor->getValue(_row.data(), ch,
+				      static_cast<unsigned long>(_nwritten[m])
+				      * nvar, nvar);
+		    for (unsigned int v = 0; v < nvar; ++v) {
+			putDouble(_buffer, _row[v]);
+		    }
+		}
+		else {
+		    for (unsigned int v = 0; v < nvar; ++v) {
+			putBytes(_buffer, R_NA_BITS, 8);
+		    }
+		}
+	    }
+	    writeBuffer(*_output[ch], _buffer);
+	}
+
+	for (unsigned int m = 0; m < M; ++m) {
+	    if (hit[m]) ++_nwritten[m];
+	}
+	++_nrow;
+    }
+}
+
+void CODAStream::update()
+{
+    writePending();
+}
+
+void CODAStream::writeRowCount()
+{
+    vector<unsigned char> buf;
+    putBytes(buf, _nrow, 8);
+    for (unsigned int ch = 0; ch < _output.size(); ++ch) {
+	ofstream &out = *_output[ch];
+	ofstream::pos_type end = out.tellp();
+	out.seekp(NROW_OFFSET);
+	writeBuffer(out, buf);
+	out.seekp(end);
+	out.flush();
+    }
+}
+
+void CODAStream::flush()
+{
+    writeRowCount();
+    for (unsigned int ch = 0; ch < _output.size(); ++ch) {
+	if (!*_output[ch]) {
+	    throw runtime_error(string("Failed to write file ") + _files[ch]);
+	}
+    }
+}
+
+bool CODAStream::isWriting(Monitor const *monitor) const
+{
+    for (unsigned int m = 0; m < _controls.size(); ++m) {
+	if (_controls[m]->monitor() == monitor) return true;
+    }
+    return false;
+}
+
+vector<string> const &CODAStream::files() const
+{
+    return _files;
+}
+
+} //namespace jags
@@ -0,0 +1,168 @@
+#include <config.h>
+#include <model/Checkpoint.h>
+
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+
+using std::vector;
+using std::string;
+using std::ostream;
+using std::istream;
+using std::runtime_error;
+using std::uint32_t;
+using std::uint64_t;
+
+static char const *MAGIC = "JAGSCKPT";
+static const unsigned int VERSION = 1;
+
+static void putBytes(ostream &out, uint64_t x, unsigned int n)
+{
+    //Writes the n low-order bytes of x in little-endian order
+    unsigned char buf[8];
+    for (unsigned int i = 0; i < n; ++i) {
+	buf[i] = static_cast<unsigned char>(x >> (8 * i));
+    }
+    out.write(reinterpret_cast<char const*>(buf), n);
+}
+
+static uint64_t getBytes(unsigned char const *buf, unsigned int n)
+{
+    uint64_t x = 0;
+    for (unsigned int i = 0; i < n; ++i) {
+	x |= static_cast<uint64_t>(buf[i]) << (8 * i);
+    }
+    return x;
+}
+
+namespace jags {
+
+    CheckpointWriter::CheckpointWriter(ostream &out)
+	: _out(out)
+    {
+	_out.write(MAGIC, 8);
+	putUInt(VERSION);
+    }
+
+    void CheckpointWriter::putUInt(unsigned int x)
+    {
+	putBytes(_out, x, 4);
+    }
+
+    void CheckpointWriter::putDouble(double x)
+    {
+	uint64_t bits;
+	std::memcpy(&bits, &x, sizeof(bits));
+	putBytes(_out, bits, 8);
+    }
+
+    void CheckpointWriter::putString(string const &x)
+    {
+	putUInt(x.size());
+	_out.write(x.data(), x.size());
+    }
+
+    void CheckpointWriter::putInts(vector<int> const &x)
+    {
+	putUInt(x.size());
+	for (unsigned int i = 0; i < x.size(); ++i) {
+	    putBytes(_out, static_cast<uint32_t>(x[i]), 4);
+	}
+    }
+
+    void CheckpointWriter::putDoubles(vector<double> const &x)
+    {
+	putUInt(x.size());
+	if (!x.empty()) {
+	    putDoubles(&x[0], x.size());
+	}
+    }
+
+    void CheckpointWriter::putDoubles(double const *x, unsigned int n)
+    {
+	for (unsigned int i = 0; i < n; ++i) {
+	    putDouble(x[i]);
+	}
+    }
+
+    CheckpointReader::CheckpointReader(istream &in)
+	: _in(in)
+    {
+	char magic[8];
+	_in.read(magic, 8);
+	if (!_in || std::memcmp(magic, MAGIC, 8) != 0) {
+	    throw runtime_error("Not a JAGS checkpoint file");
+	}
+	if (getUInt() != VERSION) {
+	    throw runtime_error("Unsupported checkpoint format version");
+	}
+    }
+
+    void CheckpointReader::read(unsigned char *buf, unsigned int n)
+    {
+	_in.read(reinterpret_cast<char*>(buf), n);
+	if (!_in) {
+	    throw runtime_error("Unexpected end of checkpoint file");
+	}
+    }
+
+    unsigned int CheckpointReader::getUInt()
+    {
+	unsigned char buf[4];
+	read(buf, 4);
+	return getBytes(buf, 4);
+    }
+
+    double CheckpointReader::getDouble()
+    {
+	unsigned char buf[8];
+	read(buf, 8);
+	uint64_t bits = getBytes(buf, 8);
+	double x;
+	std::memcpy(&x, &bits, sizeof(x));
+	return x;
+    }
+
+    string CheckpointReader::getString()
+    {
+	unsigned int n = getUInt();
+	string x(n, ' ');
+	if (n > 0) {
+	    _in.read(&x[0], n);
+	    if (!_in) {
+		throw runtime_error("Unexpected end of checkpoint file");
+	    }
+	}
+	return x;
+    }
+
+    vector<int> CheckpointReader::getInts()
+    {
+	unsigned int n = getUInt();
+	vector<int> x;
+	for (unsigned int i = 0; i < n; ++i) {
+	    x.push_back(static_cast<int>(static_cast<uint32_t>(getUInt())));
+	}
+	return x;
+    }
+
+    vector<double> CheckpointReader::getDoubles()
+    {
+	unsigned int n = getUInt();
+	vector<double> x;
+	for (unsigned int i = 0; i < n; ++i) {
+	    x.push_back(getDouble());
+	}
+	return x;
+    }
+
+    void CheckpointReader::getDoubles(double *x, unsigned int n)
+    {
+	for (unsigned int i = 0; i < n; ++i) {
+	    x[i] = getDouble();
+	}
+    }
+
+} //namespace jags
@@ -2,8 +2,11 @@
 #include <model/Model.h>
 #include <model/MonitorFactory.h>
 #include <model/Monitor.h>
+#include <model/CODAStream.h>
+#include <model/Checkpoint.h>
 #include <sampler/Sampler.h>
 #include <sampler/SamplerFactory.h>
+#include <sampler/FreeNodeSet.h>
 #include <rng/RNGFactory.h>
 #include <rng/RNG.h>
 #include <graph/GraphMarks.h>
@@ -11,11 +14,15 @@
 #include <graph/StochasticNode.h>
 #include <graph/DeterministicNode.h>
 #include <graph/ConstantNode.h>
+#include <graph/MixtureNode.h>
 #include <graph/NodeError.h>
 #include <graph/Node.h>
 #include <util/nainf.h>
+#include <util/ThreadPool.h>
 
 #include <fstream>
+#include <istream>
+#include <ostream>
 #include <sstream>
 #include <set>
 #include <stdexcept>
@@ -23,9 +30,13 @@
 #include <algorithm>
 #include <functional>
 #include <map>
+#include <limits>
+#include <chrono>
 
 using std::map;
 using std::pair;
+using std::chrono::steady_clock;
+using std::chrono::duration;
 using std::binary_function;
 using std::sort;
 using std::vector;
@@ -42,6 +53,8 @@ using std::min;
 using std::max;
 using std::reverse;
 using std::find;
+using std::bind;
+using std::placeholders::_1;
 
 namespace jags {
 
@@ -85,13 +98,20 @@ static bool checkClosure(vector<Node*> const &nodes)
 }
 
 Model::Model(unsigned int nchain)
-    : _samplers(0), _nchain(nchain), _rng(nchain, 0), _iteration(0),
-      _is_initialized(false), _adapt(false), _data_gen(false)
+    : _samplers(0), _nchain(nchain), _rng(nchain, 0), 
+      _substreams(nchain), _iteration(0),
+      _is_initialized(false), _adapt(false), _data_gen(false),
+      _index_only_mixtures(false), _values(0), _value_stride(0)
 {
 }
 
 Model::~Model()
 {
+    while(!_coda_streams.empty()) {
+	delete _coda_streams.back();
+	_coda_streams.pop_back();
+    }
+
     while(!_samplers.empty()) {
 	Sampler *sampler0 = _samplers.back();
 	delete sampler0;
@@ -105,6 +125,8 @@ Model::~Model()
 	delete node;
 	_nodes.pop_back();
     }
+
+    delete [] _values;
 }
 
 bool Model::isInitialized()
@@ -164,6 +186,24 @@ void Model::initialize(bool datagen)
     if (!checkClosure(_nodes))
 	throw runtime_error("Graph not closed");
 
+    // Move node values into contiguous storage before any samplers
+    // are created, as they may keep pointers to the values
+    allocateValues();
+
+    // Mixture nodes read through to their active parents. This is
+    // done before the samplers are created, as they must know
+    // which parameter values can move.
+    if (_index_only_mixtures) {
+	for (vector<Node*>::const_iterator i = _nodes.begin();
+	     i != _nodes.end(); ++i)
+	{
+	    MixtureNode *m = dynamic_cast<MixtureNode*>(*i);
+	    if (m && m->deterministicChildren()->empty()) {
+		m->setIndexOnly(true);
+	    }
+	}
+    }
+
     // Choose random number generators
     chooseRNGs();
 
@@ -190,6 +230,91 @@ void Model::initialize(bool datagen)
     _is_initialized = true;
 }
 
+void Model::setIndexOnlyMixtures(bool flag)
+{
+    if (_is_initialized) {
+	throw logic_error("Model already initialized");
+    }
+    _index_only_mixtures = flag;
+}
+
+void Model::allocateValues()
+{
+    /*
+      The values of all nodes are stored in a single block, which is
+      divided into one sub-block per chain. Within each sub-block,
+      the nodes are laid out in the order that they were added to
+      the model, which is a topological order, so that nodes are
+      close to their parents and children. The length of each
+      sub-block is rounded up to a multiple of 8 doubles (64 bytes)
+      to avoid false sharing when chains are updated in parallel.
+
+      Nodes are moved in reverse order. An aggregate node that is a
+      view of its parent's storage is then moved, copying its values
+      into its own slot, before the parent's storage is released.
+    */
+    unsigned long length = 0;
+    for (vector<Node*>::const_iterator i = _nodes.begin(); 
+	 i != _nodes.end(); ++i)
+    {
+	length += (*i)->length();
+    }
+    unsigned long stride = 8 * ((length + 7) / 8);
+    if (stride > std::numeric_limits<unsigned int>::max()) {
+	//Too large for Node::moveValue: leave values where they are
+	return;
+    }
+    
+    _value_stride = stride;
+    _values = new double[stride * _nchain];
+    double *value = _values + length;
+    for (vector<Node*>::const_reverse_iterator i = _nodes.rbegin(); 
+	 i != _nodes.rend(); ++i)
+    {
+	value -= (*i)->length();
+	(*i)->moveValue(value, stride);
+    }
+    for (vector<Node*>::const_iterator i = _nodes.begin(); 
+	 i != _nodes.end(); ++i)
+    {
+	(*i)->resetParentValues();
+    }
+}
+
+vector<pair<string, double> > const &Model::samplerFactoryTimes() const
+{
+    return _factory_times;
+}
+
+vector<unsigned long> Model::samplerEvaluations() const
+{
+    vector<unsigned long> counts(_samplers.size());
+    for (unsigned int i = 0; i < _samplers.size(); ++i) {
+	counts[i] = _samplers[i]->evaluations();
+    }
+    return counts;
+}
+
+void Model::allocationStats(unsigned long &nblock, unsigned long &nbytes) const
+{
+    nblock = 0;
+    nbytes = 0;
+    unsigned long nvalue = 0;
+    for (vector<Node*>::const_iterator i = _nodes.begin(); 
+	 i != _nodes.end(); ++i)
+    {
+	if ((*i)->ownsValue()) {
+	    ++nblock;
+	    nvalue += (*i)->length() * _nchain;
+	}
+    }
+    if (_values) {
+	++nblock;
+	nvalue += _value_stride * _nchain;
+    }
+    nbytes = nvalue * sizeof(double);
+}
+
 void Model::initializeNodes()
 {
     vector<Node*>::const_iterator i;
@@ -206,18 +331,15 @@ void Model::initializeNodes()
     }
 }
 
-struct less_sampler {  
+struct less_rank {  
     /* 
-       Comparison operator for Samplers which sorts them in 
-       order according to the supplied sampler map
+       Comparison operator for ranked Samplers, which ignores the
+       Sampler pointer so that stable sorting preserves the order of
+       samplers with equal rank.
     */
-    map<Sampler const*, unsigned int>  const & _sampler_map;
-
-    less_sampler(map<Sampler const*, unsigned int> const &sampler_map) 
-	: _sampler_map(sampler_map) {};
-
-    bool operator()(Sampler const *x, Sampler const *y) const {
-	return _sampler_map.find(x)->second < _sampler_map.find(y)->second;
+    bool operator()(pair<unsigned int, Sampler*> const &x,
+		    pair<unsigned int, Sampler*> const &y) const {
+	return x.first < y.first;
     };
 
 };
@@ -263,11 +385,11 @@ void Model::chooseSamplers()
     //Triage on marked nodes. We do this twice: once for stochastic
     //nodes and once for all nodes.
 
-    list<StochasticNode*> slist; //List of nodes to be sampled
+    FreeNodeSet slist; //Set of nodes to be sampled
     for(p = _stochastic_nodes.begin(); p != _stochastic_nodes.end(); ++p) {
 	if (marks.mark(*p) == 1) {
 	    //Unobserved stochastic nodes: to be sampled
-	    slist.push_back(*p); 
+	    slist.insert(*p); 
 	}
     }
 
@@ -284,32 +406,34 @@ void Model::chooseSamplers()
 	}
     }
 
-    // Traverse the list of samplers, selecting nodes that can be sampled
+    // Traverse the list of samplers, selecting nodes that can be
+    // sampled. The time taken by each factory is recorded.
+    _factory_times.clear();
     list<pair<SamplerFactory *, bool> > const &sf = samplerFactories();
     for(list<pair<SamplerFactory *, bool> >::const_iterator q = sf.begin();
 	q != sf.end(); ++q) 
     {
 	if (!q->second) continue;
 
+	steady_clock::time_point start = steady_clock::now();
 	vector<Sampler*> svec = q->first->makeSamplers(slist, sample_graph);
 	while (!svec.empty()) {
 	    for (unsigned int i = 0; i < svec.size(); ++i) {
 
 		vector<StochasticNode*> const &nodes = svec[i]->nodes();
 		for (unsigned int j = 0; j < nodes.size(); ++j) {
-		    /* FIXME: This is a potential bottleneck if slist
-		       is large */
-		    list<StochasticNode*>::iterator p = 
-			find(slist.begin(), slist.end(), nodes[j]);
-		    if (p == slist.end()) {
+		    if (!slist.contains(nodes[j])) {
 			throw logic_error("Unable to find sampled node");
 		    }
-		    slist.erase(p);
+		    slist.erase(nodes[j]);
 		}
 		_samplers.push_back(svec[i]);
 	    }
 	    svec = q->first->makeSamplers(slist, sample_graph);
 	}
+	duration<double> elapsed = steady_clock::now() - start;
+	_factory_times.push_back(pair<string, double>(q->first->name(),
+						      elapsed.count()));
     }
   
     // Make sure we found a sampler for all the nodes
@@ -322,43 +446,144 @@ void Model::chooseSamplers()
     // that are closer to the data are updated before samplers that
     // only affect higher-order parameters
     
-    // Create a map associating each stochastic node with its index
-    // in the vector _stochastic_nodes, corresponding to the order
-    // in which they were added to the model
-    map<StochasticNode const *, unsigned int> snode_map;
-    for (unsigned int i = 0; i < _stochastic_nodes.size(); ++i) {
-	snode_map[_stochastic_nodes[i]] = i;
-    }
-
-    // Create a map associating each sampler with the minimal index
-    // of its sampled nodes.
-    map<Sampler const *, unsigned int> sampler_map;
+    // Rank each sampler by the minimal id of its sampled nodes. Node
+    // ids give the order in which nodes were added to the model.
+    vector<pair<unsigned int, Sampler*> > ranked;
     for (unsigned int i = 0; i < _samplers.size(); ++i) {
-	unsigned int min_index = _stochastic_nodes.size();
+	unsigned int min_id = Node::NO_ID;
 	vector<StochasticNode*> const &snodes = _samplers[i]->nodes();
 	for (unsigned int j = 0; j < snodes.size(); ++j) {
-	    map<StochasticNode const*, unsigned int>::const_iterator p 
-		= snode_map.find(snodes[j]);
-	    if (p == snode_map.end()) {
-		throw logic_error("Invalid stochastic node map");
-	    }
-	    if (p->second < min_index) {
-		min_index = p->second;
+	    if (snodes[j]->id() < min_id) {
+		min_id = snodes[j]->id();
 	    }
 	}
-	sampler_map[_samplers[i]] = min_index;
+	ranked.push_back(pair<unsigned int, Sampler*>(min_id, _samplers[i]));
     }
 
-    stable_sort(_samplers.begin(), _samplers.end(), less_sampler(sampler_map));
+    stable_sort(ranked.begin(), ranked.end(), less_rank());
+    for (unsigned int i = 0; i < ranked.size(); ++i) {
+	_samplers[i] = ranked[i].second;
+    }
     reverse(_samplers.begin(), _samplers.end());
 }
 
-void Model::update(unsigned int niter)
+void Model::updateSamplers(unsigned int chain, unsigned int first,
+			   unsigned int last)
+{
+    for (unsigned int i = first; i < last; ++i) {
+	_samplers[i]->updateChain(chain, _rng[chain]);
+    }
+}
+
+void Model::sampleExtra(unsigned int chain)
+{
+    for (vector<Node*>::const_iterator k = _sampled_extra.begin();
+	 k != _sampled_extra.end(); ++k)
+    {
+	if (!(*k)->checkParentValues(chain)) {
+	    throw NodeError(*k, "Invalid parent values");
+	}
+	(*k)->randomSample(_rng[chain], chain);
+    }
+}
+
+void Model::updateChain(unsigned int chain, unsigned int niter)
+{
+    /* 
+       Updates a single chain without updating the monitors. The
+       samplers and the sampled extra nodes are visited in the same
+       order as in a serial update, so the chain consumes the same
+       sequence of random numbers.
+    */
+    for (unsigned int iter = 0; iter < niter; ++iter) {
+	updateSamplers(chain, 0, _samplers.size());
+	sampleExtra(chain);
+    }
+}
+
+void Model::updateParallel(unsigned int niter)
+{
+    /*
+      Chains run independently between monitored iterations. At the
+      end of each block the chains are synchronized and the monitors
+      are updated by the calling thread.
+
+      Samplers that are not thread-safe are updated for all chains by
+      the calling thread. If there are any, the chains are synchronized
+      around each of them, and the thread-safe samplers in between are
+      updated in parallel one iteration at a time.
+    */
+    bool safe = true;
+    for (unsigned int i = 0; i < _samplers.size(); ++i) {
+	if (!_samplers[i]->isThreadSafe()) {
+	    safe = false;
+	    break;
+	}
+    }
+
+    //Chain 0 is updated by the calling thread and each other chain by
+    //its own worker.
+    ThreadPool pool(_nchain);
+
+    unsigned int end = _iteration + niter;
+    while (_iteration < end) {
+	unsigned int next = end;
+	for (list<MonitorControl>::const_iterator k = _monitors.begin(); 
+	     k != _monitors.end(); ++k) 
+	{
+	    next = min(next, k->nextUpdate(_iteration + 1));
+	}
+
+	if (safe) {
+	    pool.run(bind(&Model::updateChain, this, _1, next - _iteration));
+	}
+	else {
+	    for (unsigned int iter = _iteration; iter < next; ++iter) {
+		unsigned int first = 0;
+		while (first < _samplers.size()) {
+		    unsigned int last = first;
+		    while (last < _samplers.size() &&
+			   _samplers[last]->isThreadSafe())
+		    {
+			++last;
+		    }
+		    if (last > first) {
+			pool.run(bind(&Model::updateSamplers, this, _1,
+				      first, last));
+		    }
+		    if (last < _samplers.size()) {
+			_samplers[last]->update(_rng);
+		    }
+		    first = last + 1;
+		}
+		if (!_sampled_extra.empty()) {
+		    pool.run(bind(&Model::sampleExtra, this, _1));
+		}
+	    }
+	}
+	_iteration = next;
+
+	for (list<MonitorControl>::iterator k = _monitors.begin(); 
+	     k != _monitors.end(); k++) 
+	{
+	    k->update(_iteration);
+	}
+	updateCODAStreams();
+    }
+    flushCODAStreams();
+}
+
+void Model::update(unsigned int niter, bool parallel)
 {
     if (!_is_initialized) {
 	throw logic_error("Attempt to update uninitialized model");
     }
 
+    if (parallel && _nchain > 1) {
+	updateParallel(niter);
+	return;
+    }
+
     for (unsigned int iter = 0; iter < niter; ++iter) {    
 	
 	for (vector<Sampler*>::iterator i = _samplers.begin(); 
@@ -384,8 +609,50 @@ void Model::update(unsigned int niter)
 	{
 	    k->update(_iteration);
 	}
+	updateCODAStreams();
     }
+    flushCODAStreams();
+}
 
+void Model::updateCODAStreams()
+{
+    for (list<CODAStream*>::const_iterator p = _coda_streams.begin();
+	 p != _coda_streams.end(); ++p)
+    {
+	(*p)->update();
+    }
+}
+
+void Model::flushCODAStreams()
+{
+    for (list<CODAStream*>::const_iterator p = _coda_streams.begin();
+	 p != _coda_streams.end(); ++p)
+    {
+	(*p)->flush();
+    }
+}
+
+void Model::addCODAStream(CODAStream *stream)
+{
+    //Close any existing stream that writes to the same files
+    vector<string> const &files = stream->files();
+    for (list<CODAStream*>::iterator p = _coda_streams.begin();
+	 p != _coda_streams.end(); )
+    {
+	vector<string> const &pfiles = (*p)->files();
+	bool clash = false;
+	for (unsigned int i = 0; i < pfiles.size() && !clash; ++i) {
+	    clash = find(files.begin(), files.end(), pfiles[i]) != files.end();
+	}
+	if (clash) {
+	    delete *p;
+	    p = _coda_streams.erase(p);
+	}
+	else {
+	    ++p;
+	}
+    }
+    _coda_streams.push_back(stream);
 }
 
 unsigned int Model::iteration() const
@@ -483,6 +750,19 @@ void Model::addMonitor(Monitor *monitor, unsigned int thin)
 
 void Model::removeMonitor(Monitor *monitor)
 {
+    //Close any CODA stream that is writing the monitor
+    for (list<CODAStream*>::iterator p = _coda_streams.begin();
+	 p != _coda_streams.end(); )
+    {
+	if ((*p)->isWriting(monitor)) {
+	    delete *p;
+	    p = _coda_streams.erase(p);
+	}
+	else {
+	    ++p;
+	}
+    }
+
     for(list<MonitorControl>::iterator p = _monitors.begin();
 	p != _monitors.end(); ++p)
     {
@@ -555,6 +835,7 @@ bool Model::setRNG(string const &name, unsigned int chain)
 		  delete _rng[chain];
 	      */
 	      _rng[chain] = rng;
+	      _substreams[chain].clear();
 	      return true;
 	  }
       }
@@ -569,9 +850,39 @@ bool Model::setRNG(RNG *rng, unsigned int chain)
      throw logic_error("Invalid chain number in Model::setRNG");
 
   _rng[chain] = rng;
+  _substreams[chain].clear();
   return true;
 }
 
+RNG *Model::substreamRNG(unsigned int chain, unsigned int index)
+{
+    if (chain >= _nchain)
+	throw logic_error("Invalid chain number in Model::substreamRNG");
+    if (_rng[chain] == 0)
+	return 0;
+
+    vector<RNG*> &sub = _substreams[chain];
+    if (index < sub.size() && sub[index] != 0) {
+	return sub[index];
+    }
+
+    list<pair<RNGFactory*, bool> >::const_iterator p;
+    for (p = rngFactories().begin(); p != rngFactories().end(); ++p) {
+	if (p->second) {
+	    RNG *rng = p->first->makeSubstream(_rng[chain], index);
+	    if (rng) {
+		// Substreams are owned by the factory, like other RNGs
+		if (index >= sub.size()) {
+		    sub.resize(index + 1, 0);
+		}
+		sub[index] = rng;
+		return rng;
+	    }
+	}
+    }
+    return 0;
+}
+
 list<MonitorControl> const &Model::monitors() const
 {
   return _monitors;
@@ -579,17 +890,34 @@ list<MonitorControl> const &Model::monitors() const
 
 void Model::addNode(StochasticNode *node)
 {
+    node->setId(_nodes.size());
     _nodes.push_back(node);
     _stochastic_nodes.push_back(node);
 }
 
 void Model::addNode(DeterministicNode *node)
 {
+    node->setId(_nodes.size());
     _nodes.push_back(node);
+
+    //The new node keeps pointers to the values of its parents
+    vector<Node const *> const &par = node->parents();
+    bool reset = false;
+    for (unsigned int i = 0; i < par.size(); ++i) {
+	MixtureNode const *m = asMixture(par[i]);
+	if (m && m->isIndexOnly()) {
+	    const_cast<MixtureNode*>(m)->setIndexOnly(false);
+	    reset = true;
+	}
+    }
+    if (reset) {
+	node->resetParentValues();
+    }
 }
 
 void Model::addNode(ConstantNode *node)
 {
+    node->setId(_nodes.size());
     _nodes.push_back(node);
 }
 
@@ -603,4 +931,295 @@ vector<StochasticNode*> const &Model::stochasticNodes() const
 	return _nodes;
     }
 
+void Model::checkpoint(std::ostream &out) const
+{
+    if (!_is_initialized) {
+	throw logic_error("Cannot checkpoint uninitialized model");
+    }
+
+    CheckpointWriter writer(out);
+    writer.putUInt(_nchain);
+    writer.putUInt(_iteration);
+    writer.putUInt(_adapt);
+
+    // Values of unobserved stochastic nodes. The lengths are written
+    // first so that they can be checked when the checkpoint is restored
+    vector<StochasticNode const *> snodes;
+    for (unsigned int i = 0; i < _stochastic_nodes.size(); ++i) {
+	if (!_stochastic_nodes[i]->isFixed()) {
+	    snodes.push_back(_stochastic_nodes[i]);
+	}
+    }
+    writer.putUInt(snodes.size());
+    for (unsigned int i = 0; i < snodes.size(); ++i) {
+	writer.putUInt(snodes[i]->length());
+    }
+    for (unsigned int ch = 0; ch < _nchain; ++ch) {
+	for (unsigned int i = 0; i < snodes.size(); ++i) {
+	    writer.putDoubles(snodes[i]->value(ch), snodes[i]->length());
+	}
+    }
+
+    // RNGs and their substreams
+    for (unsigned int ch = 0; ch < _nchain; ++ch) {
+	vector<int> state;
+	writer.putString(_rng[ch]->name());
+	_rng[ch]->getState(state);
+	writer.putInts(state);
+	vector<RNG*> const &sub = _substreams[ch];
+	writer.putUInt(sub.size());
+	for (unsigned int i = 0; i < sub.size(); ++i) {
+	    writer.putUInt(sub[i] != 0);
+	    if (sub[i]) {
+		sub[i]->getState(state);
+		writer.putInts(state);
+	    }
+	}
+    }
+
+    // Samplers
+    writer.putUInt(_samplers.size());
+    for (unsigned int i = 0; i < _samplers.size(); ++i) {
+	writer.putString(_samplers[i]->name());
+	for (unsigned int ch = 0; ch < _nchain; ++ch) {
+	    vector<double> state;
+	    _samplers[i]->getState(ch, state);
+	    writer.putDoubles(state);
+	}
+    }
+
+    // Monitors
+    vector<CheckpointMonitor> monitors;
+    checkpointMonitors(monitors);
+    writer.putUInt(monitors.size());
+    for (unsigned int k = 0; k < monitors.size(); ++k) {
+	CheckpointMonitor const &m = monitors[k];
+	writer.putString(m.name);
+	writer.putUInt(m.scope.size());
+	for (unsigned int j = 0; j < m.scope.size(); ++j) {
+	    writer.putInts(m.scope[j]);
+	}
+	writer.putString(m.type);
+	writer.putUInt(m.thin);
+	writer.putUInt(m.start);
+	writer.putUInt(m.niter);
+	writer.putDoubles(m.state);
+    }
+
+    if (!out) {
+	throw runtime_error("Failed to write checkpoint");
+    }
+}
+
+void Model::restore(std::istream &in)
+{
+    if (!_is_initialized) {
+	throw logic_error("Cannot restore uninitialized model");
+    }
+
+    // Read the whole checkpoint, checking the structure against the
+    // model, before modifying the model
+    CheckpointReader reader(in);
+    if (reader.getUInt() != _nchain) {
+	throw runtime_error("Checkpoint has wrong number of chains");
+    }
+    unsigned int iteration = reader.getUInt();
+    bool adapt = reader.getUInt() != 0;
+
+    vector<StochasticNode *> snodes;
+    for (unsigned int i = 0; i < _stochastic_nodes.size(); ++i) {
+	if (!_stochastic_nodes[i]->isFixed()) {
+	    snodes.push_back(_stochastic_nodes[i]);
+	}
+    }
+    if (reader.getUInt() != snodes.size()) {
+	throw runtime_error("Checkpoint does not match model nodes");
+    }
+    unsigned long nvalue = 0;
+    for (unsigned int i = 0; i < snodes.size(); ++i) {
+	if (reader.getUInt() != snodes[i]->length()) {
+	    throw runtime_error("Checkpoint does not match model nodes");
+	}
+	nvalue += snodes[i]->length();
+    }
+    vector<double> values(nvalue * _nchain);
+    for (unsigned long j = 0; j < values.size(); ++j) {
+	values[j] = reader.getDouble();
+    }
+
+    vector<string> rng_names(_nchain);
+    vector<vector<int> > rng_states(_nchain);
+    vector<vector<vector<int> > > sub_states(_nchain);
+    vector<vector<bool> > sub_present(_nchain);
+    for (unsigned int ch = 0; ch < _nchain; ++ch) {
+	rng_names[ch] = reader.getString();
+	rng_states[ch] = reader.getInts();
+	unsigned int nsub = reader.getUInt();
+	for (unsigned int i = 0; i < nsub; ++i) {
+	    bool present = reader.getUInt() != 0;
+	    sub_present[ch].push_back(present);
+	    sub_states[ch].push_back(present ? reader.getInts()
+				     : vector<int>());
+	}
+    }
+
+    if (reader.getUInt() != _samplers.size()) {
+	throw runtime_error("Checkpoint does not match model samplers");
+    }
+    vector<vector<vector<double> > > sampler_states(_samplers.size());
+    for (unsigned int i = 0; i < _samplers.size(); ++i) {
+	if (reader.getString() != _samplers[i]->name()) {
+	    throw runtime_error("Checkpoint does not match model samplers");
+	}
+	for (unsigned int ch = 0; ch < _nchain; ++ch) {
+	    sampler_states[i].push_back(reader.getDoubles());
+	}
+    }
+
+    vector<CheckpointMonitor> monitors(reader.getUInt());
+    for (unsigned int k = 0; k < monitors.size(); ++k) {
+	CheckpointMonitor &m = monitors[k];
+	m.name = reader.getString();
+	m.scope.resize(reader.getUInt());
+	for (unsigned int j = 0; j < m.scope.size(); ++j) {
+	    m.scope[j] = reader.getInts();
+	}
+	m.type = reader.getString();
+	m.thin = reader.getUInt();
+	m.start = reader.getUInt();
+	m.niter = reader.getUInt();
+	m.state = reader.getDoubles();
+    }
+    if (adapt && !monitors.empty()) {
+	throw runtime_error("Checkpoint has monitors in adaptive mode");
+    }
+
+    /* 
+       Set the states of the RNGs, samplers and monitors. The RNGs
+       and samplers cannot check a state without setting it, so
+       their current states are saved first, and put back if any
+       state is rejected.
+    */
+    vector<RNG*> old_rng = _rng;
+    vector<vector<RNG*> > old_substreams = _substreams;
+    vector<vector<int> > old_rng_states(_nchain);
+    vector<vector<vector<int> > > old_sub_states(_nchain);
+    for (unsigned int ch = 0; ch < _nchain; ++ch) {
+	if (_rng[ch]) {
+	    _rng[ch]->getState(old_rng_states[ch]);
+	}
+	vector<RNG*> const &sub = _substreams[ch];
+	old_sub_states[ch].resize(sub.size());
+	for (unsigned int i = 0; i < sub.size(); ++i) {
+	    if (sub[i]) {
+		sub[i]->getState(old_sub_states[ch][i]);
+	    }
+	}
+    }
+    vector<vector<vector<double> > > old_sampler_states(_samplers.size());
+    for (unsigned int i = 0; i < _samplers.size(); ++i) {
+	old_sampler_states[i].resize(_nchain);
+	for (unsigned int ch = 0; ch < _nchain; ++ch) {
+	    _samplers[i]->getState(ch, old_sampler_states[i][ch]);
+	}
+    }
+
+    try {
+	for (unsigned int ch = 0; ch < _nchain; ++ch) {
+	    if (_rng[ch] == 0 || _rng[ch]->name() != rng_names[ch]) {
+		if (!setRNG(rng_names[ch], ch)) {
+		    throw runtime_error(string("RNG type ") + rng_names[ch] +
+					" not found");
+		}
+	    }
+	    if (!_rng[ch]->setState(rng_states[ch])) {
+		throw runtime_error("Invalid RNG state in checkpoint");
+	    }
+	    for (unsigned int i = 0; i < sub_present[ch].size(); ++i) {
+		if (!sub_present[ch][i]) continue;
+		RNG *sub = substreamRNG(ch, i);
+		if (!sub || !sub->setState(sub_states[ch][i])) {
+		    throw runtime_error("Cannot restore RNG substream");
+		}
+	    }
+	}
+
+	for (unsigned int i = 0; i < _samplers.size(); ++i) {
+	    for (unsigned int ch = 0; ch < _nchain; ++ch) {
+		if (!_samplers[i]->setState(ch, sampler_states[i][ch])) {
+		    throw runtime_error(string("Invalid state for sampler ") +
+					_samplers[i]->name());
+		}
+	    }
+	}
+
+	restoreMonitors(monitors);
+    }
+    catch (...) {
+	_rng = old_rng;
+	_substreams = old_substreams;
+	for (unsigned int ch = 0; ch < _nchain; ++ch) {
+	    if (_rng[ch]) {
+		_rng[ch]->setState(old_rng_states[ch]);
+	    }
+	    vector<RNG*> const &sub = _substreams[ch];
+	    for (unsigned int i = 0; i < sub.size(); ++i) {
+		if (sub[i]) {
+		    sub[i]->setState(old_sub_states[ch][i]);
+		}
+	    }
+	}
+	for (unsigned int i = 0; i < _samplers.size(); ++i) {
+	    for (unsigned int ch = 0; ch < _nchain; ++ch) {
+		_samplers[i]->setState(ch, old_sampler_states[i][ch]);
+	    }
+	}
+	throw;
+    }
+
+    // Nothing below can fail
+    if (_adapt && !adapt) {
+	adaptOff();
+    }
+    _adapt = adapt;
+    _iteration = iteration;
+
+    double const *v = values.empty() ? 0 : &values[0];
+    for (unsigned int ch = 0; ch < _nchain; ++ch) {
+	for (unsigned int i = 0; i < snodes.size(); ++i) {
+	    snodes[i]->setValue(v, snodes[i]->length(), ch);
+	    v += snodes[i]->length();
+	}
+	// Nodes are in topological order, so deterministic nodes are
+	// recalculated after their parents
+	for (vector<Node*>::const_iterator p = _nodes.begin();
+	     p != _nodes.end(); ++p)
+	{
+	    DeterministicNode *dnode = dynamic_cast<DeterministicNode*>(*p);
+	    if (dnode && !dnode->isFixed()) {
+		dnode->deterministicSample(ch);
+	    }
+	}
+    }
+}
+
+void Model::checkpointMonitors(vector<CheckpointMonitor> &monitors) const
+{
+}
+
+void Model::restoreMonitors(vector<CheckpointMonitor> const &monitors)
+{
+    if (!monitors.empty()) {
+	throw runtime_error("Cannot restore monitors");
+    }
+}
+
+void Model::addRestoredMonitor(Monitor *monitor, unsigned int thin,
+			       unsigned int start, unsigned int niter)
+{
+    _monitors.push_back(MonitorControl(monitor, start, thin));
+    _monitors.back().restore(start, niter);
+    setSampledExtra();
+}
+
 } //namespace jags
@@ -101,4 +101,24 @@ SArray Monitor::dump(bool flat) const
     return(ans);
 }
 
+void Monitor::getValue(double *x, unsigned int chain, unsigned long offset,
+		       unsigned int n) const
+{
+    vector<double> const &v = value(chain);
+    if (offset + n > v.size()) {
+	throw logic_error("Invalid range in Monitor::getValue");
+    }
+    copy(v.begin() + offset, v.begin() + offset + n, x);
+}
+
+void Monitor::getState(vector<double> &state) const
+{
+    state.clear();
+}
+
+bool Monitor::setState(vector<double> const &state)
+{
+    return state.empty();
+}
+
 } //namespace jags
@@ -54,6 +54,16 @@ void MonitorControl::update(unsigned int iteration)
     }
 }
 
+unsigned int MonitorControl::nextUpdate(unsigned int iteration) const
+{
+    if (iteration <= _start) {
+	return _start;
+    }
+    else {
+	return iteration + (_thin - (iteration - _start) % _thin) % _thin;
+    }
+}
+
 bool MonitorControl::operator==(MonitorControl const &rhs) const
 {
     return (_monitor == rhs._monitor &&
@@ -62,4 +72,10 @@ bool MonitorControl::operator==(MonitorControl const &rhs) const
 	    _niter == rhs._niter);
 }
 
+void MonitorControl::restore(unsigned int start, unsigned int niter)
+{
+    _start = start;
+    _niter = niter;
+}
+
 } //namespace jags
@@ -153,6 +153,22 @@ namespace jags {
 	return anode;
     }
 
+    vector<unsigned int> NodeArray::missingOffsets(Range const &range) const
+    {
+	if (!_range.contains(range)) {
+	    throw runtime_error(string("Cannot get subset ") + name() + 
+				print(range) + ". Range out of bounds");
+	}
+	vector<unsigned int> offsets;
+	for (RangeIterator p(range); !p.atEnd(); p.nextLeft()) {
+	    unsigned int i = _range.leftOffset(p);
+	    if (_node_pointers[i] == 0) {
+		offsets.push_back(i);
+	    }
+	}
+	return offsets;
+    }
+
     void NodeArray::setValue(SArray const &value, unsigned int chain)
     {
 	if (!(_range == value.range())) {
@@ -7,12 +7,15 @@
 
 #include <set>
 #include <stdexcept>
+#include <algorithm>
 
 
 using std::set;
 using std::vector;
 using std::runtime_error;
 using std::string;
+using std::copy;
+using std::fill;
 
 namespace jags {
 
@@ -39,26 +42,54 @@ namespace jags {
 		_offsets.push_back(array->_offsets[i]);
 	    }
 	}
+	makeGatherList();
     }
-    
-    vector<double> NodeArraySubset::value(unsigned int chain) const
+
+    void NodeArraySubset::makeGatherList()
     {
-	vector<double> ans;
-	Node const *node = 0;
-	double const *values = 0;
+	/*
+	  Consecutive elements that are taken from consecutive values
+	  of the same node, or that are missing, are merged into a
+	  single run that can be copied in one step.
+	*/
 	for (unsigned int i = 0; i < _node_pointers.size(); ++i) {
-	    if (_node_pointers[i]) {
-		if (node != _node_pointers[i]) {
-		    node = _node_pointers[i];
-		    values = node->value(chain);
+	    Node const *node = _node_pointers[i];
+	    unsigned int offset = node ? _offsets[i] : 0;
+	    if (!_gather.empty()) {
+		GatherRun &last = _gather.back();
+		if (last.node == node &&
+		    (!node || last.offset + last.length == offset))
+		{
+		    last.length++;
+		    continue;
 		}
-		ans.push_back(values[_offsets[i]]);
+	    }
+	    GatherRun run = {node, offset, 1};
+	    _gather.push_back(run);
+	}
+    }
+    
+    vector<double> NodeArraySubset::value(unsigned int chain) const
+    {
+	vector<double> ans(_node_pointers.size());
+	getValue(ans.data(), chain);
+	return ans;
+    }
+
+    void NodeArraySubset::getValue(double *value, unsigned int chain) const
+    {
+	for (vector<GatherRun>::const_iterator p = _gather.begin();
+	     p != _gather.end(); ++p)
+	{
+	    if (p->node) {
+		double const *x = p->node->value(chain) + p->offset;
+		copy(x, x + p->length, value);
 	    }
 	    else {
-		ans.push_back(JAGS_NA);
+		fill(value, value + p->length, JAGS_NA);
 	    }
+	    value += p->length;
 	}
-	return ans;
     }
     
     vector<unsigned int> const &NodeArraySubset::dim() const
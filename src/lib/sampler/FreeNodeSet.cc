@@ -0,0 +1,73 @@
+#include <config.h>
+#include <sampler/FreeNodeSet.h>
+#include <graph/StochasticNode.h>
+
+#include <stdexcept>
+
+using std::list;
+using std::logic_error;
+
+namespace jags {
+
+FreeNodeSet::FreeNodeSet()
+{}
+
+void FreeNodeSet::insert(StochasticNode *node)
+{
+    if (contains(node)) return;
+
+    unsigned int id = node->id();
+    if (id == Node::NO_ID) {
+	throw logic_error("Attempt to insert node without id in FreeNodeSet");
+    }
+    if (id >= _free.size()) {
+	_free.resize(id + 1, false);
+	_index.resize(id + 1, _nodes.end());
+    }
+    _index[id] = _nodes.insert(_nodes.end(), node);
+    _free[id] = true;
+}
+
+void FreeNodeSet::erase(Node const *node)
+{
+    if (!contains(node)) {
+	throw logic_error("Attempt to erase node not in FreeNodeSet");
+    }
+    unsigned int id = node->id();
+    _nodes.erase(_index[id]);
+    _index[id] = _nodes.end();
+    _free[id] = false;
+}
+
+bool FreeNodeSet::contains(Node const *node) const
+{
+    unsigned int id = node->id();
+    return id < _free.size() && _free[id] && *_index[id] == node;
+}
+
+StochasticNode *FreeNodeSet::find(Node const *node) const
+{
+    return contains(node) ? *_index[node->id()] : 0;
+}
+
+unsigned int FreeNodeSet::size() const
+{
+    return _nodes.size();
+}
+
+bool FreeNodeSet::empty() const
+{
+    return _nodes.empty();
+}
+
+FreeNodeSet::const_iterator FreeNodeSet::begin() const
+{
+    return _nodes.begin();
+}
+
+FreeNodeSet::const_iterator FreeNodeSet::end() const
+{
+    return _nodes.end();
+}
+
+} //namespace jags
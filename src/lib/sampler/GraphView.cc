@@ -2,24 +2,31 @@
 #include <sampler/GraphView.h>
 #include <graph/StochasticNode.h>
 #include <graph/DeterministicNode.h>
+#include <graph/AggNode.h>
+#include <graph/MixtureNode.h>
 #include <graph/Graph.h>
+#include <graph/GraphAdjacency.h>
 #include <graph/NodeError.h>
+#include <distribution/ScalarDist.h>
 #include <util/nainf.h>
 
 #include <stdexcept>
-#include <set>
-#include <list>
 #include <string>
 #include <cmath>
 #include <algorithm>
+#include <map>
 
 using std::vector;
-using std::set;
-using std::list;
 using std::runtime_error;
 using std::logic_error;
 using std::string;
 using std::copy;
+using std::fill;
+using std::map;
+using std::max;
+using std::equal;
+using std::sort;
+using std::unique;
 
 static unsigned int sumLength(vector<jags::StochasticNode *> const &nodes)
 {
@@ -36,7 +43,9 @@ namespace jags {
 GraphView::GraphView(vector<StochasticNode *> const &nodes, Graph const &graph,
 		     bool multilevel)
     : _length(sumLength(nodes)), _nodes(nodes), _stoch_children(0),
-      _determ_children(0), _multilevel(false)
+      _determ_children(0), _multilevel(false),
+      _nevaluations(nodes.empty() ? 0 : nodes[0]->nchain(), 0),
+      _incremental(false)
 {
     //Sanity check on node
     //FIXME: Could use a templated version of countChains here
@@ -47,6 +56,8 @@ GraphView::GraphView(vector<StochasticNode *> const &nodes, Graph const &graph,
     }
     classifyChildren(nodes, graph, _stoch_children, _determ_children,
 		     multilevel);
+    makeChildTables();
+    groupChildren();
 }
 
 vector<StochasticNode *> const &GraphView::nodes() const
@@ -54,17 +65,60 @@ vector<StochasticNode *> const &GraphView::nodes() const
   return _nodes;
 }
 
+/*
+  Scratch marks used by classifyChildren, indexed by node id.  Each
+  call to classifyChildren starts a new generation, so the marks
+  never need to be cleared and the storage is reused from one
+  GraphView to the next.  Only marks with the current generation
+  are valid.  The marks are thread-local so that models may be
+  initialized in different threads.
+*/
+enum ClassMark {CLASS_NONE, CLASS_STOCH, CLASS_INFORMATIVE,
+		CLASS_UNINFORMATIVE, CLASS_SAMPLED};
+
+class ClassMarks {
+    vector<unsigned int> _generation;
+    vector<ClassMark> _mark;
+    unsigned int _current;
+public:
+    ClassMarks() : _current(0) {}
+    void reset() {
+	if (++_current == 0) {
+	    //Wrap-around: invalidate all marks explicitly
+	    fill(_generation.begin(), _generation.end(), 0);
+	    _current = 1;
+	}
+    }
+    ClassMark get(Node const *node) const {
+	unsigned int id = node->id();
+	if (id >= _generation.size() || _generation[id] != _current) {
+	    return CLASS_NONE;
+	}
+	return _mark[id];
+    }
+    void set(Node const *node, ClassMark m) {
+	unsigned int id = node->id();
+	if (id >= _generation.size()) {
+	    _generation.resize(id + 1, 0);
+	    _mark.resize(id + 1, CLASS_NONE);
+	}
+	_generation[id] = _current;
+	_mark[id] = m;
+    }
+};
+
+static thread_local ClassMarks class_marks;
+
 static bool classifyNode(StochasticNode *snode, Graph const &sample_graph, 
-			 set<StochasticNode const *> &sset,
-			 list<StochasticNode *> &slist)
+			 vector<StochasticNode *> &slist)
 {
     // classification function for stochastic nodes
 
-    if (sset.count(snode))
+    if (class_marks.get(snode) == CLASS_STOCH)
 	return true;
     
     if (sample_graph.contains(snode)) {
-	sset.insert(snode);
+	class_marks.set(snode, CLASS_STOCH);
 	slist.push_back(snode);
 	return true;
     }
@@ -75,38 +129,46 @@ static bool classifyNode(StochasticNode *snode, Graph const &sample_graph,
 
 static bool classifyNode(DeterministicNode *dnode, 
 			 Graph const &sample_graph,
-                         set<StochasticNode const *> &sset,
-			 list<StochasticNode *> &slist,
-			 set<DeterministicNode const *> &dset,
-			 list<DeterministicNode *> &dlist)
+			 vector<StochasticNode *> &slist,
+			 vector<DeterministicNode *> &dlist)
 {
     //  Recursive classification function for deterministic nodes
 
     if (!sample_graph.contains(dnode))
 	return false;
-    
-    if (dset.count(dnode))
+
+    switch (class_marks.get(dnode)) {
+    case CLASS_INFORMATIVE:
 	return true;
+    case CLASS_UNINFORMATIVE:
+	return false;
+    default:
+	break;
+    }
     
+    GraphAdjacency const &adj = sample_graph.adjacency();
+    unsigned int i = sample_graph.position(dnode);
+
     bool informative = false;
-    list<StochasticNode*>::const_iterator p; 
-    for (p = dnode->stochasticChildren()->begin(); 
-	 p != dnode->stochasticChildren()->end(); ++p)
+    for (GraphAdjacency::schild_iterator p = adj.stochasticChildrenBegin(i);
+	 p != adj.stochasticChildrenEnd(i); ++p)
     {
-	if (classifyNode(*p, sample_graph, sset, slist))
+	if (classifyNode(*p, sample_graph, slist))
 	    informative = true;
     }
-    list<DeterministicNode*>::const_iterator q;
-    for (q = dnode->deterministicChildren()->begin();
-	 q != dnode->deterministicChildren()->end(); ++q)
+    for (GraphAdjacency::dchild_iterator q = adj.deterministicChildrenBegin(i);
+	 q != adj.deterministicChildrenEnd(i); ++q)
     {
-	if (classifyNode(*q, sample_graph, sset, slist, dset, dlist)) 
+	if (classifyNode(*q, sample_graph, slist, dlist)) 
 	    informative = true;
     }
     if (informative) {
-	dset.insert(dnode);
+	class_marks.set(dnode, CLASS_INFORMATIVE);
 	dlist.push_back(dnode);
     }
+    else {
+	class_marks.set(dnode, CLASS_UNINFORMATIVE);
+    }
     return informative;
 }
 
@@ -117,10 +179,11 @@ void GraphView::classifyChildren(vector<StochasticNode *> const &nodes,
 				 vector<DeterministicNode*> &dtrm_nodes,
 				 bool multilevel)
 {
-    set<StochasticNode const *> sset;
-    set<DeterministicNode const *> dset;
-    list<StochasticNode *> slist;
-    list<DeterministicNode *> dlist;
+    vector<StochasticNode *> slist;
+    vector<DeterministicNode *> dlist;
+
+    GraphAdjacency const &adj = graph.adjacency();
+    class_marks.reset();
 
     /* Classify children of each node */
     vector<StochasticNode  *>::const_iterator p; 
@@ -128,17 +191,17 @@ void GraphView::classifyChildren(vector<StochasticNode *> const &nodes,
 	if (!graph.contains(*p)) {
 	    throw logic_error("Sampled node outside of sampling graph");
 	}
-	list<StochasticNode*> const *sch = (*p)->stochasticChildren();
-	for (list<StochasticNode*>::const_iterator q = sch->begin();
-	     q != sch->end(); ++q)
+	unsigned int i = graph.position(*p);
+	for (GraphAdjacency::schild_iterator q = adj.stochasticChildrenBegin(i);
+	     q != adj.stochasticChildrenEnd(i); ++q)
 	{
-	    classifyNode(*q, graph, sset, slist);
+	    classifyNode(*q, graph, slist);
 	}
-	list<DeterministicNode*> const *dch = (*p)->deterministicChildren();
-	for (list<DeterministicNode*>::const_iterator q = dch->begin();
-	     q != dch->end(); ++q)
+	for (GraphAdjacency::dchild_iterator q = 
+		 adj.deterministicChildrenBegin(i);
+	     q != adj.deterministicChildrenEnd(i); ++q)
 	{
-	    classifyNode(*q, graph, sset, slist, dset, dlist);
+	    classifyNode(*q, graph, slist, dlist);
 	}
     }
 
@@ -148,15 +211,8 @@ void GraphView::classifyChildren(vector<StochasticNode *> const &nodes,
 	   AND the likelihood, causing incorrect calculation of the
 	   log full conditional */
 	for (p = nodes.begin(); p != nodes.end(); ++p) {
-	    if (sset.count(*p)) {
-		list<StochasticNode*>::iterator i = 
-		    find(slist.begin(), slist.end(), *p);
-		if (i == slist.end()) {
-		    throw logic_error("error in ClassifyChildren"); 
-		}
-		else {
-		    slist.erase(i);
-		}
+	    if (class_marks.get(*p) == CLASS_STOCH) {
+		class_marks.set(*p, CLASS_SAMPLED);
 	    }
 	}
 	/* 
@@ -167,7 +223,7 @@ void GraphView::classifyChildren(vector<StochasticNode *> const &nodes,
     }
     else {
 	for (p = nodes.begin(); p != nodes.end(); ++p) {
-	    if (sset.count(*p)) {
+	    if (class_marks.get(*p) == CLASS_STOCH) {
 		throw logic_error("Invalid multilevel GraphView");
 	    }
 	}
@@ -175,36 +231,215 @@ void GraphView::classifyChildren(vector<StochasticNode *> const &nodes,
     }
 
     stoch_nodes.clear();
-    for (list<StochasticNode *>::const_iterator i = slist.begin();
+    for (vector<StochasticNode *>::const_iterator i = slist.begin();
          i != slist.end(); ++i)
     {
-	stoch_nodes.push_back(*i);
+	if (class_marks.get(*i) != CLASS_SAMPLED) {
+	    stoch_nodes.push_back(*i);
+	}
     }
 
-    dtrm_nodes.clear();
     // Deterministic nodes are pushed onto dtrm_nodes in reverse order
-    for (list<DeterministicNode *>::reverse_iterator i = dlist.rbegin();
-         i != dlist.rend(); ++i)
-    {
-	dtrm_nodes.push_back(*i);
+    dtrm_nodes.assign(dlist.rbegin(), dlist.rend());
+}
+
+void GraphView::makeChildTables()
+{
+    unsigned int nchain = _nodes.empty() ? 0 : _nodes[0]->nchain();
+    unsigned int N = _stoch_children.size();
+
+    unsigned int maxpar = 0;
+    _child_lengths.resize(N);
+    for (unsigned int i = 0; i < N; ++i) {
+	_child_lengths[i] = _stoch_children[i]->length();
+	maxpar = max(maxpar, 
+		     static_cast<unsigned int>(_stoch_children[i]->parents().size()));
+    }
+
+    _null_params.assign(N, 0);
+    _child_values.assign(nchain, vector<double const *>(N));
+    _child_params.assign(nchain, vector<vector<double const *> >(maxpar));
+    for (unsigned int ch = 0; ch < nchain; ++ch) {
+	for (unsigned int k = 0; k < maxpar; ++k) {
+	    _child_params[ch][k].assign(N, 0);
+	}
+	for (unsigned int i = 0; i < N; ++i) {
+	    StochasticNode const *child = _stoch_children[i];
+	    _child_values[ch][i] = child->value(ch);
+	    vector<double const *> const &par = child->parameters(ch);
+	    for (unsigned int k = 0; k < par.size(); ++k) {
+		_child_params[ch][k][i] = par[k];
+	    }
+	}
     }
 
+    for (unsigned int i = 0; i < N; ++i) {
+	if (hasIndexOnlyParent(_stoch_children[i])) {
+	    _index_only_children.push_back(i);
+	}
+    }
+}
+
+/*
+  Untruncated scalar stochastic children that share a distribution
+  are put in a group, so that their log densities can be calculated
+  with a single call to ScalarDist::logDensitySum. Each group holds
+  packed arrays of pointers to the values and parameters of its
+  members.  Groups are kept in order of first appearance among the
+  children, so that the order of summation does not depend on the
+  values of pointers. The log likelihood is therefore reproducible,
+  but it is not bitwise identical to a node-by-node sum over the
+  children.
+*/
+void GraphView::groupChildren()
+{
+    unsigned int nchain = _child_values.size();
+    
+    map<ScalarDist const *, unsigned int> index;
+    vector<ChildGroup> groups;
+    vector<vector<unsigned int> > members;
+    for (unsigned int i = 0; i < _stoch_children.size(); ++i) {
+	StochasticNode const *snode = _stoch_children[i];
+	ScalarDist const *dist =
+	    dynamic_cast<ScalarDist const *>(snode->distribution());
+	if (!dist || dist->npar() == 0 || isBounded(snode) ||
+	    hasIndexOnlyParent(snode))
+	{
+	    //The parameters of children of index-only mixture nodes
+	    //move, so they cannot be packed
+	    _other_children.push_back(snode);
+	    continue;
+	}
+	map<ScalarDist const *, unsigned int>::const_iterator j =
+	    index.find(dist);
+	if (j == index.end()) {
+	    index[dist] = groups.size();
+	    groups.push_back(ChildGroup());
+	    groups.back().dist = dist;
+	    members.push_back(vector<unsigned int>(1, i));
+	}
+	else {
+	    members[j->second].push_back(i);
+	}
+    }
+
+    //A group with a single member gains nothing
+    unsigned int xlength = 0;
+    for (unsigned int g = 0; g < groups.size(); ++g) {
+	vector<unsigned int> const &m = members[g];
+	if (m.size() == 1) {
+	    _other_children.push_back(_stoch_children[m[0]]);
+	    continue;
+	}
+	ChildGroup &group = groups[g];
+	group.members = m;
+	unsigned int np = group.dist->npar();
+	group.values.resize(nchain);
+	group.params.resize(nchain);
+	for (unsigned int ch = 0; ch < nchain; ++ch) {
+	    group.values[ch].resize(m.size());
+	    group.params[ch].resize(m.size() * np);
+	    for (unsigned int i = 0; i < m.size(); ++i) {
+		group.values[ch][i] = _child_values[ch][m[i]];
+		for (unsigned int k = 0; k < np; ++k) {
+		    group.params[ch][i * np + k] = _child_params[ch][k][m[i]];
+		}
+	    }
+	}
+	_child_groups.push_back(group);
+	xlength = max(xlength, static_cast<unsigned int>(m.size()));
+    }
+
+    _xbuffer.assign(nchain, vector<double>(xlength));
+}
+
+double GraphView::groupLogDensity(ChildGroup const &group,
+				  unsigned int chain) const
+{
+    double *x = _xbuffer[chain].data();
+    vector<double const *> const &values = group.values[chain];
+    unsigned int n = values.size();
+    for (unsigned int i = 0; i < n; ++i) {
+	x[i] = *values[i];
+    }
+    return group.dist->logDensitySum(x, group.params[chain].data(), n,
+				     PDF_LIKELIHOOD);
+}
+
+double GraphView::sumLogLikelihood(unsigned int chain) const
+{
+    double llik = 0.0;
+
+    vector<ChildGroup>::const_iterator g = _child_groups.begin();
+    for ( ; g != _child_groups.end(); ++g) {
+	llik += groupLogDensity(*g, chain);
+    }
+
+    vector<StochasticNode const *>::const_iterator q = _other_children.begin();
+    for ( ; q != _other_children.end(); ++q) {
+	llik += (*q)->logDensity(chain, PDF_LIKELIHOOD);
+    }
+
+    return llik;
+}
+
+void GraphView::sumTerms(unsigned int chain, double &lprior,
+			 double &llike) const
+{
+    /*
+      Recalculates the terms that are out of date, then adds up all
+      terms in the same order as a full evaluation, so that the
+      result does not depend on whether incremental mode is used.
+    */
+    PDFType pdf_prior = _multilevel ? PDF_FULL : PDF_PRIOR;
+    vector<double> &terms = _terms[chain];
+    vector<bool> &dirty = _dirty[chain];
+
+    unsigned int t = 0;
+    lprior = 0.0;
+    for (unsigned int i = 0; i < _nodes.size(); ++i, ++t) {
+	if (dirty[t]) {
+	    terms[t] = _nodes[i]->logDensity(chain, pdf_prior);
+	    dirty[t] = false;
+	    ++_nevaluations[chain];
+	}
+	lprior += terms[t];
+    }
+
+    llike = 0.0;
+    for (unsigned int g = 0; g < _child_groups.size(); ++g, ++t) {
+	if (dirty[t]) {
+	    terms[t] = groupLogDensity(_child_groups[g], chain);
+	    dirty[t] = false;
+	    _nevaluations[chain] += _child_groups[g].members.size();
+	}
+	llike += terms[t];
+    }
+    for (unsigned int i = 0; i < _other_children.size(); ++i, ++t) {
+	if (dirty[t]) {
+	    terms[t] = _other_children[i]->logDensity(chain, PDF_LIKELIHOOD);
+	    dirty[t] = false;
+	    ++_nevaluations[chain];
+	}
+	llike += terms[t];
+    }
 }
 
 double GraphView::logFullConditional(unsigned int chain) const
 {
     PDFType pdf_prior = _multilevel ? PDF_FULL : PDF_PRIOR;
 
-    double lprior = 0.0;
-    vector<StochasticNode*>::const_iterator p = _nodes.begin();
-    for (; p != _nodes.end(); ++p) {
-	lprior += (*p)->logDensity(chain, pdf_prior);
+    double lprior = 0.0, llike = 0.0;
+    vector<StochasticNode*>::const_iterator p;
+    if (_incremental) {
+	sumTerms(chain, lprior, llike);
     }
-  
-    double llike = 0.0;
-    vector<StochasticNode *>::const_iterator q = _stoch_children.begin();
-    for (; q != _stoch_children.end(); ++q) {
-	llike += (*q)->logDensity(chain, PDF_LIKELIHOOD);
+    else {
+	_nevaluations[chain] += _nodes.size() + _stoch_children.size();
+	for (p = _nodes.begin(); p != _nodes.end(); ++p) {
+	    lprior += (*p)->logDensity(chain, pdf_prior);
+	}
+	llike = sumLogLikelihood(chain);
     }
 
     double lfc = lprior + llike;
@@ -237,6 +472,7 @@ double GraphView::logFullConditional(unsigned int chain) const
 	}
 
 	//Check likelihood
+	vector<StochasticNode*>::const_iterator q;
 	for (q = _stoch_children.begin(); q != _stoch_children.end(); ++q) {
 	    if (jags_isnan((*q)->logDensity(chain, PDF_LIKELIHOOD))) {
 		throw NodeError(*q, "Failure to calculate log density");
@@ -285,15 +521,11 @@ double GraphView::logPrior(unsigned int chain) const
 
 double GraphView::logLikelihood(unsigned int chain) const
 {
-    double llik = 0.0;
-
-    vector<StochasticNode *>::const_iterator q = _stoch_children.begin();
-    for (; q != _stoch_children.end(); ++q) {
-	llik += (*q)->logDensity(chain, PDF_LIKELIHOOD);
-    }
+    double llik = sumLogLikelihood(chain);
   
     if(jags_isnan(llik)) {
 	//Try to find where the calculation went wrong
+	vector<StochasticNode*>::const_iterator q;
 	for (q = _stoch_children.begin(); q != _stoch_children.end(); ++q) {
 	    if (jags_isnan((*q)->logDensity(chain, PDF_LIKELIHOOD))) {
 		throw NodeError(*q, "Failure to calculate log likelihood");
@@ -317,6 +549,34 @@ vector<DeterministicNode*> const &GraphView::deterministicChildren() const
   return _determ_children;
 }
 
+vector<double const *> const &GraphView::childValues(unsigned int chain) const
+{
+    return _child_values[chain];
+}
+
+vector<double const *> const &
+GraphView::childParameters(unsigned int k, unsigned int chain) const
+{
+    if (k >= _child_params[chain].size()) {
+	return _null_params;
+    }
+    vector<double const *> &param = _child_params[chain][k];
+    for (unsigned int j = 0; j < _index_only_children.size(); ++j) {
+	unsigned int i = _index_only_children[j];
+	vector<double const *> const &par =
+	    _stoch_children[i]->parameters(chain);
+	if (k < par.size()) {
+	    param[i] = par[k];
+	}
+    }
+    return param;
+}
+
+vector<unsigned int> const &GraphView::childLengths() const
+{
+    return _child_lengths;
+}
+
 void GraphView::setValue(double const * value, unsigned int length,
 			 unsigned int chain) const
 {
@@ -324,6 +584,11 @@ void GraphView::setValue(double const * value, unsigned int length,
       throw logic_error("Argument length mismatch in GraphView::setValue");
     }
 
+    if (_incremental) {
+	setValueIncremental(value, chain);
+	return;
+    }
+
     for (unsigned int i = 0; i < _nodes.size(); ++i) {
 	Node *node = _nodes[i];
 	node->setValue(value, node->length(), chain);
@@ -342,6 +607,165 @@ void GraphView::setValue(vector<double> const &value, unsigned int chain) const
     setValue(&value[0], value.size(), chain);
 }
  
+/*
+  In incremental mode, the sampled nodes and the deterministic
+  children share a local index: sampled node i has index i and
+  deterministic child j has index nodes().size() + j.  The log
+  density terms are indexed in the order in which sumTerms adds them
+  up: the priors of the sampled nodes, then the groups of children,
+  then the other children.  For each local node we record the
+  deterministic children and the terms that depend directly on it.
+*/
+static void addDependent(Node const *node, unsigned int index,
+			 map<Node const *, unsigned int> const &local,
+			 vector<vector<unsigned int> > &affected)
+{
+    vector<Node const *> const &parents = node->parents();
+    for (unsigned int k = 0; k < parents.size(); ++k) {
+	map<Node const *, unsigned int>::const_iterator p =
+	    local.find(parents[k]);
+	if (p != local.end()) {
+	    affected[p->second].push_back(index);
+	}
+    }
+}
+
+void GraphView::setIncremental()
+{
+    if (_incremental) return;
+
+    unsigned int S = _nodes.size();
+    unsigned int D = _determ_children.size();
+    unsigned int G = _child_groups.size();
+
+    map<Node const *, unsigned int> local;
+    for (unsigned int i = 0; i < S; ++i) {
+	local[_nodes[i]] = i;
+    }
+    for (unsigned int j = 0; j < D; ++j) {
+	local[_determ_children[j]] = S + j;
+    }
+
+    _affected_determ.assign(S + D, vector<unsigned int>());
+    _affected_terms.assign(S + D, vector<unsigned int>());
+    for (unsigned int i = 0; i < S; ++i) {
+	_affected_terms[i].push_back(i);
+	addDependent(_nodes[i], i, local, _affected_terms);
+    }
+    for (unsigned int j = 0; j < D; ++j) {
+	addDependent(_determ_children[j], j, local, _affected_determ);
+    }
+    for (unsigned int g = 0; g < G; ++g) {
+	vector<unsigned int> const &members = _child_groups[g].members;
+	for (unsigned int m = 0; m < members.size(); ++m) {
+	    addDependent(_stoch_children[members[m]], S + g, local,
+			 _affected_terms);
+	}
+    }
+    for (unsigned int i = 0; i < _other_children.size(); ++i) {
+	addDependent(_other_children[i], S + G + i, local, _affected_terms);
+    }
+
+    //Children in a group usually share parents
+    for (unsigned int i = 0; i < S + D; ++i) {
+	vector<unsigned int> &terms = _affected_terms[i];
+	sort(terms.begin(), terms.end());
+	terms.erase(unique(terms.begin(), terms.end()), terms.end());
+	vector<unsigned int> &dnodes = _affected_determ[i];
+	sort(dnodes.begin(), dnodes.end());
+	dnodes.erase(unique(dnodes.begin(), dnodes.end()), dnodes.end());
+    }
+
+    unsigned int nchain = _nevaluations.size();
+    unsigned int nterms = S + G + _other_children.size();
+    unsigned int maxlength = 0;
+    _is_view.assign(D, false);
+    for (unsigned int j = 0; j < D; ++j) {
+	maxlength = max(maxlength, _determ_children[j]->length());
+	AggNode const *agg = dynamic_cast<AggNode const*>(_determ_children[j]);
+	MixtureNode const *mix = asMixture(_determ_children[j]);
+	_is_view[j] = (agg && agg->isView()) || (mix && mix->isIndexOnly());
+    }
+    _terms.assign(nchain, vector<double>(nterms, 0));
+    _dirty.assign(nchain, vector<bool>(nterms, true));
+    _stale.assign(nchain, vector<bool>(D, false));
+    _oldvalue.assign(nchain, vector<double>(maxlength));
+
+    _incremental = true;
+}
+
+void GraphView::markChanged(unsigned int i, unsigned int chain) const
+{
+    vector<unsigned int> const &dnodes = _affected_determ[i];
+    for (unsigned int k = 0; k < dnodes.size(); ++k) {
+	_stale[chain][dnodes[k]] = true;
+    }
+    vector<unsigned int> const &terms = _affected_terms[i];
+    for (unsigned int k = 0; k < terms.size(); ++k) {
+	_dirty[chain][terms[k]] = true;
+    }
+}
+
+void GraphView::setValueIncremental(double const *value,
+				    unsigned int chain) const
+{
+    /* 
+       A deterministic child is only recalculated if one of its
+       parents has changed.  Since they are in topological order, a
+       single pass is enough.  The deterministic children are always
+       up to date on entry, as every sampler recalculates the
+       immediate deterministic descendants of the nodes it samples.
+    */
+    unsigned int S = _nodes.size();
+    for (unsigned int i = 0; i < S; ++i) {
+	Node *node = _nodes[i];
+	unsigned int len = node->length();
+	if (!equal(value, value + len, node->value(chain))) {
+	    node->setValue(value, len, chain);
+	    markChanged(i, chain);
+	}
+	value += len;
+    }
+
+    vector<bool> &stale = _stale[chain];
+    double *old = _oldvalue[chain].data();
+    for (unsigned int j = 0; j < _determ_children.size(); ++j) {
+	if (!stale[j]) continue;
+	stale[j] = false;
+	DeterministicNode *dnode = _determ_children[j];
+	if (_is_view[j]) {
+	    //The value changes with the parents, so there is no copy
+	    //to compare with. An index-only mixture node must still
+	    //select its active parent.
+	    dnode->deterministicSample(chain);
+	    markChanged(S + j, chain);
+	    continue;
+	}
+	unsigned int len = dnode->length();
+	copy(dnode->value(chain), dnode->value(chain) + len, old);
+	dnode->deterministicSample(chain);
+	if (!equal(old, old + len, dnode->value(chain))) {
+	    markChanged(S + j, chain);
+	}
+    }
+}
+
+void GraphView::invalidate(unsigned int chain) const
+{
+    if (_incremental) {
+	fill(_dirty[chain].begin(), _dirty[chain].end(), true);
+    }
+}
+
+unsigned long GraphView::evaluations() const
+{
+    unsigned long n = 0;
+    for (unsigned int ch = 0; ch < _nevaluations.size(); ++ch) {
+	n += _nevaluations[ch];
+    }
+    return n;
+}
+
 void GraphView::getValue(vector<double> &value, unsigned int chain) const 
 {
     if (value.size() != _length) 
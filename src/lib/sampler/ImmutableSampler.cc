@@ -29,6 +29,16 @@ namespace jags {
 	}
     }
 
+    void ImmutableSampler::updateChain(unsigned int chain, RNG *rng)
+    {
+	_method->update(chain, rng);
+    }
+
+    bool ImmutableSampler::isThreadSafe() const
+    {
+	return true;
+    }
+
     bool ImmutableSampler::isAdaptive() const
     {
 	return false;
@@ -53,4 +53,18 @@ unsigned int Metropolis::length() const
     return _last_value.size();
 }
 
+void Metropolis::getState(vector<double> &state) const
+{
+    state.push_back(_adapt);
+    state.insert(state.end(), _last_value.begin(), _last_value.end());
+}
+
+void Metropolis::setState(vector<double> const &state, unsigned int &pos)
+{
+    _adapt = state[pos++] != 0;
+    for (unsigned int i = 0; i < _last_value.size(); ++i) {
+	_last_value[i] = state[pos++];
+    }
+}
+
 } //namespace jags
@@ -1,10 +1,21 @@
 #include <config.h>
 #include <sampler/MutableSampleMethod.h>
 
+using std::vector;
+
 namespace jags {
 
     MutableSampleMethod::~MutableSampleMethod()
     {
     }
 
+    void MutableSampleMethod::getState(vector<double> &state) const
+    {
+    }
+
+    void MutableSampleMethod::setState(vector<double> const &state,
+				       unsigned int &pos)
+    {
+    }
+
 } //namespace jags
@@ -32,6 +32,16 @@ namespace jags {
 	}
     }
 
+    void MutableSampler::updateChain(unsigned int chain, RNG *rng)
+    {
+	_methods[chain]->update(rng);
+    }
+
+    bool MutableSampler::isThreadSafe() const
+    {
+	return true;
+    }
+
     void MutableSampler::adaptOff()
     {
 	for (unsigned int ch = 0; ch < _methods.size(); ++ch) {
@@ -57,6 +67,29 @@ namespace jags {
 	return false;
     }
 
+    void MutableSampler::getState(unsigned int chain,
+				  vector<double> &state) const
+    {
+	state.clear();
+	_methods[chain]->getState(state);
+    }
+
+    bool MutableSampler::setState(unsigned int chain,
+				  vector<double> const &state)
+    {
+	vector<double> current;
+	_methods[chain]->getState(current);
+	if (current.size() != state.size()) {
+	    return false;
+	}
+	unsigned int pos = 0;
+	_methods[chain]->setState(state, pos);
+	if (pos != state.size()) {
+	    throw logic_error("Inconsistent state in MutableSampler::setState");
+	}
+	return true;
+    }
+
     string MutableSampler::name() const
     {
 	return _name;
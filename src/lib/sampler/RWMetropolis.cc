@@ -68,4 +68,20 @@ double RWMetropolis::logJacobian(vector<double> const &value) const
     return 0;
 }
 
+void RWMetropolis::getState(vector<double> &state) const
+{
+    Metropolis::getState(state);
+    _step_adapter.getState(state);
+    state.push_back(_pmean);
+    state.push_back(_niter);
+}
+
+void RWMetropolis::setState(vector<double> const &state, unsigned int &pos)
+{
+    Metropolis::setState(state, pos);
+    _step_adapter.setState(state, pos);
+    _pmean = state[pos++];
+    _niter = static_cast<unsigned int>(state[pos++]);
+}
+
 } //namespace jags
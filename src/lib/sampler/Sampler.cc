@@ -2,7 +2,10 @@
 #include <sampler/Sampler.h>
 #include <sampler/GraphView.h>
 
+#include <stdexcept>
+
 using std::vector;
+using std::logic_error;
 
 namespace jags {
 
@@ -21,4 +24,29 @@ vector<StochasticNode*> const &Sampler::nodes() const
     return _gv->nodes();
 }
 
+unsigned long Sampler::evaluations() const
+{
+    return _gv->evaluations();
+}
+
+void Sampler::updateChain(unsigned int chain, RNG *rng)
+{
+    throw logic_error("Sampler cannot update a single chain");
+}
+
+bool Sampler::isThreadSafe() const
+{
+    return false;
+}
+
+void Sampler::getState(unsigned int chain, vector<double> &state) const
+{
+    state.clear();
+}
+
+bool Sampler::setState(unsigned int chain, vector<double> const &state)
+{
+    return state.empty();
+}
+
 } //namespace jags
@@ -8,7 +8,7 @@ using std::list;
 namespace jags {
 
 vector<Sampler *>
-SingletonFactory::makeSamplers(list<StochasticNode*> const &nodes, 
+SingletonFactory::makeSamplers(FreeNodeSet const &nodes, 
 			       Graph const &graph) const
 {
     vector<Sampler *> samplers;
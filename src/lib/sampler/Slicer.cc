@@ -280,4 +280,20 @@ SlicerState Slicer::state() const
     return _state;
 }
 
+void Slicer::getState(vector<double> &state) const
+{
+    state.push_back(_adapt);
+    state.push_back(_width);
+    state.push_back(_sumdiff);
+    state.push_back(_iter);
+}
+
+void Slicer::setState(vector<double> const &state, unsigned int &pos)
+{
+    _adapt = state[pos++] != 0;
+    _width = state[pos++];
+    _sumdiff = state[pos++];
+    _iter = static_cast<unsigned int>(state[pos++]);
+}
+
 } //namespace jags
@@ -10,6 +10,7 @@ using std::min;
 using std::log;
 using std::exp;
 using std::logic_error;
+using std::vector;
 
 /* 
    The value _n controls the reduction in the step size when rescale is
@@ -56,4 +57,18 @@ double StepAdapter::logitDeviation(double p) const
     return logit_target - logit_p;
 }
 
+void StepAdapter::getState(vector<double> &state) const
+{
+    state.push_back(_lstep);
+    state.push_back(_p_over_target);
+    state.push_back(_n);
+}
+
+void StepAdapter::setState(vector<double> const &state, unsigned int &pos)
+{
+    _lstep = state[pos++];
+    _p_over_target = state[pos++] != 0;
+    _n = static_cast<unsigned int>(state[pos++]);
+}
+
 } //namespace jags
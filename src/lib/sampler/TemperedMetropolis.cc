@@ -7,6 +7,7 @@
 
 using std::vector;
 using std::invalid_argument;
+using std::logic_error;
 using std::log;
 using std::exp;
 using std::fabs;
@@ -14,6 +15,9 @@ using std::fabs;
 //Minimum number of iterations before we can go to the next level
 #define MIN_STEP 50
 
+//Length of the state of a StepAdapter
+#define STEP_ADAPTER_STATE 3
+
 static vector<double> makePower(int max_level, double max_temp)
 {
     vector<double> pwr(max_level + 1);
@@ -154,4 +158,47 @@ double TemperedMetropolis::logJacobian(vector<double> const &value) const
     return 0;
 }
 
+void TemperedMetropolis::getState(vector<double> &state) const
+{
+    Metropolis::getState(state);
+    state.push_back(_tmax);
+    state.push_back(_pmean);
+    state.push_back(_niter);
+    for (int t = 1; t <= _max_level; ++t) {
+	if (t < static_cast<int>(_step_adapter.size())) {
+	    _step_adapter[t]->getState(state);
+	}
+	else {
+	    state.insert(state.end(), STEP_ADAPTER_STATE, 0);
+	}
+    }
+}
+
+void TemperedMetropolis::setState(vector<double> const &state,
+				  unsigned int &pos)
+{
+    Metropolis::setState(state, pos);
+    _tmax = static_cast<int>(state[pos++]);
+    _pmean = state[pos++];
+    _niter = static_cast<unsigned int>(state[pos++]);
+    if (_tmax < 1 || _tmax > _max_level) {
+	throw logic_error("Invalid state in TemperedMetropolis");
+    }
+
+    for (unsigned int i = 1; i < _step_adapter.size(); ++i) {
+	delete _step_adapter[i];
+    }
+    _step_adapter.resize(1);
+    for (int t = 1; t <= _max_level; ++t) {
+	if (t <= _tmax) {
+	    StepAdapter *adapter = new StepAdapter(1);
+	    adapter->setState(state, pos);
+	    _step_adapter.push_back(adapter);
+	}
+	else {
+	    pos += STEP_ADAPTER_STATE;
+	}
+    }
+}
+
 } //namespace jags
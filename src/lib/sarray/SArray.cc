@@ -52,6 +52,17 @@ void SArray::setValue(vector<int> const &x)
     }
 }
 
+void SArray::setValue(double const *x, unsigned long length)
+{
+    if (length != _value.size()) {
+	throw length_error("Length mismatch error in SArray::setValue");
+    }
+    else {
+	copy(x, x + length, _value.begin());
+	_discrete = false;
+    }
+}
+
 void SArray::setValue(double value, unsigned int i)
 {
     if (i >= _range.length()) {
@@ -0,0 +1,104 @@
+#include <config.h>
+#include <util/ThreadPool.h>
+
+using std::vector;
+using std::thread;
+using std::mutex;
+using std::unique_lock;
+using std::lock_guard;
+using std::exception_ptr;
+using std::current_exception;
+using std::rethrow_exception;
+using std::function;
+
+namespace jags {
+
+    ThreadPool::ThreadPool(unsigned int nworker)
+	: _errors(nworker), _generation(0), _pending(0), _stop(false)
+    {
+	for (unsigned int i = 1; i < nworker; ++i) {
+	    _threads.push_back(thread(&ThreadPool::work, this, i));
+	}
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+	{
+	    lock_guard<mutex> lock(_mutex);
+	    _stop = true;
+	}
+	_start.notify_all();
+	for (unsigned int i = 0; i < _threads.size(); ++i) {
+	    _threads[i].join();
+	}
+    }
+
+    unsigned int ThreadPool::size() const
+    {
+	return _errors.size();
+    }
+
+    void ThreadPool::runWorker(unsigned int worker)
+    {
+	try {
+	    _job(worker);
+	}
+	catch (...) {
+	    _errors[worker] = current_exception();
+	}
+    }
+
+    void ThreadPool::work(unsigned int worker)
+    {
+	unsigned int generation = 0;
+	unique_lock<mutex> lock(_mutex);
+	while (true) {
+	    while (!_stop && _generation == generation) {
+		_start.wait(lock);
+	    }
+	    if (_stop) return;
+	    generation = _generation;
+	    lock.unlock();
+
+	    runWorker(worker);
+
+	    lock.lock();
+	    if (--_pending == 0) {
+		_done.notify_one();
+	    }
+	}
+    }
+
+    void ThreadPool::run(function<void(unsigned int)> const &job)
+    {
+	{
+	    lock_guard<mutex> lock(_mutex);
+	    _job = job;
+	    _pending = _threads.size();
+	    ++_generation;
+	}
+	_start.notify_all();
+
+	runWorker(0);
+
+	{
+	    unique_lock<mutex> lock(_mutex);
+	    while (_pending > 0) {
+		_done.wait(lock);
+	    }
+	}
+
+	// Errors from earlier jobs must not be reported by later ones
+	exception_ptr first;
+	for (unsigned int i = 0; i < _errors.size(); ++i) {
+	    if (_errors[i] && !first) {
+		first = _errors[i];
+	    }
+	    _errors[i] = exception_ptr();
+	}
+	if (first) {
+	    rethrow_exception(first);
+	}
+    }
+
+} /* namespace jags */
@@ -15,7 +15,7 @@ namespace base {
     MeanMonitor::MeanMonitor(NodeArraySubset const &subset)
 	: Monitor("mean", subset.nodes()), _subset(subset),
 	  _values(subset.nchain(), vector<double>(subset.length())),
-	  _n(0)
+	  _buffer(subset.length()), _n(0)
     {
 	
     }
@@ -24,7 +24,8 @@ namespace base {
     {
 	_n++;
 	for (unsigned int ch = 0; ch < _values.size(); ++ch) {
-	    vector<double> value = _subset.value(ch);
+	    vector<double> const &value = _buffer;
+	    _subset.getValue(_buffer.data(), ch);
 	    vector<double> &rmean  = _values[ch];
 	    for (unsigned int i = 0; i < value.size(); ++i) {
 		if (value[i] == JAGS_NA) {
@@ -57,4 +58,27 @@ namespace base {
 	return true;
     }
 
+    void MeanMonitor::getState(vector<double> &state) const
+    {
+	state.clear();
+	state.push_back(_n);
+	for (unsigned int ch = 0; ch < _values.size(); ++ch) {
+	    state.insert(state.end(), _values[ch].begin(), _values[ch].end());
+	}
+    }
+
+    bool MeanMonitor::setState(vector<double> const &state)
+    {
+	unsigned int len = _subset.length();
+	if (state.size() != 1 + _values.size() * len) {
+	    return false;
+	}
+	_n = static_cast<unsigned int>(state[0]);
+	for (unsigned int ch = 0; ch < _values.size(); ++ch) {
+	    vector<double>::const_iterator p = state.begin() + 1 + ch * len;
+	    _values[ch].assign(p, p + len);
+	}
+	return true;
+    }
+
 }}
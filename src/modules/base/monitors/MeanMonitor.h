@@ -15,6 +15,7 @@ namespace base {
     class MeanMonitor : public Monitor {
 	NodeArraySubset _subset;
 	std::vector<std::vector<double> > _values; // sampled values
+	std::vector<double> _buffer; // current value
 	unsigned int _n;
     public:
 	MeanMonitor(NodeArraySubset const &subset);
@@ -23,6 +24,8 @@ namespace base {
 	std::vector<unsigned int> dim() const;
 	bool poolChains() const;
 	bool poolIterations() const;
+	void getState(std::vector<double> &state) const;
+	bool setState(std::vector<double> const &state);
     };
 
 }}
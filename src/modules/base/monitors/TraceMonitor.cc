@@ -20,8 +20,9 @@ namespace base {
     void TraceMonitor::update()
     {
 	for (unsigned int ch = 0; ch < _values.size(); ++ch) {
-	    vector<double> v = _subset.value(ch);
-	    _values[ch].insert(_values[ch].end(), v.begin(), v.end());
+	    unsigned int n = _values[ch].size();
+	    _values[ch].resize(n + _subset.length());
+	    _subset.getValue(_values[ch].data() + n, ch);
 	}
     }
 
@@ -45,4 +46,26 @@ namespace base {
 	return false;
     }
 
+    void TraceMonitor::getState(vector<double> &state) const
+    {
+	state.clear();
+	for (unsigned int ch = 0; ch < _values.size(); ++ch) {
+	    state.insert(state.end(), _values[ch].begin(), _values[ch].end());
+	}
+    }
+
+    bool TraceMonitor::setState(vector<double> const &state)
+    {
+	unsigned int nchain = _values.size();
+	if (state.size() % (nchain * _subset.length()) != 0) {
+	    return false;
+	}
+	unsigned int n = state.size() / nchain;
+	for (unsigned int ch = 0; ch < nchain; ++ch) {
+	    _values[ch].assign(state.begin() + ch * n,
+			       state.begin() + (ch + 1) * n);
+	}
+	return true;
+    }
+
 }}
@@ -22,6 +22,8 @@ namespace jags {
 	    std::vector<unsigned int> dim() const;
 	    bool poolChains() const;
 	    bool poolIterations() const;
+	    void getState(std::vector<double> &state) const;
+	    bool setState(std::vector<double> const &state);
 	};
 	
     }
@@ -1,14 +1,17 @@
 #include "TraceMonitorFactory.h"
 #include "TraceMonitor.h"
+#include "TraceSpillMonitor.h"
 
 #include <model/BUGSModel.h>
 #include <graph/Graph.h>
 #include <graph/Node.h>
 #include <sarray/RangeIterator.h>
 
-using std::set;
+#include <stdexcept>
+
 using std::string;
 using std::vector;
+using std::runtime_error;
 
 namespace jags {
 namespace base {
@@ -19,7 +22,7 @@ namespace base {
 					     string const &type,
 					     string &msg)
     {
-	if (type != "trace")
+	if (type != "trace" && type != "trace_spill")
 	    return 0;
 
 	NodeArray *array = model->symtab().getVariable(name);
@@ -28,7 +31,19 @@ namespace base {
 	    return 0;
 	}
 
-	TraceMonitor *m = new TraceMonitor(NodeArraySubset(array, range));
+	Monitor *m = 0;
+	if (type == "trace") {
+	    m = new TraceMonitor(NodeArraySubset(array, range));
+	}
+	else {
+	    try {
+		m = new TraceSpillMonitor(NodeArraySubset(array, range));
+	    }
+	    catch (runtime_error const &except) {
+		msg = except.what();
+		return 0;
+	    }
+	}
 	
 	//Set name attributes 
 	m->setName(name + print(range));
@@ -0,0 +1,187 @@
+#include <config.h>
+#include <graph/Node.h>
+
+#include <stdexcept>
+#include <algorithm>
+
+#include "TraceSpillMonitor.h"
+
+using std::vector;
+using std::runtime_error;
+using std::logic_error;
+using std::min;
+using std::FILE;
+using std::size_t;
+
+/* Number of values held in memory for each chain before spilling */
+static const unsigned int SPILL_BLOCK_SIZE = 65536;
+
+namespace jags {
+namespace base {
+
+    TraceSpillMonitor::TraceSpillMonitor(NodeArraySubset const &subset)
+	: Monitor("trace_spill", subset.nodes()), _subset(subset),
+	  _block(1), _ring(subset.nchain()), _nspilled(subset.nchain(), 0),
+	  _values(subset.nchain()), _loaded(subset.nchain(), false)
+    {
+	unsigned int len = _subset.length();
+	if (len > 0 && len < SPILL_BLOCK_SIZE) {
+	    _block = SPILL_BLOCK_SIZE / len;
+	}
+	for (unsigned int ch = 0; ch < _ring.size(); ++ch) {
+	    _ring[ch].reserve(_block * len);
+	    FILE *file = std::tmpfile();
+	    if (!file) {
+		for (unsigned int i = 0; i < _spill.size(); ++i) {
+		    std::fclose(_spill[i]);
+		}
+		throw runtime_error("Failed to create temporary file for monitor");
+	    }
+	    _spill.push_back(file);
+	}
+    }
+
+    TraceSpillMonitor::~TraceSpillMonitor()
+    {
+	for (unsigned int ch = 0; ch < _spill.size(); ++ch) {
+	    std::fclose(_spill[ch]);
+	}
+    }
+
+    void TraceSpillMonitor::spill(unsigned int ch)
+    {
+	vector<double> &ring = _ring[ch];
+	if (ring.empty()) return;
+
+	if (std::fseek(_spill[ch], 0, SEEK_END) != 0 ||
+	    std::fwrite(&ring[0], sizeof(double), ring.size(), _spill[ch])
+	    != ring.size())
+	{
+	    throw runtime_error("Failed to write monitor values to disk");
+	}
+	_nspilled[ch] += ring.size();
+	ring.clear();
+    }
+
+    void TraceSpillMonitor::update()
+    {
+	for (unsigned int ch = 0; ch < _ring.size(); ++ch) {
+	    if (_loaded[ch]) {
+		//Release the copy made by value()
+		vector<double>().swap(_values[ch]);
+		_loaded[ch] = false;
+	    }
+	    unsigned int n = _ring[ch].size();
+	    _ring[ch].resize(n + _subset.length());
+	    _subset.getValue(_ring[ch].data() + n, ch);
+	    if (_ring[ch].size() >= _block * _subset.length()) {
+		spill(ch);
+	    }
+	}
+    }
+
+    vector<double> const &TraceSpillMonitor::value(unsigned int chain) const
+    {
+	if (!_loaded[chain]) {
+	    vector<double> &ans = _values[chain];
+	    vector<double> const &ring = _ring[chain];
+	    size_t n = _nspilled[chain];
+	    ans.resize(n + ring.size());
+	    if (n > 0) {
+		FILE *file = _spill[chain];
+		if (std::fflush(file) != 0 || std::fseek(file, 0, SEEK_SET) != 0
+		    || std::fread(&ans[0], sizeof(double), n, file) != n)
+		{
+		    throw runtime_error("Failed to read monitor values from disk");
+		}
+	    }
+	    std::copy(ring.begin(), ring.end(), ans.begin() + n);
+	    _loaded[chain] = true;
+	}
+	return _values[chain];
+    }
+
+    void TraceSpillMonitor::getValue(double *x, unsigned int chain,
+				     unsigned long offset, unsigned int n) const
+    {
+	if (_loaded[chain]) {
+	    Monitor::getValue(x, chain, offset, n);
+	    return;
+	}
+
+	vector<double> const &ring = _ring[chain];
+	size_t nspilled = _nspilled[chain];
+	if (offset + n > nspilled + ring.size()) {
+	    throw logic_error("Invalid range in TraceSpillMonitor::getValue");
+	}
+	if (offset < nspilled) {
+	    size_t m = min(static_cast<size_t>(n), nspilled - offset);
+	    FILE *file = _spill[chain];
+	    if (std::fflush(file) != 0 ||
+		std::fseek(file, offset * sizeof(double), SEEK_SET) != 0 ||
+		std::fread(x, sizeof(double), m, file) != m)
+	    {
+		throw runtime_error("Failed to read monitor values from disk");
+	    }
+	    x += m;
+	    offset += m;
+	    n -= m;
+	}
+	std::copy(ring.begin() + (offset - nspilled),
+		  ring.begin() + (offset - nspilled + n), x);
+    }
+
+    vector<unsigned int> TraceSpillMonitor::dim() const
+    {
+	return _subset.dim();
+    }
+
+    bool TraceSpillMonitor::poolChains() const
+    {
+	return false;
+    }
+
+    bool TraceSpillMonitor::poolIterations() const
+    {
+	return false;
+    }
+
+    void TraceSpillMonitor::getState(vector<double> &state) const
+    {
+	state.clear();
+	for (unsigned int ch = 0; ch < _ring.size(); ++ch) {
+	    size_t pos = state.size();
+	    size_t n = _nspilled[ch] + _ring[ch].size();
+	    state.resize(pos + n);
+	    if (n > 0) {
+		getValue(&state[pos], ch, 0, n);
+	    }
+	}
+    }
+
+    bool TraceSpillMonitor::setState(vector<double> const &state)
+    {
+	unsigned int nchain = _ring.size();
+	if (state.size() % (nchain * _subset.length()) != 0) {
+	    return false;
+	}
+	size_t n = state.size() / nchain;
+	for (unsigned int ch = 0; ch < nchain; ++ch) {
+	    FILE *file = std::tmpfile();
+	    if (!file) {
+		throw runtime_error("Failed to create temporary file "
+				    "for monitor");
+	    }
+	    std::fclose(_spill[ch]);
+	    _spill[ch] = file;
+	    _nspilled[ch] = 0;
+	    _ring[ch].assign(state.begin() + ch * n,
+			     state.begin() + (ch + 1) * n);
+	    spill(ch);
+	    vector<double>().swap(_values[ch]);
+	    _loaded[ch] = false;
+	}
+	return true;
+    }
+
+}}
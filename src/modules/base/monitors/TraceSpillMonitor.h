@@ -0,0 +1,68 @@
+#ifndef TRACE_SPILL_MONITOR_H_
+#define TRACE_SPILL_MONITOR_H_
+
+#include <model/Monitor.h>
+#include <model/NodeArraySubset.h>
+
+#include <vector>
+#include <cstdio>
+
+namespace jags {
+    namespace base {
+
+	/**
+	 * @short Stores sampled values of a given Node on disk
+	 *
+	 * A TraceSpillMonitor records the same values as a TraceMonitor,
+	 * but holds at most one block of iterations in memory for each
+	 * chain. When the block is full, it is appended to a temporary
+	 * file, so the memory used by the monitor does not grow with the
+	 * length of the run. The temporary files are deleted when the
+	 * monitor is destroyed.
+	 *
+	 * The full trace is read back from disk when the value member
+	 * function is called.  The copy is kept until the next update.
+	 * The getValue member function reads only the requested values.
+	 */
+	class TraceSpillMonitor : public Monitor {
+	    NodeArraySubset _subset;
+	    unsigned int _block; // length of a block
+	    std::vector<std::vector<double> > _ring; // unwritten values
+	    std::vector<std::FILE*> _spill; // temporary files
+	    std::vector<std::size_t> _nspilled; // number of values on disk
+	    mutable std::vector<std::vector<double> > _values;
+	    mutable std::vector<bool> _loaded;
+	    void spill(unsigned int chain);
+	    /* forbid copying */
+	    TraceSpillMonitor(TraceSpillMonitor const &);
+	    TraceSpillMonitor &operator=(TraceSpillMonitor const &);
+	  public:
+	    /**
+	     * Creates a temporary file for each chain. A runtime_error
+	     * is thrown if a file cannot be created.
+	     */
+	    TraceSpillMonitor(NodeArraySubset const &subset);
+	    ~TraceSpillMonitor();
+	    void update();
+	    std::vector<double> const &value(unsigned int chain) const;
+	    void getValue(double *x, unsigned int chain,
+			  unsigned long offset, unsigned int n) const;
+	    std::vector<unsigned int> dim() const;
+	    bool poolChains() const;
+	    bool poolIterations() const;
+	    /**
+	     * The state is the full trace of each chain, which is
+	     * read back from disk without keeping a copy.
+	     */
+	    void getState(std::vector<double> &state) const;
+	    /**
+	     * Replaces the temporary files with new ones holding the
+	     * restored trace.
+	     */
+	    bool setState(std::vector<double> const &state);
+	};
+
+    }
+}
+
+#endif /* TRACE_SPILL_MONITOR_H_ */
@@ -17,7 +17,7 @@ namespace base {
 	  _means(subset.nchain(), vector<double>(subset.length())),
 	  _mms(subset.nchain(), vector<double>(subset.length())),
 	  _variances(subset.nchain(), vector<double>(subset.length())),
-	  _n(0)
+	  _buffer(subset.length()), _n(0)
     {
     }
     
@@ -25,7 +25,8 @@ namespace base {
     {
 	_n++;
 	for (unsigned int ch = 0; ch < _means.size(); ++ch) {
-	    vector<double> value = _subset.value(ch);
+	    vector<double> const &value = _buffer;
+	    _subset.getValue(_buffer.data(), ch);
 	    vector<double> &rmean  = _means[ch];
 	    vector<double> &rmm  = _mms[ch];
 		vector<double> &rvar  = _variances[ch];		
@@ -78,4 +79,34 @@ namespace base {
 	return true;
     }
 	
+
+    void VarianceMonitor::getState(vector<double> &state) const
+    {
+	state.clear();
+	state.push_back(_n);
+	for (unsigned int ch = 0; ch < _means.size(); ++ch) {
+	    state.insert(state.end(), _means[ch].begin(), _means[ch].end());
+	    state.insert(state.end(), _mms[ch].begin(), _mms[ch].end());
+	    state.insert(state.end(), _variances[ch].begin(),
+			 _variances[ch].end());
+	}
+    }
+
+    bool VarianceMonitor::setState(vector<double> const &state)
+    {
+	unsigned int len = _subset.length();
+	if (state.size() != 1 + 3 * _means.size() * len) {
+	    return false;
+	}
+	_n = static_cast<unsigned int>(state[0]);
+	vector<double>::const_iterator p = state.begin() + 1;
+	for (unsigned int ch = 0; ch < _means.size(); ++ch) {
+	    _means[ch].assign(p, p + len);
+	    _mms[ch].assign(p + len, p + 2 * len);
+	    _variances[ch].assign(p + 2 * len, p + 3 * len);
+	    p += 3 * len;
+	}
+	return true;
+    }
+
 }}
@@ -17,6 +17,7 @@ namespace base {
 	std::vector<std::vector<double> > _means;
 	std::vector<std::vector<double> > _mms;
 	std::vector<std::vector<double> > _variances;
+	std::vector<double> _buffer;
 	unsigned int _n;
 	
     public:
@@ -26,6 +27,8 @@ namespace base {
 	std::vector<unsigned int> dim() const;
 	bool poolChains() const;
 	bool poolIterations() const;
+	void getState(std::vector<double> &state) const;
+	bool setState(std::vector<double> const &state);
 	};
 
 }}
@@ -6,7 +6,6 @@
 #include <graph/Node.h>
 #include <sarray/RangeIterator.h>
 
-using std::set;
 using std::string;
 using std::vector;
 
@@ -0,0 +1,149 @@
+#include "testbasemon.h"
+
+#include "TraceMonitor.h"
+#include "TraceSpillMonitor.h"
+
+#include <graph/ConstantNode.h>
+#include <model/Model.h>
+#include <model/NodeArray.h>
+#include <model/NodeArraySubset.h>
+#include <sarray/SimpleRange.h>
+
+#include <vector>
+#include <stdexcept>
+
+using std::vector;
+using jags::ConstantNode;
+using jags::NodeArray;
+using jags::NodeArraySubset;
+using jags::Range;
+using jags::SimpleRange;
+using jags::base::TraceMonitor;
+using jags::base::TraceSpillMonitor;
+
+/*
+  The monitored node has length 1000, so a TraceSpillMonitor holds 65
+  iterations in memory before it writes them to disk
+*/
+static const unsigned int LENGTH = 1000;
+static const unsigned int NCHAIN = 2;
+
+/* Value of element i of the node in the given iteration and chain */
+static double testValue(unsigned int iter, unsigned int ch, unsigned int i)
+{
+    return iter * 10000.0 + ch * LENGTH + i + 0.25;
+}
+
+static void setIteration(ConstantNode &node, unsigned int iter)
+{
+    vector<double> x(LENGTH);
+    for (unsigned int ch = 0; ch < NCHAIN; ++ch) {
+	for (unsigned int i = 0; i < LENGTH; ++i) {
+	    x[i] = testValue(iter, ch, i);
+	}
+	node.setValue(&x[0], LENGTH, ch);
+    }
+}
+
+/* Checks the values of a monitor after the given number of iterations */
+static void checkTrace(jags::Monitor const &monitor, unsigned int niter)
+{
+    for (unsigned int ch = 0; ch < NCHAIN; ++ch) {
+	//Read one iteration at a time, as CODAStream does
+	vector<double> x(LENGTH);
+	for (unsigned int iter = 0; iter < niter; ++iter) {
+	    monitor.getValue(&x[0], ch, iter * LENGTH, LENGTH);
+	    for (unsigned int i = 0; i < LENGTH; ++i) {
+		CPPUNIT_ASSERT_EQUAL(testValue(iter, ch, i), x[i]);
+	    }
+	}
+
+	vector<double> const &v = monitor.value(ch);
+	CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(niter * LENGTH), v.size());
+	for (unsigned int iter = 0; iter < niter; ++iter) {
+	    for (unsigned int i = 0; i < LENGTH; ++i) {
+		CPPUNIT_ASSERT_EQUAL(testValue(iter, ch, i),
+				     v[iter * LENGTH + i]);
+	    }
+	}
+    }
+}
+
+void BaseMonitorTest::spill()
+{
+    vector<unsigned int> dim(1, LENGTH);
+    jags::Model model(NCHAIN);
+    ConstantNode *node =
+	new ConstantNode(dim, vector<double>(LENGTH, 0), NCHAIN, false);
+    model.addNode(node);
+    NodeArray array("x", dim, NCHAIN);
+    array.insert(node, SimpleRange(dim));
+    NodeArraySubset subset(&array, Range());
+
+    TraceSpillMonitor spill(subset);
+    TraceMonitor trace(subset);
+
+    //Check the trace before the first block is written, exactly at
+    //the end of a block, and with part of a block in memory
+    unsigned int niter = 0;
+    static const unsigned int checks[] = {10, 65, 200, 260};
+    for (unsigned int k = 0; k < 4; ++k) {
+	for (; niter < checks[k]; ++niter) {
+	    setIteration(*node, niter);
+	    spill.update();
+	    trace.update();
+	}
+	checkTrace(spill, niter);
+	for (unsigned int ch = 0; ch < NCHAIN; ++ch) {
+	    CPPUNIT_ASSERT(spill.value(ch) == trace.value(ch));
+	}
+    }
+
+    //A range that starts on disk and ends in memory
+    vector<double> x(10);
+    spill.getValue(&x[0], 1, 255 * LENGTH - 5, 10);
+    for (unsigned int i = 0; i < 5; ++i) {
+	CPPUNIT_ASSERT_EQUAL(testValue(254, 1, LENGTH - 5 + i), x[i]);
+	CPPUNIT_ASSERT_EQUAL(testValue(255, 1, i), x[i + 5]);
+    }
+
+    CPPUNIT_ASSERT_THROW(spill.getValue(&x[0], 0, niter * LENGTH - 5, 10),
+			 std::logic_error);
+}
+
+void BaseMonitorTest::spillstate()
+{
+    vector<unsigned int> dim(1, LENGTH);
+    jags::Model model(NCHAIN);
+    ConstantNode *node =
+	new ConstantNode(dim, vector<double>(LENGTH, 0), NCHAIN, false);
+    model.addNode(node);
+    NodeArray array("x", dim, NCHAIN);
+    array.insert(node, SimpleRange(dim));
+    NodeArraySubset subset(&array, Range());
+
+    TraceSpillMonitor spill1(subset);
+    unsigned int niter = 0;
+    for (; niter < 100; ++niter) {
+	setIteration(*node, niter);
+	spill1.update();
+    }
+
+    //A restored monitor holds the same trace and can be extended
+    vector<double> state;
+    spill1.getState(state);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(NCHAIN * niter * LENGTH),
+			 state.size());
+
+    TraceSpillMonitor spill2(subset);
+    CPPUNIT_ASSERT(spill2.setState(state));
+    checkTrace(spill2, niter);
+    for (; niter < 150; ++niter) {
+	setIteration(*node, niter);
+	spill2.update();
+    }
+    checkTrace(spill2, niter);
+
+    state.pop_back();
+    CPPUNIT_ASSERT(!spill2.setState(state));
+}
@@ -0,0 +1,18 @@
+#ifndef BASE_MONITOR_TEST_H
+#define BASE_MONITOR_TEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class BaseMonitorTest : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE( BaseMonitorTest );
+    CPPUNIT_TEST( spill );
+    CPPUNIT_TEST( spillstate );
+    CPPUNIT_TEST_SUITE_END();
+
+  public:
+    void spill();
+    void spillstate();
+};
+
+#endif  // BASE_MONITOR_TEST_H
@@ -76,43 +76,102 @@ namespace base {
    (seed_array[0]&UPPER_MASK), seed_array[1], ..., seed_array[N-1]
    can take any values except all zeros.                             */
 
-    double MersenneTwisterRNG::uniform()
+    void MersenneTwisterRNG::MT_nextblock()
     {
+	/* generate N words at one time */
 	unsigned int y;
 	static const unsigned int mag01[2]={0x0, MATRIX_A};
 	/* mag01[x] = x * MATRIX_A  for x=0,1 */
-  
-	mti = dummy[0];
-
-	if (mti >= N) { /* generate N words at one time */
-	    int kk;
-
-	    if (mti == N+1)   /* if init() has not been called, */
-		MT_sgenrand(4357); /* a default initial seed is used   */
+	int kk;
 
-	    for (kk = 0; kk < N - M; kk++) {
-		y = (mt[kk] & UPPER_MASK) | (mt[kk+1] & LOWER_MASK);
-		mt[kk] = mt[kk+M] ^ (y >> 1) ^ mag01[y & 0x1];
-	    }
-	    for (; kk < N - 1; kk++) {
-		y = (mt[kk] & UPPER_MASK) | (mt[kk+1] & LOWER_MASK);
-		mt[kk] = mt[kk+(M-N)] ^ (y >> 1) ^ mag01[y & 0x1];
-	    }
-	    y = (mt[N-1] & UPPER_MASK) | (mt[0] & LOWER_MASK);
-	    mt[N-1] = mt[M-1] ^ (y >> 1) ^ mag01[y & 0x1];
+	if (mti == N+1)   /* if init() has not been called, */
+	    MT_sgenrand(4357); /* a default initial seed is used   */
 
-	    mti = 0;
+	for (kk = 0; kk < N - M; kk++) {
+	    y = (mt[kk] & UPPER_MASK) | (mt[kk+1] & LOWER_MASK);
+	    mt[kk] = mt[kk+M] ^ (y >> 1) ^ mag01[y & 0x1];
+	}
+	for (; kk < N - 1; kk++) {
+	    y = (mt[kk] & UPPER_MASK) | (mt[kk+1] & LOWER_MASK);
+	    mt[kk] = mt[kk+(M-N)] ^ (y >> 1) ^ mag01[y & 0x1];
 	}
+	y = (mt[N-1] & UPPER_MASK) | (mt[0] & LOWER_MASK);
+	mt[N-1] = mt[M-1] ^ (y >> 1) ^ mag01[y & 0x1];
+
+	mti = 0;
+    }
 
-	y = mt[mti++];
+    /* 
+       Converts a word from the state vector to a real number in (0,1).
+       This is equivalent to calling RNG::fixup, but is inlined so that
+       the loop in the bulk uniform function can be vectorized.
+    */
+    static inline double temper(unsigned int y)
+    {
 	y ^= TEMPERING_SHIFT_U(y);
 	y ^= TEMPERING_SHIFT_S(y) & TEMPERING_MASK_B;
 	y ^= TEMPERING_SHIFT_T(y) & TEMPERING_MASK_C;
 	y ^= TEMPERING_SHIFT_L(y);
-	dummy[0] = mti;
 
 	/* reals: [0,1)-interval */
-	return fixup( (double)y * 2.3283064365386963e-10 ); 
+	double x = (double)y * 2.3283064365386963e-10;
+	/* ensure 0 is never returned */
+	return x <= 0.0 ? 0.5 * 2.328306437080797e-10 : x;
+    }
+
+    inline double MersenneTwisterRNG::MT_genrand()
+    {
+	mti = dummy[0];
+
+	if (mti >= N) {
+	    MT_nextblock();
+	}
+	double x = temper(mt[mti++]);
+	dummy[0] = mti;
+
+	return x;
+    }
+
+    double MersenneTwisterRNG::uniform()
+    {
+	return MT_genrand();
+    }
+
+    void MersenneTwisterRNG::uniform(double *x, unsigned int n)
+    {
+	mti = dummy[0];
+
+	while (n > 0) {
+	    if (mti >= N) {
+		MT_nextblock();
+	    }
+	    /* Temper as many words as possible from the current block */
+	    unsigned int m = N - mti;
+	    if (m > n) m = n;
+	    unsigned int const *y = mt + mti;
+	    for (unsigned int i = 0; i < m; ++i) {
+		x[i] = temper(y[i]);
+	    }
+	    x += m;
+	    n -= m;
+	    mti += m;
+	}
+
+	dummy[0] = mti;
+    }
+
+    void MersenneTwisterRNG::normal(double *x, unsigned int n)
+    {
+	InlineUniform<MersenneTwisterRNG, &MersenneTwisterRNG::MT_genrand>
+	    unif(this);
+	RmathRNG::normal(x, n, unif);
+    }
+
+    void MersenneTwisterRNG::exponential(double *x, unsigned int n)
+    {
+	InlineUniform<MersenneTwisterRNG, &MersenneTwisterRNG::MT_genrand>
+	    unif(this);
+	RmathRNG::exponential(x, n, unif);
     }
 
     void MersenneTwisterRNG::init(unsigned int seed)
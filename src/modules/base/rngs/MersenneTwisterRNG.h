@@ -13,12 +13,17 @@ namespace base {
 	int mti;
 	void fixupSeeds(bool init);
 	void MT_sgenrand(unsigned int seed);
+	void MT_nextblock();
+	inline double MT_genrand();
     public:
 	MersenneTwisterRNG(unsigned int seed, NormKind norm_kind);
 	void init(unsigned int seed);
 	bool setState(std::vector<int> const &state);
 	void getState(std::vector<int> &state) const;
 	double uniform();
+	void uniform(double *x, unsigned int n);
+	void normal(double *x, unsigned int n);
+	void exponential(double *x, unsigned int n);
     };
 
 }}
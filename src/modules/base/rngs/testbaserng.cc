@@ -0,0 +1,59 @@
+#include "testbaserng.h"
+
+#include "MersenneTwisterRNG.h"
+#include "MarsagliaRNG.h"
+
+#include <vector>
+
+using std::vector;
+using jags::RNG;
+
+/*
+  Bulk generation must give exactly the same values as repeated calls
+  to the scalar member functions, and leave the RNG in the same state.
+  The lengths are chosen so that the Mersenne-Twister crosses the
+  boundary between blocks of 624 words part way through a call.
+*/
+static void checkBulk(RNG *rng1, RNG *rng2)
+{
+    static const unsigned int len[] = {1, 7, 600, 1000, 3};
+    for (unsigned int j = 0; j < 5; ++j) {
+	unsigned int n = len[j];
+	vector<double> x(n);
+
+	rng1->uniform(&x[0], n);
+	for (unsigned int i = 0; i < n; ++i) {
+	    CPPUNIT_ASSERT_EQUAL(rng2->uniform(), x[i]);
+	}
+	rng1->normal(&x[0], n);
+	for (unsigned int i = 0; i < n; ++i) {
+	    CPPUNIT_ASSERT_EQUAL(rng2->normal(), x[i]);
+	}
+	rng1->exponential(&x[0], n);
+	for (unsigned int i = 0; i < n; ++i) {
+	    CPPUNIT_ASSERT_EQUAL(rng2->exponential(), x[i]);
+	}
+    }
+
+    vector<int> state1, state2;
+    rng1->getState(state1);
+    rng2->getState(state2);
+    CPPUNIT_ASSERT(state1 == state2);
+}
+
+void BaseRNGTest::bulk()
+{
+    static const jags::NormKind kinds[] = 
+	{jags::AHRENS_DIETER, jags::BOX_MULLER, jags::KINDERMAN_RAMAGE};
+
+    for (unsigned int k = 0; k < 3; ++k) {
+	jags::base::MersenneTwisterRNG mt1(314159, kinds[k]);
+	jags::base::MersenneTwisterRNG mt2(314159, kinds[k]);
+	checkBulk(&mt1, &mt2);
+
+	//Default implementation in RmathRNG
+	jags::base::MarsagliaRNG ms1(314159, kinds[k]);
+	jags::base::MarsagliaRNG ms2(314159, kinds[k]);
+	checkBulk(&ms1, &ms2);
+    }
+}
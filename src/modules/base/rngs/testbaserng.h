@@ -0,0 +1,16 @@
+#ifndef BASE_RNG_TEST_H
+#define BASE_RNG_TEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class BaseRNGTest : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE( BaseRNGTest );
+    CPPUNIT_TEST( bulk );
+    CPPUNIT_TEST_SUITE_END();
+
+  public:
+    void bulk();
+};
+
+#endif  // BASE_RNG_TEST_H
@@ -58,6 +58,8 @@ namespace base {
     
     void DiscreteSlicer::update(RNG *rng)
     {
+	//Other samplers may have changed the graph since the last update
+	_gv->invalidate(_chain);
 	if (!updateDouble(rng)) {
 	    switch(state()) {
 	    case SLICER_POSINF:
@@ -79,4 +81,17 @@ namespace base {
 	return _gv->logFullConditional(_chain);
     }
 
+    void DiscreteSlicer::getState(vector<double> &state) const
+    {
+	Slicer::getState(state);
+	state.push_back(_x);
+    }
+
+    void DiscreteSlicer::setState(vector<double> const &state,
+				  unsigned int &pos)
+    {
+	Slicer::setState(state, pos);
+	_x = state[pos++];
+    }
+
 }}
@@ -39,6 +39,12 @@ namespace base {
 	void update(RNG*);
 	static bool canSample(StochasticNode const *node);
 	double logDensity() const;
+	/**
+	 * Appends the value of the auxiliary variable Y to the state
+	 * of the parent class.
+	 */
+	void getState(std::vector<double> &state) const;
+	void setState(std::vector<double> const &state, unsigned int &pos);
     };
 
 }}
@@ -54,6 +54,8 @@ namespace base {
 
     void RealSlicer::update(RNG *rng)
     {
+	//Other samplers may have changed the graph since the last update
+	_gv->invalidate(_chain);
 	if (!updateStep(rng)) {
 	    switch(state()) {
 	    case SLICER_POSINF:
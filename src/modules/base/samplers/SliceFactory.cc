@@ -34,6 +34,7 @@ namespace base {
 	vector<MutableSampleMethod*> methods(nchain, 0);
 
 	SingletonGraphView *gv = new SingletonGraphView(snode, graph);
+	gv->setIncremental();
 
 	bool discrete = snode->isDiscreteValued();
 	for (unsigned int ch = 0; ch < nchain; ++ch) {
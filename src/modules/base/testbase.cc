@@ -1,7 +1,11 @@
 #include "testbase.h"
 #include "functions/testbasefun.h"
+#include "monitors/testbasemon.h"
+#include "rngs/testbaserng.h"
 #include <cppunit/extensions/HelperMacros.h>
 
 void init_base_test() {
     CPPUNIT_TEST_SUITE_REGISTRATION( BaseFunTest );
+    CPPUNIT_TEST_SUITE_REGISTRATION( BaseMonitorTest );
+    CPPUNIT_TEST_SUITE_REGISTRATION( BaseRNGTest );
 }
@@ -40,6 +40,24 @@ double DBern::logDensity(double x, PDFType type,
     return d == 0 ? JAGS_NEGINF : log(d);
 }
 
+double DBern::logDensitySum(double const *x, double const * const *par,
+			    unsigned int n, PDFType type) const
+{
+    double ans = 0;
+    for (unsigned int i = 0; i < n; ++i) {
+	double prob = *par[i];
+	double d = 0;
+	if (prob >= 0.0 && prob <= 1.0) {
+	    if (x[i] == 1)
+		d = prob;
+	    else if (x[i] == 0)
+		d = 1 - prob;
+	}
+	ans += d == 0 ? JAGS_NEGINF : log(d);
+    }
+    return ans;
+}
+
 double DBern::randomSample(vector<double const *> const &parameters, 
 			   double const *lbound, double const *ubound,
 			   RNG *rng) const
@@ -75,4 +93,23 @@ bool DBern::isDiscreteValued(vector<bool> const &mask) const
 	}
     }
 
+    void DBern::KLBatch(double *kl, double const * const *par1,
+			double const * const *par2, unsigned int n) const
+    {
+	for (unsigned int i = 0; i < n; ++i) {
+	    double p0 = *par1[i];
+	    double p1 = *par2[i];
+	    if (p0 == 0) {
+		kl[i] = - log(1 - p1);
+	    }
+	    else if (p0 == 1) {
+		kl[i] = - log(p1);
+	    }
+	    else {
+		kl[i] = (p0 * (log(p0) - log(p1)) +
+			 (1 - p0) * (log(1 - p0) - log(1 - p1)));
+	    }
+	}
+    }
+
 }}
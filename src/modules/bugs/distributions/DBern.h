@@ -19,6 +19,8 @@ public:
     double logDensity(double x, PDFType type,
 		      std::vector<double const *> const &parameters,
 		      double const *lbound, double const *ubound) const;
+    double logDensitySum(double const *x, double const * const *par,
+			 unsigned int n, PDFType type) const;
     double randomSample(std::vector<double const *> const &parameters, 
 			double const *lbound, double const *ubound,
 			RNG *rng) const;
@@ -31,6 +33,8 @@ public:
     bool isDiscreteValued(std::vector<bool> const &mask) const;
     double KL(std::vector<double const *> const &par1, 
 	      std::vector<double const *> const &par2) const;
+    void KLBatch(double *kl, double const * const *par1,
+		 double const * const *par2, unsigned int n) const;
 };
 
 }}
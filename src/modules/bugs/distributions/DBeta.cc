@@ -46,6 +46,28 @@ DBeta::d(double x, PDFType type,
     }
 }
 
+double
+DBeta::logDensitySum(double const *x, double const * const *par,
+		     unsigned int n, PDFType type) const
+{
+    if (type == PDF_PRIOR) {
+	return RScalarDist::logDensitySum(x, par, n, type);
+    }
+
+    double ans = 0;
+    for (unsigned int i = 0; i < n; ++i) {
+	double a = *par[2*i];
+	double b = *par[2*i+1];
+	if (a > 0.0 && b > 0.0) {
+	    ans += dbeta(x[i], a, b, true);
+	}
+	else {
+	    ans += JAGS_NEGINF;
+	}
+    }
+    return ans;
+}
+
 double 
 DBeta::p(double q, vector<double const *> const &par, bool lower, bool log_p) 
   const
@@ -20,6 +20,8 @@ class DBeta : public RScalarDist {
   double d(double x, PDFType type,
 	   std::vector<double const *> const &parameters, 
 	   bool give_log) const;
+  double logDensitySum(double const *x, double const * const *par,
+		       unsigned int n, PDFType type) const;
   double p(double q, std::vector<double const *> const &parameters, bool lower,
 	   bool give_log) const;
   double q(double p, std::vector<double const *> const &parameters, bool lower,
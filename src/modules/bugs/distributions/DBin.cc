@@ -46,6 +46,23 @@ double DBin::d(double x, PDFType type, vector<double const *> const &par,
     return dbinom(x, SIZE(par), PROB(par), give_log);
 }
 
+double DBin::logDensitySum(double const *x, double const * const *par,
+			   unsigned int n, PDFType type) const
+{
+    double ans = 0;
+    for (unsigned int i = 0; i < n; ++i) {
+	double size = *par[2*i+1];
+	double prob = *par[2*i];
+	if (size >= 0 && prob >= 0.0 && prob <= 1.0) {
+	    ans += dbinom(x[i], size, prob, true);
+	}
+	else {
+	    ans += JAGS_NEGINF;
+	}
+    }
+    return ans;
+}
+
 double DBin::p(double x, vector<double const *> const &par, 
 	       bool lower, bool give_log) const
 {
@@ -105,4 +122,28 @@ double DBin::KL(vector<double const *> const &par0,
     }
 }
 
+void DBin::KLBatch(double *kl, double const * const *par1,
+		   double const * const *par2, unsigned int n) const
+{
+    for (unsigned int i = 0; i < n; ++i) {
+	double N0 = *par1[2*i+1];
+	double N1 = *par2[2*i+1];
+	double p0 = *par1[2*i];
+	double p1 = *par2[2*i];
+	if (N0 != N1) {
+	    kl[i] = JAGS_POSINF;
+	}
+	else if (p0 == 0) {
+	    kl[i] = - N0 * log(1 - p1);
+	}
+	else if (p0 == 1) {
+	    kl[i] = - N0 * log(p1);
+	}
+	else {
+	    kl[i] = (N0 * p0 * (log(p0) - log(p1)) +
+		     N0 * (1 - p0) * (log(1 - p0) - log(1 - p1)));
+	}
+    }
+}
+
 }}
@@ -20,6 +20,8 @@ class DBin : public RScalarDist {
   double d(double x, PDFType type,
 	   std::vector<double const *> const &parameters, 
 	   bool give_log) const;
+  double logDensitySum(double const *x, double const * const *par,
+		       unsigned int n, PDFType type) const;
   double p(double x, std::vector<double const *> const &parameters, bool lower,
 	   bool give_log) const;
   double q(double p, std::vector<double const *> const &parameters, bool lower,
@@ -38,6 +40,8 @@ class DBin : public RScalarDist {
   bool isSupportFixed(std::vector<bool> const &fixmask) const;
   double KL(std::vector<double const *> const &par1, 
 	    std::vector<double const *> const &par2) const;
+  void KLBatch(double *kl, double const * const *par1,
+	       double const * const *par2, unsigned int n) const;
 };
 
 }}
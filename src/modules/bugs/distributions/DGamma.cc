@@ -46,6 +46,28 @@ DGamma::d(double x, PDFType type,
     }
 }
 
+double
+DGamma::logDensitySum(double const *x, double const * const *par,
+		      unsigned int n, PDFType type) const
+{
+    if (type == PDF_PRIOR) {
+	return RScalarDist::logDensitySum(x, par, n, type);
+    }
+
+    double ans = 0;
+    for (unsigned int i = 0; i < n; ++i) {
+	double shape = *par[2*i];
+	double rate = *par[2*i+1];
+	if (shape > 0 && rate > 0) {
+	    ans += dgamma(x[i], shape, 1/rate, true);
+	}
+	else {
+	    ans += JAGS_NEGINF;
+	}
+    }
+    return ans;
+}
+
 double
 DGamma::p(double q, vector<double const *> const &par, bool lower,
 	  bool give_log) const
@@ -74,4 +96,15 @@ double DGamma::KL(vector<double const *> const &par0,
 	+ (b0 - b1) * digamma(b0) + lgammafn(b1) - lgammafn(b0);
 }
 
+void DGamma::KLBatch(double *kl, double const * const *par0,
+		     double const * const *par1, unsigned int n) const
+{
+    for (unsigned int i = 0; i < n; ++i) {
+	double b0 = *par0[2*i], b1 = *par1[2*i];
+	double r = *par1[2*i+1] / *par0[2*i+1];
+	kl[i] = (r - 1) * b0 - b1 * log(r)
+	    + (b0 - b1) * digamma(b0) + lgammafn(b1) - lgammafn(b0);
+    }
+}
+
 }}
@@ -1,4 +1,5 @@
 #include <config.h>
+#include <rng/RNG.h>
 #include <util/dim.h>
 #include <util/nainf.h>
 #include "DMNorm.h"
@@ -90,14 +91,26 @@ void DMNorm::randomsample(double *x, double const *mu, double const *T,
 
   /* Generate independent random normal variates, scaled by
      the eigen values. We reuse the array w. */
-  if (prec) {
+  bool bulk = true;
+  for (int i = 0; i < nrow; ++i) {
+      w[i] = prec ? 1/sqrt(w[i]) : sqrt(w[i]);
+      if (!jags_finite(w[i]) || w[i] <= 0) {
+	  bulk = false;
+      }
+  }
+  if (bulk) {
+      double *z = new double[nrow];
+      rng->normal(z, nrow);
       for (int i = 0; i < nrow; ++i) {
-	  w[i] = rnorm(0, 1/sqrt(w[i]), rng);
+	  w[i] *= z[i];
       }
+      delete [] z;
   }
   else {
+      /* rnorm does not draw a random variate for a degenerate
+	 scale, so it must be called for each element */
       for (int i = 0; i < nrow; ++i) {
-	  w[i] = rnorm(0, sqrt(w[i]), rng);
+	  w[i] = rnorm(0, w[i], rng);
       }
   }
 
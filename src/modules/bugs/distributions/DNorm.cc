@@ -33,6 +33,31 @@ DNorm::d(double x, PDFType type,
     return dnorm(x, MU(par), SIGMA(par), give_log);
 }
 
+double
+DNorm::logDensitySum(double const *x, double const * const *par,
+		     unsigned int n, PDFType type) const
+{
+    /* 
+       The parameters are checked in a separate pass so that the
+       summation loop has no branches. 
+    */
+    for (unsigned int i = 0; i < n; ++i) {
+	double tau = *par[2*i+1];
+	if (!(tau > 0) || !jags_finite(tau)) {
+	    return RScalarDist::logDensitySum(x, par, n, type);
+	}
+    }
+
+    double sumlogtau = 0, ssq = 0;
+    for (unsigned int i = 0; i < n; ++i) {
+	double delta = x[i] - *par[2*i];
+	double tau = *par[2*i+1];
+	ssq += tau * delta * delta;
+	sumlogtau += log(tau);
+    }
+    return (sumlogtau - ssq) / 2 - n * M_LN_SQRT_2PI;
+}
+
 double
 DNorm::p(double q, vector<double const *> const &par, bool lower, bool give_log)
   const
@@ -90,8 +115,21 @@ double DNorm::randomSample(vector<double const *> const &par,
 	double mu0 = MU(par0), tau0 = TAU(par0);
 	double mu1 = MU(par1), tau1 = TAU(par1);
 	
-	return ((mu0 - mu1) * (mu0 - mu1) * tau1 + tau1/tau0 - 1 + 
+	return ((mu0 - mu1) * (mu0 - mu1) * tau1 + tau1/tau0 - 1 +
 		log(tau0/tau1)) / 2;
     }
     
+
+    void DNorm::KLBatch(double *kl, double const * const *par0,
+			double const * const *par1, unsigned int n) const
+    {
+	//Same calculation as KL, in a loop with no branches
+	for (unsigned int i = 0; i < n; ++i) {
+	    double mu0 = *par0[2*i], tau0 = *par0[2*i+1];
+	    double mu1 = *par1[2*i], tau1 = *par1[2*i+1];
+	    kl[i] = ((mu0 - mu1) * (mu0 - mu1) * tau1 + tau1/tau0 - 1 +
+		     log(tau0/tau1)) / 2;
+	}
+    }
+
 }}
@@ -20,6 +20,8 @@ class DNorm : public RScalarDist {
   double d(double x, PDFType type,
 	   std::vector<double const *> const &parameters, 
 	   bool give_log) const;
+  double logDensitySum(double const *x, double const * const *par,
+		       unsigned int n, PDFType type) const;
   double p(double q, std::vector<double const *> const &parameters, bool lower,
 	   bool give_log) const;
   double q(double p, std::vector<double const *> const &parameters, bool lower,
@@ -39,6 +41,8 @@ class DNorm : public RScalarDist {
 		      RNG *rng) const;
   double KL(std::vector<double const *> const &par0,
 	    std::vector<double const *> const &par1) const;
+  void KLBatch(double *kl, double const * const *par0,
+	       double const * const *par1, unsigned int n) const;
 };
 
 }}
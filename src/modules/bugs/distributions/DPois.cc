@@ -48,6 +48,30 @@ DPois::d(double x, PDFType type,
     }
 }
 
+double
+DPois::logDensitySum(double const *x, double const * const *par,
+		     unsigned int n, PDFType type) const
+{
+    if (type != PDF_LIKELIHOOD) {
+	return RScalarDist::logDensitySum(x, par, n, type);
+    }
+
+    //Same calculations as d, without the normalizing constant
+    double ans = 0;
+    for (unsigned int i = 0; i < n; ++i) {
+	double lambda = *par[i];
+	if (!(lambda >= 0) || x[i] < 0 || (lambda == 0 && x[i] != 0) ||
+	    R_D_nonint(x[i]) || !jags_finite(lambda))
+	{
+	    ans += JAGS_NEGINF;
+	}
+	else if (lambda > 0) {
+	    ans += x[i] * log(lambda) - lambda;
+	}
+    }
+    return ans;
+}
+
 double
 DPois::p(double q, vector<double const *> const &par, bool lower, bool give_log)
     const
@@ -76,4 +100,14 @@ double DPois::r(vector<double const *> const &par, RNG *rng) const
 	return lambda0 * (log(lambda0) - log(lambda1)) - lambda0 + lambda1;
     }
 
+    void DPois::KLBatch(double *kl, double const * const *par0,
+			double const * const *par1, unsigned int n) const
+    {
+	for (unsigned int i = 0; i < n; ++i) {
+	    double lambda0 = *par0[i];
+	    double lambda1 = *par1[i];
+	    kl[i] = lambda0 * (log(lambda0) - log(lambda1)) - lambda0 + lambda1;
+	}
+    }
+
 }}
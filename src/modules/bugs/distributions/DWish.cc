@@ -105,9 +105,7 @@ void DWish::randomSample(double *x, int length,
     double *Z = new double[length];
     for (int j = 0; j < nrow; j++) {
 	double *Z_j = &Z[j*nrow]; //jth column of Z
-	for (int i = 0; i < j; i++) {
-	    Z_j[i] = rnorm(0, 1, rng);
-	}
+	rng->normal(Z_j, j);
 	Z_j[j] = sqrt(rchisq(k - j, rng));    
 	for (int i = j + 1; i < nrow; i++) {
 	    Z_j[i] = 0;
@@ -790,3 +790,153 @@ void BugsDistTest::dkw()
     dkwtest(_dweib, mkPar(0.3, 0.5));
 }
     
+
+void BugsDistTest::batch_scalar(ScalarDist const *dist,
+				vector<double> const &x,
+				vector<double> const &par)
+{
+    /*
+      Test the batch log density against the sum of the log densities
+      of the individual values. The vector par holds npar parameter
+      values for each element of x.
+
+      The batch calculation may add up the terms in a different
+      order, or rearrange them algebraically, so the results are
+      only compared up to a tolerance that grows with the size of
+      the terms, not just the size of the sum.
+    */
+    
+    unsigned int np = dist->npar();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE(dist->name(), x.size() * np, par.size());
+
+    vector<double const *> parptr(par.size());
+    for (unsigned int i = 0; i < par.size(); ++i) {
+	parptr[i] = &par[i];
+    }
+
+    jags::PDFType types[3] = {jags::PDF_FULL, jags::PDF_PRIOR,
+			      jags::PDF_LIKELIHOOD};
+    for (unsigned int t = 0; t < 3; ++t) {
+	double expected = 0, scale = 1;
+	for (unsigned int i = 0; i < x.size(); ++i) {
+	    vector<double const *> pari(parptr.begin() + i * np,
+					parptr.begin() + (i + 1) * np);
+	    if (dist->checkParameterValue(pari)) {
+		double term = dist->logDensity(x[i], types[t], pari, 0, 0);
+		expected += term;
+		scale += abs(term);
+	    }
+	    else {
+		expected += JAGS_NEGINF;
+	    }
+	}
+	double y = dist->logDensitySum(&x[0], &parptr[0], x.size(), types[t]);
+	if (jags_finite(expected)) {
+	    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(dist->name(), expected, y,
+						 1.0E-10 * scale);
+	}
+	else {
+	    CPPUNIT_ASSERT_EQUAL_MESSAGE(dist->name(), expected, y);
+	}
+    }
+}
+
+void BugsDistTest::batch_kl(ScalarDist const *dist,
+			    vector<double> const &par1,
+			    vector<double> const &par2)
+{
+    /*
+      Test the batch Kullback-Leibler divergence against the
+      divergences of the individual pairs of parameters.  The vectors
+      par1 and par2 hold npar parameter values for each pair.
+    */
+    
+    unsigned int np = dist->npar();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE(dist->name(), par1.size(), par2.size());
+    unsigned int n = par1.size() / np;
+
+    vector<double const *> ptr1(par1.size()), ptr2(par2.size());
+    for (unsigned int i = 0; i < par1.size(); ++i) {
+	ptr1[i] = &par1[i];
+	ptr2[i] = &par2[i];
+    }
+
+    vector<double> kl(n);
+    dist->KLBatch(&kl[0], &ptr1[0], &ptr2[0], n);
+    for (unsigned int i = 0; i < n; ++i) {
+	vector<double const *> p1(ptr1.begin() + i * np,
+				  ptr1.begin() + (i + 1) * np);
+	vector<double const *> p2(ptr2.begin() + i * np,
+				  ptr2.begin() + (i + 1) * np);
+	double expected = dist->KL(p1, p2);
+	if (jags_finite(expected)) {
+	    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(dist->name(), expected, kl[i],
+						 1.0E-10 * max(1.0, abs(kl[i])));
+	}
+	else {
+	    CPPUNIT_ASSERT_EQUAL_MESSAGE(dist->name(), expected, kl[i]);
+	}
+    }
+}
+
+static vector<double> mkVec(double const *x, unsigned int n)
+{
+    return vector<double>(x, x + n);
+}
+
+void BugsDistTest::batch()
+{
+    /* Batch log density: see batch_scalar for details */
+    
+    double xnorm[3] = {0.5, -1, 3};
+    double pnorm[6] = {0, 1, 2, 0.5, -1, 4};
+    batch_scalar(_dnorm, mkVec(xnorm, 3), mkVec(pnorm, 6));
+    double pnorm_bad[6] = {0, 1, 2, -0.5, -1, 4};
+    batch_scalar(_dnorm, mkVec(xnorm, 3), mkVec(pnorm_bad, 6));
+    
+    double xpois[4] = {0, 3, 7, 0};
+    double ppois[4] = {2.5, 0.5, 10, 0};
+    batch_scalar(_dpois, mkVec(xpois, 4), mkVec(ppois, 4));
+    double xpois_bad[4] = {0, 3, 2.5, 0};
+    batch_scalar(_dpois, mkVec(xpois_bad, 4), mkVec(ppois, 4));
+
+    double xbern[3] = {0, 1, 1};
+    double pbern[3] = {0.3, 0.8, 1};
+    batch_scalar(_dbern, mkVec(xbern, 3), mkVec(pbern, 3));
+    double pbern_bad[3] = {0.3, 1.5, 1};
+    batch_scalar(_dbern, mkVec(xbern, 3), mkVec(pbern_bad, 3));
+
+    double xbin[3] = {3, 0, 10};
+    double pbin[6] = {0.4, 10, 0.2, 5, 0.9, 10};
+    batch_scalar(_dbin, mkVec(xbin, 3), mkVec(pbin, 6));
+
+    double xgamma[3] = {0.5, 2, 7};
+    double pgamma[6] = {2, 1, 0.5, 3, 5, 0.7};
+    batch_scalar(_dgamma, mkVec(xgamma, 3), mkVec(pgamma, 6));
+
+    double xbeta[3] = {0.2, 0.5, 0.99};
+    double pbeta[6] = {2, 3, 0.5, 0.5, 4, 1};
+    batch_scalar(_dbeta, mkVec(xbeta, 3), mkVec(pbeta, 6));
+
+    /* Batch Kullback-Leibler divergence: see batch_kl for details */
+
+    double knorm[6] = {-3, 2, 2.5, 0.1, 0, 1};
+    batch_kl(_dnorm, mkVec(pnorm, 6), mkVec(knorm, 6));
+
+    double kpois[3] = {3, 0.5, 7};
+    batch_kl(_dpois, mkVec(ppois, 3), mkVec(kpois, 3));
+
+    double pbern2[4] = {0.6, 0.1, 0, 1};
+    double kbern[4] = {0.5, 0.9, 0.3, 0.8};
+    batch_kl(_dbern, mkVec(pbern2, 4), mkVec(kbern, 4));
+
+    //The divergence is infinite for the second pair of sizes
+    double kbin[6] = {0.9, 10, 0.2, 6, 0.5, 10};
+    batch_kl(_dbin, mkVec(pbin, 6), mkVec(kbin, 6));
+
+    double kgamma[6] = {3.5, 1.8, 2, 0.1, 5, 0.7};
+    batch_kl(_dgamma, mkVec(pgamma, 6), mkVec(kgamma, 6));
+
+    //DBeta uses the default implementation
+    batch_kl(_dbeta, mkVec(pbeta, 6), mkVec(pbeta, 6));
+}
@@ -22,6 +22,7 @@ class BugsDistTest : public CppUnit::TestFixture, public JAGSFixture
     CPPUNIT_TEST( rscalar );
     CPPUNIT_TEST( kl );
     CPPUNIT_TEST( dkw );
+    CPPUNIT_TEST( batch );
     CPPUNIT_TEST_SUITE_END(  );
 
     jags::RNG *_rng;
@@ -71,6 +72,13 @@ class BugsDistTest : public CppUnit::TestFixture, public JAGSFixture
     void dkwtest(jags::RScalarDist const *dist,
 		 std::vector<double const *> const &par,
 		 unsigned int N=10000, double pthresh=0.001);
+
+    void batch_scalar(jags::ScalarDist const *dist,
+		      std::vector<double> const &x,
+		      std::vector<double> const &par);
+    void batch_kl(jags::ScalarDist const *dist,
+		  std::vector<double> const &par1,
+		  std::vector<double> const &par2);
     
   public:
     void setUp();
@@ -83,6 +91,7 @@ class BugsDistTest : public CppUnit::TestFixture, public JAGSFixture
 
     void kl();
     void dkw();
+    void batch();
 };
 
 #endif /* BUGS_DIST_TEST_H */
@@ -88,8 +88,9 @@ ConjugateBeta::ConjugateBeta(SingletonGraphView const *gv)
 
 void ConjugateBeta::update(unsigned int chain, RNG *rng) const
 {
-    vector<StochasticNode *> const &stoch_children = 
-	_gv->stochasticChildren();
+    vector<double const *> const &value = _gv->childValues(chain);
+    vector<double const *> const &param0 = _gv->childParameters(0, chain);
+    vector<double const *> const &param1 = _gv->childParameters(1, chain);
     StochasticNode const *snode = _gv->node();
 
     double a=0, b=0; //-Wall
@@ -105,7 +106,7 @@ void ConjugateBeta::update(unsigned int chain, RNG *rng) const
     default:
 	throwLogicError("Invalid distribution in ConjugateBeta sampler");
     }
-    unsigned int Nchild = stoch_children.size();
+    unsigned int Nchild = value.size();
 
     /* For mixture models, we count only stochastic children that
        depend on snode */
@@ -114,7 +115,7 @@ void ConjugateBeta::update(unsigned int chain, RNG *rng) const
     if (is_mix) {
 	C = new double[Nchild];
 	for (unsigned int i = 0; i < Nchild; ++i) {
-	    C[i] = *stoch_children[i]->parents()[0]->value(chain);
+	    C[i] = *param0[i];
 	}
 	// Perturb current value, keeping in the legal range [0,1]
 	double x = *snode->value(chain);
@@ -123,23 +124,23 @@ void ConjugateBeta::update(unsigned int chain, RNG *rng) const
 	// C[i] == 1 if parameter of child i has changed (so depends on snode)
 	// C[i] == 0 otherwise
 	for (unsigned int i = 0; i < Nchild; ++i) {
-	    C[i] = (*stoch_children[i]->parents()[0]->value(chain) != C[i]);
+	    C[i] = (*param0[i] != C[i]);
 	}
     }
 
 
-    for (unsigned int i = 0; i < stoch_children.size(); ++i) {
+    for (unsigned int i = 0; i < Nchild; ++i) {
 	if (!(is_mix && C[i] == 0)) {
-	    double y = *stoch_children[i]->value(chain);
+	    double y = *value[i];
 	    double n;
 	    switch(_child_dist[i]) {
 	    case BIN:
-		n = *stoch_children[i]->parents()[1]->value(chain);
+		n = *param1[i];
 		a += y;
 		b += n - y;
 		break;
 	    case NEGBIN:
-		n = *stoch_children[i]->parents()[1]->value(chain);
+		n = *param1[i];
 		a += n;
 		b += y;
 		break;
@@ -130,9 +130,9 @@ bool ConjugateGamma::canSample(StochasticNode *snode, Graph const &graph)
 
 void ConjugateGamma::update(unsigned int chain, RNG *rng) const
 {
-    vector<StochasticNode *> const &stoch_children = 
-	_gv->stochasticChildren();
-    unsigned int nchildren = stoch_children.size();
+    vector<double const *> const &value = _gv->childValues(chain);
+    vector<double const *> const &param0 = _gv->childParameters(0, chain);
+    unsigned int nchildren = value.size();
 
     //Need to initialize these for -Wall
     double r=0; // shape
@@ -175,10 +175,8 @@ void ConjugateGamma::update(unsigned int chain, RNG *rng) const
 	double coef_i = empty ? 1 : coef[i];
 	if (coef_i > 0) {
 
-	    StochasticNode const *schild = stoch_children[i];
-	    vector<Node const*> const &cparam = schild->parents();
-	    double Y = *schild->value(chain);
-	    double m = *cparam[0]->value(chain); //location parameter 
+	    double Y = *value[i];
+	    double m = *param0[i]; //location parameter 
 	    switch(_child_dist[i]) {
 	    case GAMMA:
 		r += m;
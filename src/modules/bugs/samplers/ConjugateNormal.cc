@@ -31,17 +31,17 @@ static void calBeta(double *beta, SingletonGraphView const *gv,
     StochasticNode *snode = gv->node();
 
     const double xold = *snode->value(chain);
-    vector<StochasticNode *> const &stoch_children = 
-	gv->stochasticChildren();
+    vector<double const *> const &mean = gv->childParameters(0, chain);
+    vector<unsigned int> const &length = gv->childLengths();
+    unsigned int nchildren = mean.size();
 
     double xnew = xold + 1;
     gv->setValue(&xnew, 1, chain);
 
     double *bp = beta;    
-    for (unsigned int i = 0; i < stoch_children.size(); ++i) {
-	StochasticNode const *child = stoch_children[i];
-	unsigned int nrow = child->length();
-	double const *mu = child->parents()[0]->value(chain);
+    for (unsigned int i = 0; i < nchildren; ++i) {
+	unsigned int nrow = length[i];
+	double const *mu = mean[i];
 	for (unsigned int j = 0; j < nrow; ++j) {
 	    bp[j] = mu[j];
 	}
@@ -51,10 +51,9 @@ static void calBeta(double *beta, SingletonGraphView const *gv,
     gv->setValue(&xold, 1, chain);
 
     bp = beta;    
-    for (unsigned int i = 0; i < stoch_children.size(); ++i) {
-	StochasticNode const *child = stoch_children[i];
-	unsigned int nrow = child->length();
-	double const *mu = child->parents()[0]->value(chain);
+    for (unsigned int i = 0; i < nchildren; ++i) {
+	unsigned int nrow = length[i];
+	double const *mu = mean[i];
 	for (unsigned int j = 0; j < nrow; ++j) {
 	    bp[j] -= mu[j];
 	}
@@ -128,9 +127,13 @@ bool ConjugateNormal::canSample(StochasticNode *snode, Graph const &graph)
 
 void ConjugateNormal::update(unsigned int chain, RNG *rng) const
 {
-    vector<StochasticNode *> const &stoch_children = 
-	_gv->stochasticChildren();
-    unsigned int nchildren = stoch_children.size();
+    /* The values and parameters of the stochastic children are read
+       from the packed tables held by the GraphView */
+    vector<double const *> const &value = _gv->childValues(chain);
+    vector<double const *> const &mean = _gv->childParameters(0, chain);
+    vector<double const *> const &precision = 
+	_gv->childParameters(1, chain);
+    unsigned int nchildren = value.size();
     StochasticNode *snode = _gv->node();
 
     /* For convenience in the following computations, we shift the
@@ -158,8 +161,8 @@ void ConjugateNormal::update(unsigned int chain, RNG *rng) const
 	// univariate normal. We know alpha = 0, beta = 1.
 
 	for (unsigned int i = 0; i < nchildren; ++i) {
-	    double Y = *stoch_children[i]->value(chain);
-	    double tau = *stoch_children[i]->parents()[1]->value(chain);
+	    double Y = *value[i];
+	    double tau = *precision[i];
 	    A += (Y - xold) * tau;
 	    B += tau;
 	}
@@ -177,15 +180,14 @@ void ConjugateNormal::update(unsigned int chain, RNG *rng) const
 	    beta = _betas;
 	}
 
+	vector<unsigned int> const &length = _gv->childLengths();
 	double const *bp = beta;
 	for (unsigned long i = 0; i < nchildren; ++i) {
 
-	    StochasticNode const *child = stoch_children[i];
-
-	    double const *Y = child->value(chain);
-	    double const *tau = child->parents()[1]->value(chain);
-	    double const *alpha = child->parents()[0]->value(chain);
-	    unsigned int nrow = child->length();
+	    double const *Y = value[i];
+	    double const *tau = precision[i];
+	    double const *alpha = mean[i];
+	    unsigned int nrow = length[i];
 
 	    for (unsigned int k = 0; k < nrow; ++k) {
 		double tau_beta_k = 0;
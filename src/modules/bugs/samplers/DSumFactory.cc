@@ -33,7 +33,7 @@ static StochasticNode const *getDSumChild(StochasticNode *node)
     return 0;
 }
 
-Sampler * DSumFactory::makeSampler(list<StochasticNode*> const &nodes,
+Sampler * DSumFactory::makeSampler(FreeNodeSet const &nodes,
 				   Graph const &graph) const
 {
     //Find DSum node
@@ -56,10 +56,9 @@ Sampler * DSumFactory::makeSampler(list<StochasticNode*> const &nodes,
     vector<Node const *> const &parents = dsum_node->parents();
     vector<Node const *>::const_iterator pp;
     for (pp = parents.begin(); pp != parents.end(); ++pp) {
-	list<StochasticNode*>::const_iterator q =
-	    find(nodes.begin(), nodes.end(), *pp);
-	if (q != nodes.end()) {
-	    parameters.push_back(*q);
+	StochasticNode *q = nodes.find(*pp);
+	if (q) {
+	    parameters.push_back(q);
 	}
 	else {
 	    return 0;
@@ -109,7 +108,7 @@ string DSumFactory::name() const
     return "bugs::DSum";
 }
 
-vector<Sampler*>  DSumFactory::makeSamplers(list<StochasticNode*> const &nodes, 
+vector<Sampler*>  DSumFactory::makeSamplers(FreeNodeSet const &nodes, 
 					    Graph const &graph) const
 {
     Sampler *s = makeSampler(nodes, graph);
@@ -12,9 +12,9 @@ namespace bugs {
 class DSumFactory : public SamplerFactory
 {
 public:
-    std::vector<Sampler*> makeSamplers(std::list<StochasticNode*> const &nodes, 
+    std::vector<Sampler*> makeSamplers(FreeNodeSet const &nodes, 
 				       Graph const &graph) const;
-    Sampler * makeSampler(std::list<StochasticNode*> const &nodes, 
+    Sampler * makeSampler(FreeNodeSet const &nodes, 
 			  Graph const &graph) const;
     std::string name() const;
 };
@@ -91,4 +91,16 @@ double DirchMetropolis::logJacobian(vector<double> const &value) const
     return lj;
 }
 
+void DirchMetropolis::getState(vector<double> &state) const
+{
+    RWMetropolis::getState(state);
+    state.push_back(_s);
+}
+
+void DirchMetropolis::setState(vector<double> const &state, unsigned int &pos)
+{
+    RWMetropolis::setState(state, pos);
+    _s = state[pos++];
+}
+
 }}
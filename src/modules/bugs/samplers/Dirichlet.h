@@ -21,6 +21,8 @@ public:
     void step(std::vector<double> &x, double size, RNG *rng) const;
     double logJacobian(std::vector<double> const &x) const;
     double logDensity() const;
+    void getState(std::vector<double> &state) const;
+    void setState(std::vector<double> const &state, unsigned int &pos);
 };
 
 }}
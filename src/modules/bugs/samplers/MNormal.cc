@@ -176,4 +176,38 @@ void MNormMetropolis::setValue(vector<double> const &value)
     _gv->setValue(value, _chain);
 }
 
+void MNormMetropolis::getState(vector<double> &state) const
+{
+    Metropolis::getState(state);
+    unsigned int N = _gv->length();
+    state.insert(state.end(), _mean, _mean + N);
+    state.insert(state.end(), _var, _var + N * N);
+    state.insert(state.end(), _prec, _prec + N * N);
+    state.push_back(_n);
+    state.push_back(_n_isotonic);
+    state.push_back(_sump);
+    state.push_back(_meanp);
+    state.push_back(_lstep);
+    state.push_back(_nstep);
+    state.push_back(_p_over_target);
+}
+
+void MNormMetropolis::setState(vector<double> const &state, unsigned int &pos)
+{
+    Metropolis::setState(state, pos);
+    unsigned int N = _gv->length();
+    vector<double>::const_iterator p = state.begin() + pos;
+    copy(p, p + N, _mean);
+    copy(p + N, p + N + N * N, _var);
+    copy(p + N + N * N, p + N + 2 * N * N, _prec);
+    pos += N + 2 * N * N;
+    _n = static_cast<unsigned int>(state[pos++]);
+    _n_isotonic = static_cast<unsigned int>(state[pos++]);
+    _sump = state[pos++];
+    _meanp = state[pos++];
+    _lstep = state[pos++];
+    _nstep = static_cast<unsigned int>(state[pos++]);
+    _p_over_target = static_cast<unsigned int>(state[pos++]);
+}
+
 }}
@@ -30,6 +30,12 @@ public:
     bool checkAdaptation() const;
     void getValue(std::vector<double> &value) const;
     void setValue(std::vector<double> const &value);
+    /**
+     * Appends the running mean and covariance matrix of the sampled
+     * values, and the current scale of the proposal distribution.
+     */
+    void getState(std::vector<double> &state) const;
+    void setState(std::vector<double> const &state, unsigned int &pos);
 };
 
 }}
@@ -88,6 +88,22 @@ namespace bugs {
     {
 	_gv->setValue(value, _chain);
     }
+
+    void RW1::getState(vector<double> &state) const
+    {
+	Metropolis::getState(state);
+	_step_adapter.getState(state);
+	state.push_back(_pmean);
+	state.push_back(_niter);
+    }
+
+    void RW1::setState(vector<double> const &state, unsigned int &pos)
+    {
+	Metropolis::setState(state, pos);
+	_step_adapter.setState(state, pos);
+	_pmean = state[pos++];
+	_niter = static_cast<unsigned int>(state[pos++]);
+    }
     
 }
 }
@@ -25,6 +25,9 @@ namespace jags {
 	    bool checkAdaptation() const;
 	    void getValue(std::vector<double> &value) const;
 	    void setValue(std::vector<double> const &value);
+	    void getState(std::vector<double> &state) const;
+	    void setState(std::vector<double> const &state,
+			  unsigned int &pos);
 	};
     }
 }
@@ -234,4 +234,20 @@ void RWDSum::getValue(vector<double> &value) const
     _gv->getValue(value, _chain);
 }
 
+void RWDSum::getState(vector<double> &state) const
+{
+    Metropolis::getState(state);
+    _step_adapter.getState(state);
+    state.push_back(_pmean);
+    state.push_back(_niter);
+}
+
+void RWDSum::setState(vector<double> const &state, unsigned int &pos)
+{
+    Metropolis::setState(state, pos);
+    _step_adapter.setState(state, pos);
+    _pmean = state[pos++];
+    _niter = static_cast<unsigned int>(state[pos++]);
+}
+
 }}
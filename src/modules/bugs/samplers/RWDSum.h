@@ -72,7 +72,12 @@ public:
 			  Graph const &graph, bool discrete, bool multinom);
     void setValue(std::vector<double> const &value);
     void getValue(std::vector<double> &value) const;
-
+    /**
+     * Appends the state of the step adapter and the running mean of
+     * the acceptance probability to the state of the parent class.
+     */
+    void getState(std::vector<double> &state) const;
+    void setState(std::vector<double> const &state, unsigned int &pos);
 };
 
 }}
@@ -21,7 +21,7 @@ namespace jags {
     namespace bugs {
 
 	vector<Sampler *>
-	SumFactory::makeSamplers(list<StochasticNode*> const &nodes,
+	SumFactory::makeSamplers(FreeNodeSet const &nodes,
 				 Graph const &graph) const
 	{
 	    vector<Sampler*> samplers;
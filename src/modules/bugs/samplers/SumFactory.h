@@ -13,7 +13,7 @@ namespace jags {
 	{
 	  public:
 	    std::vector<Sampler*>
-		makeSamplers(std::list<StochasticNode*> const &nodes, 
+		makeSamplers(FreeNodeSet const &nodes, 
 			     Graph const &graph) const;
 	    std::string name() const;
 	};
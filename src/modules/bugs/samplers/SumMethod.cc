@@ -419,6 +419,27 @@ namespace jags {
 	    return true;
 	}
 
+	void SumMethod::getState(vector<double> &state) const
+	{
+	    state.insert(state.end(), _x.begin(), _x.end());
+	    state.push_back(_adapt);
+	    state.push_back(_width);
+	    state.push_back(_sumdiff);
+	    state.push_back(_iter);
+	}
+
+	void SumMethod::setState(vector<double> const &state,
+				 unsigned int &pos)
+	{
+	    for (unsigned int i = 0; i < _x.size(); ++i) {
+		_x[i] = state[pos++];
+	    }
+	    _adapt = state[pos++] != 0;
+	    _width = state[pos++];
+	    _sumdiff = state[pos++];
+	    _iter = static_cast<unsigned int>(state[pos++]);
+	}
+
     } // namespace bugs
 } //namespace jags
 
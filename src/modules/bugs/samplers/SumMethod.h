@@ -44,6 +44,9 @@ namespace jags {
 	    bool isAdaptive() const;
 	    void adaptOff();
 	    bool checkAdaptation() const;
+	    void getState(std::vector<double> &state) const;
+	    void setState(std::vector<double> const &state,
+			  unsigned int &pos);
 	    static StochasticNode *
 		isCandidate(StochasticNode *snode, Graph const &graph);
 	    static bool canSample(std::vector<StochasticNode *> const &nodes, 
@@ -0,0 +1,754 @@
+#include <config.h>
+#include "testcompiler.h"
+
+#include "distributions/DNorm.h"
+#include "distributions/DCat.h"
+#include "functions/Exp.h"
+#include "samplers/ConjugateFactory.h"
+#include <base/functions/Seq.h>
+#include <base/rngs/BaseRNGFactory.h>
+
+#include <Console.h>
+#include <compiler/InternTable.h>
+#include <module/Module.h>
+#include <model/BUGSModel.h>
+#include <model/Checkpoint.h>
+#include <rng/RNG.h>
+#include <graph/ConstantNode.h>
+#include <graph/ScalarStochasticNode.h>
+#include <graph/AggNode.h>
+#include <graph/MixtureNode.h>
+#include <graph/VectorStochasticNode.h>
+#include <graph/Graph.h>
+#include <sampler/GraphView.h>
+#include <sarray/SArray.h>
+
+#include <cfloat>
+#include <cstdio>
+#include <fstream>
+#include <cmath>
+#include <sstream>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+using std::map;
+using std::string;
+using std::vector;
+using std::ostringstream;
+using std::sort;
+using std::pair;
+using std::make_pair;
+
+using jags::Console;
+using jags::SArray;
+using jags::Node;
+using jags::ConstantNode;
+using jags::AggNode;
+using jags::ScalarStochasticNode;
+using jags::VectorStochasticNode;
+using jags::StochasticNode;
+using jags::MixtureNode;
+using jags::FuzzyHash;
+using jags::InternTable;
+using jags::fuzzy_less;
+using jags::Module;
+using jags::BUGSModel;
+using jags::Function;
+using jags::Distribution;
+using jags::RNGFactory;
+using jags::SamplerFactory;
+
+/* Functions, distributions and RNGs needed by the test model */
+class CompilerTestModule : public Module {
+public:
+    CompilerTestModule() : Module("compilertest")
+    {
+	insert(new jags::bugs::DNorm);
+	insert(new jags::bugs::Exp);
+	insert(new jags::base::Seq);
+	insert(new jags::base::BaseRNGFactory);
+	insert(new jags::bugs::ConjugateFactory);
+    }
+    ~CompilerTestModule()
+    {
+	vector<Distribution*> const &dvec = distributions();
+	for (unsigned int i = 0; i < dvec.size(); ++i) {
+	    delete dvec[i];
+	}
+	vector<Function*> const &fvec = functions();
+	for (unsigned int i = 0; i < fvec.size(); ++i) {
+	    delete fvec[i];
+	}
+	vector<RNGFactory*> const &rvec = rngFactories();
+	for (unsigned int i = 0; i < rvec.size(); ++i) {
+	    delete rvec[i];
+	}
+	vector<SamplerFactory*> const &svec = samplerFactories();
+	for (unsigned int i = 0; i < svec.size(); ++i) {
+	    delete svec[i];
+	}
+    }
+};
+
+/*
+   Each relation depends on relations that come after it, so that
+   nodes can only be created in the reverse of the order in which the
+   relations are written.
+*/
+static char const *REVERSE_MODEL =
+    "model {\n"
+    "   for (i in 1:N) {\n"
+    "      z[i] ~ dnorm(m[i], 1)\n"
+    "   }\n"
+    "   for (i in 1:N) {\n"
+    "      m[i] <- exp(y[i])\n"
+    "   }\n"
+    "   for (i in 1:M) {\n"
+    "      y[i] ~ dnorm(y[p[i]], 1)\n"
+    "   }\n"
+    "   y[N] ~ dnorm(0, 1)\n"
+    "}\n";
+
+static SArray vectorArray(vector<double> const &value)
+{
+    SArray ans(vector<unsigned int>(1, value.size()));
+    ans.setValue(value);
+    return ans;
+}
+
+static map<string, SArray> reverseData(unsigned int N)
+{
+    vector<double> y(N), z(N), p(N - 1);
+    for (unsigned int i = 0; i < N; ++i) {
+	y[i] = i / 10.0;
+	z[i] = 1 + i / 5.0;
+    }
+    for (unsigned int i = 0; i < N - 1; ++i) {
+	p[i] = i + 2;
+    }
+
+    map<string, SArray> data;
+    data.insert(make_pair(string("N"), vectorArray(vector<double>(1, N))));
+    data.insert(make_pair(string("M"),
+			  vectorArray(vector<double>(1, N - 1))));
+    data.insert(make_pair(string("p"), vectorArray(p)));
+    data.insert(make_pair(string("y"), vectorArray(y)));
+    data.insert(make_pair(string("z"), vectorArray(z)));
+    return data;
+}
+
+/* Compiles the model with a single chain */
+static bool compileModel(Console &console, char const *text,
+			 map<string, SArray> data, bool worklist = false)
+{
+    std::FILE *file = std::tmpfile();
+    CPPUNIT_ASSERT(file);
+    std::fputs(text, file);
+    std::rewind(file);
+    bool ok = console.checkModel(file);
+    std::fclose(file);
+    return ok && console.compile(data, 1, true, worklist);
+}
+
+/*
+   Describes each node in the model by its random variable status
+   followed by its values. The descriptions are sorted so that they do
+   not depend on the order in which the nodes were created.
+*/
+static vector<vector<double> > describeNodes(BUGSModel const *model)
+{
+    vector<vector<double> > ans;
+    vector<Node*> const &nodes = model->nodes();
+    for (unsigned int i = 0; i < nodes.size(); ++i) {
+	double const *v = nodes[i]->value(0);
+	vector<double> d(1, nodes[i]->randomVariableStatus());
+	d.insert(d.end(), v, v + nodes[i]->length());
+	ans.push_back(d);
+    }
+    sort(ans.begin(), ans.end());
+    return ans;
+}
+
+/* 
+   Model for the checkpoint tests. The mean mu is updated by a
+   conjugate sampler and z is drawn from its prior.
+*/
+static char const *NORMAL_MODEL =
+    "model {\n"
+    "   for (i in 1:N) {\n"
+    "      y[i] ~ dnorm(mu, 1)\n"
+    "   }\n"
+    "   mu ~ dnorm(0, 1.0E-4)\n"
+    "   z ~ dnorm(mu, 1)\n"
+    "}\n";
+
+static char const *CHECKPOINT_FILE = "testcompiler.tmp";
+
+/* Compiles and initializes the normal model with the given seed */
+static void startModel(Console &console, unsigned int seed, double mu)
+{
+    vector<double> y(10);
+    for (unsigned int i = 0; i < y.size(); ++i) {
+	y[i] = 2 + std::sin(3.0 * i);
+    }
+    map<string, SArray> data;
+    data.insert(make_pair(string("N"), vectorArray(vector<double>(1, 10))));
+    data.insert(make_pair(string("y"), vectorArray(y)));
+    CPPUNIT_ASSERT(compileModel(console, NORMAL_MODEL, data));
+
+    map<string, SArray> inits;
+    inits.insert(make_pair(string(".RNG.seed"),
+			   vectorArray(vector<double>(1, seed))));
+    inits.insert(make_pair(string("mu"), vectorArray(vector<double>(1, mu))));
+    CPPUNIT_ASSERT(console.setRNGname("base::Mersenne-Twister", 1));
+    CPPUNIT_ASSERT(console.setParameters(inits, 1));
+    CPPUNIT_ASSERT(console.initialize());
+}
+
+/* Checks that two models have the same values and RNG state */
+static void checkSameState(Console &console1, Console &console2)
+{
+    map<string, SArray> state1, state2;
+    string rng1, rng2;
+    CPPUNIT_ASSERT(console1.dumpState(state1, rng1, jags::DUMP_ALL, 1));
+    CPPUNIT_ASSERT(console2.dumpState(state2, rng2, jags::DUMP_ALL, 1));
+    CPPUNIT_ASSERT_EQUAL(rng1, rng2);
+    CPPUNIT_ASSERT_EQUAL(state1.size(), state2.size());
+    map<string, SArray>::const_iterator p = state1.begin();
+    map<string, SArray>::const_iterator q = state2.begin();
+    for (; p != state1.end(); ++p, ++q) {
+	CPPUNIT_ASSERT_EQUAL(p->first, q->first);
+	CPPUNIT_ASSERT(p->second.value() == q->second.value());
+    }
+}
+
+static string readCheckpoint()
+{
+    std::ifstream in(CHECKPOINT_FILE, std::ios::in | std::ios::binary);
+    CPPUNIT_ASSERT(in);
+    ostringstream out;
+    out << in.rdbuf();
+    return out.str();
+}
+
+static void writeCheckpoint(string const &ckpt)
+{
+    std::ofstream out(CHECKPOINT_FILE, std::ios::out | std::ios::binary);
+    CPPUNIT_ASSERT(out);
+    out << ckpt;
+}
+
+/* Keys for the InternTable tests */
+
+struct ValuesHash {
+    void operator()(FuzzyHash &h, vector<double> const &x) const {
+	for (unsigned int i = 0; i < x.size(); ++i) {
+	    h.add(x[i]);
+	}
+    }
+};
+
+struct ValuesLess {
+    bool operator()(vector<double> const &x, vector<double> const &y) const {
+	return jags::lt(&x[0], &y[0], x.size());
+    }
+};
+
+struct NodeHash {
+    void operator()(FuzzyHash &h, Node const *node) const {
+	h.add(node);
+    }
+};
+
+typedef InternTable<vector<double>, int, ValuesHash, ValuesLess> ValuesTable;
+typedef InternTable<Node const *, int, NodeHash, fuzzy_less<Node const *> >
+NodeTable;
+
+/*
+   FuzzyHash rounds values to multiples of 2^-20, so (k + 1/2) * 2^-20
+   is a grid boundary. Values that lie a few epsilon either side of
+   it are equal under the fuzzy comparison, but round to different
+   grid points.
+*/
+static double boundary(unsigned int k)
+{
+    return (k + 0.5) / 1048576;
+}
+
+static vector<double> belowBoundary(unsigned int n)
+{
+    vector<double> x(n);
+    for (unsigned int k = 0; k < n; ++k) {
+	x[k] = boundary(k + 1) - 4 * DBL_EPSILON;
+    }
+    return x;
+}
+
+static vector<double> aboveBoundary(unsigned int n)
+{
+    vector<double> x(n);
+    for (unsigned int k = 0; k < n; ++k) {
+	x[k] = boundary(k + 1) + 4 * DBL_EPSILON;
+    }
+    return x;
+}
+
+void BugsCompilerTest::setUp()
+{
+    _module = new CompilerTestModule;
+    _module->load();
+}
+
+void BugsCompilerTest::tearDown()
+{
+    std::remove(CHECKPOINT_FILE);
+    _module->unload();
+    delete _module;
+}
+
+void BugsCompilerTest::worklist()
+{
+    ostringstream out1, err1, out2, err2;
+    Console sweep(out1, err1), work(out2, err2);
+
+    unsigned int N = 20;
+    map<string, SArray> data = reverseData(N);
+    CPPUNIT_ASSERT(compileModel(sweep, REVERSE_MODEL, data, false));
+    CPPUNIT_ASSERT(compileModel(work, REVERSE_MODEL, data, true));
+    CPPUNIT_ASSERT(sweep.initialize());
+    CPPUNIT_ASSERT(work.initialize());
+
+    //Both modes create the same nodes with the same values
+    CPPUNIT_ASSERT_EQUAL(sweep.model()->nodes().size(),
+			 work.model()->nodes().size());
+    CPPUNIT_ASSERT(describeNodes(sweep.model()) ==
+		   describeNodes(work.model()));
+
+    map<string, SArray> state1, state2;
+    string rng1, rng2;
+    CPPUNIT_ASSERT(sweep.dumpState(state1, rng1, jags::DUMP_ALL, 1));
+    CPPUNIT_ASSERT(work.dumpState(state2, rng2, jags::DUMP_ALL, 1));
+    //Each console has its own RNG
+    state1.erase(".RNG.state");
+    state2.erase(".RNG.state");
+    CPPUNIT_ASSERT_EQUAL(state1.size(), state2.size());
+    map<string, SArray>::const_iterator p = state1.begin();
+    map<string, SArray>::const_iterator q = state2.begin();
+    for (; p != state1.end(); ++p, ++q) {
+	CPPUNIT_ASSERT_EQUAL(p->first, q->first);
+	CPPUNIT_ASSERT(p->second.value() == q->second.value());
+    }
+
+    //The deterministic nodes take their values from the data
+    vector<double> const &m = state2.find("m")->second.value();
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(N), m.size());
+    for (unsigned int i = 0; i < N; ++i) {
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(std::exp(i / 10.0), m[i], 1.0E-12);
+    }
+
+    //The compilation phases are timed
+    vector<pair<string, double> > times;
+    CPPUNIT_ASSERT(work.dumpCompileTimes(times));
+    CPPUNIT_ASSERT(!times.empty());
+}
+
+void BugsCompilerTest::fuzzyhash()
+{
+    double lo = boundary(1) - 4 * DBL_EPSILON;
+    double hi = boundary(1) + 4 * DBL_EPSILON;
+    CPPUNIT_ASSERT(!jags::lt(lo, hi) && !jags::lt(hi, lo));
+
+    //Each value is ambiguous, and its alternative candidate is the
+    //first candidate of the other
+    FuzzyHash hlo, hhi;
+    hlo.add(lo);
+    hhi.add(hi);
+    CPPUNIT_ASSERT_EQUAL(1U, hlo.nambiguous());
+    CPPUNIT_ASSERT_EQUAL(1U, hhi.nambiguous());
+    CPPUNIT_ASSERT(hlo.candidate(0) != hhi.candidate(0));
+    CPPUNIT_ASSERT_EQUAL(hlo.candidate(0), hhi.candidate(1));
+    CPPUNIT_ASSERT_EQUAL(hlo.candidate(1), hhi.candidate(0));
+
+    //Values away from a boundary are not ambiguous
+    FuzzyHash h;
+    h.add(1.0);
+    h.add(boundary(1) - 1.0E-10);
+    CPPUNIT_ASSERT_EQUAL(0U, h.nambiguous());
+
+    //Either value finds an entry inserted with the other
+    ValuesTable t1, t2;
+    t1.insert(vector<double>(1, lo), 1);
+    t2.insert(vector<double>(1, hi), 2);
+    int const *p1 = t1.find(vector<double>(1, hi));
+    int const *p2 = t2.find(vector<double>(1, lo));
+    CPPUNIT_ASSERT(p1 && *p1 == 1);
+    CPPUNIT_ASSERT(p2 && *p2 == 2);
+    CPPUNIT_ASSERT(!t1.find(vector<double>(1, boundary(2))));
+}
+
+void BugsCompilerTest::ambiguous()
+{
+    /*
+       Keys with up to 8 ambiguous values are found by trying every
+       candidate hash value. Keys with more are found by a linear
+       search of the table.
+    */
+    for (unsigned int n = 7; n <= 10; ++n) {
+	vector<double> lo = belowBoundary(n), hi = aboveBoundary(n);
+
+	FuzzyHash h;
+	ValuesHash()(h, lo);
+	CPPUNIT_ASSERT_EQUAL(n, h.nambiguous());
+
+	ValuesTable t;
+	for (unsigned int i = 0; i < 20; ++i) {
+	    t.insert(vector<double>(n, i), i);
+	}
+	t.insert(lo, 100);
+	int const *p = t.find(hi);
+	CPPUNIT_ASSERT(p && *p == 100);
+
+	vector<double> other = hi;
+	other[n - 1] = boundary(n + 1);
+	CPPUNIT_ASSERT(!t.find(other));
+	CPPUNIT_ASSERT_EQUAL(21U, t.size());
+    }
+}
+
+void BugsCompilerTest::constants()
+{
+    //Fixed nodes are hashed by dimension and value
+    ConstantNode a(boundary(1) - 4 * DBL_EPSILON, 1, true);
+    ConstantNode b(boundary(1) + 4 * DBL_EPSILON, 1, true);
+    ConstantNode c(2.0, 1, true);
+    vector<double> v(2);
+    v[0] = 1; v[1] = 2;
+    ConstantNode d(vector<unsigned int>(1, 2), v, 1, true);
+    vector<unsigned int> dim(2, 1);
+    dim[1] = 2;
+    ConstantNode e(dim, v, 1, true);
+
+    NodeTable t;
+    t.insert(&a, 1);
+    t.insert(&c, 2);
+    t.insert(&d, 3);
+    int const *pa = t.find(&b);
+    int const *pd = t.find(&d);
+    CPPUNIT_ASSERT(pa && *pa == 1);
+    CPPUNIT_ASSERT(pd && *pd == 3);
+    CPPUNIT_ASSERT(!t.find(&e));
+
+    //The compiler creates one node for equal constants
+    static char const *text =
+	"model {\n"
+	"   a ~ dnorm(0, 1)\n"
+	"   b ~ dnorm(0, 1)\n"
+	"   c ~ dnorm(1.0E-16, 1)\n"
+	"}\n";
+    ostringstream out, err;
+    Console console(out, err);
+    CPPUNIT_ASSERT(compileModel(console, text, map<string, SArray>()));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(5),
+			 console.model()->nodes().size());
+}
+
+/* Checks that the values of an aggregate node are those of its parents */
+static void checkAggregate(AggNode const *node, unsigned int nchain)
+{
+    vector<Node const *> const &par = node->parents();
+    vector<unsigned int> const &off = node->offsets();
+    for (unsigned int ch = 0; ch < nchain; ++ch) {
+	for (unsigned int i = 0; i < node->length(); ++i) {
+	    CPPUNIT_ASSERT_EQUAL(par[i]->value(ch)[off[i]],
+				 node->value(ch)[i]);
+	}
+    }
+}
+
+void BugsCompilerTest::aggregate()
+{
+    unsigned int nchain = 2;
+    jags::base::BaseRNGFactory factory;
+    jags::Model model(nchain);
+    vector<jags::RNG*> rngs = factory.makeRNGs(nchain);
+    for (unsigned int ch = 0; ch < nchain; ++ch) {
+	model.setRNG(rngs[ch], ch);
+    }
+
+    //A vector constant and six scalar stochastic nodes
+    vector<double> cv(6);
+    for (unsigned int i = 0; i < 6; ++i) {
+	cv[i] = i + 1;
+    }
+    ConstantNode *c =
+	new ConstantNode(vector<unsigned int>(1, 6), cv, nchain, true);
+    ConstantNode *zero = new ConstantNode(0, nchain, true);
+    ConstantNode *one = new ConstantNode(1, nchain, true);
+    model.addNode(c);
+    model.addNode(zero);
+    model.addNode(one);
+    vector<Node const *> param(2);
+    param[0] = zero;
+    param[1] = one;
+    jags::bugs::DNorm dnorm;
+    vector<ScalarStochasticNode *> x(6);
+    for (unsigned int i = 0; i < 6; ++i) {
+	x[i] = new ScalarStochasticNode(&dnorm, nchain, param, 0, 0);
+	model.addNode(x[i]);
+    }
+
+    //Contiguous and strided slices of each
+    vector<unsigned int> dim(1, 3);
+    vector<Node const *> cpar(3, c), xpar(3), ypar(3);
+    vector<unsigned int> coff(3), doff(3), zoff(3, 0);
+    for (unsigned int i = 0; i < 3; ++i) {
+	coff[i] = i + 1;
+	doff[i] = 2 * i;
+	xpar[i] = x[i + 1];
+	ypar[i] = x[2 * i];
+    }
+    AggNode *cslice = new AggNode(dim, nchain, cpar, coff);
+    AggNode *cstride = new AggNode(dim, nchain, cpar, doff);
+    AggNode *xslice = new AggNode(dim, nchain, xpar, zoff);
+    AggNode *xstride = new AggNode(dim, nchain, ypar, zoff);
+    AggNode *agg[4] = {cslice, cstride, xslice, xstride};
+    for (unsigned int k = 0; k < 4; ++k) {
+	model.addNode(agg[k]);
+    }
+
+    CPPUNIT_ASSERT(cslice->isView());
+    CPPUNIT_ASSERT(!cstride->isView());
+    checkAggregate(cslice, nchain);
+    checkAggregate(cstride, nchain);
+
+    //Initialization moves the node values into a single block, in
+    //which the scalar nodes are adjacent
+    model.initialize(false);
+    CPPUNIT_ASSERT(cslice->isView());
+    CPPUNIT_ASSERT(!cstride->isView());
+    CPPUNIT_ASSERT(xslice->isView());
+    CPPUNIT_ASSERT(!xstride->isView());
+    for (unsigned int ch = 0; ch < nchain; ++ch) {
+	CPPUNIT_ASSERT(cslice->value(ch) == c->value(ch) + 1);
+	CPPUNIT_ASSERT(xslice->value(ch) == x[1]->value(ch));
+    }
+
+    //Views follow their parents without being updated
+    for (unsigned int ch = 0; ch < nchain; ++ch) {
+	for (unsigned int i = 0; i < 6; ++i) {
+	    double v = 10 * ch + i;
+	    x[i]->setValue(&v, 1, ch);
+	}
+	xstride->deterministicSample(ch);
+	cstride->deterministicSample(ch);
+    }
+    for (unsigned int k = 0; k < 4; ++k) {
+	checkAggregate(agg[k], nchain);
+    }
+}
+
+/*
+   A model with index z, mixture node m <- x[z, 1:3] and child y ~
+   dcat(m). Chain n starts with z = n + 1 and y = 3.
+*/
+struct MixtureModel {
+    jags::bugs::DCat dcat;
+    jags::Model model;
+    jags::Graph graph;
+    vector<ConstantNode *> x;
+    StochasticNode *z;
+    MixtureNode *m;
+    StochasticNode *y;
+    MixtureModel(bool index_only);
+};
+
+MixtureModel::MixtureModel(bool index_only)
+    : model(2), x(2)
+{
+    jags::base::BaseRNGFactory factory;
+    vector<jags::RNG*> rngs = factory.makeRNGs(2);
+    for (unsigned int ch = 0; ch < 2; ++ch) {
+	model.setRNG(rngs[ch], ch);
+    }
+
+    vector<unsigned int> dim(1, 3);
+    double x1[3] = {0.2, 0.3, 0.5};
+    double x2[3] = {0.6, 0.3, 0.1};
+    x[0] = new ConstantNode(dim, vector<double>(x1, x1 + 3), 2, true);
+    x[1] = new ConstantNode(dim, vector<double>(x2, x2 + 3), 2, true);
+    ConstantNode *pi = new ConstantNode(vector<unsigned int>(1, 2),
+					vector<double>(2, 0.5), 2, true);
+    z = new VectorStochasticNode(&dcat, 2, vector<Node const *>(1, pi),
+				 0, 0);
+    jags::MixMap mixmap;
+    mixmap[vector<int>(1, 1)] = x[0];
+    mixmap[vector<int>(1, 2)] = x[1];
+    m = new MixtureNode(vector<Node const *>(1, z), 2, mixmap);
+    y = new VectorStochasticNode(&dcat, 2, vector<Node const *>(1, m),
+				 0, 0);
+    model.addNode(x[0]);
+    model.addNode(x[1]);
+    model.addNode(pi);
+    model.addNode(z);
+    model.addNode(m);
+    model.addNode(y);
+    vector<Node*> const &nodes = model.nodes();
+    for (unsigned int i = 0; i < nodes.size(); ++i) {
+	graph.insert(nodes[i]);
+    }
+
+    double three = 3;
+    for (unsigned int ch = 0; ch < 2; ++ch) {
+	double index = ch + 1;
+	z->setValue(&index, 1, ch);
+	y->setValue(&three, 1, ch);
+    }
+    model.setIndexOnlyMixtures(index_only);
+    model.initialize(false);
+}
+
+/* Checks that the mixture node and its child see the active parent */
+static void checkMixture(MixtureModel const &mm, unsigned int ch,
+			 bool index_only)
+{
+    Node const *active = mm.x[static_cast<int>(*mm.z->value(ch)) - 1];
+    CPPUNIT_ASSERT(mm.m->activeParent(ch) == active);
+    CPPUNIT_ASSERT(mm.y->parameters(ch)[0] == mm.m->value(ch));
+    //In index-only mode there is no copy of the active parent
+    CPPUNIT_ASSERT_EQUAL(index_only, mm.m->value(ch) == active->value(ch));
+    for (unsigned int i = 0; i < 3; ++i) {
+	CPPUNIT_ASSERT_EQUAL(active->value(ch)[i], mm.m->value(ch)[i]);
+    }
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(std::log(active->value(ch)[2]),
+				 mm.y->logDensity(ch, jags::PDF_FULL),
+				 1.0E-12);
+}
+
+void BugsCompilerTest::mixture()
+{
+    MixtureModel copied(false), indexed(true);
+    CPPUNIT_ASSERT(!copied.m->isIndexOnly());
+    CPPUNIT_ASSERT(indexed.m->isIndexOnly());
+    for (unsigned int ch = 0; ch < 2; ++ch) {
+	checkMixture(copied, ch, false);
+	checkMixture(indexed, ch, true);
+    }
+
+    //Samplers see the active parent through the GraphView tables
+    jags::GraphView gv(vector<StochasticNode *>(1, indexed.z),
+		       indexed.graph);
+    jags::GraphView incr(vector<StochasticNode *>(1, indexed.z),
+			 indexed.graph);
+    incr.setIncremental();
+    for (unsigned int ch = 0; ch < 2; ++ch) {
+	incr.logLikelihood(ch);
+	for (unsigned int k = 0; k < 3; ++k) {
+	    double index = (ch + k) % 2 + 1;
+	    incr.setValue(&index, 1, ch);
+	    gv.setValue(&index, 1, ch);
+	    checkMixture(indexed, ch, true);
+	    Node const *active = indexed.m->activeParent(ch);
+	    CPPUNIT_ASSERT(gv.childParameters(0, ch)[0] == active->value(ch));
+	    double ll = std::log(active->value(ch)[2]);
+	    CPPUNIT_ASSERT_DOUBLES_EQUAL(ll, gv.logLikelihood(ch), 1.0E-12);
+	    CPPUNIT_ASSERT_DOUBLES_EQUAL(ll, incr.logLikelihood(ch), 1.0E-12);
+	}
+    }
+
+    //A deterministic child added later keeps a pointer to the value
+    //of the mixture node, which must then be a copy
+    AggNode *agg = new AggNode(vector<unsigned int>(1, 1), 2,
+			       vector<Node const *>(1, indexed.m),
+			       vector<unsigned int>(1, 2));
+    indexed.model.addNode(agg);
+    CPPUNIT_ASSERT(!indexed.m->isIndexOnly());
+    for (unsigned int ch = 0; ch < 2; ++ch) {
+	checkMixture(indexed, ch, false);
+	double index = ch + 1;
+	gv.setValue(&index, 1, ch);
+	agg->deterministicSample(ch);
+	checkMixture(indexed, ch, false);
+	CPPUNIT_ASSERT_EQUAL(indexed.m->value(ch)[2], agg->value(ch)[0]);
+    }
+}
+
+void BugsCompilerTest::checkpoint()
+{
+    //Restoring a checkpoint into a fresh model, which has different
+    //initial values and RNG state, must give the same draws as
+    //continuing the model that wrote it
+
+    ostringstream out1, err1, out2, err2, out3, err3;
+    Console direct(out1, err1), writer(out2, err2), fresh(out3, err3);
+    startModel(direct, 1, 0);
+    startModel(writer, 1, 0);
+    startModel(fresh, 2, 10);
+
+    unsigned int N = 10;
+    CPPUNIT_ASSERT(direct.update(N));
+    CPPUNIT_ASSERT(writer.update(N));
+    CPPUNIT_ASSERT(writer.checkpoint(CHECKPOINT_FILE));
+    CPPUNIT_ASSERT(fresh.restore(CHECKPOINT_FILE));
+    CPPUNIT_ASSERT_EQUAL(N, fresh.iter());
+    checkSameState(direct, fresh);
+
+    for (unsigned int iter = 0; iter < 20; ++iter) {
+	CPPUNIT_ASSERT(direct.update(1));
+	CPPUNIT_ASSERT(fresh.update(1));
+	checkSameState(direct, fresh);
+    }
+}
+
+void BugsCompilerTest::checkpointfail()
+{
+    //A checkpoint that cannot be restored must leave the model
+    //unchanged, even if it is only rejected after the RNG and
+    //sampler states have been read
+
+    ostringstream out1, err1, out2, err2, out3, err3;
+    Console writer(out1, err1), model(out2, err2), twin(out3, err3);
+    startModel(writer, 1, 0);
+    startModel(model, 2, 0);
+    startModel(twin, 2, 0);
+    CPPUNIT_ASSERT(writer.update(7));
+    CPPUNIT_ASSERT(model.update(3));
+    CPPUNIT_ASSERT(twin.update(3));
+    CPPUNIT_ASSERT(writer.checkpoint(CHECKPOINT_FILE));
+    string ckpt = readCheckpoint();
+
+    //Truncated checkpoint
+    writeCheckpoint(ckpt.substr(0, ckpt.size() - 1));
+    CPPUNIT_ASSERT(!model.restore(CHECKPOINT_FILE));
+
+    /* 
+       Checkpoint with a trace monitor, which cannot be created as
+       no monitor factory is loaded. The empty monitor section at
+       the end is replaced by a section with one entry, written
+       without the file header.
+    */
+    ostringstream entry;
+    jags::CheckpointWriter w(entry);
+    w.putUInt(1);
+    w.putString("mu");
+    w.putUInt(0);
+    w.putString("trace");
+    w.putUInt(1);
+    w.putUInt(1);
+    w.putUInt(0);
+    w.putDoubles(vector<double>());
+    ostringstream header;
+    jags::CheckpointWriter hw(header);
+    writeCheckpoint(ckpt.substr(0, ckpt.size() - 4) +
+		    entry.str().substr(header.str().size()));
+    CPPUNIT_ASSERT(!model.restore(CHECKPOINT_FILE));
+
+    CPPUNIT_ASSERT_EQUAL(3U, model.iter());
+    checkSameState(model, twin);
+    for (unsigned int iter = 0; iter < 10; ++iter) {
+	CPPUNIT_ASSERT(model.update(1));
+	CPPUNIT_ASSERT(twin.update(1));
+	checkSameState(model, twin);
+    }
+}
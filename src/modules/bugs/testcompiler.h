@@ -0,0 +1,38 @@
+#ifndef BUGS_COMPILER_TEST_H
+#define BUGS_COMPILER_TEST_H
+
+namespace jags {
+    class Module;
+}
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class BugsCompilerTest : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE( BugsCompilerTest );
+    CPPUNIT_TEST( worklist );
+    CPPUNIT_TEST( fuzzyhash );
+    CPPUNIT_TEST( ambiguous );
+    CPPUNIT_TEST( constants );
+    CPPUNIT_TEST( aggregate );
+    CPPUNIT_TEST( mixture );
+    CPPUNIT_TEST( checkpoint );
+    CPPUNIT_TEST( checkpointfail );
+    CPPUNIT_TEST_SUITE_END();
+
+    jags::Module *_module;
+
+  public:
+    void setUp();
+    void tearDown();
+    void worklist();
+    void fuzzyhash();
+    void ambiguous();
+    void constants();
+    void aggregate();
+    void mixture();
+    void checkpoint();
+    void checkpointfail();
+};
+
+#endif  // BUGS_COMPILER_TEST_H
@@ -57,4 +57,21 @@ namespace dic {
 	}
     }
 
+    void DevianceMean::getState(vector<double> &state) const
+    {
+	state.clear();
+	state.push_back(_n);
+	state.insert(state.end(), _values.begin(), _values.end());
+    }
+
+    bool DevianceMean::setState(vector<double> const &state)
+    {
+	if (state.size() != 1 + _values.size()) {
+	    return false;
+	}
+	_n = static_cast<unsigned int>(state[0]);
+	copy(state.begin() + 1, state.end(), _values.begin());
+	return true;
+    }
+
 }}
@@ -20,6 +20,8 @@ namespace dic {
 	void update();
 	bool poolChains() const;
 	bool poolIterations() const;
+	void getState(std::vector<double> &state) const;
+	bool setState(std::vector<double> const &state);
     };
 
 }}
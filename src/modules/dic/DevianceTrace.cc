@@ -60,4 +60,26 @@ namespace dic {
 	return false;
     }
 
+    void DevianceTrace::getState(vector<double> &state) const
+    {
+	state.clear();
+	for (unsigned int ch = 0; ch < _values.size(); ++ch) {
+	    state.insert(state.end(), _values[ch].begin(), _values[ch].end());
+	}
+    }
+
+    bool DevianceTrace::setState(vector<double> const &state)
+    {
+	unsigned int nchain = _values.size();
+	if (state.size() % nchain != 0) {
+	    return false;
+	}
+	unsigned int n = state.size() / nchain;
+	for (unsigned int ch = 0; ch < nchain; ++ch) {
+	    _values[ch].assign(state.begin() + ch * n,
+			       state.begin() + (ch + 1) * n);
+	}
+	return true;
+    }
+
 }}
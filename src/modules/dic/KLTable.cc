@@ -0,0 +1,221 @@
+#include <config.h>
+
+#include "KLTable.h"
+#include <model/Model.h>
+#include <graph/StochasticNode.h>
+#include <graph/MixtureNode.h>
+#include <distribution/ScalarDist.h>
+#include <util/nainf.h>
+#include <util/ThreadPool.h>
+
+#include <map>
+#include <thread>
+#include <functional>
+#include <algorithm>
+
+using std::vector;
+using std::map;
+using std::thread;
+using std::min;
+using std::max;
+using std::exception_ptr;
+using std::current_exception;
+using std::rethrow_exception;
+using std::bind;
+using std::placeholders::_1;
+
+/* Number of nodes in each block */
+static const unsigned int BLOCK_SIZE = 4096;
+
+static unsigned int nblock(unsigned int nnode)
+{
+    return (nnode + BLOCK_SIZE - 1) / BLOCK_SIZE;
+}
+
+/* Number of threads for a table with the given number of blocks */
+static unsigned int nthreads(unsigned int nthread, unsigned int nblock)
+{
+    if (nthread == 0) {
+	nthread = thread::hardware_concurrency();
+    }
+    return max(min(nthread, nblock), 1U);
+}
+
+namespace jags {
+namespace dic {
+
+    KLTable::KLTable(vector<StochasticNode const *> const &snodes,
+		     vector<RNG *> const &rngs,
+		     vector<vector<RNG *> > const &substreams,
+		     unsigned int nrep, unsigned int nthread)
+	: _snodes(snodes), _nrep(nrep), _nchain(rngs.size()),
+	  _batched(snodes.size(), false), _blocks(nblock(snodes.size())),
+	  _kl(snodes.size() * rngs.size() * rngs.size(), 0),
+	  _nthread(nthreads(nthread, _blocks.size())),
+	  _parallel(!substreams.empty() && _nthread > 1),
+	  _pool(0), _next(0), _errors(_blocks.size())
+    {
+	for (unsigned int b = 0; b < _blocks.size(); ++b) {
+	    Block &block = _blocks[b];
+	    block.begin = b * BLOCK_SIZE;
+	    block.end = min(block.begin + BLOCK_SIZE,
+			    static_cast<unsigned int>(snodes.size()));
+	    block.rngs = substreams.empty() ? rngs : substreams[b];
+
+	    //Group untruncated scalar nodes by distribution
+	    map<ScalarDist const *, unsigned int> index;
+	    for (unsigned int k = block.begin; k < block.end; ++k) {
+		StochasticNode const *snode = snodes[k];
+		ScalarDist const *dist =
+		    dynamic_cast<ScalarDist const *>(snode->distribution());
+		if (!dist || dist->npar() == 0 ||
+		    snode->lowerBound() || snode->upperBound() ||
+		    hasIndexOnlyParent(snode))
+		{
+		    continue;
+		}
+		map<ScalarDist const *, unsigned int>::const_iterator j =
+		    index.find(dist);
+		if (j == index.end()) {
+		    index[dist] = block.groups.size();
+		    block.groups.push_back(Group());
+		    block.groups.back().dist = dist;
+		    block.groups.back().members.push_back(k);
+		}
+		else {
+		    block.groups[j->second].members.push_back(k);
+		}
+		_batched[k] = true;
+	    }
+
+	    unsigned int length = 0;
+	    for (unsigned int g = 0; g < block.groups.size(); ++g) {
+		Group &group = block.groups[g];
+		group.params.resize(_nchain);
+		for (unsigned int ch = 0; ch < _nchain; ++ch) {
+		    for (unsigned int i = 0; i < group.members.size(); ++i) {
+			vector<double const *> const &par =
+			    snodes[group.members[i]]->parameters(ch);
+			group.params[ch].insert(group.params[ch].end(),
+						par.begin(), par.end());
+		    }
+		}
+		length = max(length,
+			     static_cast<unsigned int>(group.members.size()));
+	    }
+	    block.scratch.resize(length);
+	}
+    }
+
+    KLTable::~KLTable()
+    {
+	delete _pool;
+    }
+
+    vector<vector<RNG *> > KLTable::substreams(Model *model,
+					       unsigned int nnode)
+    {
+	unsigned int nchain = model->nchain();
+	vector<vector<RNG *> > ans(nblock(nnode), vector<RNG *>(nchain));
+	for (unsigned int b = 0; b < ans.size(); ++b) {
+	    for (unsigned int ch = 0; ch < nchain; ++ch) {
+		ans[b][ch] = model->substreamRNG(ch, b);
+		if (ans[b][ch] == 0) {
+		    return vector<vector<RNG *> >();
+		}
+	    }
+	}
+	return ans;
+    }
+
+    void KLTable::updateBlock(Block &block)
+    {
+	unsigned int nch = _nchain;
+
+	//Exact divergences for the grouped nodes
+	for (unsigned int g = 0; g < block.groups.size(); ++g) {
+	    Group const &group = block.groups[g];
+	    vector<unsigned int> const &m = group.members;
+	    for (unsigned int i = 0; i < nch; ++i) {
+		for (unsigned int j = 0; j < nch; ++j) {
+		    if (i == j) continue;
+		    group.dist->KLBatch(&block.scratch[0],
+					&group.params[i][0],
+					&group.params[j][0], m.size());
+		    for (unsigned int r = 0; r < m.size(); ++r) {
+			_kl[(m[r] * nch + i) * nch + j] = block.scratch[r];
+		    }
+		}
+	    }
+	}
+
+	/*
+	   All other divergences are calculated node by node. The RNGs
+	   are called in the same order as they would be if all
+	   divergences were calculated this way.
+	*/
+	for (unsigned int k = block.begin; k < block.end; ++k) {
+	    StochasticNode const *snode = _snodes[k];
+	    double *kl = &_kl[k * nch * nch];
+	    for (unsigned int i = 0; i < nch; ++i) {
+		for (unsigned int j = 0; j < i; ++j) {
+		    if (!_batched[k] || kl[i * nch + j] == JAGS_NA) {
+			kl[i * nch + j] =
+			    snode->KL(i, j, block.rngs[i], _nrep);
+		    }
+		    if (!_batched[k] || kl[j * nch + i] == JAGS_NA) {
+			kl[j * nch + i] =
+			    snode->KL(j, i, block.rngs[j], _nrep);
+		    }
+		}
+	    }
+	}
+    }
+
+    void KLTable::work(unsigned int)
+    {
+	unsigned int b;
+	while ((b = _next++) < _blocks.size()) {
+	    try {
+		updateBlock(_blocks[b]);
+	    }
+	    catch (...) {
+		_errors[b] = current_exception();
+	    }
+	}
+    }
+
+    void KLTable::update()
+    {
+	if (!_parallel) {
+	    for (unsigned int b = 0; b < _blocks.size(); ++b) {
+		updateBlock(_blocks[b]);
+	    }
+	    return;
+	}
+
+	if (!_pool) {
+	    _pool = new ThreadPool(_nthread);
+	}
+	_next = 0;
+	_pool->run(bind(&KLTable::work, this, _1));
+
+	//Errors are reported for the first block, as in a serial update
+	exception_ptr error;
+	for (unsigned int b = 0; b < _errors.size(); ++b) {
+	    if (_errors[b] && !error) {
+		error = _errors[b];
+	    }
+	    _errors[b] = exception_ptr();
+	}
+	if (error) {
+	    rethrow_exception(error);
+	}
+    }
+
+    double const *KLTable::divergences(unsigned int k) const
+    {
+	return &_kl[k * _nchain * _nchain];
+    }
+
+}}
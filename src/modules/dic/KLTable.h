@@ -0,0 +1,113 @@
+#ifndef KL_TABLE_H_
+#define KL_TABLE_H_
+
+#include <vector>
+#include <atomic>
+#include <exception>
+
+namespace jags {
+
+    class ThreadPool;
+    class StochasticNode;
+    class ScalarDist;
+    class Model;
+    struct RNG;
+
+namespace dic {
+
+    /**
+     * @short Kullback-Leibler divergences between chains
+     *
+     * A KLTable holds the Kullback-Leibler divergences between the
+     * distributions of a set of observed stochastic nodes in each
+     * ordered pair of chains. It is used by the monitors for pD and
+     * popt.
+     *
+     * Untruncated scalar nodes are grouped by distribution, and the
+     * divergences for each group are calculated with a single call to
+     * ScalarDist#KLBatch. Nodes without an exact calculation use a
+     * Monte Carlo estimate.
+     *
+     * The nodes are divided into blocks of fixed size. If substreams
+     * of the chain RNGs are available then the blocks are evaluated in
+     * parallel, and block b draws its Monte Carlo replicates from
+     * substream b of each chain, so that the results do not depend on
+     * the number of threads. Otherwise the blocks are evaluated in
+     * turn using the chain RNGs, which are called in the same order as
+     * a node-by-node evaluation.
+     *
+     * The monitors update the table at every iteration, so the worker
+     * threads are started by the first parallel update and reused by
+     * all later ones.
+     */
+    class KLTable {
+	struct Group {
+	    ScalarDist const *dist;
+	    std::vector<unsigned int> members;
+	    std::vector<std::vector<double const *> > params;
+	};
+	struct Block {
+	    unsigned int begin, end;
+	    std::vector<Group> groups;
+	    std::vector<RNG *> rngs;
+	    std::vector<double> scratch;
+	};
+	std::vector<StochasticNode const *> _snodes;
+	unsigned int _nrep;
+	unsigned int _nchain;
+	std::vector<bool> _batched;
+	std::vector<Block> _blocks;
+	std::vector<double> _kl;
+	unsigned int _nthread;
+	bool _parallel;
+	ThreadPool *_pool;
+	std::atomic<unsigned int> _next;
+	std::vector<std::exception_ptr> _errors;
+	void updateBlock(Block &block);
+	void work(unsigned int worker);
+	/* Forbid copying */
+	KLTable(KLTable const &);
+	KLTable &operator=(KLTable const &);
+    public:
+	/**
+	 * @param snodes Observed stochastic nodes
+	 *
+	 * @param rngs RNGs for each chain
+	 *
+	 * @param substreams Substream RNGs for each block and chain, as
+	 * returned by the substreams function, or an empty vector.
+	 *
+	 * @param nrep Number of replicates for Monte Carlo estimates
+	 *
+	 * @param nthread Maximum number of threads used when substreams
+	 * are available. The default value of zero uses one thread per
+	 * hardware core.
+	 */
+	KLTable(std::vector<StochasticNode const *> const &snodes,
+		std::vector<RNG *> const &rngs,
+		std::vector<std::vector<RNG *> > const &substreams,
+		unsigned int nrep, unsigned int nthread = 0);
+	~KLTable();
+	/**
+	 * Returns the substreams of the chain RNGs for each block of a
+	 * table with the given number of nodes, or an empty vector if
+	 * the RNG of any chain has no substreams.
+	 */
+	static std::vector<std::vector<RNG *> >
+	    substreams(Model *model, unsigned int nnode);
+	/**
+	 * Recalculates the divergences for the current parameter values
+	 */
+	void update();
+	/**
+	 * Returns the divergences for node k as an nchain x nchain
+	 * array, in which element i * nchain + j is the divergence
+	 * StochasticNode#KL(i, j) for the node. The diagonal elements
+	 * are not set.
+	 */
+	double const *divergences(unsigned int k) const;
+    };
+
+}}
+
+#endif /* KL_TABLE_H_ */
@@ -3,7 +3,6 @@
 #include "PDMonitor.h"
 #include <graph/StochasticNode.h>
 #include <module/ModuleError.h>
-#include <rng/RNG.h>
 
 #include <algorithm>
 
@@ -24,10 +23,12 @@ namespace dic {
 
     PDMonitor::PDMonitor(vector<StochasticNode const *> const &snodes,
 			 vector<RNG *> const &rngs,
-			 unsigned int nrep, double scale)
-	: Monitor("mean", toNodeVec(snodes)), _snodes(snodes), _rngs(rngs),
-	  _nrep(nrep),
-	  _values(snodes.size(), 0),  _weights(snodes.size(), 0),
+			 vector<vector<RNG *> > const &substreams,
+			 unsigned int nrep, double scale,
+			 unsigned int nthread)
+	: Monitor("mean", toNodeVec(snodes)), _snodes(snodes),
+	  _table(snodes, rngs, substreams, nrep, nthread),
+	  _values(snodes.size(), 0),  _weights(snodes.size(), 0), _w(rngs.size()),
 	  _scale(scale), _nchain(rngs.size())
     {
 	if (_nchain < 2) {
@@ -61,17 +62,19 @@ namespace dic {
 
     void PDMonitor::update()
     {
-	vector<double> w(_nchain);
+	_table.update();
+
+	vector<double> &w = _w;
 	for (unsigned int k = 0; k < _values.size(); ++k) {
 	    
+	    double const *kl = _table.divergences(k);
 	    double pdsum = 0;
 	    double wsum = 0;
 	    for (unsigned int i = 0; i < _nchain; ++i) {
 		w[i] = weight(_snodes[k], i);
 		for (unsigned int j = 0; j < i; ++j) {
-		    pdsum += w[i] * w[j] * (
-			_snodes[k]->KL(i, j, _rngs[i], _nrep) +
-			_snodes[k]->KL(j, i, _rngs[j], _nrep));
+		    pdsum += w[i] * w[j] * (kl[i * _nchain + j] +
+					    kl[j * _nchain + i]);
 		    wsum += w[i] * w[j];
 		}
 	    }
@@ -89,4 +92,21 @@ namespace dic {
 	return 1;
     }
 
+    void PDMonitor::getState(vector<double> &state) const
+    {
+	state = _values;
+	state.insert(state.end(), _weights.begin(), _weights.end());
+    }
+
+    bool PDMonitor::setState(vector<double> const &state)
+    {
+	unsigned int n = _values.size();
+	if (state.size() != 2 * n) {
+	    return false;
+	}
+	copy(state.begin(), state.begin() + n, _values.begin());
+	copy(state.begin() + n, state.end(), _weights.begin());
+	return true;
+    }
+
 }}
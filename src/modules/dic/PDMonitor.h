@@ -2,6 +2,7 @@
 #define PD_MONITOR_H_
 
 #include <model/Monitor.h>
+#include "KLTable.h"
 
 #include <vector>
 
@@ -14,17 +15,19 @@ namespace dic {
 
     class PDMonitor : public Monitor {
 	std::vector<StochasticNode const *> _snodes;
-	std::vector<RNG *> _rngs;
-	unsigned int _nrep;
+	KLTable _table;
 	std::vector<double> _values;
 	std::vector<double> _weights;
+	std::vector<double> _w;
 	double _scale;
 	unsigned int _nchain;
 	unsigned int _n;
     public:
 	PDMonitor(std::vector<StochasticNode const *> const &snodes,
 		  std::vector<RNG *> const &rngs,
-		  unsigned int nrep, double scale=1);
+		  std::vector<std::vector<RNG *> > const &substreams,
+		  unsigned int nrep, double scale=1,
+		  unsigned int nthread=0);
 	~PDMonitor();
 	std::vector<unsigned int> dim() const;
 	std::vector<double> const &value(unsigned int chain) const;
@@ -33,6 +36,8 @@ namespace dic {
 	void update();
 	virtual double weight(StochasticNode const *snode,
 			      unsigned int ch) const;
+	void getState(std::vector<double> &state) const;
+	bool setState(std::vector<double> const &state);
     };
 
 }}
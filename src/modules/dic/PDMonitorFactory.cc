@@ -61,12 +61,15 @@ namespace dic {
 	    rngs.push_back(model->rng(i));
 	}
 
+	vector<vector<RNG*> > substreams =
+	    KLTable::substreams(model, observed_nodes.size());
+
 	Monitor *m = 0;
 	if (name =="pD") {
-	    m = new PDMonitor(observed_nodes, rngs, 10);
+	    m = new PDMonitor(observed_nodes, rngs, substreams, 10);
 	}
 	else if (name == "popt") {
-	    m = new PoptMonitor(observed_nodes, rngs, 10);
+	    m = new PoptMonitor(observed_nodes, rngs, substreams, 10);
 	}
 	if (m) {
 	    m->setName(name);
@@ -22,9 +22,11 @@ static vector<Node const *> toNodeVec(vector<StochasticNode const *> const &s)
 namespace dic {
 
     PDTrace::PDTrace(vector<StochasticNode const *> const &snodes,
-		     vector<RNG *> const &rngs, unsigned int nrep)
+		     vector<RNG *> const &rngs,
+		     vector<vector<RNG *> > const &substreams,
+		     unsigned int nrep, unsigned int nthread)
 	: Monitor("trace", toNodeVec(snodes)),
-	  _snodes(snodes), _rngs(rngs), _nrep(nrep),
+	  _snodes(snodes), _table(snodes, rngs, substreams, nrep, nthread),
 	  _nchain(rngs.size()),  _values()
     {
 	if (_nchain < 2) {
@@ -58,12 +60,15 @@ namespace dic {
 
     void PDTrace::update()
     {
+	_table.update();
+
 	double pd = 0;
 	for (unsigned int k = 0; k < _snodes.size(); ++k) {
+	    double const *kl = _table.divergences(k);
 	    for (unsigned int i = 0; i < _nchain; ++i) {
 		for (unsigned int j = 0; j < i; ++j) {
-		    pd += _snodes[k]->KL(i, j, _rngs[i], _nrep);
-		    pd += _snodes[k]->KL(j, i, _rngs[j], _nrep);
+		    pd += kl[i * _nchain + j];
+		    pd += kl[j * _nchain + i];
 		}
 	    }
 	}
@@ -71,4 +76,15 @@ namespace dic {
 	_values.push_back(pd);
     }
 
+    void PDTrace::getState(vector<double> &state) const
+    {
+	state = _values;
+    }
+
+    bool PDTrace::setState(vector<double> const &state)
+    {
+	_values = state;
+	return true;
+    }
+
 }}
@@ -2,6 +2,7 @@
 #define PD_TRACE_H_
 
 #include <model/Monitor.h>
+#include "KLTable.h"
 
 #include <vector>
 
@@ -14,20 +15,23 @@ namespace dic {
 
     class PDTrace : public Monitor {
 	std::vector<StochasticNode const *> _snodes;
-	std::vector<RNG *> _rngs;
-	unsigned int _nrep;
+	KLTable _table;
 	unsigned int _nchain;
 	std::vector<double> _values;
 
     public:
 	PDTrace(std::vector<StochasticNode const *> const &snodes,
-		std::vector<RNG*> const &rngs, unsigned int nrep);
+		std::vector<RNG*> const &rngs,
+		std::vector<std::vector<RNG*> > const &substreams,
+		unsigned int nrep, unsigned int nthread=0);
 	~PDTrace();
 	std::vector<unsigned int> dim() const;
 	std::vector<double> const &value(unsigned int chain) const;
 	bool poolChains() const;
 	bool poolIterations() const;
 	void update();
+	void getState(std::vector<double> &state) const;
+	bool setState(std::vector<double> const &state);
     };
 
 }}
@@ -55,7 +55,10 @@ namespace dic {
 	    rngs.push_back(model->rng(i));
 	}
 
-	Monitor *m  = new PDTrace(observed_nodes, rngs, 10);
+	vector<vector<RNG*> > substreams =
+	    KLTable::substreams(model, observed_nodes.size());
+
+	Monitor *m  = new PDTrace(observed_nodes, rngs, substreams, 10);
 	m->setName("pD");
 	m->setElementNames(vector<string>(1,"pD"));
 	return m;
@@ -12,8 +12,10 @@ namespace jags {
 namespace dic {
 
     PoptMonitor::PoptMonitor(vector<StochasticNode const *> const &snodes,
-			     vector<RNG *> const &rngs, unsigned int nrep)
-	: PDMonitor(snodes, rngs, nrep, 2.0)
+			     vector<RNG *> const &rngs,
+			     vector<vector<RNG *> > const &substreams,
+			     unsigned int nrep, unsigned int nthread)
+	: PDMonitor(snodes, rngs, substreams, nrep, 2.0, nthread)
     {
     }
 
@@ -15,7 +15,9 @@ namespace dic {
 	std::vector<StochasticNode const*> _snodes;
     public:
 	PoptMonitor(std::vector<StochasticNode const *> const &snodes,
-		    std::vector<RNG*> const &rngs, unsigned int nrep);
+		    std::vector<RNG*> const &rngs,
+		    std::vector<std::vector<RNG*> > const &substreams,
+		    unsigned int nrep, unsigned int nthread=0);
 	double weight(StochasticNode const *snode, unsigned int ch) const;
     };
 
@@ -0,0 +1,7 @@
+#include "testdic.h"
+#include "testkltable.h"
+#include <cppunit/extensions/HelperMacros.h>
+
+void init_dic_test() {
+    CPPUNIT_TEST_SUITE_REGISTRATION( KLTableTest );
+}
@@ -0,0 +1,109 @@
+#include <config.h>
+#include "testkltable.h"
+
+#include "KLTable.h"
+#include <bugs/distributions/DNorm.h>
+#include <philox/PhiloxFactory.h>
+#include <model/Model.h>
+#include <graph/ConstantNode.h>
+#include <graph/ScalarStochasticNode.h>
+#include <rng/RNG.h>
+
+#include <vector>
+
+using std::vector;
+
+using jags::Node;
+using jags::ConstantNode;
+using jags::StochasticNode;
+using jags::ScalarStochasticNode;
+using jags::RNG;
+using jags::dic::KLTable;
+using jags::philox::PhiloxFactory;
+
+static const unsigned int NCHAIN = 3;
+/* Enough nodes for more than 7 blocks of 4096 */
+static const unsigned int NNODE = 30000;
+static const unsigned int NBLOCK = 8;
+
+/*
+   Updates a table twice, using substreams of the philox RNGs, and
+   returns the divergences for all nodes after each update.
+*/
+static vector<double>
+divergences(vector<StochasticNode const *> const &snodes,
+	    unsigned int nthread)
+{
+    PhiloxFactory factory;
+    factory.setSeed(271828);
+    vector<RNG *> rngs = factory.makeRNGs(NCHAIN);
+    vector<vector<RNG *> > substreams(NBLOCK, vector<RNG *>(NCHAIN));
+    for (unsigned int b = 0; b < NBLOCK; ++b) {
+	for (unsigned int ch = 0; ch < NCHAIN; ++ch) {
+	    substreams[b][ch] = factory.makeSubstream(rngs[ch], b);
+	}
+    }
+
+    KLTable table(snodes, rngs, substreams, 10, nthread);
+    vector<double> ans;
+    for (unsigned int i = 0; i < 2; ++i) {
+	table.update();
+	for (unsigned int k = 0; k < snodes.size(); ++k) {
+	    double const *kl = table.divergences(k);
+	    ans.insert(ans.end(), kl, kl + NCHAIN * NCHAIN);
+	}
+    }
+    return ans;
+}
+
+void KLTableTest::threads()
+{
+    /*
+       Normal nodes with a mean that differs between chains. Every
+       third node is truncated, so that its divergences are Monte
+       Carlo estimates. The others are calculated in batches.
+    */
+    jags::bugs::DNorm dnorm;
+    jags::Model model(NCHAIN);
+    ConstantNode *zero = new ConstantNode(0, NCHAIN, true);
+    ConstantNode *one = new ConstantNode(1, NCHAIN, true);
+    model.addNode(zero);
+    model.addNode(one);
+
+    vector<Node const *> prior(2);
+    prior[0] = zero;
+    prior[1] = one;
+    ScalarStochasticNode *mu =
+	new ScalarStochasticNode(&dnorm, NCHAIN, prior, 0, 0);
+    model.addNode(mu);
+    for (unsigned int ch = 0; ch < NCHAIN; ++ch) {
+	double v = 0.5 * ch;
+	mu->setValue(&v, 1, ch);
+    }
+
+    vector<Node const *> par(2);
+    par[0] = mu;
+    par[1] = one;
+    vector<StochasticNode const *> snodes(NNODE);
+    for (unsigned int k = 0; k < NNODE; ++k) {
+	StochasticNode *y = new ScalarStochasticNode(&dnorm, NCHAIN, par,
+						     k % 3 ? 0 : zero, 0);
+	double v = (k % 7) / 7.0;
+	y->setData(&v, 1);
+	model.addNode(y);
+	snodes[k] = y;
+    }
+
+    //Results with any number of threads equal the serial ones
+    vector<double> serial = divergences(snodes, 1);
+    unsigned int nthread[3] = {3, 4, 7};
+    for (unsigned int i = 0; i < 3; ++i) {
+	CPPUNIT_ASSERT(divergences(snodes, nthread[i]) == serial);
+    }
+
+    //The Monte Carlo estimates differ between the two updates
+    unsigned int length = NNODE * NCHAIN * NCHAIN;
+    CPPUNIT_ASSERT(serial[1] != serial[length + 1]);
+    CPPUNIT_ASSERT(serial[NCHAIN * NCHAIN + 1] ==
+		   serial[length + NCHAIN * NCHAIN + 1]);
+}
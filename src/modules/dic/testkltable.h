@@ -0,0 +1,16 @@
+#ifndef KL_TABLE_TEST_H_
+#define KL_TABLE_TEST_H_
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class KLTableTest : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE( KLTableTest );
+    CPPUNIT_TEST( threads );
+    CPPUNIT_TEST_SUITE_END();
+
+  public:
+    void threads();
+};
+
+#endif /* KL_TABLE_TEST_H_ */
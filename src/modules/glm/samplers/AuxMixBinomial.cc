@@ -66,6 +66,40 @@ namespace glm {
 	_mix->update(_y_star - _lp, _nb, rng);
     }
 
+    void AuxMixBinomial::updateBatch(Outcome * const *batch, unsigned int n,
+				     RNG *rng)
+    {
+	/* 
+	   The random variables for a chunk of outcomes are drawn in
+	   one loop, in the same order as by update(RNG*). The
+	   aggregated utilities and mixture components are then
+	   calculated in a second loop that does not use the RNG.
+	*/
+	double u[CHUNK], v[CHUNK], w[CHUNK];
+	for (unsigned int i0 = 0; i0 < n; i0 += CHUNK) {
+	    unsigned int m = n - i0 < CHUNK ? n - i0 : CHUNK;
+	    for (unsigned int i = 0; i < m; ++i) {
+		AuxMixBinomial *o = static_cast<AuxMixBinomial*>(batch[i0 + i]);
+		if (o->_nb == 0) 
+		    continue;
+		u[i] = rgamma(o->_nb, 1.0, rng);
+		v[i] = 0.0;
+		if (static_cast<int>(o->_y) < static_cast<int>(o->_nb)) {
+		    v[i] = rgamma(o->_nb - o->_y, 1.0, rng);
+		}
+		w[i] = rng->uniform();
+	    }
+	    for (unsigned int i = 0; i < m; ++i) {
+		AuxMixBinomial *o = static_cast<AuxMixBinomial*>(batch[i0 + i]);
+		if (o->_nb == 0) 
+		    continue;
+		double lambda = exp(o->_lp);
+		o->_y_star = -log(u[i] / (1.0 + lambda) + v[i] / lambda);
+		o->_mix->select(o->_y_star - o->_lp, o->_nb, w[i]);
+	    }
+	}
+    }
+
     double AuxMixBinomial::value() const
     {
 	if (_nb == 0) {
@@ -37,6 +37,11 @@ namespace glm {
 	 * given y and calculates a new normal mixture approximation
 	 */
 	void update(RNG *rng);
+	/**
+	 * Updates a batch of AuxMixBinomial outcomes, giving the
+	 * same result as calling update for each outcome in turn.
+	 */
+	void updateBatch(Outcome * const *batch, unsigned int n, RNG *rng);
 	/**
 	 * Returns the residual of the auxiliary variable according to
 	 * the current normal approximation
@@ -44,6 +44,42 @@ namespace glm {
 	_mix1->update(-log(_tau1) - _lp, 1, rng);
     }
 
+    void AuxMixPoisson::updateBatch(Outcome * const *batch, unsigned int n,
+				    RNG *rng)
+    {
+	/*
+	   The random variables for a chunk of outcomes are drawn in
+	   one loop, in the same order as by update(RNG*). The
+	   inter-arrival times and mixture components are then
+	   calculated in a second loop that does not use the RNG.
+	*/
+	double tau2[CHUNK], u2[CHUNK], e[CHUNK], u1[CHUNK];
+	for (unsigned int i0 = 0; i0 < n; i0 += CHUNK) {
+	    unsigned int m = n - i0 < CHUNK ? n - i0 : CHUNK;
+	    for (unsigned int i = 0; i < m; ++i) {
+		AuxMixPoisson *o = static_cast<AuxMixPoisson*>(batch[i0 + i]);
+		if (o->_y == 0) {
+		    tau2[i] = 0;
+		}
+		else {
+		    tau2[i] = rbeta(o->_y, 1, rng);
+		    u2[i] = rng->uniform();
+		}
+		e[i] = rng->exponential();
+		u1[i] = rng->uniform();
+	    }
+	    for (unsigned int i = 0; i < m; ++i) {
+		AuxMixPoisson *o = static_cast<AuxMixPoisson*>(batch[i0 + i]);
+		o->_tau2 = tau2[i];
+		if (o->_y != 0) {
+		    o->_mix2->select(-log(o->_tau2) - o->_lp, o->_y, u2[i]);
+		}
+		o->_tau1 = 1 - o->_tau2 + e[i] / exp(o->_lp);
+		o->_mix1->select(-log(o->_tau1) - o->_lp, 1, u1[i]);
+	    }
+	}
+    }
+
     /*
     void AuxMixPoisson::update(double mean, double var, RNG *rng)
     {
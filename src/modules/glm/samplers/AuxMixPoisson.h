@@ -42,6 +42,11 @@ namespace glm {
 	 * normal approximation
 	 */
 	void update(RNG *rng);
+	/**
+	 * Updates a batch of AuxMixPoisson outcomes, giving the same
+	 * result as calling update for each outcome in turn.
+	 */
+	void updateBatch(Outcome * const *batch, unsigned int n, RNG *rng);
 	/**
 	 * Returns a weighted mean of the residuals from the current
 	 * normal approximation. The residuals are weighted by their
@@ -12,6 +12,7 @@
 using std::exp;
 using std::log;
 using std::sqrt;
+using std::vector;
 
 #define REG_PENALTY 0.001
 
@@ -65,6 +66,35 @@ namespace glm {
 
     }
 
+    void BinaryLogit::updateBatch(Outcome * const *batch, unsigned int n,
+				  RNG *rng)
+    {
+	/*
+	   The truncation points of the latent logistic variables, on
+	   the probability scale, are calculated for a chunk of outcomes
+	   in a loop that does not use the RNG. Then the draws are made
+	   in the same order as by update(RNG*).
+	*/
+	double lp[CHUNK], q[CHUNK];
+	for (unsigned int i0 = 0; i0 < n; i0 += CHUNK) {
+	    unsigned int m = n - i0 < CHUNK ? n - i0 : CHUNK;
+	    for (unsigned int i = 0; i < m; ++i) {
+		lp[i] = static_cast<BinaryLogit*>(batch[i0 + i])->_lp;
+	    }
+	    for (unsigned int i = 0; i < m; ++i) {
+		q[i] = 1/(1 + exp(lp[i]));
+	    }
+	    for (unsigned int i = 0; i < m; ++i) {
+		BinaryLogit *o = static_cast<BinaryLogit*>(batch[i0 + i]);
+		double x = o->_y ? q[i] + (1 - q[i]) * rng->uniform() :
+		    q[i] * rng->uniform();
+		o->_z = lp[i] + log(x) - log(1 - x);
+		o->_sigma2 = sample_lambda(o->_z - lp[i], rng);
+		o->_tau = REG_PENALTY + 1/o->_sigma2;
+	    }
+	}
+    }
+
     void BinaryLogit::update(double mean, double var, RNG *rng)
     {
 	/* Holmes-Held update */
@@ -102,4 +132,18 @@ namespace glm {
 	return getLink(snode) == LNK_LOGIT;
     }
 
+    void BinaryLogit::getState(vector<double> &state) const
+    {
+	state.push_back(_z);
+	state.push_back(_tau);
+	state.push_back(_sigma2);
+    }
+
+    void BinaryLogit::setState(vector<double> const &state, unsigned int &pos)
+    {
+	_z = state[pos++];
+	_tau = state[pos++];
+	_sigma2 = state[pos++];
+    }
+
 }}
@@ -35,8 +35,11 @@ namespace glm {
 	double value() const;
 	double precision() const;
 	void update(RNG *rng);
+	void updateBatch(Outcome * const *batch, unsigned int n, RNG *rng);
 	void update(double mean, double var, RNG *rng);
 	static bool canRepresent(StochasticNode const *snode);
+	void getState(std::vector<double> &state) const;
+	void setState(std::vector<double> const &state, unsigned int &pos);
     };
 
 }}
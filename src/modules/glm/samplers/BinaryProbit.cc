@@ -7,6 +7,7 @@
 #include <cmath>
 
 using std::sqrt;
+using std::vector;
 
 namespace jags {
 namespace glm {
@@ -37,6 +38,22 @@ namespace glm {
 	}
     }
 
+    void BinaryProbit::updateBatch(Outcome * const *batch, unsigned int n,
+				   RNG *rng)
+    {
+	// There are no calculations to separate from the draws, but
+	// a single loop saves a virtual function call per outcome
+	for (unsigned int i = 0; i < n; ++i) {
+	    BinaryProbit *o = static_cast<BinaryProbit*>(batch[i]);
+	    if (o->_y) {
+		o->_z = lnormal(0, rng, o->_lp, 1);
+	    }
+	    else {
+		o->_z = rnormal(0, rng, o->_lp, 1);
+	    }
+	}
+    }
+
     void BinaryProbit::update(double mean, double var, RNG *rng)
     {
 	if (_y) {
@@ -76,4 +93,14 @@ namespace glm {
 	return true;
     }
 
+    void BinaryProbit::getState(vector<double> &state) const
+    {
+	state.push_back(_z);
+    }
+
+    void BinaryProbit::setState(vector<double> const &state, unsigned int &pos)
+    {
+	_z = state[pos++];
+    }
+
 }}
@@ -43,4 +43,9 @@ namespace glm {
 	}
     }
 
+    void ConjugateFSampler::updateChain(unsigned int chain, RNG *rng)
+    {
+	_methods[chain]->update(rng);
+    }
+
 }}
@@ -25,6 +25,7 @@ namespace glm {
 			  std::vector<ConjugateFMethod*> const &methods);
 	~ConjugateFSampler();
 	void update(std::vector<RNG*> const &rngs);
+	void updateChain(unsigned int chain, RNG *rng);
 	/**
 	 * Returns false. This is not an adaptive sampler
 	 */
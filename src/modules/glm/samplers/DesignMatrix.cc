@@ -0,0 +1,134 @@
+#include <config.h>
+
+#include "DesignMatrix.h"
+
+#include <sampler/GraphView.h>
+#include <sampler/SingletonGraphView.h>
+#include <graph/StochasticNode.h>
+#include <module/ModuleError.h>
+
+#include <map>
+#include <set>
+#include <algorithm>
+
+using std::vector;
+using std::set;
+using std::map;
+using std::copy;
+
+namespace jags {
+
+static void getIndices(set<StochasticNode *> const &schildren,
+		       vector<StochasticNode *> const &rows,
+		       vector<int> &indices)
+{
+    indices.clear();
+
+    for (unsigned int i = 0; i < rows.size(); ++i) {
+	if (schildren.count(rows[i])) {
+	    indices.push_back(i);
+	}
+    }
+
+    if (indices.size() != schildren.size()) {
+	throwLogicError("Size mismatch in getIndices");
+    }
+}
+
+namespace glm {
+
+    typedef map<GraphView const *, DesignMatrix *> DesignMap;
+
+    static DesignMap &designMap()
+    {
+	static DesignMap _map;
+	return _map;
+    }
+
+    DesignMatrix::DesignMatrix(GraphView const *view,
+			       vector<SingletonGraphView const *> const
+			       &sub_views)
+	: _view(view), _wk(new cholmod_common), _x(0), _nref(1)
+    {
+	cholmod_start(_wk);
+
+	vector<StochasticNode *> const &schildren =
+	    view->stochasticChildren();
+
+	int nrow = schildren.size();
+	int ncol = view->length();
+
+	vector<int> Xp(ncol + 1);
+	vector<int> Xi;
+
+	int c = 0; //column counter
+	int r = 0; //count of number of non-zero entries
+
+	for (unsigned int p = 0; p < sub_views.size(); ++p) {
+
+	    set<StochasticNode *> children_p;
+	    children_p.insert(sub_views[p]->stochasticChildren().begin(),
+			      sub_views[p]->stochasticChildren().end());
+	    vector<int> indices;
+	    getIndices(children_p, schildren, indices);
+
+	    unsigned int length = sub_views[p]->length();
+	    for (unsigned int i = 0; i < length; ++i, ++c) {
+		Xp[c] = r;
+		for (unsigned int j = 0; j < indices.size(); ++j, ++r) {
+		    Xi.push_back(indices[j]);
+		}
+	    }
+	}
+	Xp[c] = r;
+
+	//Set up sparse representation of the design matrix
+	_x = cholmod_allocate_sparse(nrow, ncol, r, 1, 1, 0, CHOLMOD_REAL,
+				     _wk);
+	copy(Xp.begin(), Xp.end(), static_cast<int*>(_x->p));
+	copy(Xi.begin(), Xi.end(), static_cast<int*>(_x->i));
+    }
+
+    DesignMatrix::~DesignMatrix()
+    {
+	cholmod_free_sparse(&_x, _wk);
+	cholmod_finish(_wk);
+	delete _wk;
+    }
+
+    DesignMatrix *DesignMatrix::attach(GraphView const *view)
+    {
+	DesignMap::const_iterator p = designMap().find(view);
+	if (p == designMap().end()) {
+	    return 0;
+	}
+	p->second->_nref++;
+	return p->second;
+    }
+
+    DesignMatrix *
+    DesignMatrix::create(GraphView const *view,
+			 vector<SingletonGraphView const *> const &sub_views)
+    {
+	if (designMap().count(view)) {
+	    throwLogicError("Design matrix already exists");
+	}
+	DesignMatrix *design = new DesignMatrix(view, sub_views);
+	designMap()[view] = design;
+	return design;
+    }
+
+    void DesignMatrix::detach(DesignMatrix *design)
+    {
+	if (--design->_nref == 0) {
+	    designMap().erase(design->_view);
+	    delete design;
+	}
+    }
+
+    cholmod_sparse *DesignMatrix::matrix() const
+    {
+	return _x;
+    }
+
+}}
@@ -0,0 +1,80 @@
+#ifndef DESIGN_MATRIX_H_
+#define DESIGN_MATRIX_H_
+
+#include <vector>
+
+extern "C" {
+#include <cholmod.h>
+}
+
+namespace jags {
+
+    class GraphView;
+    class SingletonGraphView;
+
+namespace glm {
+
+    /**
+     * @short Design matrix shared by the chains of a GLM sampler
+     *
+     * Each chain is updated by its own GLMMethod, but the sparsity
+     * pattern of the design matrix, and the columns for sampled
+     * nodes with fixed linear terms, are the same for all chains. A
+     * DesignMatrix holds a single copy of them, which is shared by
+     * all GLMMethod objects that sample the same GraphView.
+     *
+     * DesignMatrix objects are reference counted. They are created
+     * by the first GLMMethod for a given GraphView, and deleted when
+     * the last one is destroyed.  The static member functions are
+     * not thread-safe, but they are only called when sampling
+     * methods are created and deleted, which is done serially.
+     */
+    class DesignMatrix {
+	GraphView const *_view;
+	cholmod_common *_wk;
+	cholmod_sparse *_x;
+	unsigned int _nref;
+	DesignMatrix(GraphView const *view,
+		     std::vector<SingletonGraphView const *> const &sub_views);
+	~DesignMatrix();
+	// Forbid copying
+	DesignMatrix(DesignMatrix const &);
+	DesignMatrix &operator=(DesignMatrix const &);
+      public:
+	/**
+	 * Returns the design matrix for the given GraphView, if it
+	 * exists, and increments its reference count. Otherwise a
+	 * null pointer is returned.
+	 */
+	static DesignMatrix *attach(GraphView const *view);
+	/**
+	 * Creates the design matrix for the given GraphView, with a
+	 * reference count of one. The sparsity pattern is
+	 * calculated, but the values are not set.
+	 *
+	 * @param view GraphView for all sampled nodes
+	 *
+	 * @param sub_views Vector of pointers to SingletonGraphView
+	 * objects for each sampled node.
+	 */
+	static DesignMatrix *
+	    create(GraphView const *view,
+		   std::vector<SingletonGraphView const *> const &sub_views);
+	/**
+	 * Decrements the reference count of the design matrix, and
+	 * deletes it when it reaches zero.
+	 */
+	static void detach(DesignMatrix *design);
+	/**
+	 * Returns the design matrix. The values are calculated by the
+	 * GLMMethod that created it, before any other GLMMethod is
+	 * attached, and are read-only thereafter, except when they
+	 * are restored by GLMMethod#setState.  Only the columns for
+	 * fixed linear terms are valid for all chains.
+	 */
+	cholmod_sparse *matrix() const;
+    };
+
+}}
+
+#endif /* DESIGN_MATRIX_H_ */
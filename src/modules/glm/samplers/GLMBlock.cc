@@ -13,20 +13,45 @@
 using std::vector;
 using std::sqrt;
 
-extern cholmod_common *glm_wk;
-
 namespace jags {
 
 namespace glm {
 
+    /*
+      When the factor is simplicial, cholmod_solve2 reshapes its
+      workspace Y to fit the right hand side, so that it no longer
+      matches the size requested on the next call and is reallocated
+      every time. Restoring the original shape allows Y to be reused.
+    */
+    static void restoreShape(cholmod_dense *Y)
+    {
+	if (Y && Y->ncol > 0) {
+	    Y->nrow = Y->d = Y->nzmax / Y->ncol;
+	}
+    }
+
     GLMBlock::GLMBlock(GraphView const *view, 
 			 vector<SingletonGraphView const *> const &sub_views,
 			 vector<Outcome *> const &outcomes,
-			 unsigned int chain)
-	: GLMMethod(view, sub_views, outcomes, chain)
+			 unsigned int chain, bool simplicial)
+	: GLMMethod(view, sub_views, outcomes, chain),
+	  _w(0), _u1(0), _u2(0), _Y(0), _E(0)
     {
 	calDesign();
-	symbolic();
+	symbolic(simplicial);
+
+	// Dense vectors are allocated once and reused by cholmod_solve2
+	unsigned int nrow = _view->length();
+	_w = cholmod_allocate_dense(nrow, 1, nrow, CHOLMOD_REAL, workspace());
+    }
+
+    GLMBlock::~GLMBlock()
+    {
+	cholmod_free_dense(&_w, workspace());
+	cholmod_free_dense(&_u1, workspace());
+	cholmod_free_dense(&_u2, workspace());
+	cholmod_free_dense(&_Y, workspace());
+	cholmod_free_dense(&_E, workspace());
     }
 
     void GLMBlock::update(RNG *rng) 
@@ -40,46 +65,37 @@ namespace glm {
 	//   of the sampled nodes, as the origin
 
 	// Update outcomes
-	for (vector<Outcome*>::const_iterator p = _outcomes.begin();
-	     p != _outcomes.end(); ++p)
-	{
-	    (*p)->update(rng);
-	}
+	updateOutcomes(rng);
 	
-	double *b = 0;
-	cholmod_sparse *A = 0;
-	calCoef(b, A);
-	
-	// Get LDL' decomposition of posterior precision
-	A->stype = -1;
-	int ok = cholmod_factorize(A, _factor, glm_wk);
-	cholmod_free_sparse(&A, glm_wk);
-	if (!ok) {
-	    throwRuntimeError("Cholesky decomposition failure in GLMBlock");
-	}
+	updateFactor();
 
-	// Use the LDL' decomposition to generate a new sample
+	// Use the decomposition to generate a new sample
 	// with mean mu such that A %*% mu = b and precision A. 
 	
 	unsigned int nrow = _view->length();
-	cholmod_dense *w = cholmod_allocate_dense(nrow, 1, nrow, CHOLMOD_REAL, 
-						  glm_wk);
+	double *b = &_b[0];
 
 	// Permute RHS
-	double *wx = static_cast<double*>(w->x);
+	double *wx = static_cast<double*>(_w->x);
 	int *perm = static_cast<int*>(_factor->Perm);
 	for (unsigned int i = 0; i < nrow; ++i) {
 	    wx[i] = b[perm[i]];
 	}
 
-	cholmod_dense *u1 = cholmod_solve(CHOLMOD_L, _factor, w, glm_wk);
-	updateAuxiliary(u1, _factor, rng);
+	cholmod_solve2(CHOLMOD_L, _factor, _w, 0, &_u1, 0, &_Y, &_E,
+		       workspace());
+	restoreShape(_Y);
+	updateAuxiliary(_u1, _factor, rng);
 
-	double *u1x = static_cast<double*>(u1->x);
+	// The right hand side is no longer needed, so _w is reused
+	// to hold a vector of independent standard normal variables
+	rng->normal(wx, nrow);
+
+	double *u1x = static_cast<double*>(_u1->x);
 	if (_factor->is_ll) {
 	    // LL' decomposition
 	    for (unsigned int r = 0; r < nrow; ++r) {
-		u1x[r] += rng->normal();
+		u1x[r] += wx[r];
 	    }
 	}
 	else {
@@ -88,22 +104,20 @@ namespace glm {
 	    int *fp = static_cast<int*>(_factor->p);
 		double *fx = static_cast<double*>(_factor->x);
 		for (unsigned int r = 0; r < nrow; ++r) {
-		    u1x[r] += rng->normal() * sqrt(fx[fp[r]]);
+		    u1x[r] += wx[r] * sqrt(fx[fp[r]]);
 		}
 	}
 
-	cholmod_dense *u2 = cholmod_solve(CHOLMOD_DLt, _factor, u1, glm_wk);
+	cholmod_solve2(CHOLMOD_DLt, _factor, _u1, 0, &_u2, 0, &_Y, &_E,
+		       workspace());
+	restoreShape(_Y);
 
 	// Permute solution
-	double *u2x = static_cast<double*>(u2->x);
+	double *u2x = static_cast<double*>(_u2->x);
 	for (unsigned int i = 0; i < nrow; ++i) {
 	    b[perm[i]] = u2x[i];
 	}
 
-	cholmod_free_dense(&w, glm_wk);
-	cholmod_free_dense(&u1, glm_wk);
-	cholmod_free_dense(&u2, glm_wk);
-
 	//Shift origin back to original scale
 	int r = 0;
 	for (vector<StochasticNode*>::const_iterator p = 
@@ -117,7 +131,6 @@ namespace glm {
 	}
 
 	_view->setValue(b, nrow, _chain);
-	delete [] b;
     }
 
     void GLMBlock::updateAuxiliary(cholmod_dense *b, cholmod_factor *N,
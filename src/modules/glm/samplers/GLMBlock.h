@@ -32,6 +32,7 @@ namespace glm {
      * relying on asymptotic approximations.
      */
     class GLMBlock : public GLMMethod {
+	cholmod_dense *_w, *_u1, *_u2, *_Y, *_E;
     public:
 	/**
 	 * Constructor.
@@ -55,16 +56,31 @@ namespace glm {
 	 * valid GLM. If link is true then the last deterministic
 	 * descendents in view (i.e. those with no deterministic
 	 * descendants) may be link nodes.
+	 *
+	 * @param simplicial Flag that forces the use of a simplicial
+	 * factorization of the posterior precision, even for large
+	 * blocks. Sub-classes must set this to true if their
+	 * implementation of updateAuxiliary solves equations with
+	 * sparse right hand sides.
+	 *
+	 * @see GLMMethod#setSupernodalLength
 	 */
 	GLMBlock(GraphView const *view, 
 		 std::vector<SingletonGraphView const *> const &sub_views,
 		 std::vector<Outcome *> const &outcomes,
-		 unsigned int chain);
+		 unsigned int chain, bool simplicial = false);
+	/**
+	 * Destructor. Frees the dense vectors reused by update.
+	 */
+	~GLMBlock();
 	/**
 	 * Updates the regression parameters by treating the GLM as a
 	 * linear model (LM).  All regression parameters are updated
 	 * together in a block.
 	 *
+	 * All the storage needed for the update is allocated by the
+	 * constructor, or on the first call, and reused thereafter.
+	 *
 	 * @param rng Random number generator used for sampling
 	 */
 	void update(RNG *rng);
@@ -8,6 +8,7 @@
 #include <graph/StochasticNode.h>
 #include <graph/DeterministicNode.h>
 #include <graph/LinkNode.h>
+#include <graph/MixtureNode.h>
 #include <distribution/Distribution.h>
 #include <sampler/Linear.h>
 #include <sampler/GraphView.h>
@@ -228,6 +229,9 @@ namespace glm {
 	    if (fixedOutcome() && !isObserved(stoch_nodes[i])) {
 		return false; //Unobserved outcome not allowed by sampler
 	    }
+	    if (hasIndexOnlyParent(stoch_nodes[i])) {
+		return false; //Outcome keeps pointers to the parameters
+	    }
 	    //Check that other parameters do not depend on snode	    
 	    vector<Node const *> const &param = stoch_nodes[i]->parents();
 	    for (unsigned int j = 1; j < param.size(); ++j) {
@@ -279,7 +283,7 @@ namespace glm {
     {}
     
     Sampler * 
-    GLMFactory::makeSampler(list<StochasticNode*> const &free_nodes, 
+    GLMFactory::makeSampler(FreeNodeSet const &free_nodes, 
 			    Graph const &graph, bool gibbs) const
     {
 	// Find candidate nodes that could be part of a GLM.
@@ -414,7 +418,7 @@ namespace glm {
     }
 
     vector<Sampler*>  
-    GLMFactory::makeSamplers(list<StochasticNode*> const &nodes, 
+    GLMFactory::makeSamplers(FreeNodeSet const &nodes, 
 			     Graph const &graph) const
     {
 	if (Sampler *s = makeSampler(nodes, graph, false)) {
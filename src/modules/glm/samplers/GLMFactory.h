@@ -34,14 +34,14 @@ namespace glm {
 	 * or a NULL pointer. Sub-classes of GLMFactory only have to
 	 * implement the abstract member function newMethod.
 	 */
-	Sampler * makeSampler(std::list<StochasticNode*> const &free_nodes, 
+	Sampler * makeSampler(FreeNodeSet const &free_nodes, 
 			      Graph const &graph, bool gibbs) const;
 	/**
 	 * Wraps GLMFactory#makeSampler and returns a single
 	 * newly-allocated sampler in a vector.
 	 */
 	std::vector<Sampler*> 
-	    makeSamplers(std::list<StochasticNode*> const &free_nodes, 
+	    makeSamplers(FreeNodeSet const &free_nodes, 
 			 Graph const &graph) const;
 	/**
 	 * Checks that an outcome variable in a GLM has the correct
@@ -14,8 +14,6 @@
 using std::vector;
 using std::sqrt;
 
-extern cholmod_common *glm_wk;
-
 namespace jags {
 
 namespace glm {
@@ -39,11 +37,7 @@ namespace glm {
 	// necessary for truncated parameters
 
 	// Update outcomes
-	for (vector<Outcome*>::const_iterator p = _outcomes.begin();
-	     p != _outcomes.end(); ++p)
-	{
-	    (*p)->update(rng);
-	}
+	updateOutcomes(rng);
 	
 	double *b = 0;
 	cholmod_sparse *A = 0;
@@ -102,7 +96,7 @@ namespace glm {
 	    }
 	}
 
-	cholmod_free_sparse(&A, glm_wk);
+	cholmod_free_sparse(&A, workspace());
 	delete [] b;
 	
 	_view->setValue(theta,  _chain);
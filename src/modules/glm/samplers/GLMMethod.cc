@@ -5,9 +5,11 @@
 #include <vector>
 #include <algorithm>
 #include <cmath>
+#include <typeinfo>
 
 #include "GLMMethod.h"
 #include "Outcome.h"
+#include "DesignMatrix.h"
 
 #include <sampler/SingletonGraphView.h>
 #include <sampler/Linear.h>
@@ -25,28 +27,50 @@ using std::set;
 using std::copy;
 using std::sqrt;
 
-extern cholmod_common *glm_wk;
+// Default minimum block size for supernodal factorization
+#define SUPERNODAL_LENGTH 4000
+// Default maximum cost of modifying the factorization, relative to
+// the cost of recalculating it
+#define UPDATE_COST 1.0
+// Maximum number of successive modifications of the factorization,
+// to limit the accumulation of rounding error
+#define REFACTOR_INTERVAL 100
 
 namespace jags {
 
-static void getIndices(set<StochasticNode *> const &schildren,
-		       vector<StochasticNode *> const &rows,
-		       vector<int> &indices)
-{
-    indices.clear();
-    
-    for (unsigned int i = 0; i < rows.size(); ++i) {
-	if (schildren.count(rows[i])) {
-	    indices.push_back(i);
-	}
+namespace glm {
+
+    unsigned int GLMMethod::_supernodal_length = SUPERNODAL_LENGTH;
+    double GLMMethod::_update_cost = UPDATE_COST;
+
+    void GLMMethod::setSupernodalLength(unsigned int length)
+    {
+	_supernodal_length = length;
     }
-    
-    if (indices.size() != schildren.size()) {
-	throwLogicError("Size mismatch in getIndices");
+
+    unsigned int GLMMethod::supernodalLength()
+    {
+	return _supernodal_length;
     }
-}
 
-namespace glm {
+    void GLMMethod::setUpdateCost(double ratio)
+    {
+	_update_cost = ratio;
+    }
+
+    double GLMMethod::updateCost()
+    {
+	return _update_cost;
+    }
+
+    /*
+      Tests whether the element in permuted row pr and column pc is
+      in the stored triangle of _A
+    */
+    static inline bool inTriangle(int pr, int pc, bool upper)
+    {
+	return upper ? pr <= pc : pr >= pc;
+    }
 
     void GLMMethod::calDesign() const
     {
@@ -65,7 +89,7 @@ namespace glm {
 	}
 
 	int c = 0; //column counter
-	double *xnew = new double[_length_max];
+	double *xnew = &_xnew[0];
 	
 	for (unsigned int i = 0; i < snodes.size(); ++i) {
 
@@ -96,8 +120,6 @@ namespace glm {
 	    
 	    c += length;
 	}
-
-	delete [] xnew;
     }
     
     GLMMethod::GLMMethod(GraphView const *view, 
@@ -106,66 +128,79 @@ namespace glm {
 			 unsigned int chain)
 	: _view(view), _chain(chain), _sub_views(sub_views),
 	  _outcomes(outcomes),
-	  _x(0), _factor(0), _fixed(sub_views.size(), false), 
-	  _length_max(0), _nz_prior(0)
+	  _x(0), _factor(0), _A(0), _design(0),
+	  _fixed(sub_views.size(), false),
+	  _length_max(0), _nz_prior(0), _glm_wk(0), _C(0), _max_cost(-1),
+	  _nmodify(0)
     {
 	view->checkFinite(chain); //Check validity of initial values
 	
-	vector<StochasticNode *> const &schildren = 
-	    view->stochasticChildren();
-
-	int nrow = schildren.size();
-	int ncol = view->length();
-
-	vector<int> Xp(ncol + 1);
-	vector<int> Xi;
-    
-	int c = 0; //column counter
-	int r = 0; //count of number of non-zero entries
-
 	for (unsigned int p = 0; p < _sub_views.size(); ++p) {
-
-	    set<StochasticNode *> children_p;
-	    children_p.insert(sub_views[p]->stochasticChildren().begin(),
-			      sub_views[p]->stochasticChildren().end());
-	    vector<int> indices;
-	    getIndices(children_p, schildren, indices);
-
-	    unsigned int length = _sub_views[p]->length();
-	    for (unsigned int i = 0; i < length; ++i, ++c) {
-		Xp[c] = r;
-		for (unsigned int j = 0; j < indices.size(); ++j, ++r) {
-		    Xi.push_back(indices[j]);
-		}
-	    }
-
 	    //Save these values for later calculations
+	    unsigned int length = _sub_views[p]->length();
 	    _nz_prior += length * length; //No. of non-zeros in prior precision
 	    if (length > _length_max) {
 		_length_max = length; //Length of longest sampled node
 	    }
 	}
-	Xp[c] = r;
-
-	//Set up sparse representation of the design matrix
-	_x = cholmod_allocate_sparse(nrow, ncol, r, 1, 1, 0, CHOLMOD_REAL, glm_wk);
-	int *_xp = static_cast<int*>(_x->p);
-	int *_xi = static_cast<int*>(_x->i);
+	_xnew.resize(_length_max);
+
+	// The design matrix is shared with the other chains, and is
+	// set up by the first chain. At that point, all elements of
+	// _fixed are set to false, so a call to calDesign calculates
+	// the whole design matrix
+	_design = DesignMatrix::attach(view);
+	bool first = _design == 0;
+	if (first) {
+	    _design = DesignMatrix::create(view, sub_views);
+	}
+	try {
+	    if (first) {
+		_x = _design->matrix();
+		calDesign();
+	    }
+	
+	    // In future calls to calDesign, we do not want to
+	    // recalculate fixed linear terms.
+	    bool all_fixed = true;
+	    for (unsigned int i = 0; i < sub_views.size(); ++i) {
+		// FIXME: For future reference, we will need to make sure
+		// this still works correctly for log-linear models.
+		_fixed[i] = checkLinear(sub_views[i], true, true);
+		if (!_fixed[i]) all_fixed = false;
+	    }
 
-	copy(Xp.begin(), Xp.end(), _xp);
-	copy(Xi.begin(), Xi.end(), _xi);
+	    if (all_fixed) {
+		// The shared design matrix is used directly
+		_x = _design->matrix();
+	    }
+	    else {
+		// Each chain needs its own values for the columns
+		// that are not fixed. The sparsity pattern is shared
+		// and the fixed columns are copied.
+		cholmod_sparse const *X = _design->matrix();
+		double const *Xx = static_cast<double const *>(X->x);
+		_xchain_values.assign(Xx, Xx + X->nzmax);
+		_xchain = *X;
+		_xchain.x = &_xchain_values[0];
+		_x = &_xchain;
+		calDesign();
+	    }
+	}
+	catch (...) {
+	    DesignMatrix::detach(_design);
+	    throw;
+	}
 
-	// At this point, all elements of _fixed are set to false, so
-	// a call to calDesign calculates the whole design matrix
-	calDesign();
-	
-	// In future calls to calDesign, we do not want to recalculate
-	// fixed linear terms.
-	for (unsigned int i = 0; i < sub_views.size(); ++i) {
-	    // FIXME: For future reference, we will need to make sure this
-	    // still works correctly for log-linear models.
-	    _fixed[i] = checkLinear(sub_views[i], true, true);
+	// Group consecutive outcomes of the same type into batches
+	for (unsigned int i = 0; i < _outcomes.size(); ++i) {
+	    if (i == 0 ||
+		typeid(*_outcomes[i]) != typeid(*_outcomes[i-1]))
+	    {
+		_batch.push_back(i);
+	    }
 	}
+	_batch.push_back(_outcomes.size());
     }
 
     GLMMethod::~GLMMethod()
@@ -174,7 +209,53 @@ namespace glm {
 	    delete _outcomes.back();
 	    _outcomes.pop_back();
 	}
-	cholmod_free_sparse(&_x, glm_wk);
+	DesignMatrix::detach(_design);
+	if (_factor) {
+	    cholmod_free_factor(&_factor, workspace());
+	}
+	if (_A) {
+	    cholmod_free_sparse(&_A, workspace());
+	}
+	if (_C) {
+	    cholmod_free_sparse(&_C, workspace());
+	}
+	cholmod_finish(_glm_wk);
+	delete _glm_wk;
+    }
+
+    void GLMMethod::updateOutcomes(RNG *rng)
+    {
+	for (unsigned int k = 0; k + 1 < _batch.size(); ++k) {
+	    Outcome * const *batch = &_outcomes[_batch[k]];
+	    batch[0]->updateBatch(batch, _batch[k+1] - _batch[k], rng);
+	}
+    }
+
+    cholmod_common *GLMMethod::workspace()
+    {
+	if (!_glm_wk) {
+	    _glm_wk = new cholmod_common;
+	    cholmod_start(_glm_wk);
+
+	    //Use simplicial factorization by default. Supernodal
+	    //factorizations have a completely different data
+	    //structure, although held in the same object, and are
+	    //only selected by symbolic for large blocks.
+	    _glm_wk->supernodal = CHOLMOD_SIMPLICIAL;
+
+	    /*	
+	    //Force use of LL' factorisation instead of LDL
+	    //_glm_wk->final_ll = true; 
+
+	    //For debuggin purposes we may choose not to reorder matrices
+	    //Use only on small problems
+
+	    _glm_wk->nmethods = 1 ;
+	    _glm_wk->method [0].ordering = CHOLMOD_NATURAL ;
+	    _glm_wk->postorder = 0 ;
+	    */
+	}
+	return _glm_wk;
     }
     
     /* 
@@ -185,14 +266,22 @@ namespace glm {
        craeted. It is a stripped-down version of the code in update.
        Note that the values of the sparse matrices are never
        referenced.
+
+       We also allocate the permuted posterior precision _A, and the
+       workspace used by calCoefInPlace to fill in its values.
+
+       The fill-reducing permutation is chosen by CHOLMOD's default
+       strategy, which uses AMD.
     */
-    void GLMMethod::symbolic()  
+    void GLMMethod::symbolic(bool simplicial)  
     {
 	unsigned int nrow = _view->length();
+	bool super = !simplicial && nrow >= _supernodal_length;
+	workspace()->supernodal = super ? CHOLMOD_SUPERNODAL : CHOLMOD_SIMPLICIAL;
 
 	// Prior contribution 
 	cholmod_sparse *Aprior =  
-	    cholmod_allocate_sparse(nrow, nrow, _nz_prior, 1, 1, 0, CHOLMOD_PATTERN, glm_wk); 
+	    cholmod_allocate_sparse(nrow, nrow, _nz_prior, 1, 1, 0, CHOLMOD_PATTERN, workspace()); 
 	int *Ap = static_cast<int*>(Aprior->p);
 	int *Ai = static_cast<int*>(Aprior->i);
 
@@ -221,18 +310,102 @@ namespace glm {
 	
 	// Likelihood contribution
     
-	cholmod_sparse *t_x = cholmod_transpose(_x, 0, glm_wk);
-	cholmod_sparse *Alik = cholmod_aat(t_x, 0, 0, 0, glm_wk);
-	cholmod_sparse *A = cholmod_add(Aprior, Alik, 0, 0, 0, 0, glm_wk);
+	cholmod_sparse *t_x = cholmod_transpose(_x, 0, workspace());
+	cholmod_sparse *Alik = cholmod_aat(t_x, 0, 0, 0, workspace());
+	cholmod_sparse *A = cholmod_add(Aprior, Alik, 0, 0, 0, 0, workspace());
 
 	//Free working matrices
-	cholmod_free_sparse(&t_x, glm_wk);
-	cholmod_free_sparse(&Aprior, glm_wk);
-	cholmod_free_sparse(&Alik, glm_wk);
+	cholmod_free_sparse(&t_x, workspace());
+	cholmod_free_sparse(&Aprior, workspace());
+	cholmod_free_sparse(&Alik, workspace());
 
 	A->stype = -1;
-	_factor = cholmod_analyze(A, glm_wk); 
-	cholmod_free_sparse(&A, glm_wk);
+	_factor = cholmod_analyze(A, workspace()); 
+
+	// This is the same transformation that cholmod_factorize
+	// applies to A before calling cholmod_rowfac
+	int *perm = static_cast<int*>(_factor->Perm);
+	_A = cholmod_ptranspose(A, 0, perm, 0, 0, workspace());
+	cholmod_free_sparse(&A, workspace());
+	if (_factor->is_super) {
+	    // cholmod_super_numeric needs the lower triangle instead
+	    cholmod_sparse *At = cholmod_transpose(_A, 0, workspace());
+	    cholmod_free_sparse(&_A, workspace());
+	    _A = At;
+	}
+	cholmod_sparse_xtype(CHOLMOD_REAL, _A, workspace());
+
+	_b.resize(nrow);
+	_work.assign(nrow, 0);
+	_pinv.resize(nrow);
+	for (unsigned int i = 0; i < nrow; ++i) {
+	    _pinv[perm[i]] = i;
+	}
+
+	// Row-wise representation of the pattern of the design
+	// matrix, pointing back to the values in _x
+	unsigned int nout = _x->nrow;
+	int const *Xp = static_cast<int const*>(_x->p);
+	int const *Xi = static_cast<int const*>(_x->i);
+	_xrow_p.assign(nout + 1, 0);
+	for (int j = 0; j < Xp[nrow]; ++j) {
+	    _xrow_p[Xi[j] + 1]++;
+	}
+	for (unsigned int k = 0; k < nout; ++k) {
+	    _xrow_p[k+1] += _xrow_p[k];
+	}
+	_xrow_col.resize(Xp[nrow]);
+	_xrow_pos.resize(Xp[nrow]);
+	// Within each row, columns are sorted in permuted order, as
+	// required by cholmod_updown in modifyFactor
+	vector<int> next(_xrow_p.begin(), _xrow_p.end() - 1);
+	for (unsigned int i = 0; i < nrow; ++i) {
+	    unsigned int c = perm[i];
+	    for (int j = Xp[c]; j < Xp[c+1]; ++j) {
+		int q = next[Xi[j]]++;
+		_xrow_col[q] = c;
+		_xrow_pos[q] = j;
+	    }
+	}
+	_tau.resize(nout);
+	_delta.resize(nout);
+	_tau_factor.resize(nout);
+	_prior.assign(_nz_prior, 0);
+
+	if (!_factor->is_super) {
+	    // Storage for low-rank modifications of a simplicial factor
+	    _C = cholmod_allocate_sparse(nrow, nout, Xp[nrow], 1, 1, 0,
+					 CHOLMOD_REAL, workspace());
+
+	    /* 
+	       Estimate the cost of modifying the factor for each
+	       outcome. A rank-one modification with the row of X for
+	       outcome k changes the columns of the factor on the path
+	       from its first non-zero to the root of the elimination
+	       tree, so its cost is the number of non-zeros in those
+	       columns. Recalculating the factor costs the sum of the
+	       squared column counts, plus the cost of assembling the
+	       posterior precision in calCoefInPlace.
+	    */
+	    vector<int> parent(nrow);
+	    cholmod_etree(_A, &parent[0], workspace());
+	    int const *colcount = static_cast<int const*>(_factor->ColCount);
+	    double factor_cost = 0;
+	    for (unsigned int j = 0; j < nrow; ++j) {
+		factor_cost += static_cast<double>(colcount[j]) * colcount[j];
+	    }
+	    _update_cost_k.assign(nout, 0);
+	    for (unsigned int k = 0; k < nout; ++k) {
+		int len = _xrow_p[k+1] - _xrow_p[k];
+		factor_cost += static_cast<double>(len) * len;
+		if (len == 0) continue;
+		for (int j = _pinv[_xrow_col[_xrow_p[k]]]; j >= 0; j = parent[j])
+		{
+		    _update_cost_k[k] += colcount[j];
+		}
+	    }
+	    _max_cost = _update_cost * factor_cost;
+	}
     }
 
     void GLMMethod::calCoef(double *&b, cholmod_sparse *&A) 
@@ -250,7 +423,7 @@ namespace glm {
 
 	cholmod_sparse *Aprior =  
 	    cholmod_allocate_sparse(nrow, nrow, _nz_prior, 1, 1, 0, 
-				    CHOLMOD_REAL, glm_wk); 
+				    CHOLMOD_REAL, workspace()); 
     
 	// Set up prior contributions to A, b
 	int *Ap = static_cast<int*>(Aprior->p);
@@ -297,7 +470,7 @@ namespace glm {
 	//   - mu is the mean of the stochastic children
 	//   - Y is the value of the stochastic children
 
-	cholmod_sparse *t_x = cholmod_transpose(_x, 1, glm_wk);
+	cholmod_sparse *t_x = cholmod_transpose(_x, 1, workspace());
 	int *Tp = static_cast<int*>(t_x->p);
 	int *Ti = static_cast<int*>(t_x->i);
 	double *Tx = static_cast<double*>(t_x->x);
@@ -313,13 +486,202 @@ namespace glm {
 	    }
 	}
 
-	cholmod_sparse *Alik = cholmod_aat(t_x, 0, 0, 1, glm_wk);
-	cholmod_free_sparse(&t_x, glm_wk);
+	cholmod_sparse *Alik = cholmod_aat(t_x, 0, 0, 1, workspace());
+	cholmod_free_sparse(&t_x, workspace());
 	double one[2] = {1, 0};
-	A = cholmod_add(Aprior, Alik, one, one, 1, 0, glm_wk);
+	A = cholmod_add(Aprior, Alik, one, one, 1, 0, workspace());
+
+	cholmod_free_sparse(&Aprior, workspace());
+	cholmod_free_sparse(&Alik, workspace());
+    }
+
+    void GLMMethod::calCoefInPlace(bool precision) 
+    {
+	// Recalculate the design matrix, if necessary
+	calDesign();
+
+	for (unsigned int k = 0; k < _outcomes.size(); ++k) {
+	    _tau[k] = _outcomes[k]->precision();
+	    _delta[k] = _tau[k] * (_outcomes[k]->value() - _outcomes[k]->mean());
+	}
+
+	int const *perm = static_cast<int const*>(_factor->Perm);
+	int const *Xp = static_cast<int const*>(_x->p);
+	int const *Xi = static_cast<int const*>(_x->i);
+	double const *Xx = static_cast<double const*>(_x->x);
+	int const *Sp = static_cast<int const*>(_A->p);
+	int const *Si = static_cast<int const*>(_A->i);
+	double *Sx = static_cast<double*>(_A->x);
+	bool upper = _A->stype > 0;
+
+	/* 
+	   Column c of the posterior precision is accumulated in _work
+	   and then copied to column _pinv[c] of _A. Only the rows that
+	   fall in the stored triangle after permutation are needed.
+	*/
+	int c = 0;
+	vector<StochasticNode*> const &snodes = _view->nodes();
+	for (vector<StochasticNode*>::const_iterator p = snodes.begin();
+	     p != snodes.end(); ++p)
+	{
+	    StochasticNode *snode = *p;
+	    double const *priormean = snode->parents()[0]->value(_chain);
+	    double const *priorprec = snode->parents()[1]->value(_chain);
+	    double const *xold = snode->value(_chain);
+	    unsigned int length = snode->length();
+	
+	    int cbase = c; //first column of this diagonal block
+	    for (unsigned int i = 0; i < length; ++i, ++c) {
+		int pc = _pinv[c];
+
+		// Prior contribution
+		_b[c] = 0;
+		for (unsigned int j = 0; j < length; ++j) {
+		    _b[c] += priorprec[i + length*j] * (priormean[j] - xold[j]);
+		    if (precision && inTriangle(_pinv[cbase + j], pc, upper)) {
+			_work[cbase + j] += priorprec[i + length*j];
+		    }
+		}
+
+		// Likelihood contribution
+		for (int r = Xp[c]; r < Xp[c+1]; ++r) {
+		    int k = Xi[r];
+		    _b[c] += Xx[r] * _delta[k];
+		    if (!precision) continue;
+		    double xtau = Xx[r] * _tau[k];
+		    for (int q = _xrow_p[k]; q < _xrow_p[k+1]; ++q) {
+			int col = _xrow_col[q];
+			if (inTriangle(_pinv[col], pc, upper)) {
+			    _work[col] += xtau * Xx[_xrow_pos[q]];
+			}
+		    }
+		}
+
+		if (!precision) continue;
+		for (int r = Sp[pc]; r < Sp[pc+1]; ++r) {
+		    int row = perm[Si[r]];
+		    Sx[r] = _work[row];
+		    _work[row] = 0;
+		}
+	    }
+	}
+    }
+
+    bool GLMMethod::priorChanged()
+    {
+	bool changed = false;
+	unsigned int r = 0;
+	vector<StochasticNode*> const &snodes = _view->nodes();
+	for (vector<StochasticNode*>::const_iterator p = snodes.begin();
+	     p != snodes.end(); ++p)
+	{
+	    double const *priorprec = (*p)->parents()[1]->value(_chain);
+	    unsigned int length = (*p)->length();
+	    for (unsigned int i = 0; i < length * length; ++i, ++r) {
+		if (_prior[r] != priorprec[i]) {
+		    _prior[r] = priorprec[i];
+		    changed = true;
+		}
+	    }
+	}
+	return changed;
+    }
 
-	cholmod_free_sparse(&Aprior, glm_wk);
-	cholmod_free_sparse(&Alik, glm_wk);
+    bool GLMMethod::modifyFactor()
+    {
+	/*
+	   The likelihood contribution to the posterior precision is
+	   t(X) %*% diag(tau) %*% X. If only tau has changed since
+	   the last factorization, the new factor is obtained by
+	   adding C %*% t(C) to the old one, where column k of C is
+	   row k of P %*% t(X) scaled by the square root of the change
+	   in tau[k], and subtracting the same for a decrease in tau.
+	*/
+	int *Cp = static_cast<int*>(_C->p);
+	int *Ci = static_cast<int*>(_C->i);
+	double *Cx = static_cast<double*>(_C->x);
+	double const *Xx = static_cast<double const*>(_x->x);
+
+	for (int update = 1; update >= 0; --update) {
+	    unsigned int ncol = 0;
+	    int nz = 0;
+	    for (unsigned int k = 0; k < _outcomes.size(); ++k) {
+		double dtau = _tau[k] - _tau_factor[k];
+		if (update ? dtau <= 0 : dtau >= 0) continue;
+		double sigma = sqrt(update ? dtau : -dtau);
+		Cp[ncol++] = nz;
+		for (int q = _xrow_p[k]; q < _xrow_p[k+1]; ++q, ++nz) {
+		    Ci[nz] = _pinv[_xrow_col[q]];
+		    Cx[nz] = Xx[_xrow_pos[q]] * sigma;
+		}
+	    }
+	    if (ncol == 0) continue;
+	    Cp[ncol] = nz;
+	    _C->ncol = ncol;
+	    if (!cholmod_updown(update, _C, _factor, workspace()) ||
+		workspace()->status == CHOLMOD_NOT_POSDEF)
+	    {
+		return false;
+	    }
+	}
+	_tau_factor = _tau;
+	return true;
+    }
+
+    void GLMMethod::updateFactor()
+    {
+	/*
+	   Decide whether the factorization can be modified: the
+	   factor must be simplicial and already calculated, and the
+	   design matrix and prior precision must be unchanged. The
+	   estimated cost of the modification must also be less than
+	   the cost of a new factorization.
+	*/
+	bool modify = _C && _factor->xtype != CHOLMOD_PATTERN &&
+	    _nmodify < REFACTOR_INTERVAL &&
+	    std::find(_fixed.begin(), _fixed.end(), false) == _fixed.end();
+	if (modify) {
+	    double cost = 0;
+	    for (unsigned int k = 0; k < _outcomes.size(); ++k) {
+		if (_outcomes[k]->precision() != _tau_factor[k]) {
+		    cost += _update_cost_k[k];
+		}
+	    }
+	    modify = cost <= _max_cost;
+	}
+	// Always called, to keep a copy of the current prior precision
+	if (priorChanged()) {
+	    modify = false;
+	}
+
+	if (modify) {
+	    calCoefInPlace(false);
+	    if (modifyFactor()) {
+		++_nmodify;
+		return;
+	    }
+	}
+
+	calCoefInPlace(true);
+	// Get LDL' decomposition of posterior precision, or LL' if
+	// the factor is supernodal. The matrix _A is already
+	// permuted, so it is passed straight to the numerical
+	// factorization, reusing the storage of the factor.
+	double zero[2] = {0, 0};
+	if (_factor->is_super) {
+	    if (!cholmod_super_numeric(_A, 0, zero, _factor, workspace()) ||
+		workspace()->status == CHOLMOD_NOT_POSDEF)
+	    {
+		throwRuntimeError("Cholesky decomposition failure in GLMBlock");
+	    }
+	}
+	else if (!cholmod_rowfac(_A, 0, zero, 0, _A->nrow, _factor,
+				 workspace()))
+	{
+	    throwRuntimeError("Cholesky decomposition failure in GLMBlock");
+	}
+	_tau_factor = _tau;
+	_nmodify = 0;
     }
 
     bool GLMMethod::isAdaptive() const
@@ -336,4 +698,49 @@ namespace glm {
 	return true;
     }
 
+    void GLMMethod::getState(vector<double> &state) const
+    {
+	for (unsigned int i = 0; i < _outcomes.size(); ++i) {
+	    _outcomes[i]->getState(state);
+	}
+
+	int const *Xp = static_cast<int const*>(_x->p);
+	double const *Xx = static_cast<double const*>(_x->x);
+	unsigned int c = 0;
+	for (unsigned int i = 0; i < _sub_views.size(); ++i) {
+	    unsigned int length = _sub_views[i]->length();
+	    if (_fixed[i]) {
+		state.insert(state.end(), Xx + Xp[c], Xx + Xp[c + length]);
+	    }
+	    c += length;
+	}
+    }
+
+    void GLMMethod::setState(vector<double> const &state, unsigned int &pos)
+    {
+	for (unsigned int i = 0; i < _outcomes.size(); ++i) {
+	    _outcomes[i]->setState(state, pos);
+	}
+
+	/* 
+	   If all columns are fixed then _x is the design matrix shared
+	   with the other chains. Their states hold the same values.
+	*/
+	int const *Xp = static_cast<int const*>(_x->p);
+	double *Xx = static_cast<double*>(_x->x);
+	unsigned int c = 0;
+	for (unsigned int i = 0; i < _sub_views.size(); ++i) {
+	    unsigned int length = _sub_views[i]->length();
+	    if (_fixed[i]) {
+		for (int r = Xp[c]; r < Xp[c + length]; ++r) {
+		    Xx[r] = state[pos++];
+		}
+	    }
+	    c += length;
+	}
+
+	// The factor no longer matches the design matrix
+	_nmodify = REFACTOR_INTERVAL;
+    }
+
 }}
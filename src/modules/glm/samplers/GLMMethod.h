@@ -19,6 +19,7 @@ namespace jags {
 namespace glm {
 
     class Outcome;
+    class DesignMatrix;
 
     /**
      * @short Abstract class for sampling generalized linear models.
@@ -42,15 +43,104 @@ namespace glm {
 	unsigned int _chain;
 	std::vector<SingletonGraphView const *> _sub_views;
 	std::vector<Outcome *> _outcomes;
-	cholmod_sparse *_x;
+	cholmod_sparse *_x; // Design matrix. Read-only except in calDesign
 	cholmod_factor *_factor; //???
-	void symbolic();
+	cholmod_sparse *_A;
+	std::vector<double> _b;
+	/**
+	 * Symbolic analysis of the posterior precision.  This sets up
+	 * the fill-reducing permutation and the pattern of the
+	 * Cholesky factor _factor, and allocates _A.
+	 *
+	 * A supernodal factorization is used if the number of
+	 * regression parameters is at least supernodalLength, and the
+	 * simplicial flag is false. Otherwise a simplicial LDL'
+	 * factorization is used.
+	 *
+	 * @param simplicial Flag that forces the use of a simplicial
+	 * factorization. This is required by sampling methods that
+	 * solve equations with sparse right hand sides, which
+	 * CHOLMOD only supports for a simplicial factor.
+	 */
+	void symbolic(bool simplicial = false);
 	void calDesign() const;
+	/**
+	 * Calculates the coefficients of the posterior distribution
+	 * in place, without allocating memory. This is a faster
+	 * version of calCoef for sampling methods that have called
+	 * symbolic.
+	 *
+	 * On exit, _b holds the canonical parameter "b" and _A holds
+	 * P %*% A %*% t(P), where "A" is the posterior precision and
+	 * P is the fill-reducing permutation of _factor. Only the
+	 * upper triangle is stored if _factor is simplicial, as
+	 * required by cholmod_rowfac, or the lower triangle if it is
+	 * supernodal, as required by cholmod_super_numeric. So _A
+	 * may be factorized directly into _factor. The sparsity
+	 * pattern of _A is set by symbolic and never changes.
+	 *
+	 * @param precision If false, only _b is calculated and _A is
+	 * left unchanged.
+	 */
+	void calCoefInPlace(bool precision = true);
+	/**
+	 * Calculates the coefficients of the posterior distribution
+	 * with calCoefInPlace, and the Cholesky factorization of the
+	 * posterior precision in _factor.
+	 *
+	 * When the design matrix and the prior precision are
+	 * unchanged since the last call, the posterior precision only
+	 * changes through the precisions of the outcomes.  If the
+	 * factor is simplicial, and few outcomes have a changed
+	 * precision compared to the size and sparsity of the block
+	 * (see setUpdateCost), then the existing factor is modified
+	 * by a low-rank update instead of being recalculated.  A full
+	 * factorization is done at least every 100 calls to limit the
+	 * accumulation of rounding error.
+	 */
+	void updateFactor();
+	/**
+	 * Updates the auxiliary variables of all outcomes, using the
+	 * current value of the linear predictor. Consecutive outcomes
+	 * of the same type are updated together by a single call to
+	 * Outcome#updateBatch.
+	 */
+	void updateOutcomes(RNG *rng);
+	/**
+	 * Returns the CHOLMOD workspace used by this sampling method,
+	 * creating it on first use. Each GLMMethod has its own
+	 * workspace, so that different chains, or different GLM
+	 * samplers, may be updated at the same time.
+	 */
+	cholmod_common *workspace();
 
     private:
+	static unsigned int _supernodal_length;
+	// Design matrix shared with other chains, and this chain's
+	// copy of its values when some terms are not fixed
+	DesignMatrix *_design;
+	cholmod_sparse _xchain;
+	std::vector<double> _xchain_values;
 	std::vector<bool> _fixed;
+	// Start of each batch of outcomes of the same type
+	std::vector<unsigned int> _batch;
 	unsigned int _length_max;
 	unsigned _nz_prior;
+	cholmod_common *_glm_wk;
+	// Workspace for calDesign
+	mutable std::vector<double> _xnew;
+	// Workspace for calCoefInPlace, set up by symbolic
+	std::vector<int> _pinv;
+	std::vector<int> _xrow_p, _xrow_col, _xrow_pos;
+	std::vector<double> _tau, _delta, _work;
+	// Low-rank modification of the factor
+	static double _update_cost;
+	cholmod_sparse *_C;
+	double _max_cost;
+	std::vector<double> _update_cost_k, _tau_factor, _prior;
+	unsigned int _nmodify;
+	bool priorChanged();
+	bool modifyFactor();
     public:
 	/**
 	 * Constructor.
@@ -90,6 +180,55 @@ namespace glm {
 	 * @param A Posterior precision represented as a sparse matrix.
 	 */
 	void calCoef(double *&b, cholmod_sparse *&A);
+	/**
+	 * Sets the minimum number of regression parameters in a block
+	 * for which a supernodal Cholesky factorization is used.
+	 * Smaller blocks use a simplicial factorization, which has
+	 * less overhead.  For large blocks with a sparse posterior
+	 * precision, such as those arising from spatial random
+	 * effects, the supernodal factorization is much faster as it
+	 * uses dense BLAS operations on the columns of the factor.
+	 *
+	 * The setting only affects sampling methods created after the
+	 * call, so it may be changed between models.
+	 *
+	 * @param length Minimum block size. A value of zero means that
+	 * a supernodal factorization is always used.
+	 */
+	static void setSupernodalLength(unsigned int length);
+	/**
+	 * Returns the minimum block size for which a supernodal
+	 * factorization is used.
+	 *
+	 * @see setSupernodalLength
+	 */
+	static unsigned int supernodalLength();
+	/**
+	 * Sets the maximum estimated cost of modifying the Cholesky
+	 * factorization of the posterior precision by a low-rank
+	 * update, relative to the estimated cost of recalculating it.
+	 * The cost of a modification grows with the number of
+	 * outcomes whose precision has changed, so this favours
+	 * modification for blocks with few outcomes relative to the
+	 * number of regression parameters.
+	 *
+	 * A value of zero means that the factorization is only reused
+	 * if no outcome precision has changed.  A negative value
+	 * means that the factorization is always recalculated.
+	 *
+	 * The setting only affects sampling methods created after the
+	 * call.
+	 *
+	 * @see updateFactor
+	 */
+	static void setUpdateCost(double ratio);
+	/**
+	 * Returns the maximum relative cost of modifying the
+	 * factorization.
+	 *
+	 * @see setUpdateCost
+	 */
+	static double updateCost();
 	/**
 	 * Returns false. Sampling methods inheriting from GLMMethod
 	 * are not adaptive.
@@ -103,6 +242,21 @@ namespace glm {
 	 * Returns true, as GLMMethod is not adaptive
 	 */
 	bool checkAdaptation() const;
+	/**
+	 * Appends the auxiliary variables of the outcomes, followed by
+	 * the columns of the design matrix for fixed linear terms.
+	 * These columns are calculated only once, from the initial
+	 * values, so they are saved to make a restored sampler
+	 * reproduce the original.
+	 *
+	 * The Cholesky factor is not part of the state. It is
+	 * recalculated at the next update after setState, so if the
+	 * original sampler was modifying its factor by low-rank
+	 * updates, the restored sampler may differ from it by rounding
+	 * error.
+	 */
+	void getState(std::vector<double> &state) const;
+	void setState(std::vector<double> const &state, unsigned int &pos);
     };
 
 }}
@@ -24,4 +24,9 @@ namespace glm {
 	}
     }
 
+    bool GLMSampler::isThreadSafe() const
+    {
+	return true;
+    }
+
 }}
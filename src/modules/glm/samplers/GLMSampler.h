@@ -42,6 +42,11 @@ namespace glm {
 	 * Deletes the sub-views passed to the constructor.
 	 */
 	~GLMSampler();
+	/**
+	 * Returns true. Each sampling method has its own CHOLMOD
+	 * workspace, so chains may be updated concurrently.
+	 */
+	bool isThreadSafe() const;
     }; 
 
 }}
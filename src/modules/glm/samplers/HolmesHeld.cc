@@ -19,19 +19,16 @@ using std::vector;
 using std::string;
 using std::sqrt;
 
-extern cholmod_common *glm_wk;
-
-static cholmod_sparse shallow_copy(cholmod_sparse *x, unsigned int c)
+static cholmod_sparse shallow_copy(cholmod_sparse *x, unsigned int c,
+				   int *p)
 {
     //Take a copy of column c of sparse matrix x without allocating
     //any memory. This is computationally cheaper than calling
     //cholmod_submatrix, but potentially dangerous if the copy is
-    //passed to a function that tries to modify it. Note that we can
-    //only have one shallow copy in use at a time since they all share
-    //the same array of column pointers given by the static array p.
+    //passed to a function that tries to modify it. The column
+    //pointers of the copy are held in the caller's array p, of
+    //length 2, which must outlive the copy.
 
-    static int p[2]; 
-    
     cholmod_sparse xcopy = *x;
 
     double *xx = static_cast<double*>(x->x);
@@ -43,7 +40,7 @@ static cholmod_sparse shallow_copy(cholmod_sparse *x, unsigned int c)
     xcopy.nzmax = nz;
     p[0] = 0;
     p[1] = nz; 
-    xcopy.p = &p;
+    xcopy.p = p;
     xcopy.i = xi + xp[c];
     xcopy.x = xx + xp[c];
 
@@ -58,8 +55,10 @@ namespace glm {
 			   vector<SingletonGraphView const *> const &sub_views,
 			   vector<Outcome *> const &outcomes,
 			   unsigned int chain)
-	: GLMBlock(view, sub_views, outcomes, chain)
+	: GLMBlock(view, sub_views, outcomes, chain, true)
     {
+	// The factor is always simplicial, as updateAuxiliary solves
+	// with sparse right hand sides
     }
 
     void HolmesHeld::updateAuxiliary(cholmod_dense *W, 
@@ -88,11 +87,11 @@ namespace glm {
 	int nrow = schildren.size();
 
 	//Transpose and permute the design matrix
-	cholmod_sparse *t_x = cholmod_transpose(_x, 1, glm_wk);
+	cholmod_sparse *t_x = cholmod_transpose(_x, 1, workspace());
 	int *fperm = static_cast<int*>(_factor->Perm);
 	cholmod_sparse *pt_x = cholmod_submatrix(t_x, fperm, t_x->nrow,
-						 0, -1, 1, 1, glm_wk);
-	cholmod_free_sparse(&t_x, glm_wk);
+						 0, -1, 1, 1, workspace());
+	cholmod_free_sparse(&t_x, workspace());
 	
 	int ncol = _x->ncol;
 	vector<double> d(ncol, 1);
@@ -110,9 +109,10 @@ namespace glm {
 	
 	cholmod_dense *U = 0, *Y = 0, *E = 0;
 	cholmod_sparse *uset = 0;
+	int xset_p[2];
 
 	cholmod_dense *X = cholmod_allocate_dense(ncol, 1, ncol,
-						  CHOLMOD_REAL, glm_wk);
+						  CHOLMOD_REAL, workspace());
 	double *Xx = static_cast<double*>(X->x);
 
 	for (int r = 0; r < nrow; ++r) {
@@ -129,7 +129,7 @@ namespace glm {
 	    
 	    if (_outcomes[r]->fixedb()) continue;
 
-	    cholmod_sparse xset = shallow_copy(pt_x, r);
+	    cholmod_sparse xset = shallow_copy(pt_x, r, xset_p);
 	    double *xx = static_cast<double*>(xset.x);
 	    int *xp = static_cast<int*>(xset.p);
 	    int *xi = static_cast<int*>(xset.i);
@@ -141,7 +141,7 @@ namespace glm {
 	    }
 	    
 	    cholmod_solve2(CHOLMOD_L, _factor, X, &xset, &U, &uset, &Y, &E,
-			   glm_wk);
+			   workspace());
 
 	    double mu_r = _outcomes[r]->mean(); // See IMPORTANT NOTE above
 	    double tau_r = _outcomes[r]->precision();
@@ -183,13 +183,13 @@ namespace glm {
 	    
 	//Free workspace
 
-	cholmod_free_sparse(&pt_x, glm_wk);
-	cholmod_free_sparse(&uset, glm_wk);
+	cholmod_free_sparse(&pt_x, workspace());
+	cholmod_free_sparse(&uset, workspace());
 	
-	cholmod_free_dense(&U, glm_wk);
-	cholmod_free_dense(&Y, glm_wk);
-	cholmod_free_dense(&E, glm_wk);
-	cholmod_free_dense(&X, glm_wk);
+	cholmod_free_dense(&U, workspace());
+	cholmod_free_dense(&Y, workspace());
+	cholmod_free_dense(&E, workspace());
+	cholmod_free_dense(&X, workspace());
     }
     
 }}
@@ -15,8 +15,6 @@
 
 using std::vector;
 
-extern cholmod_common *glm_wk;
-
 namespace jags {
     namespace glm {
 	
@@ -31,11 +29,7 @@ namespace jags {
 	void HolmesHeldGibbs::update(RNG *rng) 
 	{
 	    // Update outcomes
-	    for (vector<Outcome*>::const_iterator p = _outcomes.begin();
-		 p != _outcomes.end(); ++p)
-	    {
-		(*p)->update(rng);
-	    }
+	    updateOutcomes(rng);
 	
 	    double *b = 0;
 	    cholmod_sparse *A = 0;
@@ -67,7 +61,7 @@ namespace jags {
 	    }
 
 	    //Transpose design matrix
-	    cholmod_sparse *t_x = cholmod_transpose(_x, 1, glm_wk);
+	    cholmod_sparse *t_x = cholmod_transpose(_x, 1, workspace());
 	
 	    double *xx = static_cast<double*>(t_x->x);
 	    int *xp = static_cast<int*>(t_x->p);
@@ -122,7 +116,7 @@ namespace jags {
 		}
 	    }
 
-	    cholmod_free_sparse(&A, glm_wk);
+	    cholmod_free_sparse(&A, workspace());
 	    delete [] b;
 	    
 	    _view->setValue(theta,  _chain);
@@ -433,23 +433,29 @@ namespace glm {
 	for (int i = 0; i < _ncomp; i++) {
 	    _means[i] = _means[i] * sigma + mu;
 	    _variances[i] *= sigma2;
+	    _sds[i] = sqrt(_variances[i]);
+	    _logweights[i] = log(_weights[i]);
 	}
 	_n = n;
 
     }
 
     void LGMix::update(double z, double n, RNG *rng)
+    {
+	select(z, n, rng->uniform());
+    }
+
+    void LGMix::select(double z, double n, double u)
     {
 	// Check whether value of n has changed since last update
 	if (n != _n) updateShape(n);
 
 	//Log probabilities
-	vector<double> p(_ncomp);
+	double p[10];
 	for (int i = 0; i < _ncomp; i++) {
-	    p[i] = dnorm(z, _means[i], sqrt(_variances[i]), true) + 
-		log(_weights[i]);
+	    p[i] = dnorm(z, _means[i], _sds[i], true) + _logweights[i];
 	}
-	double maxp = *max_element(p.begin(), p.end());
+	double maxp = *max_element(p, p + _ncomp);
 
 	//Cumulative probabilities (unnormalized)
 	double sump = 0.0;
@@ -459,8 +465,7 @@ namespace glm {
 	}
     
 	//Sample _r from cumulative probabilities
-	double u = rng->uniform() * sump;
-	_r = upper_bound(p.begin(), p.end(), u) - p.begin();
+	_r = upper_bound(p, p + _ncomp, u * sump) - p;
     }
 
     double LGMix::mean() const
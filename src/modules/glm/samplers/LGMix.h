@@ -23,6 +23,8 @@ namespace glm {
 	double _weights[10];
 	double _means[10];
 	double _variances[10];
+	double _sds[10];
+	double _logweights[10];
 	void updateShapeExact(int n);
 	void updateShapeApprox(double n);
 	void updateShape(double n);
@@ -38,6 +40,18 @@ namespace glm {
 	 * @param rng Random number generator
 	 */
 	void update(double z, double n, RNG *rng);
+	/**
+	 * Updates the mixture representation, given a uniform random
+	 * variable on (0,1). This is equivalent to update, but allows
+	 * the random number to be drawn in advance.
+	 *
+	 * @param z Value sampled from negative log gamma distribution
+	 *          with shape parameter n.
+	 * @param n Value of n, which may be different from value used in
+	 *          constructor. 
+	 * @param u Uniform random variable used to choose the component
+	 */
+	void select(double z, double n, double u);
 	/**
 	 * Rturns the mean of the current normal component
 	 */
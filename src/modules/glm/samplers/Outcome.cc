@@ -5,6 +5,8 @@
 #include <graph/StochasticNode.h>
 #include <graph/LinkNode.h>
 
+using std::vector;
+
 namespace jags {
 namespace glm {
 
@@ -47,6 +49,14 @@ namespace glm {
     {
     }
 
+    void Outcome::updateBatch(Outcome * const *batch, unsigned int n,
+			      RNG *rng)
+    {
+	for (unsigned int i = 0; i < n; ++i) {
+	    batch[i]->update(rng);
+	}
+    }
+
     void Outcome::update(double mean, double var, RNG *rng)
     {
     }
@@ -65,6 +75,14 @@ namespace glm {
     {
 	return false;
     }
+
+    void Outcome::getState(vector<double> &state) const
+    {
+    }
+
+    void Outcome::setState(vector<double> const &state, unsigned int &pos)
+    {
+    }
 }}
     
 
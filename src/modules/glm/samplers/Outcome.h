@@ -1,6 +1,8 @@
 #ifndef GLM_OUTCOME_H_
 #define GLM_OUTCOME_H_
 
+#include <vector>
+
 namespace jags {
 
 struct RNG;
@@ -24,6 +26,11 @@ namespace glm {
     class Outcome  {
       protected:
 	double const &_lp;
+	/**
+	 * Number of outcomes processed at a time by the overrides of
+	 * updateBatch, which keep per-outcome workspace on the stack.
+	 */
+	static const unsigned int CHUNK = 64;
       public:
 	/**
 	 * Constructor
@@ -64,6 +71,35 @@ namespace glm {
 	 * @param rng Random number generator
 	 */
 	virtual void update(RNG *rng); 
+	/**
+	 * Updates the auxiliary variables of a batch of outcomes using
+	 * the current values of their linear predictors. This is
+	 * called on the first outcome of the batch, and all outcomes
+	 * in the batch must have the same type.
+	 *
+	 * The default implementation calls update(RNG*) for each
+	 * outcome in turn. Sub-classes with expensive updates should
+	 * override it, doing the calculations that do not use the
+	 * random number generator for the whole batch in a separate
+	 * loop. Random numbers must be drawn in the same order as by
+	 * the default implementation, so that the sampled values do
+	 * not depend on how the outcomes are batched.
+	 *
+	 * For the same reason, the bulk functions of the RNG, such as
+	 * RNG#uniform(double*, unsigned int), may only be used for
+	 * draws that are consecutive in this order. The overrides in
+	 * this module do not use them: each outcome draws the uniform
+	 * that selects its mixture component (see LGMix#select) or its
+	 * truncation point in between calls to rejection samplers
+	 * (gamma, beta, truncated normal or Polya-gamma), which consume
+	 * a variable number of random numbers.
+	 *
+	 * @param batch Array of pointers to the outcomes in the batch
+	 * @param n Length of the batch
+	 * @param rng Random number generator
+	 */
+	virtual void updateBatch(Outcome * const *batch, unsigned int n,
+				 RNG *rng);
         /**
 	 * Updates the auxiliary variables marginalizing over the
 	 * distribution of the linear predictor. The default
@@ -84,6 +120,21 @@ namespace glm {
 	 * "A" is fixed at any given iteration. The default returns false.
 	 */
 	virtual bool fixedA() const;
+	/**
+	 * Appends the values of any auxiliary variables that are
+	 * carried over from one update to the next. The default
+	 * implementation appends nothing.
+	 *
+	 * @see MutableSampleMethod#getState
+	 */
+	virtual void getState(std::vector<double> &state) const;
+	/**
+	 * Restores the auxiliary variables written by getState,
+	 * starting at position pos of the state vector, and advances
+	 * pos past them.
+	 */
+	virtual void setState(std::vector<double> const &state,
+			      unsigned int &pos);
     };
 
 }}
@@ -95,25 +95,35 @@ namespace jags {
 	}
 
 
-	static double rpolya_gamma(double z, RNG *rng)
+	/*
+	  Sampling from the Polya-gamma distribution PG(1, z) depends on
+	  z only through the constants set here, which are shared by
+	  all draws for the same value of z.
+
+	  In fact we are sampling from a Jacobi density, exploiting the
+	  fact that PG(1, z) = J(1, z/2)/4; hence the transformation of
+	  z on input and the return value of rpolya_gamma on exit.
+	*/
+	static inline void pg_constants(double lp, double &z, double &K,
+					double &ptail)
 	{
-	    /* Sample from Polya-gamma PG(1, abs(z))
-	    
-	       In fact we are sampling from a Jacobi density, exploiting
-	       the fact that PG(1, z) = J(1, z/2)/4; hence the transformation
-	       of z on input and the return value on exit.
-	    */
-	    
-	    z = abs(z)/2;
-
-	    double K = M_PI * M_PI / 8 + z * z / 2;
+	    z = abs(lp)/2;
+	    K = M_PI * M_PI / 8 + z * z / 2;
 	    double p = M_PI * exp(-K*TRUNC) / (2 * K);
 	    double q = 2 * exp(-z) * pigauss(z);
+	    ptail = p/(p+q);
+	}
+
+	static double rpolya_gamma(double z, double K, double ptail,
+				   RNG *rng)
+	{
+	    /* Sample from Polya-gamma PG(1, abs(lp)) given the constants
+	       calculated by pg_constants */
 	    
 	    for (unsigned int i = 0; i < 10; ++i) {
 
 		double X;
-		if (rng->uniform() < p/(p+q)) {
+		if (rng->uniform() < ptail) {
 		    // Sample from the tail with an exponential proposal
 		    double E = rng->exponential();
 		    X = TRUNC + E/K;
@@ -182,9 +192,41 @@ namespace jags {
 	{
 	    unsigned int N = static_cast<unsigned int>(_N);
 
+	    double z, K, ptail;
+	    pg_constants(_lp, z, K, ptail);
 	    _tau = 0.0;
 	    for (unsigned int i = 0; i < N; ++i) {
-		_tau += rpolya_gamma(_lp, rng);
+		_tau += rpolya_gamma(z, K, ptail, rng);
+	    }
+	}
+
+	void PolyaGamma::updateBatch(Outcome * const *batch, unsigned int n,
+				     RNG *rng)
+	{
+	    /*
+	      The constants of the sampler are calculated for a chunk
+	      of outcomes at a time, in a loop that does not touch the
+	      RNG. Then the draws are made in the same order as by
+	      update(RNG*).
+	    */
+	    double lp[CHUNK], z[CHUNK], K[CHUNK], ptail[CHUNK];
+	    for (unsigned int i0 = 0; i0 < n; i0 += CHUNK) {
+		unsigned int m = n - i0 < CHUNK ? n - i0 : CHUNK;
+		for (unsigned int i = 0; i < m; ++i) {
+		    lp[i] = static_cast<PolyaGamma*>(batch[i0 + i])->_lp;
+		}
+		for (unsigned int i = 0; i < m; ++i) {
+		    pg_constants(lp[i], z[i], K[i], ptail[i]);
+		}
+		for (unsigned int i = 0; i < m; ++i) {
+		    PolyaGamma *pg = static_cast<PolyaGamma*>(batch[i0 + i]);
+		    unsigned int N = static_cast<unsigned int>(pg->_N);
+		    double tau = 0.0;
+		    for (unsigned int j = 0; j < N; ++j) {
+			tau += rpolya_gamma(z[i], K[i], ptail[i], rng);
+		    }
+		    pg->_tau = tau;
+		}
 	    }
 	}
 
@@ -29,6 +29,8 @@ namespace jags {
 	    double value() const;
 	    double precision() const;
 	    void update(RNG *rng);
+	    void updateBatch(Outcome * const *batch, unsigned int n,
+			     RNG *rng);
 	    static bool canRepresent(StochasticNode const *snode);
 	};
 
@@ -1,11 +1,45 @@
 #include "testglmsamp.h"
 #include "LGMix.h"
+#include "GLMGenericFactory.h"
+#include "GLMMethod.h"
+#include "GLMBlock.h"
+#include "Outcome.h"
+#include "AuxMixBinomial.h"
+#include "AuxMixPoisson.h"
+#include "BinaryLogit.h"
+#include "BinaryProbit.h"
+#include "PolyaGamma.h"
+#include "DesignMatrix.h"
+
+#include <model/Model.h>
+#include <graph/ConstantNode.h>
+#include <graph/ScalarStochasticNode.h>
+#include <graph/ScalarLogicalNode.h>
+#include <graph/Graph.h>
+#include <sampler/GraphView.h>
+#include <sampler/Sampler.h>
+#include <sampler/SamplerFactory.h>
+#include <sampler/FreeNodeSet.h>
+#include <distribution/RScalarDist.h>
+#include <function/ScalarFunction.h>
+#include <rng/RmathRNG.h>
 #include <JRmath.h>
 
+extern "C" {
+#include <cholmod.h>
+}
+
+#include <climits>
+#include <stdexcept>
+#include <cmath>
+#include <cstdlib>
+#include <list>
+#include <utility>
 #include <sstream>
 #include <iostream>
 
 using std::vector;
+using std::string;
 using std::stringstream;
 
 void GLMSampTest::setUp()
@@ -52,3 +86,830 @@ void GLMSampTest::lgmix()
     }
     
 }
+
+namespace {
+
+    /* Minimal versions of the dnorm distribution, a linear function
+       and a random number generator, so that a GLM can be built
+       without loading the base and bugs modules */
+
+    class TestNorm : public jags::RScalarDist
+    {
+      public:
+	TestNorm() : RScalarDist("dnorm", 2, jags::DIST_UNBOUNDED) {}
+	bool checkParameterValue(vector<double const *> const &par) const {
+	    return *par[1] > 0;
+	}
+	double d(double x, jags::PDFType type,
+		 vector<double const *> const &par, bool give_log) const {
+	    return dnorm(x, *par[0], 1/sqrt(*par[1]), give_log);
+	}
+	double p(double q, vector<double const *> const &par,
+		 bool lower, bool give_log) const {
+	    return pnorm(q, *par[0], 1/sqrt(*par[1]), lower, give_log);
+	}
+	double q(double p, vector<double const *> const &par,
+		 bool lower, bool log_p) const {
+	    return qnorm(p, *par[0], 1/sqrt(*par[1]), lower, log_p);
+	}
+	double r(vector<double const *> const &par, jags::RNG *rng) const {
+	    return rnorm(*par[0], 1/sqrt(*par[1]), rng);
+	}
+    };
+
+    //Returns a + b * x
+    class TestLinear : public jags::ScalarFunction
+    {
+      public:
+	TestLinear() : ScalarFunction("linear", 3) {}
+	double evaluate(vector<double const *> const &args) const {
+	    return *args[0] + *args[1] * *args[2];
+	}
+	bool isLinear(vector<bool> const &mask,
+		      vector<bool> const &isfixed) const {
+	    return !mask[2];
+	}
+    };
+
+    class TestRNG : public jags::RmathRNG
+    {
+	unsigned int _x;
+      public:
+	TestRNG(unsigned int seed) : RmathRNG("test", jags::KINDERMAN_RAMAGE) {
+	    init(seed);
+	}
+	void init(unsigned int seed) { _x = seed ? seed : 1; }
+	void getState(vector<int> &state) const {
+	    state.assign(1, static_cast<int>(_x));
+	}
+	bool setState(vector<int> const &state) {
+	    _x = static_cast<unsigned int>(state[0]);
+	    return true;
+	}
+	double uniform() {
+	    //Marsaglia's xorshift generator
+	    _x ^= _x << 13;
+	    _x ^= _x >> 17;
+	    _x ^= _x << 5;
+	    return fixup(_x / 4294967296.0);
+	}
+    };
+
+    /*
+      Builds the linear regression y[i] ~ dnorm(b1 + b2 * x[i], 1)
+      with independent normal priors on b1 and b2, and returns the
+      sampled nodes.
+    */
+    vector<jags::StochasticNode*>
+    regression(jags::Model &model, jags::ScalarDist const *dist,
+	       jags::ScalarFunction const *func)
+    {
+	unsigned int nchain = model.nchain();
+	jags::ConstantNode *mu = new jags::ConstantNode(0, nchain, true);
+	jags::ConstantNode *prec = new jags::ConstantNode(1.0E-4, nchain, true);
+	jags::ConstantNode *tau = new jags::ConstantNode(1, nchain, true);
+	model.addNode(mu);
+	model.addNode(prec);
+	model.addNode(tau);
+
+	vector<jags::Node const *> prior(2);
+	prior[0] = mu;
+	prior[1] = prec;
+	vector<jags::StochasticNode*> b(2);
+	for (unsigned int j = 0; j < 2; ++j) {
+	    b[j] = new jags::ScalarStochasticNode(dist, nchain, prior, 0, 0);
+	    model.addNode(b[j]);
+	}
+
+	for (unsigned int i = 0; i < 20; ++i) {
+	    double xi = i - 9.5;
+	    jags::ConstantNode *x = new jags::ConstantNode(xi, nchain, true);
+	    model.addNode(x);
+
+	    vector<jags::Node const *> args(3);
+	    args[0] = b[0];
+	    args[1] = b[1];
+	    args[2] = x;
+	    jags::DeterministicNode *lp =
+		new jags::ScalarLogicalNode(func, nchain, args);
+	    model.addNode(lp);
+
+	    vector<jags::Node const *> par(2);
+	    par[0] = lp;
+	    par[1] = tau;
+	    jags::StochasticNode *y =
+		new jags::ScalarStochasticNode(dist, nchain, par, 0, 0);
+	    double yi = 1 + 0.5 * xi + sin(3.0 * i);
+	    y->setData(&yi, 1);
+	    model.addNode(y);
+	}
+	return b;
+    }
+
+    /* 
+       Normal outcome with a precision that is redrawn at each
+       update, as for outcomes with auxiliary variables
+    */
+    class TestOutcome : public jags::glm::Outcome
+    {
+	double _value;
+	double _precision;
+      public:
+	TestOutcome(jags::StochasticNode const *snode, unsigned int chain)
+	    : Outcome(snode, chain), _value(snode->value(chain)[0]),
+	      _precision(1) {}
+	double value() const { return _value; }
+	double precision() const { return _precision; }
+	void update(jags::RNG *rng) { _precision = 0.5 + rng->uniform(); }
+    };
+
+    //GLMBlock that gives access to the design matrix it uses
+    class TestBlock : public jags::glm::GLMBlock
+    {
+      public:
+	TestBlock(jags::GraphView const *view,
+		  vector<jags::SingletonGraphView const *> const &sub_views,
+		  vector<jags::glm::Outcome*> const &outcomes,
+		  unsigned int chain)
+	    : GLMBlock(view, sub_views, outcomes, chain) {}
+	cholmod_sparse const *design() const { return _x; }
+    };
+
+    class TestGLMFactory : public jags::glm::GLMFactory
+    {
+      public:
+	//GraphView of the last sampling method created
+	mutable jags::GraphView const *view;
+	//Sampling methods created, in order
+	mutable vector<TestBlock const *> blocks;
+	TestGLMFactory() : GLMFactory("test::GLM"), view(0) {}
+	bool checkOutcome(jags::StochasticNode const *snode) const {
+	    return snode->distribution()->name() == "dnorm";
+	}
+	jags::glm::GLMMethod *
+	newMethod(jags::GraphView const *view,
+		  vector<jags::SingletonGraphView const *> const &sub_views,
+		  unsigned int chain, bool gibbs) const
+	{
+	    vector<jags::glm::Outcome*> outcomes;
+	    for (unsigned int i = 0; i < view->stochasticChildren().size();
+		 ++i)
+	    {
+		outcomes.push_back(new TestOutcome(view->stochasticChildren()[i],
+						   chain));
+	    }
+	    this->view = view;
+	    TestBlock *block = new TestBlock(view, sub_views, outcomes, chain);
+	    blocks.push_back(block);
+	    return block;
+	}
+    };
+
+    /*
+       Sampler that draws a node from its prior, ignoring the
+       likelihood. Like samplers written before chains could be
+       updated in parallel, it does not override updateChain or
+       isThreadSafe.
+    */
+    class PriorSampler : public jags::Sampler
+    {
+      public:
+	PriorSampler(jags::GraphView *gv) : Sampler(gv) {}
+	void update(vector<jags::RNG*> const &rngs) {
+	    for (unsigned int ch = 0; ch < rngs.size(); ++ch) {
+		nodes()[0]->randomSample(rngs[ch], ch);
+	    }
+	}
+	void adaptOff() {}
+	bool checkAdaptation() const { return true; }
+	bool isAdaptive() const { return false; }
+	string name() const { return "test::Prior"; }
+    };
+
+    class PriorFactory : public jags::SamplerFactory
+    {
+	jags::StochasticNode *_node;
+      public:
+	PriorFactory(jags::StochasticNode *node) : _node(node) {}
+	vector<jags::Sampler*> makeSamplers(jags::FreeNodeSet const &nodes,
+					    jags::Graph const &graph) const
+	{
+	    vector<jags::Sampler*> samplers;
+	    if (nodes.contains(_node)) {
+		vector<jags::StochasticNode*> snodes(1, _node);
+		jags::GraphView *gv = new jags::GraphView(snodes, graph);
+		samplers.push_back(new PriorSampler(gv));
+	    }
+	    return samplers;
+	}
+	string name() const { return "test::Prior"; }
+    };
+
+    /* Initializes the model using only the given sampler factory */
+    void initialize(jags::Model &model, jags::SamplerFactory *factory)
+    {
+	std::list<std::pair<jags::SamplerFactory*, bool> > &factories =
+	    jags::Model::samplerFactories();
+	factories.push_front(std::pair<jags::SamplerFactory*, bool>(factory,
+								     true));
+	try {
+	    model.initialize(true);
+	}
+	catch (...) {
+	    factories.pop_front();
+	    throw;
+	}
+	factories.pop_front();
+    }
+
+    /*
+       Discrete distribution with a given name, used to build
+       outcomes of each GLM family. Only the name and the number of
+       parameters matter, so the density is a dummy.
+    */
+    class TestFamily : public jags::RScalarDist
+    {
+      public:
+	TestFamily(string const &name, unsigned int npar)
+	    : RScalarDist(name, npar, jags::DIST_POSITIVE, true) {}
+	bool checkParameterValue(vector<double const *> const &par) const {
+	    return true;
+	}
+	double d(double x, jags::PDFType type,
+		 vector<double const *> const &par, bool give_log) const {
+	    return give_log ? 0 : 1;
+	}
+	double p(double q, vector<double const *> const &par,
+		 bool lower, bool give_log) const {
+	    return give_log ? 0 : 1;
+	}
+	double q(double p, vector<double const *> const &par,
+		 bool lower, bool log_p) const {
+	    return 0;
+	}
+	double r(vector<double const *> const &par, jags::RNG *rng) const {
+	    return 0;
+	}
+    };
+
+    /*
+       Builds nout observed outcomes with the given distribution,
+       each with its own linear predictor. Binomial outcomes have
+       sizes between 1 and 7, and the outcome values cycle through
+       their support so that every branch of the updates is used.
+    */
+    vector<jags::StochasticNode const *>
+    outcomes(jags::Model &model, jags::ScalarDist const *dist,
+	     unsigned int nout)
+    {
+	vector<jags::StochasticNode const *> ans;
+	for (unsigned int i = 0; i < nout; ++i) {
+	    vector<jags::Node const *> par;
+	    jags::ConstantNode *lp =
+		new jags::ConstantNode(3 * sin(0.7 * i), 1, true);
+	    model.addNode(lp);
+	    par.push_back(lp);
+
+	    double yi = i % 2;
+	    if (dist->name() == "dbin") {
+		double size = 1 + i % 7;
+		jags::ConstantNode *N = new jags::ConstantNode(size, 1, true);
+		model.addNode(N);
+		par.push_back(N);
+		yi = i % static_cast<unsigned int>(size + 1);
+	    }
+	    else if (dist->name() == "dpois") {
+		yi = i % 5;
+	    }
+
+	    jags::StochasticNode *y =
+		new jags::ScalarStochasticNode(dist, 1, par, 0, 0);
+	    y->setData(&yi, 1);
+	    model.addNode(y);
+	    ans.push_back(y);
+	}
+	return ans;
+    }
+
+    /*
+       Updating the outcomes with updateBatch must give the same
+       auxiliary variables as calling update(RNG*) for each outcome
+       in turn with the same random number generator.
+    */
+    template<class T>
+    void checkBatch(vector<jags::StochasticNode const *> const &snodes)
+    {
+	vector<jags::glm::Outcome*> single, batch;
+	for (unsigned int i = 0; i < snodes.size(); ++i) {
+	    single.push_back(new T(snodes[i], 0));
+	    batch.push_back(new T(snodes[i], 0));
+	}
+
+	TestRNG rng1(7), rng2(7);
+	for (unsigned int iter = 0; iter < 3; ++iter) {
+	    for (unsigned int i = 0; i < single.size(); ++i) {
+		single[i]->update(&rng1);
+	    }
+	    batch[0]->updateBatch(&batch[0], batch.size(), &rng2);
+	    for (unsigned int i = 0; i < single.size(); ++i) {
+		CPPUNIT_ASSERT_EQUAL(single[i]->value(), batch[i]->value());
+		CPPUNIT_ASSERT_EQUAL(single[i]->precision(),
+				     batch[i]->precision());
+	    }
+	}
+	CPPUNIT_ASSERT_EQUAL(rng1.uniform(), rng2.uniform());
+
+	for (unsigned int i = 0; i < single.size(); ++i) {
+	    delete single[i];
+	    delete batch[i];
+	}
+    }
+
+    /* Counts memory allocations made by CHOLMOD */
+    unsigned long cholmod_nalloc = 0;
+
+    void *count_malloc(size_t size)
+    {
+	++cholmod_nalloc;
+	return malloc(size);
+    }
+
+    void *count_calloc(size_t n, size_t size)
+    {
+	++cholmod_nalloc;
+	return calloc(n, size);
+    }
+
+    void *count_realloc(void *p, size_t size)
+    {
+	++cholmod_nalloc;
+	return realloc(p, size);
+    }
+}
+
+void GLMSampTest::lgmixselect()
+{
+    //Choosing the mixture component with a uniform drawn in
+    //advance, as in Outcome#updateBatch, must give the same result
+    //as drawing it inside LGMix#update
+
+    TestRNG rng1(1), rng2(1);
+    double const n[] = {1, 4, 7, 19, 35, 500, 2000, 40000};
+    for (unsigned int i = 0; i < sizeof(n)/sizeof(n[0]); ++i) {
+	jags::glm::LGMix lg1(n[i]), lg2(n[i]);
+	double mu = -digamma(n[i]);
+	double sigma = sqrt(trigamma(n[i]));
+	for (int j = -50; j < 50; ++j) {
+	    double z = mu + sigma * j / 20.0;
+	    lg1.update(z, n[i], &rng1);
+	    lg2.select(z, n[i], rng2.uniform());
+	    CPPUNIT_ASSERT_EQUAL(lg1.mean(), lg2.mean());
+	    CPPUNIT_ASSERT_EQUAL(lg1.precision(), lg2.precision());
+	}
+    }
+}
+
+void GLMSampTest::updatebatch()
+{
+    //Each override of Outcome#updateBatch must draw the same random
+    //numbers as the default. The number of outcomes is not a
+    //multiple of the chunk size, so the last chunk is partial.
+
+    TestFamily dbern("dbern", 1), dbin("dbin", 2), dpois("dpois", 1);
+    jags::Model model(1);
+    unsigned int nout = 150;
+    vector<jags::StochasticNode const *> bern = outcomes(model, &dbern, nout);
+    vector<jags::StochasticNode const *> bin = outcomes(model, &dbin, nout);
+    vector<jags::StochasticNode const *> pois = outcomes(model, &dpois, nout);
+
+    checkBatch<jags::glm::AuxMixBinomial>(bern);
+    checkBatch<jags::glm::AuxMixBinomial>(bin);
+    checkBatch<jags::glm::AuxMixPoisson>(pois);
+    checkBatch<jags::glm::BinaryLogit>(bern);
+    checkBatch<jags::glm::BinaryProbit>(bern);
+    checkBatch<jags::glm::PolyaGamma>(bern);
+    checkBatch<jags::glm::PolyaGamma>(bin);
+}
+
+void GLMSampTest::parallel()
+{
+    //Updating the chains in parallel must give the same draws as
+    //updating them one after the other
+
+    TestNorm dist;
+    TestLinear func;
+    jags::glm::GLMGenericFactory factory;
+
+    unsigned int nchain = 4;
+    jags::Model serial_model(nchain), parallel_model(nchain);
+    vector<jags::StochasticNode*> serial_b =
+	regression(serial_model, &dist, &func);
+    vector<jags::StochasticNode*> parallel_b =
+	regression(parallel_model, &dist, &func);
+
+    vector<TestRNG*> rngs;
+    for (unsigned int ch = 0; ch < nchain; ++ch) {
+	rngs.push_back(new TestRNG(ch + 1));
+	serial_model.setRNG(rngs.back(), ch);
+	rngs.push_back(new TestRNG(ch + 1));
+	parallel_model.setRNG(rngs.back(), ch);
+    }
+
+    initialize(serial_model, &factory);
+    initialize(parallel_model, &factory);
+
+    //Both coefficients are sampled in a single block
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1),
+			 parallel_model.samplerEvaluations().size());
+
+    for (unsigned int iter = 0; iter < 10; ++iter) {
+	serial_model.update(5, false);
+	parallel_model.update(5, true);
+	for (unsigned int ch = 0; ch < nchain; ++ch) {
+	    for (unsigned int j = 0; j < 2; ++j) {
+		CPPUNIT_ASSERT_EQUAL(serial_b[j]->value(ch)[0],
+				     parallel_b[j]->value(ch)[0]);
+	    }
+	}
+    }
+
+    //Sanity check on the posterior means of the last chain
+    double b1 = 0, b2 = 0;
+    unsigned int nsample = 200;
+    for (unsigned int iter = 0; iter < nsample; ++iter) {
+	parallel_model.update(1, true);
+	b1 += parallel_b[0]->value(nchain - 1)[0] / nsample;
+	b2 += parallel_b[1]->value(nchain - 1)[0] / nsample;
+    }
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, b1, 0.5);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, b2, 0.1);
+
+    for (unsigned int i = 0; i < rngs.size(); ++i) {
+	delete rngs[i];
+    }
+}
+
+void GLMSampTest::serialsampler()
+{
+    //A sampler that is not thread-safe is updated for all chains by
+    //the calling thread in a parallel update, which must still give
+    //the same draws as a serial update
+
+    TestNorm dist;
+    TestLinear func;
+    jags::glm::GLMGenericFactory factory;
+
+    unsigned int nchain = 3;
+    jags::Model serial_model(nchain), parallel_model(nchain);
+    jags::Model *models[2] = {&serial_model, &parallel_model};
+    vector<jags::StochasticNode*> b[2], z(2);
+    vector<TestRNG*> rngs;
+    for (unsigned int k = 0; k < 2; ++k) {
+	b[k] = regression(*models[k], &dist, &func);
+
+	//Additional node z with an observed child w
+	vector<jags::Node const *> par = b[k][0]->parents();
+	z[k] = new jags::ScalarStochasticNode(&dist, nchain, par, 0, 0);
+	models[k]->addNode(z[k]);
+	par[0] = z[k];
+	jags::StochasticNode *w =
+	    new jags::ScalarStochasticNode(&dist, nchain, par, 0, 0);
+	double wvalue = 0;
+	w->setData(&wvalue, 1);
+	models[k]->addNode(w);
+
+	for (unsigned int ch = 0; ch < nchain; ++ch) {
+	    rngs.push_back(new TestRNG(ch + 1));
+	    models[k]->setRNG(rngs.back(), ch);
+	}
+
+	PriorFactory prior(z[k]);
+	std::list<std::pair<jags::SamplerFactory*, bool> > &factories =
+	    jags::Model::samplerFactories();
+	factories.push_front(std::pair<jags::SamplerFactory*, bool>(&factory,
+								     true));
+	initialize(*models[k], &prior);
+	factories.pop_front();
+	CPPUNIT_ASSERT_EQUAL(std::size_t(2),
+			     models[k]->samplerEvaluations().size());
+    }
+
+    for (unsigned int iter = 0; iter < 10; ++iter) {
+	serial_model.update(5, false);
+	parallel_model.update(5, true);
+	for (unsigned int ch = 0; ch < nchain; ++ch) {
+	    for (unsigned int j = 0; j < 2; ++j) {
+		CPPUNIT_ASSERT_EQUAL(b[0][j]->value(ch)[0],
+				     b[1][j]->value(ch)[0]);
+	    }
+	    CPPUNIT_ASSERT_EQUAL(z[0]->value(ch)[0], z[1]->value(ch)[0]);
+	}
+    }
+
+    for (unsigned int i = 0; i < rngs.size(); ++i) {
+	delete rngs[i];
+    }
+}
+
+void GLMSampTest::allocation()
+{
+    //After the first iteration, a block update reuses its storage
+    //and makes no calls to the CHOLMOD memory allocator
+    
+    TestNorm dist;
+    TestLinear func;
+    jags::glm::GLMGenericFactory factory;
+
+    jags::Model model(1);
+    vector<jags::StochasticNode*> b = regression(model, &dist, &func);
+    TestRNG rng(1);
+    model.setRNG(&rng, 0);
+    initialize(model, &factory);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), model.samplerEvaluations().size());
+
+    void *(*old_malloc)(size_t) = SuiteSparse_config.malloc_func;
+    void *(*old_calloc)(size_t, size_t) = SuiteSparse_config.calloc_func;
+    void *(*old_realloc)(void *, size_t) = SuiteSparse_config.realloc_func;
+    SuiteSparse_config.malloc_func = count_malloc;
+    SuiteSparse_config.calloc_func = count_calloc;
+    SuiteSparse_config.realloc_func = count_realloc;
+
+    vector<unsigned long> nalloc;
+    for (unsigned int iter = 0; iter < 10; ++iter) {
+	cholmod_nalloc = 0;
+	model.update(1, false);
+	nalloc.push_back(cholmod_nalloc);
+    }
+
+    SuiteSparse_config.malloc_func = old_malloc;
+    SuiteSparse_config.calloc_func = old_calloc;
+    SuiteSparse_config.realloc_func = old_realloc;
+
+    //Storage for the numeric factorization and the solutions is
+    //allocated on the first update
+    CPPUNIT_ASSERT(nalloc[0] > 0);
+    for (unsigned int iter = 1; iter < nalloc.size(); ++iter) {
+	stringstream msg;
+	msg << "iteration " << iter + 1;
+	CPPUNIT_ASSERT_EQUAL_MESSAGE(msg.str(), 0UL, nalloc[iter]);
+    }
+}
+
+void GLMSampTest::supernodal()
+{
+    //Supernodal and simplicial factorizations of the posterior
+    //precision must give the same draws, up to rounding error
+
+    TestNorm dist;
+    TestLinear func;
+    jags::glm::GLMGenericFactory factory;
+    unsigned int length = jags::glm::GLMMethod::supernodalLength();
+
+    jags::Model simplicial_model(1), supernodal_model(1);
+    vector<jags::StochasticNode*> simplicial_b =
+	regression(simplicial_model, &dist, &func);
+    vector<jags::StochasticNode*> supernodal_b =
+	regression(supernodal_model, &dist, &func);
+    TestRNG rng1(1), rng2(1);
+    simplicial_model.setRNG(&rng1, 0);
+    supernodal_model.setRNG(&rng2, 0);
+
+    try {
+	jags::glm::GLMMethod::setSupernodalLength(UINT_MAX);
+	initialize(simplicial_model, &factory);
+	jags::glm::GLMMethod::setSupernodalLength(0);
+	initialize(supernodal_model, &factory);
+    }
+    catch (...) {
+	jags::glm::GLMMethod::setSupernodalLength(length);
+	throw;
+    }
+    jags::glm::GLMMethod::setSupernodalLength(length);
+
+    for (unsigned int iter = 0; iter < 50; ++iter) {
+	simplicial_model.update(1, false);
+	supernodal_model.update(1, false);
+	for (unsigned int j = 0; j < 2; ++j) {
+	    CPPUNIT_ASSERT_DOUBLES_EQUAL(simplicial_b[j]->value(0)[0],
+					 supernodal_b[j]->value(0)[0],
+					 1.0E-8);
+	}
+    }
+}
+
+void GLMSampTest::lowrank()
+{
+    //Modifying the factorization when the outcome precisions change
+    //must give the same draws as recalculating it, up to rounding
+    //error
+
+    TestNorm dist;
+    TestLinear func;
+    TestGLMFactory factory;
+    double cost = jags::glm::GLMMethod::updateCost();
+
+    jags::Model full_model(1), lowrank_model(1);
+    vector<jags::StochasticNode*> full_b =
+	regression(full_model, &dist, &func);
+    vector<jags::StochasticNode*> lowrank_b =
+	regression(lowrank_model, &dist, &func);
+    TestRNG rng1(1), rng2(1);
+    full_model.setRNG(&rng1, 0);
+    lowrank_model.setRNG(&rng2, 0);
+
+    //The factorization is always recalculated for full_model, and
+    //always modified for lowrank_model
+    try {
+	jags::glm::GLMMethod::setUpdateCost(-1);
+	initialize(full_model, &factory);
+	jags::glm::GLMMethod::setUpdateCost(100);
+	initialize(lowrank_model, &factory);
+    }
+    catch (...) {
+	jags::glm::GLMMethod::setUpdateCost(cost);
+	throw;
+    }
+    jags::glm::GLMMethod::setUpdateCost(cost);
+
+    for (unsigned int iter = 0; iter < 50; ++iter) {
+	full_model.update(1, false);
+	lowrank_model.update(1, false);
+	for (unsigned int j = 0; j < 2; ++j) {
+	    CPPUNIT_ASSERT_DOUBLES_EQUAL(full_b[j]->value(0)[0],
+					 lowrank_b[j]->value(0)[0],
+					 1.0E-8);
+	}
+    }
+}
+
+void GLMSampTest::design()
+{
+    //The chains of a GLM sampler share a single copy of a fixed
+    //design matrix
+
+    TestNorm dist;
+    TestLinear func;
+    TestGLMFactory factory;
+
+    jags::Model model(2);
+    regression(model, &dist, &func);
+    TestRNG rng1(1), rng2(2);
+    model.setRNG(&rng1, 0);
+    model.setRNG(&rng2, 1);
+    initialize(model, &factory);
+    CPPUNIT_ASSERT(factory.view != 0);
+
+    jags::glm::DesignMatrix *design =
+	jags::glm::DesignMatrix::attach(factory.view);
+    CPPUNIT_ASSERT(design != 0);
+    cholmod_sparse const *X = design->matrix();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(20), X->nrow);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), X->ncol);
+
+    //Column 0 is the intercept and column 1 the covariate
+    int const *Xp = static_cast<int const*>(X->p);
+    int const *Xi = static_cast<int const*>(X->i);
+    double const *Xx = static_cast<double const*>(X->x);
+    for (unsigned int j = 0; j < 2; ++j) {
+	CPPUNIT_ASSERT_EQUAL(20, Xp[j+1] - Xp[j]);
+	for (int k = Xp[j]; k < Xp[j+1]; ++k) {
+	    double xk = j == 0 ? 1 : Xi[k] - 9.5;
+	    CPPUNIT_ASSERT_DOUBLES_EQUAL(xk, Xx[k], 1.0E-12);
+	}
+    }
+
+    //Both chains use the shared matrix itself, not a copy
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), factory.blocks.size());
+    for (unsigned int ch = 0; ch < 2; ++ch) {
+	CPPUNIT_ASSERT(factory.blocks[ch]->design() == X);
+    }
+
+    //Updates do not rebuild or modify it
+    vector<double> values(Xx, Xx + Xp[2]);
+    for (unsigned int iter = 0; iter < 5; ++iter) {
+	model.update(1, false);
+    }
+    CPPUNIT_ASSERT(design->matrix() == X);
+    CPPUNIT_ASSERT(X->p == Xp && X->i == Xi && X->x == Xx);
+    for (unsigned int ch = 0; ch < 2; ++ch) {
+	CPPUNIT_ASSERT(factory.blocks[ch]->design() == X);
+    }
+    CPPUNIT_ASSERT(values == vector<double>(Xx, Xx + Xp[2]));
+    jags::glm::DesignMatrix::detach(design);
+}
+
+void GLMSampTest::incremental()
+{
+    /*
+      In incremental mode, GraphView must give the same log full
+      conditional as a full evaluation, while only recalculating
+      the log densities that depend on a changed node. The sampled
+      nodes b1 and b2 each have 10 children, with a different
+      distribution so that they are in separate groups:
+
+      y[i] ~ dnorm(b1 + x[i], 1)
+      z[i] ~ dnorm(0 + b2 * x[i], 1)
+    */
+    TestNorm ydist, zdist;
+    TestLinear func;
+
+    jags::Model model(1);
+    jags::ConstantNode *mu = new jags::ConstantNode(0, 1, true);
+    jags::ConstantNode *prec = new jags::ConstantNode(1.0E-4, 1, true);
+    jags::ConstantNode *one = new jags::ConstantNode(1, 1, true);
+    model.addNode(mu);
+    model.addNode(prec);
+    model.addNode(one);
+
+    vector<jags::Node const *> prior(2);
+    prior[0] = mu;
+    prior[1] = prec;
+    vector<jags::StochasticNode*> b(2);
+    for (unsigned int j = 0; j < 2; ++j) {
+	b[j] = new jags::ScalarStochasticNode(&ydist, 1, prior, 0, 0);
+	model.addNode(b[j]);
+    }
+
+    for (unsigned int i = 0; i < 10; ++i) {
+	jags::ConstantNode *x = new jags::ConstantNode(i - 4.5, 1, true);
+	model.addNode(x);
+	for (unsigned int j = 0; j < 2; ++j) {
+	    vector<jags::Node const *> args(3);
+	    args[0] = j == 0 ? b[0] : static_cast<jags::Node const*>(mu);
+	    args[1] = j == 0 ? static_cast<jags::Node const*>(one) : b[1];
+	    args[2] = x;
+	    jags::DeterministicNode *lp =
+		new jags::ScalarLogicalNode(&func, 1, args);
+	    model.addNode(lp);
+
+	    vector<jags::Node const *> par(2);
+	    par[0] = lp;
+	    par[1] = one;
+	    jags::StochasticNode *y = 
+		new jags::ScalarStochasticNode(j == 0 ? &ydist : &zdist, 1,
+					       par, 0, 0);
+	    double yi = sin(3.0 * i + j);
+	    y->setData(&yi, 1);
+	    model.addNode(y);
+	}
+    }
+
+    jags::Graph graph;
+    for (unsigned int i = 0; i < model.nodes().size(); ++i) {
+	graph.insert(model.nodes()[i]);
+    }
+    jags::GraphView full(b, graph), incr(b, graph);
+    incr.setIncremental();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(20), incr.stochasticChildren().size());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(20),
+			 incr.deterministicChildren().size());
+
+    /*
+      Values to set, with the number of log densities that must be
+      recalculated: all 22 at first, then the prior of b1 or b2 and
+      its 10 children when only one of them changes.
+    */
+    double values[7][2] = {{0.5, 1}, {0.7, 1}, {0.7, 1}, {0.7, -2},
+			   {-1, 3}, {-1, 0.25}, {-1, 0.25}};
+    unsigned long nterms[7] = {22, 11, 0, 11, 22, 11, 0};
+
+    for (unsigned int k = 0; k < 7; ++k) {
+	vector<double> value(values[k], values[k] + 2);
+	unsigned long nfull = full.evaluations();
+	unsigned long nincr = incr.evaluations();
+
+	incr.setValue(value, 0);
+	double lincr = incr.logFullConditional(0);
+	full.setValue(value, 0);
+	double lfull = full.logFullConditional(0);
+	CPPUNIT_ASSERT_EQUAL(lfull, lincr);
+
+	CPPUNIT_ASSERT_EQUAL(22UL, full.evaluations() - nfull);
+	stringstream msg;
+	msg << "value " << k + 1;
+	CPPUNIT_ASSERT_EQUAL_MESSAGE(msg.str(), nterms[k],
+				     incr.evaluations() - nincr);
+    }
+
+    //After the values have been changed outside the incremental
+    //GraphView, invalidate makes it recalculate every term
+    vector<double> value(2);
+    value[0] = 2;
+    value[1] = -0.5;
+    full.setValue(value, 0);
+    double lfull = full.logFullConditional(0);
+    unsigned long nincr = incr.evaluations();
+    incr.invalidate(0);
+    incr.setValue(value, 0);
+    CPPUNIT_ASSERT_EQUAL(lfull, incr.logFullConditional(0));
+    CPPUNIT_ASSERT_EQUAL(22UL, incr.evaluations() - nincr);
+
+    //Only the changed node is recalculated after that
+    value[1] = 1.5;
+    nincr = incr.evaluations();
+    incr.setValue(value, 0);
+    double lincr = incr.logFullConditional(0);
+    CPPUNIT_ASSERT_EQUAL(11UL, incr.evaluations() - nincr);
+    full.setValue(value, 0);
+    CPPUNIT_ASSERT_EQUAL(full.logFullConditional(0), lincr);
+}
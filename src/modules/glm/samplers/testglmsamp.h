@@ -8,12 +8,30 @@ class GLMSampTest : public CppUnit::TestFixture , public JAGSFixture
 {
     CPPUNIT_TEST_SUITE( GLMSampTest );
     CPPUNIT_TEST( lgmix );
+    CPPUNIT_TEST( lgmixselect );
+    CPPUNIT_TEST( updatebatch );
+    CPPUNIT_TEST( parallel );
+    CPPUNIT_TEST( serialsampler );
+    CPPUNIT_TEST( allocation );
+    CPPUNIT_TEST( supernodal );
+    CPPUNIT_TEST( lowrank );
+    CPPUNIT_TEST( design );
+    CPPUNIT_TEST( incremental );
     CPPUNIT_TEST_SUITE_END();
 
 public:
     void setUp();
     void tearDown();
     void lgmix();
+    void lgmixselect();
+    void updatebatch();
+    void parallel();
+    void serialsampler();
+    void allocation();
+    void supernodal();
+    void lowrank();
+    void design();
+    void incremental();
 };
 
 #endif  // GLM_SAMP_TEST_H
@@ -122,7 +122,12 @@ namespace lecuyer {
 	}
     }
 
-    double RngStream::uniform ()
+    /*
+      Advances the state of the generator by one step and returns the
+      next uniform random variable. The state is passed explicitly so
+      that the bulk uniform function can keep it in local variables.
+    */
+    static inline double MRG32k3a(double Cg[6])
     {
 	/* Component 1 */
 	double p1 = a12 * Cg[1] - a13n * Cg[0];
@@ -148,6 +153,46 @@ namespace lecuyer {
 	return ((p1 > p2) ? (p1 - p2) * norm : (p1 - p2 + m1) * norm);
     }
 
+    inline double RngStream::next()
+    {
+	return MRG32k3a(Cg);
+    }
+
+    double RngStream::uniform ()
+    {
+	return next();
+    }
+
+    void RngStream::uniform(double *x, unsigned int n)
+    {
+	/* 
+	   Work on a local copy of the state, which the compiler can
+	   keep in registers, since it cannot alias the output array
+	*/
+	double cg[6];
+	for (int i = 0; i < 6; ++i) {
+	    cg[i] = Cg[i];
+	}
+	for (unsigned int i = 0; i < n; ++i) {
+	    x[i] = MRG32k3a(cg);
+	}
+	for (int i = 0; i < 6; ++i) {
+	    Cg[i] = cg[i];
+	}
+    }
+
+    void RngStream::normal(double *x, unsigned int n)
+    {
+	InlineUniform<RngStream, &RngStream::next> unif(this);
+	RmathRNG::normal(x, n, unif);
+    }
+
+    void RngStream::exponential(double *x, unsigned int n)
+    {
+	InlineUniform<RngStream, &RngStream::next> unif(this);
+	RmathRNG::exponential(x, n, unif);
+    }
+
     void RngStream::init(unsigned int seed)
     {
 	unsigned int state[6];
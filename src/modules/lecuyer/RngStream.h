@@ -14,6 +14,7 @@ namespace lecuyer {
      */
     class RngStream : public RmathRNG {
 	double Cg[6];
+	inline double next();
     public:
 	/**
 	 * Constructor for RngStream random number generator
@@ -28,6 +29,9 @@ namespace lecuyer {
 	bool setState(std::vector<int> const &state);
 	void getState(std::vector<int> &state) const;
 	double uniform();
+	void uniform(double *x, unsigned int n);
+	void normal(double *x, unsigned int n);
+	void exponential(double *x, unsigned int n);
 	/**
 	 * Generates a state vector from a random seed
 	 */
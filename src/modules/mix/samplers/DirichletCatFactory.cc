@@ -83,7 +83,7 @@ namespace jags {
 
 
 	vector<Sampler*>  
-	DirichletCatFactory::makeSamplers(list<StochasticNode*> const &nodes, 
+	DirichletCatFactory::makeSamplers(FreeNodeSet const &nodes, 
 					  Graph const &graph) const
 	{
 	    //Assemble candidates from available nodes and classify
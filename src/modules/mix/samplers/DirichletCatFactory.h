@@ -15,7 +15,7 @@ namespace jags {
 	    Sampler * makeSampler(std::vector<StochasticNode*> const &snodes, 
 				  Graph const &graph) const;
 	    std::vector<Sampler*>  
-		makeSamplers(std::list<StochasticNode*> const &nodes, 
+		makeSamplers(FreeNodeSet const &nodes, 
 			     Graph const &graph) const;
 	    std::string name() const;
 	};
@@ -125,7 +125,7 @@ namespace jags {
 	Sampler * 
 	LDAFactory::makeSampler(vector<StochasticNode*> const &topicPriors,
 				vector<StochasticNode*> const &wordPriors,
-				list<StochasticNode*> const &free_nodes,
+				FreeNodeSet const &free_nodes,
 				Graph const &graph) const
 	{
 	    if (topicPriors.empty() || wordPriors.empty()) return 0;
@@ -137,9 +137,7 @@ namespace jags {
 		SingletonGraphView gvd(topicPriors[d], graph);
 		topics[d] = gvd.stochasticChildren();
 		for (unsigned int i = 0; i < topics[d].size(); ++i) {
-		    if (find(free_nodes.begin(), free_nodes.end(), topics[d][i])
-			== free_nodes.end()) 
-		    {
+		    if (!free_nodes.contains(topics[d][i])) {
 			return 0;
 		    }
 		    SingletonGraphView gvi(topics[d][i], graph);
@@ -168,7 +166,7 @@ namespace jags {
 	}
 
 	vector<Sampler*>  
-	LDAFactory::makeSamplers(list<StochasticNode*> const &free_nodes, 
+	LDAFactory::makeSamplers(FreeNodeSet const &free_nodes, 
 				 Graph const &graph) const
 	{
 	    //First we need to traverse the graph looking for
@@ -65,7 +65,7 @@ static void aggregate(SingletonGraphView const *gv,
 namespace mix {
 
     Sampler * 
-    MixSamplerFactory::makeSampler(list<StochasticNode*> const &nodes, 
+    MixSamplerFactory::makeSampler(FreeNodeSet const &nodes, 
 				   Graph const &graph) const
     {
 	vector<SingletonGraphView*> gvec;
@@ -107,7 +107,7 @@ namespace mix {
     }
 
     vector<Sampler*>  
-    MixSamplerFactory::makeSamplers(list<StochasticNode*> const &nodes, 
+    MixSamplerFactory::makeSamplers(FreeNodeSet const &nodes, 
 				    Graph const &graph) const
     {
 	Sampler *s = makeSampler(nodes, graph);
@@ -12,10 +12,10 @@ namespace mix {
     class MixSamplerFactory : public SamplerFactory
     {
     public:
-	Sampler * makeSampler(std::list<StochasticNode*> const &nodes, 
+	Sampler * makeSampler(FreeNodeSet const &nodes, 
 			      Graph const &graph) const;
 	std::vector<Sampler*>  
-	    makeSamplers(std::list<StochasticNode*> const &nodes, 
+	    makeSamplers(FreeNodeSet const &nodes, 
 			 Graph const &graph) const;
 	std::string name() const;
     };
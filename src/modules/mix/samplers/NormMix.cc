@@ -238,4 +238,20 @@ namespace mix {
         return _gv->logLikelihood(_chain);
     }
 
+    void NormMix::getState(vector<double> &state) const
+    {
+	TemperedMetropolis::getState(state);
+	for (unsigned int i = 0; i < _di.size(); ++i) {
+	    state.push_back(_di[i]->sum);
+	}
+    }
+
+    void NormMix::setState(vector<double> const &state, unsigned int &pos)
+    {
+	TemperedMetropolis::setState(state, pos);
+	for (unsigned int i = 0; i < _di.size(); ++i) {
+	    _di[i]->sum = state[pos++];
+	}
+    }
+
 }}
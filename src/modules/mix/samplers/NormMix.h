@@ -54,6 +54,12 @@ namespace mix {
 	double logJacobian(std::vector<double> const &value) const;
 	void step(std::vector<double> &value, double step, RNG *rng) const;
 	static bool canSample(std::vector<StochasticNode *> const &snodes);
+	/**
+	 * Appends the scale factors of any Dirichlet nodes to the
+	 * state of the parent class.
+	 */
+	void getState(std::vector<double> &state) const;
+	void setState(std::vector<double> const &state, unsigned int &pos);
     };
 
 }}
@@ -0,0 +1,71 @@
+#include "PhiloxFactory.h"
+#include "PhiloxRNG.h"
+
+#include <ctime>
+
+using std::vector;
+using std::time;
+using std::string;
+
+namespace jags {
+namespace philox {
+
+    PhiloxFactory::PhiloxFactory()
+	: _seed(static_cast<unsigned int>(time(NULL))), _stream(0)
+    {
+    }
+    
+    PhiloxFactory::~PhiloxFactory()
+    {
+	for (unsigned int i = 0; i < _rngvec.size(); ++i) {
+	    delete _rngvec[i];
+	}
+    }
+
+    void PhiloxFactory::setSeed(unsigned int seed)
+    {
+	_seed = seed;
+	_stream = 0;
+    }
+
+    vector<RNG *> PhiloxFactory::makeRNGs(unsigned int n)
+    {
+	vector<RNG *> ans;
+	for (unsigned int i = 0; i < n; ++i) {
+	    RNG *rng = new PhiloxRNG(_seed, _stream++, 0);
+	    _rngvec.push_back(rng);
+	    ans.push_back(rng);
+	}
+	return ans;
+    }
+
+    RNG * PhiloxFactory::makeRNG(string const &name)
+    {
+	if (name == "philox::Philox4x32") {
+	    RNG *rng = new PhiloxRNG(_seed, _stream++, 0);
+	    _rngvec.push_back(rng);
+	    return rng;
+	}
+	else {
+	    return 0;
+	}
+    }
+
+    RNG * PhiloxFactory::makeSubstream(RNG const *rng, unsigned int index)
+    {
+	PhiloxRNG const *prng = dynamic_cast<PhiloxRNG const *>(rng);
+	if (prng == 0 || index == ~0U) {
+	    return 0;
+	}
+	/* Substream 0 belongs to the original RNG */
+	RNG *ans = prng->substream(index + 1);
+	_rngvec.push_back(ans);
+	return ans;
+    }
+
+    string PhiloxFactory::name() const
+    {
+	return "philox::Philox4x32";
+    }
+
+}}
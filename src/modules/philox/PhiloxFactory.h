@@ -0,0 +1,35 @@
+#ifndef PHILOX_FACTORY_H_
+#define PHILOX_FACTORY_H_
+
+#include <rng/RNGFactory.h>
+
+namespace jags {
+namespace philox {
+    
+/**
+ * @short Factory object for Philox RNGs
+ *
+ * All RNGs produced by the factory share the same key, which is set
+ * from the seed, and each one has its own stream.  Since streams
+ * are selected by the counter, rather than by jumping ahead in a
+ * sequence, there is no practical limit on the number of
+ * independent RNGs.
+ */
+    class PhiloxFactory : public RNGFactory
+    {
+	unsigned int _seed;
+	unsigned int _stream;
+	std::vector<RNG*> _rngvec;
+    public:
+	PhiloxFactory();
+	~PhiloxFactory();
+	void setSeed(unsigned int seed);
+	std::vector<RNG *> makeRNGs(unsigned int n);
+	RNG * makeRNG(std::string const &name);
+	RNG * makeSubstream(RNG const *rng, unsigned int index);
+	std::string name() const;
+    };
+
+}}
+
+#endif /* PHILOX_FACTORY_H_ */
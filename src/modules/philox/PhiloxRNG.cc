@@ -0,0 +1,257 @@
+/*
+ * Philox4x32-10 counter-based random number generator
+ *
+ * Salmon JK, Moraes MA, Dror RO, Shaw DE (2011) Parallel random
+ * numbers: as easy as 1, 2, 3. Proceedings of the International
+ * Conference for High Performance Computing, Networking, Storage and
+ * Analysis (SC11).
+ *
+ * The round function and constants are those of the Random123
+ * library. The output for a given key and counter is identical to
+ * philox4x32 with 10 rounds in Random123.
+ */
+
+#include "PhiloxRNG.h"
+
+using std::vector;
+
+#define PHILOX_M0 0xD2511F53U /* Multipliers */
+#define PHILOX_M1 0xCD9E8D57U
+#define PHILOX_W0 0x9E3779B9U /* Weyl sequence for the key schedule */
+#define PHILOX_W1 0xBB67AE85U
+
+/* Number of blocks calculated together in the bulk uniform function */
+#define NLANE 8
+
+/* Converts a 32-bit integer to a real number in the open interval (0,1) */
+static inline double toUniform(uint32_t x)
+{
+    return (x + 0.5) * 2.3283064365386963e-10; /* 2^-32 */
+}
+
+static inline void philoxRound(uint32_t ctr[4], uint32_t const key[2])
+{
+    uint64_t p0 = static_cast<uint64_t>(PHILOX_M0) * ctr[0];
+    uint64_t p1 = static_cast<uint64_t>(PHILOX_M1) * ctr[2];
+    uint32_t hi0 = p0 >> 32, lo0 = p0;
+    uint32_t hi1 = p1 >> 32, lo1 = p1;
+    ctr[0] = hi1 ^ ctr[1] ^ key[0];
+    ctr[1] = lo1;
+    ctr[2] = hi0 ^ ctr[3] ^ key[1];
+    ctr[3] = lo0;
+}
+
+/* Increments the block position held in words 0 and 1 of the counter */
+static inline void increment(uint32_t ctr[4])
+{
+    if (++ctr[0] == 0) ++ctr[1];
+}
+
+/* Generates a 64-bit key from a 32-bit seed */
+static void seedToKey(unsigned int seed, uint32_t key[2])
+{
+    /* Finalizer of the SplitMix64 generator */
+    uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= (z >> 31);
+    key[0] = static_cast<uint32_t>(z);
+    key[1] = static_cast<uint32_t>(z >> 32);
+}
+
+namespace jags {
+namespace philox {
+
+    void PhiloxRNG::block(uint32_t const key[2], uint32_t const ctr[4],
+			  uint32_t out[4])
+    {
+	uint32_t k[2] = {key[0], key[1]};
+	for (int i = 0; i < 4; ++i) {
+	    out[i] = ctr[i];
+	}
+	for (int r = 0; r < 10; ++r) {
+	    if (r > 0) {
+		k[0] += PHILOX_W0;
+		k[1] += PHILOX_W1;
+	    }
+	    philoxRound(out, k);
+	}
+    }
+
+    PhiloxRNG::PhiloxRNG(unsigned int seed, unsigned int stream,
+			 unsigned int substream)
+	: RmathRNG("philox::Philox4x32", KINDERMAN_RAMAGE), _index(4)
+    {
+	seedToKey(seed, _key);
+	setStream(stream, substream);
+    }
+
+    void PhiloxRNG::init(unsigned int seed)
+    {
+	seedToKey(seed, _key);
+	setStream(_ctr[3], _ctr[2]);
+    }
+
+    void PhiloxRNG::setStream(unsigned int stream, unsigned int substream)
+    {
+	_ctr[0] = _ctr[1] = 0;
+	_ctr[2] = substream;
+	_ctr[3] = stream;
+	_index = 4;
+    }
+
+    unsigned int PhiloxRNG::stream() const
+    {
+	return _ctr[3];
+    }
+
+    void PhiloxRNG::skip(uint64_t n)
+    {
+	/* Use up the current block first */
+	unsigned int m = 4 - _index;
+	if (n <= m) {
+	    _index += n;
+	    return;
+	}
+	n -= m;
+
+	/* Then skip whole blocks by advancing the counter */
+	uint64_t pos = (static_cast<uint64_t>(_ctr[1]) << 32) | _ctr[0];
+	pos += n / 4;
+	_ctr[0] = static_cast<uint32_t>(pos);
+	_ctr[1] = static_cast<uint32_t>(pos >> 32);
+	_index = 4;
+
+	/* Finally, part of a block */
+	if (n % 4) {
+	    block(_key, _ctr, _out);
+	    increment(_ctr);
+	    _index = n % 4;
+	}
+    }
+
+    PhiloxRNG *PhiloxRNG::substream(unsigned int index) const
+    {
+	PhiloxRNG *rng = new PhiloxRNG(*this);
+	rng->setStream(_ctr[3], index);
+	return rng;
+    }
+
+    bool PhiloxRNG::setState(vector<int> const &state)
+    {
+	if (state.size() != 7)
+	    return false;
+
+	unsigned int index = static_cast<unsigned int>(state[6]);
+	if (index > 4)
+	    return false;
+
+	for (int i = 0; i < 2; ++i) {
+	    _key[i] = static_cast<uint32_t>(state[i]);
+	}
+	for (int i = 0; i < 4; ++i) {
+	    _ctr[i] = static_cast<uint32_t>(state[i + 2]);
+	}
+	_index = index;
+	if (_index < 4) {
+	    /* Regenerate the current block from the previous counter */
+	    uint32_t ctr[4] = {_ctr[0], _ctr[1], _ctr[2], _ctr[3]};
+	    if (ctr[0]-- == 0) --ctr[1];
+	    block(_key, ctr, _out);
+	}
+	return true;
+    }
+
+    void PhiloxRNG::getState(vector<int> &state) const
+    {
+	state.clear();
+	for (int i = 0; i < 2; ++i) {
+	    state.push_back(static_cast<int>(_key[i]));
+	}
+	for (int i = 0; i < 4; ++i) {
+	    state.push_back(static_cast<int>(_ctr[i]));
+	}
+	state.push_back(static_cast<int>(_index));
+    }
+
+    inline double PhiloxRNG::next()
+    {
+	if (_index == 4) {
+	    block(_key, _ctr, _out);
+	    increment(_ctr);
+	    _index = 0;
+	}
+	return toUniform(_out[_index++]);
+    }
+
+    double PhiloxRNG::uniform()
+    {
+	return next();
+    }
+
+    void PhiloxRNG::uniform(double *x, unsigned int n)
+    {
+	/* Use up the current block */
+	while (n > 0 && _index < 4) {
+	    *x++ = toUniform(_out[_index++]);
+	    --n;
+	}
+
+	/* 
+	   Blocks are independent, so NLANE of them are calculated
+	   together. The words are stored by lane so that the loops
+	   over lanes can be vectorized.
+	*/
+	while (n >= 4 * NLANE) {
+	    uint32_t c[4][NLANE];
+	    for (unsigned int l = 0; l < NLANE; ++l) {
+		for (int i = 0; i < 4; ++i) {
+		    c[i][l] = _ctr[i];
+		}
+		increment(_ctr);
+	    }
+	    uint32_t k0 = _key[0], k1 = _key[1];
+	    for (int r = 0; r < 10; ++r) {
+		if (r > 0) {
+		    k0 += PHILOX_W0;
+		    k1 += PHILOX_W1;
+		}
+		for (unsigned int l = 0; l < NLANE; ++l) {
+		    uint64_t p0 = static_cast<uint64_t>(PHILOX_M0) * c[0][l];
+		    uint64_t p1 = static_cast<uint64_t>(PHILOX_M1) * c[2][l];
+		    uint32_t hi0 = p0 >> 32, lo0 = p0;
+		    uint32_t hi1 = p1 >> 32, lo1 = p1;
+		    c[0][l] = hi1 ^ c[1][l] ^ k0;
+		    c[1][l] = lo1;
+		    c[2][l] = hi0 ^ c[3][l] ^ k1;
+		    c[3][l] = lo0;
+		}
+	    }
+	    for (unsigned int l = 0; l < NLANE; ++l) {
+		for (int i = 0; i < 4; ++i) {
+		    x[4 * l + i] = toUniform(c[i][l]);
+		}
+	    }
+	    x += 4 * NLANE;
+	    n -= 4 * NLANE;
+	}
+
+	/* Remaining values */
+	for (unsigned int i = 0; i < n; ++i) {
+	    x[i] = next();
+	}
+    }
+
+    void PhiloxRNG::normal(double *x, unsigned int n)
+    {
+	InlineUniform<PhiloxRNG, &PhiloxRNG::next> unif(this);
+	RmathRNG::normal(x, n, unif);
+    }
+
+    void PhiloxRNG::exponential(double *x, unsigned int n)
+    {
+	InlineUniform<PhiloxRNG, &PhiloxRNG::next> unif(this);
+	RmathRNG::exponential(x, n, unif);
+    }
+
+}}
@@ -0,0 +1,83 @@
+#ifndef PHILOX_RNG_H_
+#define PHILOX_RNG_H_
+
+#include <rng/RmathRNG.h>
+
+#include <cstdint>
+
+namespace jags {
+namespace philox {
+
+    /**
+     * @short Philox4x32-10 counter-based random number generator
+     *
+     * Philox is a counter-based RNG (Salmon et al, 2011): the n-th
+     * block of four 32-bit random integers is a bijective function of
+     * the 128-bit counter n, under the 64-bit key. There is no state
+     * other than the key and the counter, so any position in the
+     * sequence can be reached in constant time.
+     *
+     * The key is set from the seed. The counter is divided into a
+     * 64-bit block position (words 0 and 1), a 32-bit substream
+     * number (word 2), and a 32-bit stream number (word 3). Each
+     * chain of a model has its own stream, and each stream may be
+     * split into substreams, for example for use by different
+     * threads working on the same chain. Every substream has a
+     * period of 2^66 uniform random numbers.
+     */
+    class PhiloxRNG : public RmathRNG {
+	uint32_t _key[2];
+	uint32_t _ctr[4]; // Counter of the next block to be generated
+	uint32_t _out[4]; // Current block
+	unsigned int _index; // Position of the next value in _out
+	inline double next();
+    public:
+	/**
+	 * Constructor for PhiloxRNG random number generator
+	 *
+	 * @param seed Seed from which the key is generated
+	 * @param stream Stream number
+	 * @param substream Substream number
+	 */
+	PhiloxRNG(unsigned int seed, unsigned int stream, 
+		  unsigned int substream);
+	void init(unsigned int seed);
+	bool setState(std::vector<int> const &state);
+	void getState(std::vector<int> &state) const;
+	double uniform();
+	void uniform(double *x, unsigned int n);
+	void normal(double *x, unsigned int n);
+	void exponential(double *x, unsigned int n);
+	/**
+	 * Moves to the start of the given stream and substream,
+	 * keeping the same key.
+	 */
+	void setStream(unsigned int stream, unsigned int substream);
+	/**
+	 * Returns the stream number
+	 */
+	unsigned int stream() const;
+	/**
+	 * Advances the RNG by n uniform random numbers within the
+	 * current substream, in constant time.
+	 */
+	void skip(uint64_t n);
+	/**
+	 * Returns a copy of this RNG positioned at the start of the
+	 * given substream of the same stream.
+	 */
+	PhiloxRNG *substream(unsigned int index) const;
+	/**
+	 * Calculates one block of the Philox4x32-10 function.
+	 *
+	 * @param key Key
+	 * @param ctr Counter
+	 * @param out Array of length 4 that is overwritten with the output
+	 */
+	static void block(uint32_t const key[2], uint32_t const ctr[4], 
+			  uint32_t out[4]);
+    };
+ 
+}}
+
+#endif /* PHILOX_RNG_H_ */
@@ -0,0 +1,134 @@
+#include "testphiloxrng.h"
+
+#include "PhiloxRNG.h"
+#include "PhiloxFactory.h"
+
+#include <vector>
+
+using std::vector;
+using jags::RNG;
+using jags::philox::PhiloxRNG;
+using jags::philox::PhiloxFactory;
+
+void PhiloxRNGTest::kat()
+{
+    //Known answer tests from the Random123 library
+    uint32_t out[4];
+
+    uint32_t key1[2] = {0, 0};
+    uint32_t ctr1[4] = {0, 0, 0, 0};
+    PhiloxRNG::block(key1, ctr1, out);
+    CPPUNIT_ASSERT_EQUAL(0x6627e8d5U, out[0]);
+    CPPUNIT_ASSERT_EQUAL(0xe169c58dU, out[1]);
+    CPPUNIT_ASSERT_EQUAL(0xbc57ac4cU, out[2]);
+    CPPUNIT_ASSERT_EQUAL(0x9b00dbd8U, out[3]);
+
+    uint32_t key2[2] = {0xffffffff, 0xffffffff};
+    uint32_t ctr2[4] = {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff};
+    PhiloxRNG::block(key2, ctr2, out);
+    CPPUNIT_ASSERT_EQUAL(0x408f276dU, out[0]);
+    CPPUNIT_ASSERT_EQUAL(0x41c83b0eU, out[1]);
+    CPPUNIT_ASSERT_EQUAL(0xa20bc7c6U, out[2]);
+    CPPUNIT_ASSERT_EQUAL(0x6d5451fdU, out[3]);
+
+    uint32_t key3[2] = {0xa4093822, 0x299f31d0};
+    uint32_t ctr3[4] = {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344};
+    PhiloxRNG::block(key3, ctr3, out);
+    CPPUNIT_ASSERT_EQUAL(0xd16cfe09U, out[0]);
+    CPPUNIT_ASSERT_EQUAL(0x94fdccebU, out[1]);
+    CPPUNIT_ASSERT_EQUAL(0x5001e420U, out[2]);
+    CPPUNIT_ASSERT_EQUAL(0x24126ea1U, out[3]);
+}
+
+void PhiloxRNGTest::bulk()
+{
+    //Bulk generation gives the same values as repeated scalar calls
+    PhiloxRNG philox1(271828, 3, 0), philox2(271828, 3, 0);
+    RNG &rng1 = philox1, &rng2 = philox2;
+
+    static const unsigned int len[] = {3, 1, 100, 33, 7};
+    for (unsigned int j = 0; j < 5; ++j) {
+	unsigned int n = len[j];
+	vector<double> x(n);
+
+	rng1.uniform(&x[0], n);
+	for (unsigned int i = 0; i < n; ++i) {
+	    CPPUNIT_ASSERT_EQUAL(rng2.uniform(), x[i]);
+	    CPPUNIT_ASSERT(x[i] > 0 && x[i] < 1);
+	}
+	rng1.normal(&x[0], n);
+	for (unsigned int i = 0; i < n; ++i) {
+	    CPPUNIT_ASSERT_EQUAL(rng2.normal(), x[i]);
+	}
+	rng1.exponential(&x[0], n);
+	for (unsigned int i = 0; i < n; ++i) {
+	    CPPUNIT_ASSERT_EQUAL(rng2.exponential(), x[i]);
+	}
+    }
+}
+
+void PhiloxRNGTest::skip()
+{
+    //Skipping ahead is the same as discarding values
+    static const unsigned int len[] = {0, 1, 3, 4, 5, 1000, 6};
+    PhiloxRNG rng1(1, 0, 0), rng2(1, 0, 0);
+    for (unsigned int j = 0; j < 7; ++j) {
+	rng1.skip(len[j]);
+	for (unsigned int i = 0; i < len[j]; ++i) {
+	    rng2.uniform();
+	}
+	CPPUNIT_ASSERT_EQUAL(rng2.uniform(), rng1.uniform());
+    }
+}
+
+void PhiloxRNGTest::state()
+{
+    //The state can be saved and restored in the middle of a block
+    PhiloxRNG rng1(42, 7, 0), rng2(0, 0, 0);
+    for (unsigned int j = 0; j < 6; ++j) {
+	vector<int> state;
+	rng1.getState(state);
+	CPPUNIT_ASSERT(rng2.setState(state));
+	for (unsigned int i = 0; i < 10; ++i) {
+	    CPPUNIT_ASSERT_EQUAL(rng1.uniform(), rng2.uniform());
+	}
+	rng1.uniform();
+    }
+
+    vector<int> bad(7, 0);
+    bad[6] = 5;
+    CPPUNIT_ASSERT(!rng2.setState(bad));
+    bad.pop_back();
+    CPPUNIT_ASSERT(!rng2.setState(bad));
+}
+
+void PhiloxRNGTest::streams()
+{
+    PhiloxFactory factory;
+    factory.setSeed(1234);
+    vector<RNG *> rngs = factory.makeRNGs(3);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), rngs.size());
+
+    //Resetting the seed gives the same streams
+    factory.setSeed(1234);
+    vector<RNG *> rngs2 = factory.makeRNGs(3);
+    for (unsigned int i = 0; i < 3; ++i) {
+	CPPUNIT_ASSERT_EQUAL(rngs[i]->uniform(), rngs2[i]->uniform());
+    }
+    
+    //Different streams and substreams give different values
+    RNG *sub0 = factory.makeSubstream(rngs[0], 0);
+    RNG *sub1 = factory.makeSubstream(rngs[0], 1);
+    CPPUNIT_ASSERT(sub0 != 0 && sub1 != 0);
+    vector<double> x(5);
+    x[0] = rngs[0]->uniform();
+    x[1] = rngs[1]->uniform();
+    x[2] = rngs[2]->uniform();
+    x[3] = sub0->uniform();
+    x[4] = sub1->uniform();
+    for (unsigned int i = 0; i < 5; ++i) {
+	for (unsigned int j = 0; j < i; ++j) {
+	    CPPUNIT_ASSERT(x[i] != x[j]);
+	}
+    }
+}
@@ -0,0 +1,24 @@
+#ifndef PHILOX_RNG_TEST_H
+#define PHILOX_RNG_TEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class PhiloxRNGTest : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE( PhiloxRNGTest );
+    CPPUNIT_TEST( kat );
+    CPPUNIT_TEST( bulk );
+    CPPUNIT_TEST( skip );
+    CPPUNIT_TEST( state );
+    CPPUNIT_TEST( streams );
+    CPPUNIT_TEST_SUITE_END();
+
+  public:
+    void kat();
+    void bulk();
+    void skip();
+    void state();
+    void streams();
+};
+
+#endif  // PHILOX_RNG_TEST_H
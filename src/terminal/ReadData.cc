@@ -1,9 +1,25 @@
+#include <config.h>
 #include <model/NodeArray.h>
 #include "ReadData.h"
 #include <sarray/SArray.h>
+#include <util/nainf.h>
 
 #include <iostream>
 #include <vector>
+#include <cstdio>
+#include <cstring>
+#include <climits>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+
+#if defined(HAVE_MMAP) && defined(HAVE_SYS_MMAN_H)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define USE_MMAP 1
+#endif
 
 using std::cout;
 using std::cerr;
@@ -174,3 +190,247 @@ bool readRData(vector<ParseTree*> const *array_list,
 
 
 
+
+static char const *BINARY_MAGIC = "JAGSDATA";
+static const unsigned int BINARY_VERSION = 1;
+
+namespace {
+
+/* Read-only view of the contents of a file */
+class FileView {
+    unsigned char const *_data;
+    size_t _size;
+#ifdef USE_MMAP
+    void *_map;
+#else
+    vector<unsigned char> _buffer;
+#endif
+    FileView(FileView const &);
+    FileView &operator=(FileView const &);
+public:
+    FileView(string const &file);
+    ~FileView();
+    unsigned char const *data() const { return _data; }
+    size_t size() const { return _size; }
+};
+
+#ifdef USE_MMAP
+
+FileView::FileView(string const &file)
+    : _data(0), _size(0), _map(MAP_FAILED)
+{
+    int fd = open(file.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+	_map = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (_map != MAP_FAILED) {
+#ifdef MADV_SEQUENTIAL
+	    madvise(_map, st.st_size, MADV_SEQUENTIAL);
+#endif
+	    _data = static_cast<unsigned char const*>(_map);
+	    _size = st.st_size;
+	}
+    }
+    close(fd);
+}
+
+FileView::~FileView()
+{
+    if (_map != MAP_FAILED) {
+	munmap(_map, _size);
+    }
+}
+
+#else
+
+FileView::FileView(string const &file)
+    : _data(0), _size(0)
+{
+    FILE *fp = fopen(file.c_str(), "rb");
+    if (!fp) return;
+    if (fseek(fp, 0, SEEK_END) == 0) {
+	long n = ftell(fp);
+	if (n > 0 && fseek(fp, 0, SEEK_SET) == 0) {
+	    _buffer.resize(n);
+	    if (fread(&_buffer[0], 1, n, fp) == static_cast<size_t>(n)) {
+		_data = &_buffer[0];
+		_size = n;
+	    }
+	}
+    }
+    fclose(fp);
+}
+
+FileView::~FileView()
+{
+}
+
+#endif
+
+/* Sequential reader for the contents of a binary data file */
+class BinaryReader {
+    unsigned char const *_data;
+    size_t _size;
+    size_t _pos;
+public:
+    BinaryReader(FileView const &view)
+	: _data(view.data()), _size(view.size()), _pos(0) {}
+    bool skip(size_t n) {
+	if (_size - _pos < n) return false;
+	_pos += n;
+	return true;
+    }
+    bool getUInt(unsigned int &x) {
+	if (_size - _pos < 4) return false;
+	unsigned char const *b = _data + _pos;
+	x = b[0] | (b[1] << 8) | (b[2] << 16) | 
+	    (static_cast<unsigned int>(b[3]) << 24);
+	_pos += 4;
+	return true;
+    }
+    /* Returns a pointer to the next n bytes and moves past them */
+    unsigned char const *getBytes(size_t n) {
+	if (_size - _pos < n) return 0;
+	unsigned char const *b = _data + _pos;
+	_pos += n;
+	return b;
+    }
+    size_t position() const { return _pos; }
+    size_t remaining() const { return _size - _pos; }
+};
+
+}
+
+static bool littleEndian()
+{
+    unsigned int x = 1;
+    return *reinterpret_cast<unsigned char const*>(&x) == 1;
+}
+
+static double getDouble(unsigned char const *b)
+{
+    unsigned long long bits = 0;
+    for (int i = 7; i >= 0; --i) {
+	bits = (bits << 8) | b[i];
+    }
+    double x;
+    std::memcpy(&x, &bits, sizeof(x));
+    return x;
+}
+
+bool isBinaryData(string const &file)
+{
+    FILE *fp = fopen(file.c_str(), "rb");
+    if (!fp) return false;
+    char magic[8];
+    bool binary = fread(magic, 1, 8, fp) == 8 &&
+	std::memcmp(magic, BINARY_MAGIC, 8) == 0;
+    fclose(fp);
+    return binary;
+}
+
+bool readBinaryData(string const &file, map<string, SArray> &table)
+{
+    FileView view(file);
+    BinaryReader reader(view);
+
+    unsigned int version = 0, narray = 0;
+    unsigned char const *magic = reader.getBytes(8);
+    if (!magic || std::memcmp(magic, BINARY_MAGIC, 8) != 0 ||
+	!reader.getUInt(version) || !reader.getUInt(narray))
+    {
+	cerr << "Invalid binary data file " << file << endl;
+	return false;
+    }
+    if (version != BINARY_VERSION) {
+	cerr << "Unsupported binary data format version " << version
+	     << " in " << file << endl;
+	return false;
+    }
+
+    for (unsigned int k = 0; k < narray; ++k) {
+
+	/* Name and dimensions */
+	unsigned int nchar = 0, ndim = 0, flags = 0;
+	unsigned char const *pname = 0;
+	if (!reader.getUInt(nchar) || !(pname = reader.getBytes(nchar)) ||
+	    !reader.getUInt(ndim))
+	{
+	    cerr << "Unexpected end of binary data file " << file << endl;
+	    return false;
+	}
+	string name(reinterpret_cast<char const*>(pname), nchar);
+	if (name.empty() || ndim == 0) {
+	    cerr << "Invalid array in binary data file " << file << endl;
+	    return false;
+	}
+	vector<unsigned int> dim(ndim);
+	unsigned long long length = 1;
+	for (unsigned int i = 0; i < ndim; ++i) {
+	    if (!reader.getUInt(dim[i])) {
+		cerr << "Unexpected end of binary data file " << file << endl;
+		return false;
+	    }
+	    if (dim[i] == 0) {
+		cerr << "Non-positive dimension for variable " << name
+		     << endl;
+		return false;
+	    }
+	    length *= dim[i];
+	    if (length > UINT_MAX) {
+		cerr << "Variable " << name << " is too large" << endl;
+		return false;
+	    }
+	}
+	if (!reader.getUInt(flags) ||
+	    !reader.skip((8 - reader.position() % 8) % 8))
+	{
+	    cerr << "Unexpected end of binary data file " << file << endl;
+	    return false;
+	}
+	bool has_na = flags & 1;
+
+	/* Values and bitmap of missing values */
+	if (reader.remaining() / 8 < length) {
+	    cerr << "Unexpected end of binary data file " << file << endl;
+	    return false;
+	}
+	unsigned char const *pvalue = reader.getBytes(8 * length);
+	unsigned char const *pna = 0;
+	if (has_na && !(pna = reader.getBytes((length + 7) / 8))) {
+	    cerr << "Unexpected end of binary data file " << file << endl;
+	    return false;
+	}
+
+	if (table.find(name) != table.end()) {
+	    cerr << "WARNING: Replacing " << name << endl;
+	    table.erase(table.find(name));
+	}
+	SArray &sarray = table.emplace(std::piecewise_construct,
+				       std::forward_as_tuple(name),
+				       std::forward_as_tuple(dim)).first->second;
+
+	if (littleEndian() &&
+	    reinterpret_cast<std::uintptr_t>(pvalue) % sizeof(double) == 0)
+	{
+	    // Values are copied straight from the file
+	    sarray.setValue(reinterpret_cast<double const*>(pvalue), length);
+	}
+	else {
+	    vector<double> values(length);
+	    for (unsigned long i = 0; i < length; ++i) {
+		values[i] = getDouble(pvalue + 8 * i);
+	    }
+	    sarray.setValue(values);
+	}
+	if (pna) {
+	    for (unsigned long i = 0; i < length; ++i) {
+		if (pna[i / 8] & (1 << (i % 8))) {
+		    sarray.setValue(JAGS_NA, i);
+		}
+	    }
+	}
+    }
+    return true;
+}
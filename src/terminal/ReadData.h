@@ -10,4 +10,35 @@ bool readRData(std::vector<jags::ParseTree*> const *r_assignment_list,
 	       std::map<std::string, jags::SArray> &table,
                std::string &rngname);
 
+/**
+ * Tests whether a file is in the binary data format read by
+ * readBinaryData.
+ */
+bool isBinaryData(std::string const &file);
+
+/**
+ * Reads a binary data file into a table. The file contains the 8
+ * characters "JAGSDATA", the format version (currently 1) and the
+ * number of arrays, followed by each array in turn.  Each array is
+ * stored as:
+ *
+ * - the length of its name, and the name
+ * - the number of dimensions, and the dimensions
+ * - a flag which is 1 if the values are followed by a bitmap of
+ *   missing values and 0 otherwise
+ * - zero padding, so that the values start at an offset from the
+ *   beginning of the file that is a multiple of 8
+ * - the values, in column-major order
+ * - the bitmap, if present, in which bit (i % 8) of byte (i / 8) is
+ *   set if element i is missing
+ *
+ * All integers are uint32, and values are float64. Both are in
+ * little-endian byte order.
+ *
+ * The file is mapped into memory where the platform allows it, so
+ * that values are copied directly from the file into the table.
+ */
+bool readBinaryData(std::string const &file,
+		    std::map<std::string, jags::SArray> &table);
+
 #endif /* READ_DATA_H_ */
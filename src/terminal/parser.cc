@@ -0,0 +1,3699 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 0
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+/* Substitute the variable and function names.  */
+#define yyparse         zzparse
+#define yylex           zzlex
+#define yyerror         zzerror
+#define yydebug         zzdebug
+#define yynerrs         zznerrs
+#define yylval          zzlval
+#define yychar          zzchar
+
+/* First part of user prologue.  */
+#line 2 "parser.yy"
+
+#include <config.h>
+
+#ifdef WIN32
+#include <windows.h>   /* For getCurrentDirectory */
+#include <io.h>        /* For chdir */
+#else
+#include <unistd.h>    /* For getcwd, chdir */
+#endif
+
+//#include <limits.h>
+
+#include <cstdlib>
+#include <cstdio>
+#include <iostream>
+#include <fstream>
+#include <map>
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <fstream>
+#include <list>
+#include <iterator>
+#include <string>
+#include <utility>
+
+#include <dirent.h>
+#include <time.h>
+#include <errno.h>
+
+#include <Console.h>
+#include <module/Module.h>
+#include <compiler/ParseTree.h>
+#include <util/nainf.h>
+#include <cstring>
+#include <ltdl.h>
+
+//Required for warning about masked distributions after module loading
+#include <deque>
+#include <distribution/Distribution.h>
+#include <compiler/Compiler.h>
+
+#include "ReadData.h"
+
+    typedef void(*pt2Func)();
+
+    int zzerror(const char *);
+    int zzlex();
+    int zzlex_destroy();
+#define YYERROR_VERBOSE 0
+    static jags::Console *console;
+    bool interactive;
+    extern int command_buffer_count;
+    void setName(jags::ParseTree *p, std::string *name);
+    std::map<std::string, jags::SArray> _data_table;
+    std::deque<lt_dlhandle> _dyn_lib;
+    bool open_data_buffer(std::string const *name, bool binary);
+    std::string _binary_data; // Binary file opened by data or parameters
+    bool open_command_buffer(std::string const *name);
+    void return_to_main_buffer();
+    void setMonitor(jags::ParseTree const *var, int thin, std::string const &type);
+    void clearMonitor(jags::ParseTree const *var, std::string const &type);
+    void doCoda (jags::ParseTree const *var, std::string const &stem,
+		 bool binary = false);
+    void doAllCoda (std::string const &stem, bool binary = false);
+    void doDump (std::string const &file, jags::DumpType type, unsigned int chain);
+    void dumpMonitors(std::string const &file, std::string const &type);
+    void doSystem(std::string const *command);
+    std::string ExpandFileName(char const *s);
+
+    static bool getWorkingDirectory(std::string &name);
+    static void errordump();
+    static void updatestar(long niter, long refresh, int width,
+                           bool parallel);
+	// Run adaptation phase until adapted, regardless of iterations:
+    static void autoadaptstar(long maxiter);
+    static void adaptstar(long niter, long refresh, int width);
+    static void setParameters(jags::ParseTree *p, jags::ParseTree *param1);
+    static void setParameters(jags::ParseTree *p, std::vector<jags::ParseTree*> *parameters);
+    static void setParameters(jags::ParseTree *p, jags::ParseTree *param1, jags::ParseTree *param2);
+    static void loadModule(std::string const &name);
+    static void unloadModule(std::string const &name);
+    static void dumpSamplers(std::string const &file);
+    static void delete_pvec(std::vector<jags::ParseTree*> *);
+    static void doCompile(unsigned int nchain, bool worklist);
+    static void print_unused_variables(std::map<std::string, jags::SArray> const &table, bool data);
+    static void openBinaryData(std::string const &name);
+    static void setAllParameters(std::map<std::string, jags::SArray> &table,
+				 std::string const &rngname);
+    static void setChainParameters(std::map<std::string, jags::SArray> &table,
+				   std::string const &rngname,
+				   unsigned int chain);
+    static void listFactories(jags::FactoryType type);
+    static void setFactory(std::string const &name, jags::FactoryType type,
+                           std::string const &status);
+    static void setSeed(unsigned int seed);
+    static bool Jtry(bool ok);
+	// Needed for update (and adapt) functions to dump variable states:
+    static bool Jtry_dump(bool ok);
+    
+
+#line 180 "parser.cc"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "parser.hh"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_INT = 3,                        /* INT  */
+  YYSYMBOL_DOUBLE = 4,                     /* DOUBLE  */
+  YYSYMBOL_NAME = 5,                       /* NAME  */
+  YYSYMBOL_STRING = 6,                     /* STRING  */
+  YYSYMBOL_SYSCMD = 7,                     /* SYSCMD  */
+  YYSYMBOL_ENDCMD = 8,                     /* ENDCMD  */
+  YYSYMBOL_MODEL = 9,                      /* MODEL  */
+  YYSYMBOL_DATA = 10,                      /* DATA  */
+  YYSYMBOL_IN = 11,                        /* IN  */
+  YYSYMBOL_TO = 12,                        /* TO  */
+  YYSYMBOL_INITS = 13,                     /* INITS  */
+  YYSYMBOL_PARAMETERS = 14,                /* PARAMETERS  */
+  YYSYMBOL_COMPILE = 15,                   /* COMPILE  */
+  YYSYMBOL_INITIALIZE = 16,                /* INITIALIZE  */
+  YYSYMBOL_ADAPT = 17,                     /* ADAPT  */
+  YYSYMBOL_AUTOADAPT = 18,                 /* AUTOADAPT  */
+  YYSYMBOL_UPDATE = 19,                    /* UPDATE  */
+  YYSYMBOL_BY = 20,                        /* BY  */
+  YYSYMBOL_PARALLEL = 21,                  /* PARALLEL  */
+  YYSYMBOL_WORKLIST = 22,                  /* WORKLIST  */
+  YYSYMBOL_BINARY = 23,                    /* BINARY  */
+  YYSYMBOL_MONITORS = 24,                  /* MONITORS  */
+  YYSYMBOL_MONITOR = 25,                   /* MONITOR  */
+  YYSYMBOL_TYPE = 26,                      /* TYPE  */
+  YYSYMBOL_SET = 27,                       /* SET  */
+  YYSYMBOL_CLEAR = 28,                     /* CLEAR  */
+  YYSYMBOL_THIN = 29,                      /* THIN  */
+  YYSYMBOL_CODA = 30,                      /* CODA  */
+  YYSYMBOL_STEM = 31,                      /* STEM  */
+  YYSYMBOL_EXIT = 32,                      /* EXIT  */
+  YYSYMBOL_NCHAINS = 33,                   /* NCHAINS  */
+  YYSYMBOL_CHAIN = 34,                     /* CHAIN  */
+  YYSYMBOL_LOAD = 35,                      /* LOAD  */
+  YYSYMBOL_UNLOAD = 36,                    /* UNLOAD  */
+  YYSYMBOL_SAMPLER = 37,                   /* SAMPLER  */
+  YYSYMBOL_SAMPLERS = 38,                  /* SAMPLERS  */
+  YYSYMBOL_RNGTOK = 39,                    /* RNGTOK  */
+  YYSYMBOL_FACTORY = 40,                   /* FACTORY  */
+  YYSYMBOL_FACTORIES = 41,                 /* FACTORIES  */
+  YYSYMBOL_SEED = 42,                      /* SEED  */
+  YYSYMBOL_CHECKPOINT = 43,                /* CHECKPOINT  */
+  YYSYMBOL_RESTORE = 44,                   /* RESTORE  */
+  YYSYMBOL_FROM = 45,                      /* FROM  */
+  YYSYMBOL_LIST = 46,                      /* LIST  */
+  YYSYMBOL_STRUCTURE = 47,                 /* STRUCTURE  */
+  YYSYMBOL_DIM = 48,                       /* DIM  */
+  YYSYMBOL_NA = 49,                        /* NA  */
+  YYSYMBOL_R_NULL = 50,                    /* R_NULL  */
+  YYSYMBOL_DIMNAMES = 51,                  /* DIMNAMES  */
+  YYSYMBOL_ITER = 52,                      /* ITER  */
+  YYSYMBOL_ARROW = 53,                     /* ARROW  */
+  YYSYMBOL_ENDDATA = 54,                   /* ENDDATA  */
+  YYSYMBOL_ASINTEGER = 55,                 /* ASINTEGER  */
+  YYSYMBOL_DIRECTORY = 56,                 /* DIRECTORY  */
+  YYSYMBOL_CD = 57,                        /* CD  */
+  YYSYMBOL_PWD = 58,                       /* PWD  */
+  YYSYMBOL_RUN = 59,                       /* RUN  */
+  YYSYMBOL_ENDSCRIPT = 60,                 /* ENDSCRIPT  */
+  YYSYMBOL_61_ = 61,                       /* ','  */
+  YYSYMBOL_62_ = 62,                       /* '('  */
+  YYSYMBOL_63_ = 63,                       /* ')'  */
+  YYSYMBOL_64_ = 64,                       /* '['  */
+  YYSYMBOL_65_ = 65,                       /* ']'  */
+  YYSYMBOL_66_ = 66,                       /* ':'  */
+  YYSYMBOL_67_ = 67,                       /* '*'  */
+  YYSYMBOL_68_ = 68,                       /* ';'  */
+  YYSYMBOL_69_ = 69,                       /* '`'  */
+  YYSYMBOL_70_ = 70,                       /* '='  */
+  YYSYMBOL_71_c_ = 71,                     /* 'c'  */
+  YYSYMBOL_YYACCEPT = 72,                  /* $accept  */
+  YYSYMBOL_input = 73,                     /* input  */
+  YYSYMBOL_line = 74,                      /* line  */
+  YYSYMBOL_command = 75,                   /* command  */
+  YYSYMBOL_model = 76,                     /* model  */
+  YYSYMBOL_data_in = 77,                   /* data_in  */
+  YYSYMBOL_data_to = 78,                   /* data_to  */
+  YYSYMBOL_data = 79,                      /* data  */
+  YYSYMBOL_data_clear = 80,                /* data_clear  */
+  YYSYMBOL_parameters_in = 81,             /* parameters_in  */
+  YYSYMBOL_parameters_to = 82,             /* parameters_to  */
+  YYSYMBOL_parameters = 83,                /* parameters  */
+  YYSYMBOL_compile = 84,                   /* compile  */
+  YYSYMBOL_initialize = 85,                /* initialize  */
+  YYSYMBOL_autoadapt = 86,                 /* autoadapt  */
+  YYSYMBOL_adapt = 87,                     /* adapt  */
+  YYSYMBOL_update = 88,                    /* update  */
+  YYSYMBOL_exit = 89,                      /* exit  */
+  YYSYMBOL_var = 90,                       /* var  */
+  YYSYMBOL_var_name = 91,                  /* var_name  */
+  YYSYMBOL_range_list = 92,                /* range_list  */
+  YYSYMBOL_range_element = 93,             /* range_element  */
+  YYSYMBOL_index = 94,                     /* index  */
+  YYSYMBOL_monitor = 95,                   /* monitor  */
+  YYSYMBOL_monitor_set = 96,               /* monitor_set  */
+  YYSYMBOL_monitor_clear = 97,             /* monitor_clear  */
+  YYSYMBOL_monitors_to = 98,               /* monitors_to  */
+  YYSYMBOL_file_name = 99,                 /* file_name  */
+  YYSYMBOL_coda = 100,                     /* coda  */
+  YYSYMBOL_load = 101,                     /* load  */
+  YYSYMBOL_unload = 102,                   /* unload  */
+  YYSYMBOL_samplers_to = 103,              /* samplers_to  */
+  YYSYMBOL_list_factories = 104,           /* list_factories  */
+  YYSYMBOL_set_factory = 105,              /* set_factory  */
+  YYSYMBOL_set_seed = 106,                 /* set_seed  */
+  YYSYMBOL_checkpoint = 107,               /* checkpoint  */
+  YYSYMBOL_restore = 108,                  /* restore  */
+  YYSYMBOL_r_assignment_list = 109,        /* r_assignment_list  */
+  YYSYMBOL_r_assignment = 110,             /* r_assignment  */
+  YYSYMBOL_r_name = 111,                   /* r_name  */
+  YYSYMBOL_r_structure = 112,              /* r_structure  */
+  YYSYMBOL_r_attribute_list = 113,         /* r_attribute_list  */
+  YYSYMBOL_r_dim = 114,                    /* r_dim  */
+  YYSYMBOL_r_collection = 115,             /* r_collection  */
+  YYSYMBOL_r_integer_collection = 116,     /* r_integer_collection  */
+  YYSYMBOL_r_value_collection = 117,       /* r_value_collection  */
+  YYSYMBOL_r_value_list = 118,             /* r_value_list  */
+  YYSYMBOL_r_value = 119,                  /* r_value  */
+  YYSYMBOL_r_generic_attribute = 120,      /* r_generic_attribute  */
+  YYSYMBOL_r_generic_list = 121,           /* r_generic_list  */
+  YYSYMBOL_r_generic_list_element = 122,   /* r_generic_list_element  */
+  YYSYMBOL_r_generic_vector = 123,         /* r_generic_vector  */
+  YYSYMBOL_r_numeric_vector = 124,         /* r_numeric_vector  */
+  YYSYMBOL_r_double_list = 125,            /* r_double_list  */
+  YYSYMBOL_r_character_vector = 126,       /* r_character_vector  */
+  YYSYMBOL_r_string_list = 127,            /* r_string_list  */
+  YYSYMBOL_get_working_dir = 128,          /* get_working_dir  */
+  YYSYMBOL_set_working_dir = 129,          /* set_working_dir  */
+  YYSYMBOL_read_dir = 130,                 /* read_dir  */
+  YYSYMBOL_run_script = 131                /* run_script  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int16 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_USE_ALLOCA
+#  if YYSTACK_USE_ALLOCA
+#   ifdef __GNUC__
+#    define YYSTACK_ALLOC __builtin_alloca
+#   elif defined __BUILTIN_VA_ARG_INCR
+#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
+#   elif defined _AIX
+#    define YYSTACK_ALLOC __alloca
+#   elif defined _MSC_VER
+#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
+#    define alloca _alloca
+#   else
+#    define YYSTACK_ALLOC alloca
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
+#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
+#     endif
+#    endif
+#   endif
+#  endif
+# endif
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* !defined yyoverflow */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
+      + YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  2
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   326
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  72
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  60
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  163
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  330
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   315
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+      62,    63,    67,     2,    61,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,    66,    68,
+       2,    70,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,    64,     2,    65,     2,     2,    69,     2,     2,    71,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
+      55,    56,    57,    58,    59,    60
+};
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
+{
+       0,   192,   192,   196,   202,   203,   204,   205,   206,   207,
+     210,   211,   212,   213,   214,   215,   216,   217,   218,   219,
+     220,   221,   222,   223,   224,   225,   226,   227,   228,   229,
+     230,   231,   232,   233,   234,   235,   238,   250,   255,   263,
+     271,   277,   283,   296,   302,   310,   318,   330,   342,   345,
+     349,   355,   365,   378,   381,   384,   387,   392,   399,   404,
+     408,   413,   417,   420,   424,   429,   432,   435,   442,   443,
+     444,   445,   446,   447,   448,   451,   454,   459,   462,   468,
+     471,   472,   475,   478,   481,   484,   487,   491,   495,   501,
+     504,   510,   516,   528,   529,   532,   535,   538,   541,   544,
+     547,   550,   553,   558,   561,   564,   571,   576,   581,   587,
+     594,   601,   609,   615,   622,   631,   634,   637,   642,   645,
+     650,   658,   659,   660,   665,   672,   680,   681,   682,   683,
+     686,   689,   694,   695,   698,   701,   705,   711,   712,   715,
+     716,   722,   725,   726,   729,   730,   733,   734,   735,   736,
+     737,   738,   741,   742,   745,   746,   749,   750,   753,   754,
+     759,   770,   778,   802
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
+static const char *const yytname[] =
+{
+  "\"end of file\"", "error", "\"invalid token\"", "INT", "DOUBLE",
+  "NAME", "STRING", "SYSCMD", "ENDCMD", "MODEL", "DATA", "IN", "TO",
+  "INITS", "PARAMETERS", "COMPILE", "INITIALIZE", "ADAPT", "AUTOADAPT",
+  "UPDATE", "BY", "PARALLEL", "WORKLIST", "BINARY", "MONITORS", "MONITOR",
+  "TYPE", "SET", "CLEAR", "THIN", "CODA", "STEM", "EXIT", "NCHAINS",
+  "CHAIN", "LOAD", "UNLOAD", "SAMPLER", "SAMPLERS", "RNGTOK", "FACTORY",
+  "FACTORIES", "SEED", "CHECKPOINT", "RESTORE", "FROM", "LIST",
+  "STRUCTURE", "DIM", "NA", "R_NULL", "DIMNAMES", "ITER", "ARROW",
+  "ENDDATA", "ASINTEGER", "DIRECTORY", "CD", "PWD", "RUN", "ENDSCRIPT",
+  "','", "'('", "')'", "'['", "']'", "':'", "'*'", "';'", "'`'", "'='",
+  "'c'", "$accept", "input", "line", "command", "model", "data_in",
+  "data_to", "data", "data_clear", "parameters_in", "parameters_to",
+  "parameters", "compile", "initialize", "autoadapt", "adapt", "update",
+  "exit", "var", "var_name", "range_list", "range_element", "index",
+  "monitor", "monitor_set", "monitor_clear", "monitors_to", "file_name",
+  "coda", "load", "unload", "samplers_to", "list_factories", "set_factory",
+  "set_seed", "checkpoint", "restore", "r_assignment_list", "r_assignment",
+  "r_name", "r_structure", "r_attribute_list", "r_dim", "r_collection",
+  "r_integer_collection", "r_value_collection", "r_value_list", "r_value",
+  "r_generic_attribute", "r_generic_list", "r_generic_list_element",
+  "r_generic_vector", "r_numeric_vector", "r_double_list",
+  "r_character_vector", "r_string_list", "get_working_dir",
+  "set_working_dir", "read_dir", "run_script", YY_NULLPTR
+};
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-254)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-1)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
+{
+    -254,   122,  -254,    -4,    20,  -254,     5,    91,    23,   175,
+     -18,  -254,    63,   118,   145,   144,   162,    49,    83,  -254,
+     119,   158,   163,   165,   143,   155,  -254,   119,  -254,   119,
+     189,  -254,   190,  -254,  -254,  -254,    42,  -254,  -254,  -254,
+      44,  -254,  -254,  -254,  -254,  -254,  -254,  -254,  -254,  -254,
+    -254,  -254,  -254,  -254,  -254,  -254,  -254,  -254,  -254,  -254,
+    -254,  -254,  -254,  -254,  -254,  -254,   119,  -254,   119,   119,
+    -254,   119,   119,   119,    75,   138,  -254,   139,   119,  -254,
+    -254,  -254,  -254,   150,   150,  -254,  -254,  -254,   140,   146,
+     128,   199,   142,   147,  -254,  -254,  -254,  -254,   119,   119,
+     119,   148,  -254,  -254,  -254,  -254,  -254,  -254,  -254,   206,
+      25,  -254,   151,   152,    32,  -254,  -254,  -254,  -254,  -254,
+     153,  -254,   154,   192,   171,   156,   157,   159,    -7,   212,
+     214,   216,  -254,     9,    87,  -254,  -254,  -254,   196,   160,
+    -254,    18,  -254,    21,   191,   166,   194,   220,   164,   168,
+    -254,   198,   202,   207,   170,   172,  -254,    55,  -254,   169,
+     176,   177,  -254,   174,  -254,   178,   179,  -254,  -254,  -254,
+    -254,   180,  -254,   181,   182,  -254,  -254,  -254,  -254,  -254,
+     183,   205,   184,   185,   244,   246,   188,   193,   195,   247,
+     248,   212,  -254,   212,   227,   228,   119,   119,    70,    10,
+       6,    31,   253,   197,   255,   200,   201,   203,   257,   260,
+     262,   208,   209,  -254,  -254,   211,   213,   215,   217,   218,
+     219,   221,    54,   222,    81,  -254,   223,   265,   224,   238,
+    -254,   204,   225,   226,   229,   240,   250,   -10,   233,   230,
+     232,  -254,  -254,  -254,    51,  -254,  -254,    31,  -254,  -254,
+     231,  -254,  -254,   256,  -254,  -254,  -254,   234,   235,   236,
+     237,   239,   251,   267,   241,   242,    82,  -254,  -254,  -254,
+    -254,  -254,   276,   278,  -254,  -254,  -254,  -254,  -254,    14,
+       3,    51,  -254,   243,   245,  -254,  -254,   252,   254,  -254,
+     258,   259,  -254,  -254,  -254,  -254,  -254,  -254,  -254,  -254,
+    -254,     7,     7,     4,   108,   249,    90,  -254,  -254,    98,
+     261,   263,  -254,  -254,   101,   113,    14,     7,  -254,  -254,
+     291,  -254,   294,  -254,   295,  -254,  -254,  -254,  -254,  -254
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_uint8 yydefact[] =
+{
+       2,     0,     1,     0,     0,     4,     0,     0,     0,     0,
+      53,    57,     0,     0,     0,     0,     0,     0,     0,    65,
+       0,     0,     0,     0,     0,     0,   162,     0,   160,     0,
+       0,     3,     0,    10,    11,    12,    40,    13,    14,    15,
+      48,    16,    17,    19,    18,    20,    26,    21,    80,    81,
+      22,    23,    24,    25,    30,    31,    32,    33,    34,    35,
+      28,    29,    27,     7,     6,     9,     0,    37,     0,     0,
+      43,     0,     0,     0,     0,    59,    58,    61,     0,    68,
+      69,    70,    71,     0,     0,    72,    73,    74,    84,    66,
+       0,     0,    97,    95,    93,    94,   103,   104,     0,     0,
+       0,     0,   161,   163,     8,     5,   122,   121,    39,     0,
+       0,   115,     0,    46,     0,    36,    42,    41,    52,    51,
+      49,    55,     0,     0,     0,    91,    82,    89,     0,     0,
+       0,     0,   112,     0,     0,   105,   113,   114,     0,     0,
+      38,     0,   116,     0,     0,    44,     0,     0,     0,     0,
+      63,     0,     0,     0,     0,     0,    79,     0,    75,    77,
+       0,     0,   101,     0,    99,     0,     0,   123,   117,   139,
+     120,     0,   140,     0,     0,   118,   119,   132,   133,   135,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,    67,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,    54,     0,     0,     0,     0,
+       0,     0,     0,    76,    78,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,   137,     0,     0,     0,     0,
+      60,    62,     0,     0,     0,    86,    85,     0,     0,    98,
+      96,   108,   106,   107,     0,   125,   134,     0,   136,    47,
+       0,    50,    56,     0,    92,    83,    90,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,   126,   127,   138,
+      45,    64,     0,     0,   111,   110,   109,   102,   100,     0,
+       0,     0,   124,     0,     0,   152,   156,     0,     0,   151,
+       0,     0,   141,   146,   148,   131,   130,   129,   128,    87,
+      88,     0,     0,     0,     0,     0,     0,   142,   144,     0,
+       0,     0,   154,   158,     0,     0,     0,     0,   149,   150,
+       0,   147,     0,   153,     0,   157,   145,   143,   155,   159
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
+{
+    -254,  -254,  -254,  -254,  -254,  -254,  -254,  -254,  -254,  -254,
+    -254,  -254,  -254,  -254,  -254,  -254,  -254,  -254,    -1,  -254,
+    -254,  -190,   110,  -254,  -254,  -254,  -254,   -27,  -254,  -254,
+    -254,  -254,  -254,  -254,  -254,  -254,  -254,   264,  -105,  -254,
+    -254,  -254,    24,  -196,  -254,   107,  -254,  -180,    28,     8,
+      -2,  -253,    15,  -254,  -254,  -254,  -254,  -254,  -254,  -254
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int16 yydefgoto[] =
+{
+       0,     1,    31,    32,    33,    34,    35,    36,    37,    38,
+      39,    40,    41,    42,    43,    44,    45,    46,    88,    89,
+     157,   158,   159,    47,    48,    49,    50,    96,    51,    52,
+      53,    54,    55,    56,    57,    58,    59,   110,   111,   112,
+     175,   266,   267,   176,   177,   178,   224,   179,   268,   306,
+     307,   308,   293,   314,   294,   315,    60,    61,    62,    63
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
+{
+     102,   213,   103,   222,    64,   142,   156,   169,   285,   142,
+     169,   285,   305,   286,   169,   259,    66,    93,   285,   154,
+     286,   225,   155,   106,   107,   169,   292,   170,    65,   260,
+     106,   107,   162,    67,    71,   169,   168,   106,   107,   115,
+     163,   116,   117,    74,   118,   119,   120,   106,   107,   106,
+     107,   125,   172,   287,   288,   172,   264,   289,   173,   172,
+     287,   288,   290,   326,   289,   173,    75,   269,   171,   290,
+     172,   135,   136,   137,   174,   310,   173,   174,   291,   140,
+     172,   174,   126,   127,   296,   291,   145,   109,    79,    90,
+     295,    91,   174,   141,   109,   219,   108,   121,   113,   265,
+     141,   109,    68,    69,    80,    81,    82,   220,   122,   221,
+     164,   109,   312,   109,   313,   244,   191,   245,   165,    70,
+     192,    76,     2,     3,    94,    95,    85,    86,    87,     4,
+       5,     6,     7,   130,   131,     8,     9,    10,    11,    12,
+      13,    14,   247,   281,   248,   282,    15,    16,    77,    17,
+      92,   317,    18,   318,    19,    79,    78,    20,    21,   317,
+      22,   319,   322,    97,   323,    23,    24,    79,    25,   217,
+     218,    80,    81,    82,   324,    98,   325,    99,    26,    27,
+      28,    29,    30,    80,    81,    82,    72,    73,   100,    83,
+      84,   149,   150,    85,    86,    87,   101,   104,   105,   123,
+     124,   128,   132,   133,   143,    85,    86,    87,   134,   138,
+     129,   139,   148,   144,   146,   156,   147,   151,   152,   160,
+     153,   161,   166,   183,   186,   180,   184,   181,   182,   167,
+     185,   187,   189,   188,   190,   193,   196,   194,   195,   203,
+     197,   198,   199,   200,   201,   202,   204,   206,   205,   207,
+     208,   212,   211,   215,   216,   209,   226,   210,   228,   227,
+     252,   229,   232,   233,   230,   253,   231,   234,   250,   257,
+     261,   235,   236,   237,   277,   238,   258,   271,   239,   283,
+     240,   241,   242,   284,   243,   246,   249,   251,   254,   255,
+     278,   262,   256,   263,   270,   312,   272,   273,   328,   274,
+     275,   329,   276,   214,   114,   297,   299,   223,   300,   298,
+     309,   279,   280,     0,   301,   327,   302,     0,   311,   316,
+     303,   304,     0,   320,     0,     0,   321
+};
+
+static const yytype_int16 yycheck[] =
+{
+      27,   191,    29,   199,     8,   110,     3,     4,     4,   114,
+       4,     4,     5,     6,     4,    25,    11,    18,     4,    26,
+       6,   201,    29,     5,     6,     4,   279,     6,     8,    39,
+       5,     6,    23,    28,    11,     4,   141,     5,     6,    66,
+      31,    68,    69,    61,    71,    72,    73,     5,     6,     5,
+       6,    78,    49,    46,    47,    49,     5,    50,    55,    49,
+      46,    47,    55,   316,    50,    55,     3,   247,    47,    55,
+      49,    98,    99,   100,    71,    71,    55,    71,    71,    54,
+      49,    71,    83,    84,   280,    71,    54,    69,     5,    40,
+     280,    42,    71,    68,    69,    25,    54,    22,    54,    48,
+      68,    69,    11,    12,    21,    22,    23,    37,    33,    39,
+      23,    69,     4,    69,     6,    61,    61,    63,    31,    28,
+      65,     3,     0,     1,     5,     6,    43,    44,    45,     7,
+       8,     9,    10,     5,     6,    13,    14,    15,    16,    17,
+      18,    19,    61,    61,    63,    63,    24,    25,     3,    27,
+      67,    61,    30,    63,    32,     5,    12,    35,    36,    61,
+      38,    63,    61,     5,    63,    43,    44,     5,    46,   196,
+     197,    21,    22,    23,    61,    12,    63,    12,    56,    57,
+      58,    59,    60,    21,    22,    23,    11,    12,    45,    27,
+      28,    20,    21,    43,    44,    45,    41,     8,     8,    61,
+      61,    61,     3,    61,    53,    43,    44,    45,    61,    61,
+      64,     5,    20,    61,    61,     3,    62,    61,    61,     5,
+      61,     5,    26,     3,    26,    34,    62,    61,    34,    69,
+      62,    29,    62,    26,    62,    66,    62,    61,    61,    34,
+      62,    62,    62,    62,    62,    62,    62,     3,    63,     3,
+      62,     3,     5,    26,    26,    62,     3,    62,     3,    62,
+      22,    61,     5,     3,    63,    61,    63,     5,     3,    29,
+      37,    63,    63,    62,    23,    62,    26,    21,    63,     3,
+      63,    63,    63,     5,    63,    63,    63,    63,    63,    63,
+      23,    61,    63,    61,    63,     4,    62,    62,     4,    63,
+      63,     6,    63,   193,    40,   281,    63,   200,    63,   281,
+     302,    70,    70,    -1,    62,   317,    62,    -1,   303,    70,
+      62,    62,    -1,    62,    -1,    -1,    63
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_uint8 yystos[] =
+{
+       0,    73,     0,     1,     7,     8,     9,    10,    13,    14,
+      15,    16,    17,    18,    19,    24,    25,    27,    30,    32,
+      35,    36,    38,    43,    44,    46,    56,    57,    58,    59,
+      60,    74,    75,    76,    77,    78,    79,    80,    81,    82,
+      83,    84,    85,    86,    87,    88,    89,    95,    96,    97,
+      98,   100,   101,   102,   103,   104,   105,   106,   107,   108,
+     128,   129,   130,   131,     8,     8,    11,    28,    11,    12,
+      28,    11,    11,    12,    61,     3,     3,     3,    12,     5,
+      21,    22,    23,    27,    28,    43,    44,    45,    90,    91,
+      40,    42,    67,    90,     5,     6,    99,     5,    12,    12,
+      45,    41,    99,    99,     8,     8,     5,     6,    54,    69,
+     109,   110,   111,    54,   109,    99,    99,    99,    99,    99,
+      99,    22,    33,    61,    61,    99,    90,    90,    61,    64,
+       5,     6,     3,    61,    61,    99,    99,    99,    61,     5,
+      54,    68,   110,    53,    61,    54,    61,    62,    20,    20,
+      21,    61,    61,    61,    26,    29,     3,    92,    93,    94,
+       5,     5,    23,    31,    23,    31,    26,    69,   110,     4,
+       6,    47,    49,    55,    71,   112,   115,   116,   117,   119,
+      34,    61,    34,     3,    62,    62,    26,    29,    26,    62,
+      62,    61,    65,    66,    61,    61,    62,    62,    62,    62,
+      62,    62,    62,    34,    62,    63,     3,     3,    62,    62,
+      62,     5,     3,    93,    94,    26,    26,    99,    99,    25,
+      37,    39,   115,   117,   118,   119,     3,    62,     3,    61,
+      63,    63,     5,     3,     5,    63,    63,    62,    62,    63,
+      63,    63,    63,    63,    61,    63,    63,    61,    63,    63,
+       3,    63,    22,    61,    63,    63,    63,    29,    26,    25,
+      39,    37,    61,    61,     5,    48,   113,   114,   120,   119,
+      63,    21,    62,    62,    63,    63,    63,    23,    23,    70,
+      70,    61,    63,     3,     5,     4,     6,    46,    47,    50,
+      55,    71,   123,   124,   126,    93,   115,   114,   120,    63,
+      63,    62,    62,    62,    62,     5,   121,   122,   123,   121,
+      71,   124,     4,     6,   125,   127,    70,    61,    63,    63,
+      62,    63,    61,    63,    61,    63,   123,   122,     4,     6
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_uint8 yyr1[] =
+{
+       0,    72,    73,    73,    74,    74,    74,    74,    74,    74,
+      75,    75,    75,    75,    75,    75,    75,    75,    75,    75,
+      75,    75,    75,    75,    75,    75,    75,    75,    75,    75,
+      75,    75,    75,    75,    75,    75,    76,    76,    77,    77,
+      77,    78,    79,    80,    81,    81,    81,    81,    81,    82,
+      82,    83,    83,    84,    84,    84,    84,    85,    86,    87,
+      87,    88,    88,    88,    88,    89,    90,    90,    91,    91,
+      91,    91,    91,    91,    91,    92,    92,    93,    93,    94,
+      95,    95,    96,    96,    96,    96,    96,    96,    96,    97,
+      97,    98,    98,    99,    99,   100,   100,   100,   100,   100,
+     100,   100,   100,   101,   102,   103,   104,   104,   104,   105,
+     105,   105,   106,   107,   108,   109,   109,   109,   110,   110,
+     110,   111,   111,   111,   112,   112,   113,   113,   113,   113,
+     114,   114,   115,   115,   116,   117,   117,   118,   118,   119,
+     119,   120,   121,   121,   122,   122,   123,   123,   123,   123,
+     123,   123,   124,   124,   125,   125,   126,   126,   127,   127,
+     128,   129,   130,   131
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     0,     2,     1,     2,     2,     1,     2,     2,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     3,     2,     3,     2,
+       1,     3,     3,     2,     3,     8,     2,     7,     1,     3,
+       8,     3,     3,     1,     6,     3,     8,     1,     2,     2,
+       7,     2,     7,     4,     9,     1,     1,     4,     1,     1,
+       1,     1,     1,     1,     1,     1,     3,     1,     3,     1,
+       1,     1,     3,     8,     2,     7,     7,    11,    11,     3,
+       8,     3,     8,     1,     1,     2,     7,     2,     7,     4,
+       9,     4,     9,     2,     2,     3,     7,     7,     7,     9,
+       9,     9,     3,     3,     3,     1,     2,     3,     3,     3,
+       3,     1,     1,     3,     6,     4,     1,     1,     3,     3,
+       3,     3,     1,     1,     4,     1,     4,     1,     3,     1,
+       1,     3,     1,     3,     1,     3,     1,     4,     1,     4,
+       4,     1,     1,     4,     1,     3,     1,     4,     1,     3,
+       1,     2,     1,     2
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  yy_symbol_value_print (yyo, yykind, yyvaluep);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)]);
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+
+
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep)
+{
+  YY_USE (yyvaluep);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/* Lookahead token kind.  */
+int yychar;
+
+/* The semantic value of the lookahead symbol.  */
+YYSTYPE yylval;
+/* Number of syntax errors so far.  */
+int yynerrs;
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (void)
+{
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+
+
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex ();
+    }
+
+  if (yychar <= YYEOF)
+    {
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
+    {
+  case 2: /* input: %empty  */
+#line 192 "parser.yy"
+       {
+    if (interactive && command_buffer_count == 0) 
+	std::cout << ". " << std::flush;
+}
+#line 1532 "parser.cc"
+    break;
+
+  case 3: /* input: input line  */
+#line 196 "parser.yy"
+             {
+    if (interactive && command_buffer_count == 0) 
+	std::cout << ". " << std::flush;
+}
+#line 1541 "parser.cc"
+    break;
+
+  case 4: /* line: ENDCMD  */
+#line 202 "parser.yy"
+             {}
+#line 1547 "parser.cc"
+    break;
+
+  case 5: /* line: command ENDCMD  */
+#line 203 "parser.yy"
+                 {}
+#line 1553 "parser.cc"
+    break;
+
+  case 6: /* line: error ENDCMD  */
+#line 204 "parser.yy"
+               {if(interactive) yyerrok; else exit(1); }
+#line 1559 "parser.cc"
+    break;
+
+  case 7: /* line: run_script  */
+#line 205 "parser.yy"
+             {}
+#line 1565 "parser.cc"
+    break;
+
+  case 8: /* line: ENDSCRIPT ENDCMD  */
+#line 206 "parser.yy"
+                   {}
+#line 1571 "parser.cc"
+    break;
+
+  case 9: /* line: SYSCMD ENDCMD  */
+#line 207 "parser.yy"
+                { doSystem((yyvsp[-1].stringptr)); delete (yyvsp[-1].stringptr);}
+#line 1577 "parser.cc"
+    break;
+
+  case 36: /* model: MODEL IN file_name  */
+#line 238 "parser.yy"
+                          {
+    std::FILE *file = std::fopen(ExpandFileName(((yyvsp[0].stringptr))->c_str()).c_str(), "r");
+    if (!file) {
+	std::cerr << "Failed to open file " << *((yyvsp[0].stringptr)) << std::endl;
+	if (!interactive) exit(1);
+    }
+    else {
+	Jtry(console->checkModel(file));
+	std::fclose(file);
+    }
+    delete (yyvsp[0].stringptr);
+ }
+#line 1594 "parser.cc"
+    break;
+
+  case 37: /* model: MODEL CLEAR  */
+#line 250 "parser.yy"
+              {
+    console->clearModel();
+ }
+#line 1602 "parser.cc"
+    break;
+
+  case 38: /* data_in: data r_assignment_list ENDDATA  */
+#line 255 "parser.yy"
+                                        {
+    std::string rngname;
+    readRData((yyvsp[-1].pvec), _data_table, rngname);
+    if (rngname.size() != 0) {
+	std::cerr << "WARNING: .RNG.name assignment ignored" << std::endl;
+    }
+    delete_pvec((yyvsp[-1].pvec));
+ }
+#line 1615 "parser.cc"
+    break;
+
+  case 39: /* data_in: data ENDDATA  */
+#line 263 "parser.yy"
+               {
+    // Binary data file, or empty text file
+    if (!_binary_data.empty()) {
+	if (!readBinaryData(_binary_data, _data_table) && !interactive) {
+	    exit(1);
+	}
+    }
+ }
+#line 1628 "parser.cc"
+    break;
+
+  case 40: /* data_in: data  */
+#line 271 "parser.yy"
+       {
+    // Failed to open the data file 
+    if (!interactive) exit(1);
+  }
+#line 1637 "parser.cc"
+    break;
+
+  case 41: /* data_to: DATA TO file_name  */
+#line 277 "parser.yy"
+                           {
+    doDump(*(yyvsp[0].stringptr), jags::DUMP_DATA, 1);
+    delete (yyvsp[0].stringptr);
+}
+#line 1646 "parser.cc"
+    break;
+
+  case 42: /* data: DATA IN file_name  */
+#line 283 "parser.yy"
+                        {
+    openBinaryData(*(yyvsp[0].stringptr));
+    if(open_data_buffer((yyvsp[0].stringptr), !_binary_data.empty())) {
+	std::cout << "Reading data file " << *(yyvsp[0].stringptr) << std::endl;
+    }
+    else {
+	std::cerr << "Unable to open file " << *(yyvsp[0].stringptr) << std::endl << std::flush;
+	if (!interactive) exit(1);
+    }
+    delete (yyvsp[0].stringptr);
+ }
+#line 1662 "parser.cc"
+    break;
+
+  case 43: /* data_clear: DATA CLEAR  */
+#line 296 "parser.yy"
+                       {
+    std::cout << "Clearing data table " << std::endl;
+    _data_table.clear();
+}
+#line 1671 "parser.cc"
+    break;
+
+  case 44: /* parameters_in: parameters r_assignment_list ENDDATA  */
+#line 303 "parser.yy"
+{
+    std::map<std::string, jags::SArray> parameter_table;
+    std::string rngname;
+    readRData((yyvsp[-1].pvec), parameter_table, rngname);
+    delete_pvec((yyvsp[-1].pvec));
+    setAllParameters(parameter_table, rngname);
+}
+#line 1683 "parser.cc"
+    break;
+
+  case 45: /* parameters_in: parameters r_assignment_list ENDDATA ',' CHAIN '(' INT ')'  */
+#line 311 "parser.yy"
+{
+    std::map<std::string, jags::SArray> parameter_table;
+    std::string rngname;
+    readRData((yyvsp[-6].pvec), parameter_table, rngname);
+    delete (yyvsp[-6].pvec);
+    setChainParameters(parameter_table, rngname, (yyvsp[-1].intval));
+}
+#line 1695 "parser.cc"
+    break;
+
+  case 46: /* parameters_in: parameters ENDDATA  */
+#line 319 "parser.yy"
+{
+    std::map<std::string, jags::SArray> parameter_table;
+    if (!_binary_data.empty()) {
+	if (readBinaryData(_binary_data, parameter_table)) {
+	    setAllParameters(parameter_table, "");
+	}
+	else if (!interactive) {
+	    exit(1);
+	}
+    }
+}
+#line 1711 "parser.cc"
+    break;
+
+  case 47: /* parameters_in: parameters ENDDATA ',' CHAIN '(' INT ')'  */
+#line 331 "parser.yy"
+{
+    std::map<std::string, jags::SArray> parameter_table;
+    if (!_binary_data.empty()) {
+	if (readBinaryData(_binary_data, parameter_table)) {
+	    setChainParameters(parameter_table, "", (yyvsp[-1].intval));
+	}
+	else if (!interactive) {
+	    exit(1);
+	}
+    }
+}
+#line 1727 "parser.cc"
+    break;
+
+  case 48: /* parameters_in: parameters  */
+#line 342 "parser.yy"
+             {}
+#line 1733 "parser.cc"
+    break;
+
+  case 49: /* parameters_to: PARAMETERS TO file_name  */
+#line 345 "parser.yy"
+                                       {
+    doDump(*(yyvsp[0].stringptr), jags::DUMP_PARAMETERS, 1);
+    delete (yyvsp[0].stringptr);
+}
+#line 1742 "parser.cc"
+    break;
+
+  case 50: /* parameters_to: PARAMETERS TO file_name ',' CHAIN '(' INT ')'  */
+#line 349 "parser.yy"
+                                                {
+    doDump(*(yyvsp[-5].stringptr), jags::DUMP_PARAMETERS, (yyvsp[-1].intval));
+    delete (yyvsp[-5].stringptr);
+}
+#line 1751 "parser.cc"
+    break;
+
+  case 51: /* parameters: PARAMETERS IN file_name  */
+#line 355 "parser.yy"
+                                    {
+  openBinaryData(*(yyvsp[0].stringptr));
+  if(open_data_buffer((yyvsp[0].stringptr), !_binary_data.empty())) {
+    std::cout << "Reading parameter file " << *(yyvsp[0].stringptr) << std::endl;
+  }
+  else {
+    std::cerr << "Unable to open file " << *(yyvsp[0].stringptr) << std::endl << std::flush;
+  }
+  delete (yyvsp[0].stringptr);
+}
+#line 1766 "parser.cc"
+    break;
+
+  case 52: /* parameters: INITS IN file_name  */
+#line 365 "parser.yy"
+                     {
+  /* Legacy option to not break existing scripts */
+  openBinaryData(*(yyvsp[0].stringptr));
+  if(open_data_buffer((yyvsp[0].stringptr), !_binary_data.empty())) {
+    std::cout << "Reading initial values file " << *(yyvsp[0].stringptr) << std::endl;
+  }
+  else {
+    std::cerr << "Unable to open file " << *(yyvsp[0].stringptr) << std::endl << std::flush;
+  }
+  delete (yyvsp[0].stringptr);
+}
+#line 1782 "parser.cc"
+    break;
+
+  case 53: /* compile: COMPILE  */
+#line 378 "parser.yy"
+                 {
+    doCompile(1, false);
+}
+#line 1790 "parser.cc"
+    break;
+
+  case 54: /* compile: COMPILE ',' NCHAINS '(' INT ')'  */
+#line 381 "parser.yy"
+                                  {
+    doCompile((yyvsp[-1].intval), false);
+}
+#line 1798 "parser.cc"
+    break;
+
+  case 55: /* compile: COMPILE ',' WORKLIST  */
+#line 384 "parser.yy"
+                       {
+    doCompile(1, true);
+}
+#line 1806 "parser.cc"
+    break;
+
+  case 56: /* compile: COMPILE ',' NCHAINS '(' INT ')' ',' WORKLIST  */
+#line 387 "parser.yy"
+                                               {
+    doCompile((yyvsp[-3].intval), true);
+}
+#line 1814 "parser.cc"
+    break;
+
+  case 57: /* initialize: INITIALIZE  */
+#line 392 "parser.yy"
+                       {
+    if (!console->initialize()) {
+	errordump();
+    }
+}
+#line 1824 "parser.cc"
+    break;
+
+  case 58: /* autoadapt: AUTOADAPT INT  */
+#line 399 "parser.yy"
+                         {
+	autoadaptstar((yyvsp[0].intval));
+}
+#line 1832 "parser.cc"
+    break;
+
+  case 59: /* adapt: ADAPT INT  */
+#line 404 "parser.yy"
+                 {
+    long refresh = interactive ? (yyvsp[0].intval)/50 : 0;
+    adaptstar((yyvsp[0].intval), refresh, 50);
+}
+#line 1841 "parser.cc"
+    break;
+
+  case 60: /* adapt: ADAPT INT ',' BY '(' INT ')'  */
+#line 408 "parser.yy"
+                               {
+    adaptstar((yyvsp[-5].intval),(yyvsp[-1].intval), 50);
+}
+#line 1849 "parser.cc"
+    break;
+
+  case 61: /* update: UPDATE INT  */
+#line 413 "parser.yy"
+                   {
+    long refresh = interactive ? (yyvsp[0].intval)/50 : 0;
+    updatestar((yyvsp[0].intval), refresh, 50, false);
+}
+#line 1858 "parser.cc"
+    break;
+
+  case 62: /* update: UPDATE INT ',' BY '(' INT ')'  */
+#line 417 "parser.yy"
+                                {
+  updatestar((yyvsp[-5].intval),(yyvsp[-1].intval), 50, false);
+}
+#line 1866 "parser.cc"
+    break;
+
+  case 63: /* update: UPDATE INT ',' PARALLEL  */
+#line 420 "parser.yy"
+                          {
+    long refresh = interactive ? (yyvsp[-2].intval)/50 : 0;
+    updatestar((yyvsp[-2].intval), refresh, 50, true);
+}
+#line 1875 "parser.cc"
+    break;
+
+  case 64: /* update: UPDATE INT ',' BY '(' INT ')' ',' PARALLEL  */
+#line 424 "parser.yy"
+                                             {
+  updatestar((yyvsp[-7].intval),(yyvsp[-3].intval), 50, true);
+}
+#line 1883 "parser.cc"
+    break;
+
+  case 65: /* exit: EXIT  */
+#line 429 "parser.yy"
+           { return 0; }
+#line 1889 "parser.cc"
+    break;
+
+  case 66: /* var: var_name  */
+#line 432 "parser.yy"
+              {
+  (yyval.ptree) = new jags::ParseTree(jags::P_VAR); setName((yyval.ptree), (yyvsp[0].stringptr));
+}
+#line 1897 "parser.cc"
+    break;
+
+  case 67: /* var: var_name '[' range_list ']'  */
+#line 435 "parser.yy"
+                              {
+  (yyval.ptree) = new jags::ParseTree(jags::P_VAR); setName((yyval.ptree), (yyvsp[-3].stringptr));
+  setParameters((yyval.ptree), (yyvsp[-1].pvec));
+}
+#line 1906 "parser.cc"
+    break;
+
+  case 69: /* var_name: PARALLEL  */
+#line 443 "parser.yy"
+           { (yyval.stringptr) = new std::string("parallel"); }
+#line 1912 "parser.cc"
+    break;
+
+  case 70: /* var_name: WORKLIST  */
+#line 444 "parser.yy"
+           { (yyval.stringptr) = new std::string("worklist"); }
+#line 1918 "parser.cc"
+    break;
+
+  case 71: /* var_name: BINARY  */
+#line 445 "parser.yy"
+         { (yyval.stringptr) = new std::string("binary"); }
+#line 1924 "parser.cc"
+    break;
+
+  case 72: /* var_name: CHECKPOINT  */
+#line 446 "parser.yy"
+             { (yyval.stringptr) = new std::string("checkpoint"); }
+#line 1930 "parser.cc"
+    break;
+
+  case 73: /* var_name: RESTORE  */
+#line 447 "parser.yy"
+          { (yyval.stringptr) = new std::string("restore"); }
+#line 1936 "parser.cc"
+    break;
+
+  case 74: /* var_name: FROM  */
+#line 448 "parser.yy"
+       { (yyval.stringptr) = new std::string("from"); }
+#line 1942 "parser.cc"
+    break;
+
+  case 75: /* range_list: range_element  */
+#line 451 "parser.yy"
+                          {
+  (yyval.pvec) = new std::vector<jags::ParseTree*>(1, (yyvsp[0].ptree)); 
+}
+#line 1950 "parser.cc"
+    break;
+
+  case 76: /* range_list: range_list ',' range_element  */
+#line 454 "parser.yy"
+                               {
+  (yyval.pvec)=(yyvsp[-2].pvec); (yyval.pvec)->push_back((yyvsp[0].ptree));
+}
+#line 1958 "parser.cc"
+    break;
+
+  case 77: /* range_element: index  */
+#line 459 "parser.yy"
+                     {
+  (yyval.ptree) = new jags::ParseTree(jags::P_RANGE); setParameters((yyval.ptree), (yyvsp[0].ptree));
+}
+#line 1966 "parser.cc"
+    break;
+
+  case 78: /* range_element: index ':' index  */
+#line 462 "parser.yy"
+                  {
+  (yyval.ptree) = new jags::ParseTree(jags::P_RANGE); setParameters((yyval.ptree), (yyvsp[-2].ptree), (yyvsp[0].ptree));
+}
+#line 1974 "parser.cc"
+    break;
+
+  case 79: /* index: INT  */
+#line 468 "parser.yy"
+           {(yyval.ptree) = new jags::ParseTree(jags::P_VALUE); (yyval.ptree)->setValue((yyvsp[0].intval));}
+#line 1980 "parser.cc"
+    break;
+
+  case 82: /* monitor_set: MONITOR SET var  */
+#line 475 "parser.yy"
+                              { 
+    setMonitor((yyvsp[0].ptree), 1, "trace"); delete (yyvsp[0].ptree);
+}
+#line 1988 "parser.cc"
+    break;
+
+  case 83: /* monitor_set: MONITOR SET var ',' THIN '(' INT ')'  */
+#line 478 "parser.yy"
+                                       { 
+    setMonitor((yyvsp[-5].ptree), (yyvsp[-1].intval), "trace"); delete (yyvsp[-5].ptree);
+}
+#line 1996 "parser.cc"
+    break;
+
+  case 84: /* monitor_set: MONITOR var  */
+#line 481 "parser.yy"
+              {
+    setMonitor((yyvsp[0].ptree), 1, "trace"); delete (yyvsp[0].ptree);
+}
+#line 2004 "parser.cc"
+    break;
+
+  case 85: /* monitor_set: MONITOR var ',' THIN '(' INT ')'  */
+#line 484 "parser.yy"
+                                   { 
+    setMonitor((yyvsp[-5].ptree), (yyvsp[-1].intval), "trace"); delete (yyvsp[-5].ptree);
+}
+#line 2012 "parser.cc"
+    break;
+
+  case 86: /* monitor_set: MONITOR var ',' TYPE '(' NAME ')'  */
+#line 487 "parser.yy"
+                                    {
+    setMonitor((yyvsp[-5].ptree), 1, *(yyvsp[-1].stringptr));
+    delete (yyvsp[-1].stringptr);
+}
+#line 2021 "parser.cc"
+    break;
+
+  case 87: /* monitor_set: MONITOR var ',' TYPE '(' NAME ')' THIN '(' INT ')'  */
+#line 491 "parser.yy"
+                                                     {
+    setMonitor((yyvsp[-9].ptree), (yyvsp[-1].intval), *(yyvsp[-5].stringptr)); 
+    delete (yyvsp[-5].stringptr);
+}
+#line 2030 "parser.cc"
+    break;
+
+  case 88: /* monitor_set: MONITOR var ',' THIN '(' INT ')' TYPE '(' NAME ')'  */
+#line 495 "parser.yy"
+                                                     {
+    setMonitor((yyvsp[-9].ptree), (yyvsp[-5].intval), *(yyvsp[-1].stringptr)); 
+    delete (yyvsp[-1].stringptr);
+}
+#line 2039 "parser.cc"
+    break;
+
+  case 89: /* monitor_clear: MONITOR CLEAR var  */
+#line 501 "parser.yy"
+                                 {
+    clearMonitor((yyvsp[0].ptree), "trace"); delete (yyvsp[0].ptree);
+}
+#line 2047 "parser.cc"
+    break;
+
+  case 90: /* monitor_clear: MONITOR CLEAR var ',' TYPE '(' NAME ')'  */
+#line 504 "parser.yy"
+                                          {
+    clearMonitor((yyvsp[-5].ptree), *(yyvsp[-1].stringptr));
+    delete (yyvsp[-1].stringptr);
+}
+#line 2056 "parser.cc"
+    break;
+
+  case 91: /* monitors_to: MONITORS TO file_name  */
+#line 511 "parser.yy"
+{
+    dumpMonitors(*(yyvsp[0].stringptr), "trace");
+    delete (yyvsp[0].stringptr);
+}
+#line 2065 "parser.cc"
+    break;
+
+  case 92: /* monitors_to: MONITORS TO file_name ',' TYPE '(' NAME ')'  */
+#line 516 "parser.yy"
+                                            {
+    dumpMonitors(*(yyvsp[-5].stringptr), *(yyvsp[-1].stringptr));
+    delete (yyvsp[-5].stringptr);
+    delete (yyvsp[-1].stringptr); 
+}
+#line 2075 "parser.cc"
+    break;
+
+  case 93: /* file_name: NAME  */
+#line 528 "parser.yy"
+                { (yyval.stringptr) = (yyvsp[0].stringptr);}
+#line 2081 "parser.cc"
+    break;
+
+  case 94: /* file_name: STRING  */
+#line 529 "parser.yy"
+         { (yyval.stringptr) = (yyvsp[0].stringptr); }
+#line 2087 "parser.cc"
+    break;
+
+  case 95: /* coda: CODA var  */
+#line 532 "parser.yy"
+               {
+  doCoda ((yyvsp[0].ptree), "CODA"); delete (yyvsp[0].ptree);
+}
+#line 2095 "parser.cc"
+    break;
+
+  case 96: /* coda: CODA var ',' STEM '(' file_name ')'  */
+#line 535 "parser.yy"
+                                      {
+  doCoda ((yyvsp[-5].ptree), *(yyvsp[-1].stringptr)); delete (yyvsp[-5].ptree); delete (yyvsp[-1].stringptr);
+}
+#line 2103 "parser.cc"
+    break;
+
+  case 97: /* coda: CODA '*'  */
+#line 538 "parser.yy"
+           {
+  doAllCoda ("CODA"); 
+}
+#line 2111 "parser.cc"
+    break;
+
+  case 98: /* coda: CODA '*' ',' STEM '(' file_name ')'  */
+#line 541 "parser.yy"
+                                      {
+  doAllCoda (*(yyvsp[-1].stringptr)); delete (yyvsp[-1].stringptr); 
+}
+#line 2119 "parser.cc"
+    break;
+
+  case 99: /* coda: CODA var ',' BINARY  */
+#line 544 "parser.yy"
+                      {
+  doCoda ((yyvsp[-2].ptree), "CODA", true); delete (yyvsp[-2].ptree);
+}
+#line 2127 "parser.cc"
+    break;
+
+  case 100: /* coda: CODA var ',' STEM '(' file_name ')' ',' BINARY  */
+#line 547 "parser.yy"
+                                                 {
+  doCoda ((yyvsp[-7].ptree), *(yyvsp[-3].stringptr), true); delete (yyvsp[-7].ptree); delete (yyvsp[-3].stringptr);
+}
+#line 2135 "parser.cc"
+    break;
+
+  case 101: /* coda: CODA '*' ',' BINARY  */
+#line 550 "parser.yy"
+                      {
+  doAllCoda ("CODA", true); 
+}
+#line 2143 "parser.cc"
+    break;
+
+  case 102: /* coda: CODA '*' ',' STEM '(' file_name ')' ',' BINARY  */
+#line 553 "parser.yy"
+                                                 {
+  doAllCoda (*(yyvsp[-3].stringptr), true); delete (yyvsp[-3].stringptr); 
+}
+#line 2151 "parser.cc"
+    break;
+
+  case 103: /* load: LOAD file_name  */
+#line 558 "parser.yy"
+                     { loadModule(*(yyvsp[0].stringptr)); }
+#line 2157 "parser.cc"
+    break;
+
+  case 104: /* unload: UNLOAD NAME  */
+#line 561 "parser.yy"
+                    { unloadModule(*(yyvsp[0].stringptr)); }
+#line 2163 "parser.cc"
+    break;
+
+  case 105: /* samplers_to: SAMPLERS TO file_name  */
+#line 565 "parser.yy"
+{
+    dumpSamplers(*(yyvsp[0].stringptr));
+    delete (yyvsp[0].stringptr);
+}
+#line 2172 "parser.cc"
+    break;
+
+  case 106: /* list_factories: LIST FACTORIES ',' TYPE '(' SAMPLER ')'  */
+#line 572 "parser.yy"
+{
+    listFactories(jags::SAMPLER_FACTORY);
+}
+#line 2180 "parser.cc"
+    break;
+
+  case 107: /* list_factories: LIST FACTORIES ',' TYPE '(' RNGTOK ')'  */
+#line 577 "parser.yy"
+{
+    listFactories(jags::RNG_FACTORY);
+}
+#line 2188 "parser.cc"
+    break;
+
+  case 108: /* list_factories: LIST FACTORIES ',' TYPE '(' MONITOR ')'  */
+#line 582 "parser.yy"
+{
+    listFactories(jags::MONITOR_FACTORY);
+}
+#line 2196 "parser.cc"
+    break;
+
+  case 109: /* set_factory: SET FACTORY STRING NAME ',' TYPE '(' SAMPLER ')'  */
+#line 588 "parser.yy"
+{
+    setFactory(*(yyvsp[-6].stringptr), jags::SAMPLER_FACTORY, *(yyvsp[-5].stringptr));
+    delete (yyvsp[-6].stringptr);
+    delete (yyvsp[-5].stringptr);
+}
+#line 2206 "parser.cc"
+    break;
+
+  case 110: /* set_factory: SET FACTORY NAME NAME ',' TYPE '(' RNGTOK ')'  */
+#line 595 "parser.yy"
+{
+    setFactory(*(yyvsp[-6].stringptr), jags::RNG_FACTORY, *(yyvsp[-5].stringptr));
+    delete (yyvsp[-6].stringptr);
+    delete (yyvsp[-5].stringptr);
+}
+#line 2216 "parser.cc"
+    break;
+
+  case 111: /* set_factory: SET FACTORY NAME NAME ',' TYPE '(' MONITOR ')'  */
+#line 602 "parser.yy"
+{
+    setFactory(*(yyvsp[-6].stringptr), jags::MONITOR_FACTORY, *(yyvsp[-5].stringptr));
+    delete (yyvsp[-6].stringptr);
+    delete (yyvsp[-5].stringptr);
+}
+#line 2226 "parser.cc"
+    break;
+
+  case 112: /* set_seed: SET SEED INT  */
+#line 610 "parser.yy"
+{
+    setSeed((yyvsp[0].intval));
+}
+#line 2234 "parser.cc"
+    break;
+
+  case 113: /* checkpoint: CHECKPOINT TO file_name  */
+#line 616 "parser.yy"
+{
+    Jtry(console->checkpoint(ExpandFileName(((yyvsp[0].stringptr))->c_str())));
+    delete (yyvsp[0].stringptr);
+}
+#line 2243 "parser.cc"
+    break;
+
+  case 114: /* restore: RESTORE FROM file_name  */
+#line 623 "parser.yy"
+{
+    Jtry(console->restore(ExpandFileName(((yyvsp[0].stringptr))->c_str())));
+    delete (yyvsp[0].stringptr);
+}
+#line 2252 "parser.cc"
+    break;
+
+  case 115: /* r_assignment_list: r_assignment  */
+#line 631 "parser.yy"
+                                {
+  (yyval.pvec) = new std::vector<jags::ParseTree*>(1, (yyvsp[0].ptree));
+}
+#line 2260 "parser.cc"
+    break;
+
+  case 116: /* r_assignment_list: r_assignment_list r_assignment  */
+#line 634 "parser.yy"
+                                 {
+  (yyval.pvec) = (yyvsp[-1].pvec); (yyval.pvec)->push_back((yyvsp[0].ptree));
+}
+#line 2268 "parser.cc"
+    break;
+
+  case 117: /* r_assignment_list: r_assignment_list ';' r_assignment  */
+#line 637 "parser.yy"
+                                     {
+  (yyval.pvec) = (yyvsp[-2].pvec); (yyval.pvec)->push_back((yyvsp[0].ptree));
+}
+#line 2276 "parser.cc"
+    break;
+
+  case 118: /* r_assignment: r_name ARROW r_structure  */
+#line 642 "parser.yy"
+                                       {
+  (yyval.ptree) = (yyvsp[0].ptree); setName((yyval.ptree), (yyvsp[-2].stringptr));
+}
+#line 2284 "parser.cc"
+    break;
+
+  case 119: /* r_assignment: r_name ARROW r_collection  */
+#line 645 "parser.yy"
+                            {
+  (yyval.ptree) = new jags::ParseTree(jags::P_ARRAY);
+  setName((yyval.ptree), (yyvsp[-2].stringptr));
+  setParameters((yyval.ptree), (yyvsp[0].ptree));
+}
+#line 2294 "parser.cc"
+    break;
+
+  case 120: /* r_assignment: r_name ARROW STRING  */
+#line 650 "parser.yy"
+                      {
+  /* Allow this for setting the NAME of the random number generator */
+  (yyval.ptree) = new jags::ParseTree(jags::P_VAR); setName((yyval.ptree), (yyvsp[-2].stringptr));
+  jags::ParseTree *p = new jags::ParseTree(jags::P_VAR); setName(p, (yyvsp[0].stringptr));
+  setParameters((yyval.ptree), p);
+}
+#line 2305 "parser.cc"
+    break;
+
+  case 123: /* r_name: '`' NAME '`'  */
+#line 660 "parser.yy"
+               {
+    /* R >= 2.4.0 uses backticks for quoted names */
+    (yyval.stringptr) = (yyvsp[-1].stringptr);
+}
+#line 2314 "parser.cc"
+    break;
+
+  case 124: /* r_structure: STRUCTURE '(' r_collection ',' r_attribute_list ')'  */
+#line 665 "parser.yy"
+                                                                 {
+  (yyval.ptree) = new jags::ParseTree(jags::P_ARRAY); 
+  if ((yyvsp[-1].ptree)) 
+    setParameters((yyval.ptree), (yyvsp[-3].ptree), (yyvsp[-1].ptree));
+  else
+    setParameters((yyval.ptree), (yyvsp[-3].ptree));
+}
+#line 2326 "parser.cc"
+    break;
+
+  case 125: /* r_structure: STRUCTURE '(' r_collection ')'  */
+#line 672 "parser.yy"
+                                 {
+    (yyval.ptree) = new jags::ParseTree(jags::P_ARRAY);
+    setParameters((yyval.ptree), (yyvsp[-1].ptree));
+}
+#line 2335 "parser.cc"
+    break;
+
+  case 127: /* r_attribute_list: r_generic_attribute  */
+#line 681 "parser.yy"
+                      {(yyval.ptree)=0;}
+#line 2341 "parser.cc"
+    break;
+
+  case 129: /* r_attribute_list: r_attribute_list ',' r_dim  */
+#line 683 "parser.yy"
+                             {(yyval.ptree)=(yyvsp[0].ptree);}
+#line 2347 "parser.cc"
+    break;
+
+  case 130: /* r_dim: DIM '=' r_collection  */
+#line 686 "parser.yy"
+                            {
+  (yyval.ptree) = (yyvsp[0].ptree);
+}
+#line 2355 "parser.cc"
+    break;
+
+  case 131: /* r_dim: DIM '=' range_element  */
+#line 689 "parser.yy"
+                        {
+  (yyval.ptree) = (yyvsp[0].ptree);
+}
+#line 2363 "parser.cc"
+    break;
+
+  case 134: /* r_integer_collection: ASINTEGER '(' r_value_collection ')'  */
+#line 698 "parser.yy"
+                                                           {(yyval.ptree) = (yyvsp[-1].ptree);}
+#line 2369 "parser.cc"
+    break;
+
+  case 135: /* r_value_collection: r_value  */
+#line 701 "parser.yy"
+                            { 
+  (yyval.ptree) = new jags::ParseTree(jags::P_VECTOR); 
+  setParameters((yyval.ptree), (yyvsp[0].ptree));
+}
+#line 2378 "parser.cc"
+    break;
+
+  case 136: /* r_value_collection: 'c' '(' r_value_list ')'  */
+#line 705 "parser.yy"
+                           {
+  (yyval.ptree) = new jags::ParseTree(jags::P_VECTOR);
+  setParameters((yyval.ptree), (yyvsp[-1].pvec));
+}
+#line 2387 "parser.cc"
+    break;
+
+  case 137: /* r_value_list: r_value  */
+#line 711 "parser.yy"
+                      {(yyval.pvec) = new std::vector<jags::ParseTree*>(1, (yyvsp[0].ptree)); }
+#line 2393 "parser.cc"
+    break;
+
+  case 138: /* r_value_list: r_value_list ',' r_value  */
+#line 712 "parser.yy"
+                           {(yyval.pvec) = (yyvsp[-2].pvec); (yyval.pvec)->push_back((yyvsp[0].ptree));}
+#line 2399 "parser.cc"
+    break;
+
+  case 139: /* r_value: DOUBLE  */
+#line 715 "parser.yy"
+                {(yyval.ptree) = new jags::ParseTree(jags::P_VALUE); (yyval.ptree)->setValue((yyvsp[0].val));}
+#line 2405 "parser.cc"
+    break;
+
+  case 140: /* r_value: NA  */
+#line 716 "parser.yy"
+     {(yyval.ptree) = new jags::ParseTree(jags::P_VALUE); (yyval.ptree)->setValue(JAGS_NA);}
+#line 2411 "parser.cc"
+    break;
+
+  case 141: /* r_generic_attribute: NAME '=' r_generic_vector  */
+#line 722 "parser.yy"
+                                               {;}
+#line 2417 "parser.cc"
+    break;
+
+  case 142: /* r_generic_list: r_generic_list_element  */
+#line 725 "parser.yy"
+                                       {;}
+#line 2423 "parser.cc"
+    break;
+
+  case 143: /* r_generic_list: r_generic_list ',' r_generic_list_element  */
+#line 726 "parser.yy"
+                                            {;}
+#line 2429 "parser.cc"
+    break;
+
+  case 144: /* r_generic_list_element: r_generic_vector  */
+#line 729 "parser.yy"
+                                         {;}
+#line 2435 "parser.cc"
+    break;
+
+  case 145: /* r_generic_list_element: NAME '=' r_generic_vector  */
+#line 730 "parser.yy"
+                            {;}
+#line 2441 "parser.cc"
+    break;
+
+  case 146: /* r_generic_vector: r_numeric_vector  */
+#line 733 "parser.yy"
+                                   {;}
+#line 2447 "parser.cc"
+    break;
+
+  case 147: /* r_generic_vector: ASINTEGER '(' r_numeric_vector ')'  */
+#line 734 "parser.yy"
+                                     {;}
+#line 2453 "parser.cc"
+    break;
+
+  case 148: /* r_generic_vector: r_character_vector  */
+#line 735 "parser.yy"
+                     {;}
+#line 2459 "parser.cc"
+    break;
+
+  case 149: /* r_generic_vector: LIST '(' r_generic_list ')'  */
+#line 736 "parser.yy"
+                              {;}
+#line 2465 "parser.cc"
+    break;
+
+  case 150: /* r_generic_vector: STRUCTURE '(' r_generic_list ')'  */
+#line 737 "parser.yy"
+                                   {;}
+#line 2471 "parser.cc"
+    break;
+
+  case 151: /* r_generic_vector: R_NULL  */
+#line 738 "parser.yy"
+         {;}
+#line 2477 "parser.cc"
+    break;
+
+  case 152: /* r_numeric_vector: DOUBLE  */
+#line 741 "parser.yy"
+                         {;}
+#line 2483 "parser.cc"
+    break;
+
+  case 154: /* r_double_list: DOUBLE  */
+#line 745 "parser.yy"
+                      {;}
+#line 2489 "parser.cc"
+    break;
+
+  case 155: /* r_double_list: r_double_list ',' DOUBLE  */
+#line 746 "parser.yy"
+                           {;}
+#line 2495 "parser.cc"
+    break;
+
+  case 156: /* r_character_vector: STRING  */
+#line 749 "parser.yy"
+                           {;}
+#line 2501 "parser.cc"
+    break;
+
+  case 157: /* r_character_vector: 'c' '(' r_string_list ')'  */
+#line 750 "parser.yy"
+                            {;}
+#line 2507 "parser.cc"
+    break;
+
+  case 158: /* r_string_list: STRING  */
+#line 753 "parser.yy"
+                      {;}
+#line 2513 "parser.cc"
+    break;
+
+  case 159: /* r_string_list: r_string_list ',' STRING  */
+#line 754 "parser.yy"
+                           {;}
+#line 2519 "parser.cc"
+    break;
+
+  case 160: /* get_working_dir: PWD  */
+#line 760 "parser.yy"
+{
+    std::string name;
+    if (getWorkingDirectory(name)) {
+	std::cout << name << std::endl;
+    }
+    else {
+	std::cout << "ERROR: " << name << std::endl;
+    }
+}
+#line 2533 "parser.cc"
+    break;
+
+  case 161: /* set_working_dir: CD file_name  */
+#line 771 "parser.yy"
+{
+    if (chdir(((yyvsp[0].stringptr))->c_str()) == -1) {
+	std::cout << "ERROR: Cannot change working directory" << std::endl;
+    }
+    delete (yyvsp[0].stringptr);
+}
+#line 2544 "parser.cc"
+    break;
+
+  case 162: /* read_dir: DIRECTORY  */
+#line 779 "parser.yy"
+{
+    std::string name;
+    if (!getWorkingDirectory(name)) {
+	std::cerr << "ERROR: Unable to get working directory name\n"
+		  << name << std::endl;
+	return 0;
+    }
+	
+    DIR *dir;
+    struct dirent *de;
+    if ((dir = opendir(name.c_str())) != 0) {
+	while ((de = readdir(dir)) != 0) {
+	    if (std::strcmp(de->d_name, ".") && std::strcmp(de->d_name, "..")) {
+		std::cout << de->d_name << "\n";
+	    }
+	}
+	closedir(dir);
+    }
+    else {
+	std::cerr << "Unable to open working directory" << std::endl;
+    }
+}
+#line 2571 "parser.cc"
+    break;
+
+  case 163: /* run_script: RUN file_name  */
+#line 802 "parser.yy"
+                          {
+    if(open_command_buffer((yyvsp[0].stringptr))) {
+	std::cout << "Running script file " << *(yyvsp[0].stringptr) << std::endl;
+    }
+    else {
+	std::cerr << "Unable to open script file " << *(yyvsp[0].stringptr) << std::endl;
+    }
+    delete (yyvsp[0].stringptr);
+ }
+#line 2585 "parser.cc"
+    break;
+
+
+#line 2589 "parser.cc"
+
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      yyerror (YY_("syntax error"));
+    }
+
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= YYEOF)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp);
+      YYPOPSTACK (1);
+    }
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+
+  return yyresult;
+}
+
+#line 813 "parser.yy"
+
+
+int zzerror (const char *s)
+{
+    return_to_main_buffer();
+    std::cerr << s << std::endl;
+    return 0;
+}
+
+static jags::Range getRange(jags::ParseTree const *var)
+{
+  /* 
+     Blank arguments, e.g. foo[] or bar[,1]  are not allowed.
+  */
+  unsigned int size = var->parameters().size();
+
+  std::vector<int>  ind_lower(size), ind_upper(size);
+  for (unsigned int i = 0; i < size; ++i) {
+    jags::ParseTree const *range_element = var->parameters()[i];
+    switch(range_element->parameters().size()) {
+    case 1:
+      ind_lower[i] = (int) (range_element->parameters()[0]->value() + 1.0E-6);
+      ind_upper[i] = ind_lower[i];
+      break;
+    case 2:
+      ind_lower[i] = (int) (range_element->parameters()[0]->value() + 1.0E-6);  
+      ind_upper[i] = (int) (range_element->parameters()[1]->value() + 1.0E-6);
+      break;
+    default:
+      //Error! FIXME
+      break;
+    }
+  }
+  return jags::SimpleRange(ind_lower, ind_upper);
+}
+
+void setMonitor(jags::ParseTree const *var, int thin, std::string const &type)
+{
+    std::string const &name = var->name();
+    if (var->parameters().empty()) {
+	/* Requesting the whole node */
+	console->setMonitor(name, jags::Range(), thin, type);
+    }
+    else {
+	/* Requesting subset of a multivariate node */
+	console->setMonitor(name, getRange(var), thin, type);
+    }
+}
+
+void clearMonitor(jags::ParseTree const *var, std::string const &type)
+{
+    std::string const &name = var->name();
+    if (var->parameters().empty()) {
+	/* Requesting the whole node */
+	console->clearMonitor(name, jags::Range(), type);
+    }
+    else {
+	/* Requesting subset of a multivariate node */
+	console->clearMonitor(name, getRange(var), type);
+    }
+}
+
+void doAllCoda (std::string const &stem, bool binary)
+{
+    console->coda(stem, binary);
+}
+
+void doCoda (jags::ParseTree const *var, std::string const &stem, bool binary)
+{
+    //FIXME: Allow list of several nodes
+
+    std::vector<std::pair<std::string, jags::Range> > dmp;
+    if (var->parameters().empty()) {
+	/* Requesting the whole node */
+	dmp.push_back(std::pair<std::string,jags::Range>(var->name(), jags::Range()));
+    }
+    else {
+	/* Requesting subset of a multivariate node */
+	dmp.push_back(std::pair<std::string,jags::Range>(var->name(), getRange(var)));
+    }
+    console->coda(dmp, stem, binary);
+}
+
+/* Helper function for doDump that handles all the special cases
+   (missing values etc) when writing a double value */
+static void writeValue(double x, std::ostream &out, bool isdiscrete)
+{
+  using namespace std;
+
+  if (x == JAGS_NA) {
+    out << "NA";
+  }
+  else if (jags_isnan(x)) {
+    out << "NaN";
+  }
+  else if (!jags_finite(x)) {
+    if (x > 0)
+      out << "Inf";
+    else
+      out << "-Inf";
+  }
+  else if (isdiscrete) {
+      out << static_cast<int>(x) << "L";
+  }
+  else {
+    out << x;
+  }
+}
+
+void doDump(std::string const &file, jags::DumpType type, unsigned int chain)
+{
+    std::map<std::string,jags::SArray> data_table;
+    std::string rng_name;
+    if (!console->dumpState(data_table, rng_name, type, chain)) {
+	return;
+    }
+
+    /* Open output file */
+    std::ofstream out(file.c_str());
+    if (!out) {
+	std::cerr << "Failed to open file " << file << std::endl;
+	return;
+    }
+  
+    if (rng_name.size() != 0) {
+	out << "`.RNG.name` <- \"" << rng_name << "\"\n";
+    }
+
+    for (std::map<std::string, jags::SArray>::const_iterator p = data_table.begin();
+	 p != data_table.end(); ++p) {
+	std::string const &name = p->first;
+	jags::SArray const &sarray = p->second;
+	std::vector<double> const &value = sarray.value();
+	long length = sarray.length();
+	out << "`" << name << "` <- " << std::endl;
+	std::vector<unsigned int> const &dim = sarray.dim(false);
+	bool discrete = sarray.isDiscreteValued();
+
+	if (dim.size() == 1) {
+	    // Vector 
+	    if (dim[0] == 1) {
+		// Scalar
+		writeValue(value[0], out, discrete);
+	    }
+	    else {
+		// Vector of length > 1
+		out << "c(";
+		for (int i = 0; i < length; ++i) {
+		    if (i > 0) {
+			out << ",";
+		    }
+		    writeValue(value[i], out, discrete);
+		}
+		out << ")";
+	    }
+	}
+	else {
+	    // Array 
+	    out << "structure(c(";
+	    for (int i = 0; i < length; ++i) {
+		if (i > 0) {
+		    out << ",";
+		}
+		writeValue(value[i], out, discrete);
+	    }
+	    out << "), .Dim = c(";
+	    for (unsigned int j = 0; j < dim.size(); ++j) {
+		if (j > 0) {
+		    out << ",";
+		}
+		out << dim[j] << "L";
+	    }
+	    out << "))";
+	}
+	out << "\n";
+    }
+    out.close();
+}  
+
+void dumpMonitors(std::string const &file, std::string const &type)
+{
+    std::map<std::string,jags::SArray> data_table;
+
+    if (!console->dumpMonitors(data_table, type, false)) {
+	return;
+    }
+
+    /* Open output file */
+    std::ofstream out(file.c_str());
+    if (!out) {
+	std::cerr << "Failed to open file " << file << std::endl;
+	return;
+    }
+
+    out << "`" << type << "` <-\nstructure(list(";
+
+    std::map<std::string, jags::SArray>::const_iterator p;
+    for (p = data_table.begin(); p != data_table.end(); ++p) {
+	std::string const &name = p->first;
+	jags::SArray const &sarray = p->second;
+	std::vector<double> const &value = sarray.value();
+	long length = sarray.length();
+
+	if (p != data_table.begin()) {
+	    out << ", \n";
+	}
+	out << "\"" << name << "\" = ";
+	std::vector<unsigned int> const &dim = sarray.dim(false);
+	bool discrete = sarray.isDiscreteValued();
+	bool named = !sarray.dimNames().empty();
+
+	if (dim.size() == 1 && !named) {
+	    // Vector 
+	    if (dim[0] == 1) {
+		// Scalar
+		writeValue(value[0], out, discrete);
+	    }
+	    else {
+		// Vector of length > 1
+		out << "c(";
+		for (int i = 0; i < length; ++i) {
+		    if (i > 0) {
+			out << ",";
+		    }
+		    writeValue(value[i], out, discrete);
+		}
+		out << ")";
+	    }
+	}
+	else {
+	    // Array 
+	    out << "structure(c(";
+	    for (int i = 0; i < length; ++i) {
+		if (i > 0) {
+		    out << ",";
+		}
+		writeValue(value[i], out, discrete);
+	    }
+	    out << "), .Dim = ";
+	    if (named) {
+		out << "structure(";
+	    }
+	    out << "c(";
+	    for (unsigned int j = 0; j < dim.size(); ++j) {
+		if (j > 0) {
+		    out << ",";
+		}
+		out << dim[j] << "L";
+	    }
+	    out << ")";
+	    if (named) {
+		std::vector<std::string> const &dnames = sarray.dimNames();
+		out << ", .Names = c(";
+		for (unsigned int k = 0; k < dnames.size(); ++k) {
+		    if (k > 0) {
+			out << ",";
+		    }
+		    out << "\"" << dnames[k] << "\"";
+		}
+		out << "))";
+	    }
+	    out << ")";
+	}
+    }
+
+    out << "), \n.Names = c(";
+    for (p = data_table.begin(); p != data_table.end(); ++p) {
+	if (p != data_table.begin()) {
+	    out << ", ";
+	}
+	std::string const &name = p->first;
+	out << "\"" << name << "\"";
+    }
+    out << "))";
+    out.close();
+}
+
+void setParameters(jags::ParseTree *p, std::vector<jags::ParseTree*> *parameters)
+{
+  /* 
+     The parser dynamically allocates vectors of (pointers to)
+     parameters. These vectors must be deleted when we are done with
+     them.
+  */
+  p->setParameters(*parameters);
+  delete parameters; 
+}
+
+void setParameters(jags::ParseTree *p, jags::ParseTree *param1)
+{
+  /*
+    Wrapper function that creates a vector containing param1
+    to be passed to jags::ParseTree::setParameters.
+  */
+  std::vector<jags::ParseTree *> parameters(1, param1);
+  p->setParameters(parameters);
+}
+
+void setParameters(jags::ParseTree *p, jags::ParseTree *param1, jags::ParseTree *param2)
+{
+  /*
+    Wrapper function that creates a vector containing param1
+    and param2, to be passed to jags::ParseTree::setParameters
+  */
+  std::vector<jags::ParseTree *> parameters;
+  parameters.push_back(param1);
+  parameters.push_back(param2);
+  p->setParameters(parameters);
+}
+
+void setName(jags::ParseTree *p, std::string *name)
+{
+  p->setName(*name);
+  delete name;
+}
+
+static void errordump()
+{
+    if (console->model()) {
+	std::ostringstream fname;
+	for (unsigned int i = 1; i <= console->nchain(); ++i) {
+	    fname << "jags.dump" << i << ".R";
+	    std::cout << "Dumping chain " << i << " at iteration " 
+		      << console->iter() << " to file " << fname.str() 
+		      << std::endl;
+	    doDump(fname.str(), jags::DUMP_ALL, i);
+	    fname.str("");
+	}
+	// Moved clearModel from Console.cc CATCH_ERRORS to here
+	// to allow doDump to work as described in the manual:
+	console->clearModel();
+    }
+    if (!interactive) exit(1);
+}
+
+static void updatestar(long niter, long refresh, int width, bool parallel)
+{
+    std::cout << "Updating " << niter << std::endl;
+
+    bool adapt = console->isAdapting();
+    if (adapt && console->iter() > 0) {
+	//Turn off iteration immediately if we have some burn-in
+	if (console->adaptOff()) {
+	    adapt = false;
+	}
+	else {
+	    std::cout << std::endl;
+	    errordump();
+	    return;
+	}
+    }
+
+    if (refresh == 0) {
+	Jtry_dump(console->update(niter/2, parallel));
+	bool status = true;
+	if (adapt) {
+	    if (!console->checkAdaptation(status)) {
+		errordump();
+		return;
+	    }
+	    if (!console->adaptOff()) {
+		errordump();
+		return;
+	    }
+	}
+	Jtry_dump(console->update(niter - niter/2, parallel));
+	if (!status) {
+	    std::cerr << "WARNING: Adaptation incomplete\n";
+	}
+	return;
+    }
+
+    if (width > niter / refresh + 1)
+	width = niter / refresh + 1;
+
+    for (int i = 0; i < width - 1; ++i) {
+	std::cout << "-";
+    }
+    std::cout << "| " << std::min(width * refresh, niter) << std::endl 
+	      << std::flush;
+
+    int col = 0;
+    bool status = true;
+    for (long n = niter; n > 0; n -= refresh) {
+	if (adapt && n <= niter/2) {
+	    // Turn off adaptive mode half way through burnin
+	    if (!console->checkAdaptation(status)) {
+		std::cout << std::endl;
+		errordump();
+		return;
+	    }
+	    if (console->adaptOff()) {
+		adapt = false;
+	    }
+	    else {
+		std::cout << std::endl;
+		errordump();
+		return;
+	    }
+	}
+	long nupdate = std::min(n, refresh);
+	if(Jtry_dump(console->update(nupdate, parallel))) {
+	    std::cout << "*" << std::flush;
+	}
+	else {
+	    std::cout << std::endl;
+	    return;
+	}
+	col++;
+	if (col == width || n <= nupdate) {
+	    int percent = 100 - (n-nupdate) * 100/niter;
+	    std::cout << " " << percent << "%" << std::endl;
+	    if (n > nupdate) {
+		col = 0;
+	    }
+	}
+    }
+    if (!status) {
+	std::cerr << "WARNING: Adaptation incomplete\n";
+    }
+}
+
+static void autoadaptstar(long maxiter)
+{
+    std::cout << "Autoadapting up to " << maxiter << " iterations" << std::endl;
+	
+	bool status = true;
+	long i = 0;
+    for (i = 0; i < maxiter; i++) {
+		if (!console->checkAdaptation(status)) {
+		    errordump();
+		    return;
+		}
+		if(status)
+			break;
+
+		Jtry_dump(console->update(1));
+	}
+	if (!console->checkAdaptation(status)) {
+	    errordump();
+	    return;
+	}
+	
+	if (!status) {
+	    std::cerr << "Adaptation incomplete\n";
+	}
+	else {
+		if (i==0)
+			std::cout << "Adaptation skipped: model is not in adaptive mode\n";
+		else
+			std::cout << "Adaptation completed in " << i << " iterations" << std::endl;
+		if (!console->adaptOff()) {
+			std::cout << std::endl;
+			errordump();
+			return;
+	    }
+	}
+    return;
+}
+
+static void adaptstar(long niter, long refresh, int width)
+{
+    if (!console->isAdapting()) {
+	std::cerr << "Adaptation skipped: model is not in adaptive mode.\n";
+	return;
+    }
+    std::cout << "Adapting " << niter << std::endl;
+    
+    bool status = true;
+    if (refresh == 0) {
+	Jtry_dump(console->update(niter));
+	if (!console->checkAdaptation(status)) {
+	    errordump();
+	    return;
+	}
+	if (!status) {
+	    std::cerr << "Adaptation incomplete\n";
+	    return;
+	}
+	else {
+	    std::cerr << "Adaptation successful\n";
+	    return;
+	}
+    }
+
+    if (width > niter / refresh + 1)
+	width = niter / refresh + 1;
+
+    for (int i = 0; i < width - 1; ++i) {
+	std::cout << "-";
+    }
+    std::cout << "| " << std::min(width * refresh, niter) << std::endl 
+	      << std::flush;
+
+    int col = 0;
+    for (long n = niter; n > 0; n -= refresh) {
+	long nupdate = std::min(n, refresh);
+	if(Jtry_dump(console->update(nupdate)))
+	    std::cout << "+" << std::flush;
+	else {
+	    std::cout << std::endl;
+	    return;
+	}
+	col++;
+	if (col == width || n <= nupdate) {
+	    int percent = 100 - (n-nupdate) * 100/niter;
+	    std::cout << " " << percent << "%" << std::endl;
+	    if (n > nupdate) {
+		col = 0;
+	    }
+	}
+    }
+    if (!console->checkAdaptation(status)) {
+	std::cout << std::endl;
+	errordump();
+	return;
+    }
+    if (!status) {
+	std::cerr << "Adaptation incomplete.\n";
+    }
+    else {
+	std::cerr << "Adaptation successful\n";
+    }
+}
+
+static void loadModule(std::string const &name)
+{
+    std::cout << "Loading module: " << name;
+    lt_dlhandle mod = lt_dlopenext(name.c_str());
+    if (mod == NULL) {
+	std::cout << ": " << lt_dlerror() << std::endl;
+    }
+    else {
+	std::cout << ": ok" << std::endl;
+	_dyn_lib.push_front(mod);
+	jags::Console::loadModule(name);
+    }
+}
+
+static void unloadModule(std::string const &name)
+{
+    std::cout << "Unloading module: " << name << std::endl;
+    jags::Console::unloadModule(name);
+}
+
+int main (int argc, char **argv)
+{
+  extern std::FILE *zzin;
+
+  std::FILE *cmdfile = 0;
+  if (argc > 2) {
+    std::cerr << "Too many arguments" << std::endl;
+  }
+  else if (argc == 2) {
+    interactive = false;
+    cmdfile = std::fopen(ExpandFileName(argv[1]).c_str(),"r");
+    if (cmdfile) {
+      zzin = cmdfile;
+    }
+    else {
+      std::cerr << "Unable to open command file " << argv[1] << std::endl;
+      return 1;
+    }
+  }
+  else {
+    interactive = true;
+  }
+
+#ifndef _WIN32
+  /* 
+     - Allows emulation of dynamic loading on platforms that do not
+     support it by preloading modules. 
+     - Causes build failures on mingw-w64 (as at 21 April 2010) so
+     not used on Windows platform.
+  */
+  LTDL_SET_PRELOADED_SYMBOLS();
+#endif
+
+  if(lt_dlinit()) {
+      std::cerr << lt_dlerror() << std::endl;
+      return 1;
+  }
+
+  /*
+  pt2Func load_base = (pt2Func)(lt_dlsym(base, "load"));
+  if (load_base == NULL) {
+      std::cout << lt_dlerror() << std::endl;
+      return 1;
+  }
+  else{
+      (*load_base)();
+  }
+  */
+  
+  time_t t;
+  time(&t);
+  std::cout << "Welcome to " << PACKAGE_STRING << " on " << ctime(&t);
+  std::cout << "JAGS is free software and comes with ABSOLUTELY NO WARRANTY" 
+            << std::endl;
+  loadModule("basemod");
+  loadModule("bugs");
+
+  console = new jags::Console(std::cout, std::cerr);
+
+  zzparse();
+  zzlex_destroy();
+
+  if (argc==2) {
+      std::fclose(cmdfile);
+  }
+  
+  //Unload modules
+  std::vector<std::string> mods = jags::Console::listModules();
+  for (unsigned int i = 0; i < mods.size(); ++i) {
+      jags::Console::unloadModule(mods[i]);
+  }
+  delete console;
+  //Release dynamic libraries. 
+  for (unsigned int i = 0; i < _dyn_lib.size(); ++i) {
+      lt_dlclose(_dyn_lib[i]);
+  }
+  lt_dlexit();
+}
+
+static bool getWorkingDirectory(std::string &name)
+{
+    char buf[FILENAME_MAX];
+#ifdef Win32
+    if (getCurrentDirectory(FILENAME_MAX, buf)) {
+	name = buf;
+	return true;
+    }
+    else {
+	name = "Error in getCurrentDirectory";
+	return false;
+    }
+#else
+    if (getcwd(buf, FILENAME_MAX)) {
+	name = buf;
+	return true;
+    }
+    else {
+	switch(errno) {
+	case EACCES:
+	    name = "Access denied";
+	    break;
+	case ENOENT:
+	    name = "Not found";
+	    break;
+	case ERANGE:
+	    name = "Directory name too long";
+	    break;
+	default:
+	    name = "Error in getcwd";
+	    break;
+	}
+	return false;
+    }
+#endif
+}
+
+static void dumpSamplers(std::string const &file)
+{
+    std::ofstream out(file.c_str());
+    if (!out) {
+	std::cerr << "Failed to open file " << file << std::endl;
+	return;
+    }
+
+    std::vector<std::vector<std::string> > sampler_list;
+    console->dumpSamplers(sampler_list);
+    for (unsigned int i = 0; i < sampler_list.size(); ++i) {
+	for (unsigned int j = 1; j < sampler_list[i].size(); ++j) {
+	    out << i + 1 << "\t" 
+		<< sampler_list[i][0] << "\t" //First element is sampler name
+		<< sampler_list[i][j] << "\n"; //Rest are node names
+	}
+    }
+
+    out.close();
+}
+
+static void delete_pvec(std::vector<jags::ParseTree*> *pv)
+{
+    for (unsigned int i = 0; i < pv->size(); ++i) {
+	delete (*pv)[i];
+    }
+    delete pv;
+}
+
+static void openBinaryData(std::string const &name)
+{
+    /* 
+       A binary data file is read by the parser in a single pass,
+       rather than being tokenized by the scanner. The name is saved
+       here and the scanner is given an empty buffer.
+    */
+    std::string file = ExpandFileName(name.c_str());
+    _binary_data = isBinaryData(file) ? file : std::string();
+}
+
+static void setAllParameters(std::map<std::string, jags::SArray> &table,
+			     std::string const &rngname)
+{
+    /* Set all chains to the same state. If the user sets the
+       RNG state in addition to the parameter values then all
+       chains will be identical!
+    */
+    if (console->model() == 0) {
+	std::cout << "ERROR: Initial values ignored. "
+		  <<  "(You must compile the model first)" << std::endl;
+	if (!interactive) exit(1);
+    }
+    for (unsigned int i = 1; i <= console->nchain(); ++i) {
+	/* We have to set the name first, because the state or seed
+	   might be embedded in the parameter_table */
+	if (rngname.size() != 0) {
+	    Jtry(console->setRNGname(rngname, i));
+	}
+	Jtry(console->setParameters(table, i));
+    }
+    print_unused_variables(table, false);
+}
+
+static void setChainParameters(std::map<std::string, jags::SArray> &table,
+			       std::string const &rngname,
+			       unsigned int chain)
+{
+    /* We have to set the name first, because the state or seed
+       might be embedded in the parameter_table */
+    if (rngname.size() != 0) {
+        Jtry(console->setRNGname(rngname, chain));
+    }
+    Jtry(console->setParameters(table, chain));
+    print_unused_variables(table, false);
+}
+
+static void doCompile(unsigned int nchain, bool worklist)
+{
+    if (Jtry(console->compile(_data_table, nchain, true, worklist)) &&
+	interactive)
+    {
+	//Timings are not printed in batch mode, so that output from
+	//scripts is unchanged
+	std::vector<std::pair<std::string, double> > times;
+	if (console->dumpCompileTimes(times)) {
+	    std::cout << "Compilation times (seconds):\n";
+	    for (unsigned int i = 0; i < times.size(); ++i) {
+		std::cout << "   " << times[i].first << ": "
+			  << times[i].second << "\n";
+	    }
+	    std::cout << std::flush;
+	}
+    }
+    print_unused_variables(_data_table, true);
+}
+
+static void print_unused_variables(std::map<std::string, jags::SArray> const &table,
+				   bool data)
+{
+    std::vector<std::string> supplied_vars;
+    for (std::map<std::string, jags::SArray>::const_iterator p = table.begin();
+	 p != table.end(); ++p)
+    {
+	supplied_vars.push_back(p->first);
+    }
+    
+    std::vector<std::string> unused_vars;
+    std::vector<std::string> model_vars = console->variableNames();
+    if (!data) {
+	// Initial values table may legitimately contain these names
+	model_vars.push_back(".RNG.name");
+	model_vars.push_back(".RNG.seed");
+	model_vars.push_back(".RNG.state");
+    }
+	
+	// Make sure both vectors are sorted to avoid false positive WARNINGs:
+	std::sort(model_vars.begin(), model_vars.end());
+	std::sort(supplied_vars.begin(), supplied_vars.end());
+	
+	/*  Test code to check vectors:
+	if(data){
+		std::cout << "Variables in model:\n";
+		std::copy(model_vars.begin(), model_vars.end(),
+			  std::ostream_iterator<std::string>(std::cout, ", "));
+		std::cout << "\n";
+
+		std::cout << "Supplied vars:\n";
+		std::copy(supplied_vars.begin(), supplied_vars.end(),
+			  std::ostream_iterator<std::string>(std::cout, ", "));
+		std::cout << "\n";
+	}  
+	*/
+	
+    std::set_difference(supplied_vars.begin(), supplied_vars.end(),
+			model_vars.begin(), model_vars.end(),
+			std::inserter(unused_vars, unused_vars.begin()));
+
+    if (!unused_vars.empty()) {
+	std::cerr << "\nWARNING: Unused variable(s) in ";
+	if (data) {
+	    std::cerr << "data table:\n";
+	}
+	else {
+	    std::cerr << "initial value table:\n";
+	}
+	std::copy(unused_vars.begin(), unused_vars.end(),
+		  std::ostream_iterator<std::string>(std::cerr, "\n"));
+	std::cerr << "\n";
+    }
+
+}
+
+std::string ExpandFileName(char const *s)
+{
+    if(s[0] != '~') return s;
+    std::string name = s;
+    if(name.size() > 1 && s[1] != '/') return s;
+
+    char const *p = getenv("HOME");
+    if (p) {
+	std::string UserHOME = p;
+	if (!UserHOME.empty()) {
+	    if (name.size() == 1) 
+		return UserHOME;
+	    else
+		return UserHOME + name.substr(1);
+	}
+    }
+    return name;
+}
+
+
+void doSystem(std::string const *command)
+{
+    std::system(command->c_str());
+}
+
+void listFactories(jags::FactoryType type)
+{
+    std::vector<std::pair<std::string, bool> > faclist = 
+	jags::Console::listFactories(type);
+
+    std::vector<std::pair<std::string, bool> >::const_iterator p;
+    unsigned int max_strlen = 0;
+    for (p = faclist.begin(); p != faclist.end(); ++p) {
+	if (p->first.length() > max_strlen)
+	    max_strlen = p->first.length();
+    }
+    if (max_strlen < 4)
+	max_strlen = 4;
+
+    //Header
+    std::cout << "Name";
+    for (int i = max_strlen - 4; i >=0; --i) {
+	std::cout << " ";
+    }
+    std::cout << "Status\n";
+
+    //Body
+    for (p = faclist.begin(); p != faclist.end(); ++p) {
+	std::cout << p->first << " ";
+	for (int i = max_strlen - p->first.length(); i >= 0; --i) {
+	    std::cout << " ";
+	}
+	if (p->second) {
+	    std::cout << "on";
+	}
+	else {
+	    std::cout << "off";
+	}
+	std::cout << "\n";
+    }
+}
+
+void setFactory(std::string const &name, jags::FactoryType type, 
+		std::string const &status)
+{
+    if (status == "on") {
+	jags::Console::setFactoryActive(name, type, true);
+    }
+    else if (status == "off") {
+	jags::Console::setFactoryActive(name, type, false);
+    }
+    else {
+	std::cout << "status should be \"on\" or \"off\"";
+    }
+}
+
+void setSeed(unsigned int seed)
+{
+    if (seed == 0) {
+	std::cout << "seed must be non-zero";
+    }
+    else {
+	jags::Console::setRNGSeed(seed);
+    }
+}
+	    
+bool Jtry(bool ok)
+{
+    if (!ok && !interactive) 
+	exit(1);
+    else
+	return ok;
+}
+
+bool Jtry_dump(bool ok)
+{
+	// Allows doDump to work as described in the manual:
+	if (!ok) {
+	errordump();
+	console->clearModel();
+    if (!interactive) 
+	exit(1);
+	}
+	return ok;
+}
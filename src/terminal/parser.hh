@@ -0,0 +1,148 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_ZZ_PARSER_HH_INCLUDED
+# define YY_ZZ_PARSER_HH_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int zzdebug;
+#endif
+
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    INT = 258,                     /* INT  */
+    DOUBLE = 259,                  /* DOUBLE  */
+    NAME = 260,                    /* NAME  */
+    STRING = 261,                  /* STRING  */
+    SYSCMD = 262,                  /* SYSCMD  */
+    ENDCMD = 263,                  /* ENDCMD  */
+    MODEL = 264,                   /* MODEL  */
+    DATA = 265,                    /* DATA  */
+    IN = 266,                      /* IN  */
+    TO = 267,                      /* TO  */
+    INITS = 268,                   /* INITS  */
+    PARAMETERS = 269,              /* PARAMETERS  */
+    COMPILE = 270,                 /* COMPILE  */
+    INITIALIZE = 271,              /* INITIALIZE  */
+    ADAPT = 272,                   /* ADAPT  */
+    AUTOADAPT = 273,               /* AUTOADAPT  */
+    UPDATE = 274,                  /* UPDATE  */
+    BY = 275,                      /* BY  */
+    PARALLEL = 276,                /* PARALLEL  */
+    WORKLIST = 277,                /* WORKLIST  */
+    BINARY = 278,                  /* BINARY  */
+    MONITORS = 279,                /* MONITORS  */
+    MONITOR = 280,                 /* MONITOR  */
+    TYPE = 281,                    /* TYPE  */
+    SET = 282,                     /* SET  */
+    CLEAR = 283,                   /* CLEAR  */
+    THIN = 284,                    /* THIN  */
+    CODA = 285,                    /* CODA  */
+    STEM = 286,                    /* STEM  */
+    EXIT = 287,                    /* EXIT  */
+    NCHAINS = 288,                 /* NCHAINS  */
+    CHAIN = 289,                   /* CHAIN  */
+    LOAD = 290,                    /* LOAD  */
+    UNLOAD = 291,                  /* UNLOAD  */
+    SAMPLER = 292,                 /* SAMPLER  */
+    SAMPLERS = 293,                /* SAMPLERS  */
+    RNGTOK = 294,                  /* RNGTOK  */
+    FACTORY = 295,                 /* FACTORY  */
+    FACTORIES = 296,               /* FACTORIES  */
+    SEED = 297,                    /* SEED  */
+    CHECKPOINT = 298,              /* CHECKPOINT  */
+    RESTORE = 299,                 /* RESTORE  */
+    FROM = 300,                    /* FROM  */
+    LIST = 301,                    /* LIST  */
+    STRUCTURE = 302,               /* STRUCTURE  */
+    DIM = 303,                     /* DIM  */
+    NA = 304,                      /* NA  */
+    R_NULL = 305,                  /* R_NULL  */
+    DIMNAMES = 306,                /* DIMNAMES  */
+    ITER = 307,                    /* ITER  */
+    ARROW = 308,                   /* ARROW  */
+    ENDDATA = 309,                 /* ENDDATA  */
+    ASINTEGER = 310,               /* ASINTEGER  */
+    DIRECTORY = 311,               /* DIRECTORY  */
+    CD = 312,                      /* CD  */
+    PWD = 313,                     /* PWD  */
+    RUN = 314,                     /* RUN  */
+    ENDSCRIPT = 315                /* ENDSCRIPT  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
+
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+union YYSTYPE
+{
+#line 106 "parser.yy"
+
+  int intval;
+  double val;
+  std::string *stringptr;
+  jags::ParseTree *ptree;
+  std::vector<jags::ParseTree*> *pvec;
+  std::vector<double> *vec;
+  std::vector<long> *ivec;
+
+#line 134 "parser.hh"
+
+};
+typedef union YYSTYPE YYSTYPE;
+# define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
+#endif
+
+
+extern YYSTYPE zzlval;
+
+
+int zzparse (void);
+
+
+#endif /* !YY_ZZ_PARSER_HH_INCLUDED  */
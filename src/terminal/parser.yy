@@ -55,13 +55,15 @@
     void setName(jags::ParseTree *p, std::string *name);
     std::map<std::string, jags::SArray> _data_table;
     std::deque<lt_dlhandle> _dyn_lib;
-    bool open_data_buffer(std::string const *name);
+    bool open_data_buffer(std::string const *name, bool binary);
+    std::string _binary_data; // Binary file opened by data or parameters
     bool open_command_buffer(std::string const *name);
     void return_to_main_buffer();
     void setMonitor(jags::ParseTree const *var, int thin, std::string const &type);
     void clearMonitor(jags::ParseTree const *var, std::string const &type);
-    void doCoda (jags::ParseTree const *var, std::string const &stem);
-    void doAllCoda (std::string const &stem);
+    void doCoda (jags::ParseTree const *var, std::string const &stem,
+		 bool binary = false);
+    void doAllCoda (std::string const &stem, bool binary = false);
     void doDump (std::string const &file, jags::DumpType type, unsigned int chain);
     void dumpMonitors(std::string const &file, std::string const &type);
     void doSystem(std::string const *command);
@@ -69,7 +71,8 @@
 
     static bool getWorkingDirectory(std::string &name);
     static void errordump();
-    static void updatestar(long niter, long refresh, int width);
+    static void updatestar(long niter, long refresh, int width,
+                           bool parallel);
 	// Run adaptation phase until adapted, regardless of iterations:
     static void autoadaptstar(long maxiter);
     static void adaptstar(long niter, long refresh, int width);
@@ -80,7 +83,14 @@
     static void unloadModule(std::string const &name);
     static void dumpSamplers(std::string const &file);
     static void delete_pvec(std::vector<jags::ParseTree*> *);
+    static void doCompile(unsigned int nchain, bool worklist);
     static void print_unused_variables(std::map<std::string, jags::SArray> const &table, bool data);
+    static void openBinaryData(std::string const &name);
+    static void setAllParameters(std::map<std::string, jags::SArray> &table,
+				 std::string const &rngname);
+    static void setChainParameters(std::map<std::string, jags::SArray> &table,
+				   std::string const &rngname,
+				   unsigned int chain);
     static void listFactories(jags::FactoryType type);
     static void setFactory(std::string const &name, jags::FactoryType type,
                            std::string const &status);
@@ -123,6 +133,9 @@
 %token <intval> AUTOADAPT
 %token <intval> UPDATE
 %token <intval> BY
+%token <intval> PARALLEL
+%token <intval> WORKLIST
+%token <intval> BINARY
 %token <intval> MONITORS
 %token <intval> MONITOR
 %token <intval> TYPE
@@ -142,6 +155,9 @@
 %token <intval> FACTORY;
 %token <intval> FACTORIES;
 %token <intval> SEED;
+%token <intval> CHECKPOINT
+%token <intval> RESTORE
+%token <intval> FROM
 
 %token <intval> LIST 
 %token <intval> STRUCTURE
@@ -169,6 +185,7 @@
 %type <ptree> r_value_collection r_integer_collection r_collection
 %type <stringptr> file_name;
 %type <stringptr> r_name;
+%type <stringptr> var_name;
 
 %%
 
@@ -214,6 +231,8 @@ command: model
 | list_factories
 | set_factory
 | set_seed
+| checkpoint
+| restore
 ;
 
 model: MODEL IN file_name {
@@ -241,6 +260,14 @@ data_in: data r_assignment_list ENDDATA {
     }
     delete_pvec($2);
  }
+| data ENDDATA {
+    // Binary data file, or empty text file
+    if (!_binary_data.empty()) {
+	if (!readBinaryData(_binary_data, _data_table) && !interactive) {
+	    exit(1);
+	}
+    }
+ }
 | data {
     // Failed to open the data file 
     if (!interactive) exit(1);
@@ -254,7 +281,8 @@ data_to: DATA TO file_name {
 ;
 
 data: DATA IN file_name {
-    if(open_data_buffer($3)) {
+    openBinaryData(*$3);
+    if(open_data_buffer($3, !_binary_data.empty())) {
 	std::cout << "Reading data file " << *$3 << std::endl;
     }
     else {
@@ -277,25 +305,7 @@ parameters_in: parameters r_assignment_list ENDDATA
     std::string rngname;
     readRData($2, parameter_table, rngname);
     delete_pvec($2);
-    /* Set all chains to the same state. If the user sets the
-       RNG state in addition to the parameter values then all
-       chains will be identical!
-    */
-    if (console->model() == 0) {
-	std::cout << "ERROR: Initial values ignored. "
-		  <<  "(You must compile the model first)" << std::endl;
-	if (!interactive) exit(1);
-    }
-    for (unsigned int i = 1; i <= console->nchain(); ++i) {
-	/* We have to set the name first, because the state or seed
-	   might be embedded in the parameter_table */
-	if (rngname.size() != 0) {
-	    Jtry(console->setRNGname(rngname, i));
-	}
-	Jtry(console->setParameters(parameter_table, i));
-    }
-    print_unused_variables(parameter_table, false);
-
+    setAllParameters(parameter_table, rngname);
 }
 | parameters r_assignment_list ENDDATA ',' CHAIN '(' INT ')' 
 {
@@ -303,13 +313,31 @@ parameters_in: parameters r_assignment_list ENDDATA
     std::string rngname;
     readRData($2, parameter_table, rngname);
     delete $2;
-    /* We have to set the name first, because the state or seed
-       might be embedded in the parameter_table */
-    if (rngname.size() != 0) {
-        Jtry(console->setRNGname(rngname, $7));
+    setChainParameters(parameter_table, rngname, $7);
+}
+| parameters ENDDATA
+{
+    std::map<std::string, jags::SArray> parameter_table;
+    if (!_binary_data.empty()) {
+	if (readBinaryData(_binary_data, parameter_table)) {
+	    setAllParameters(parameter_table, "");
+	}
+	else if (!interactive) {
+	    exit(1);
+	}
+    }
+}
+| parameters ENDDATA ',' CHAIN '(' INT ')'
+{
+    std::map<std::string, jags::SArray> parameter_table;
+    if (!_binary_data.empty()) {
+	if (readBinaryData(_binary_data, parameter_table)) {
+	    setChainParameters(parameter_table, "", $6);
+	}
+	else if (!interactive) {
+	    exit(1);
+	}
     }
-    Jtry(console->setParameters(parameter_table, $7));
-    print_unused_variables(parameter_table, false);
 }
 | parameters {} // Failed to open the file
 ;
@@ -325,7 +353,8 @@ parameters_to: PARAMETERS TO file_name {
 ;
 
 parameters: PARAMETERS IN file_name {
-  if(open_data_buffer($3)) {
+  openBinaryData(*$3);
+  if(open_data_buffer($3, !_binary_data.empty())) {
     std::cout << "Reading parameter file " << *$3 << std::endl;
   }
   else {
@@ -335,7 +364,8 @@ parameters: PARAMETERS IN file_name {
 }
 | INITS IN file_name {
   /* Legacy option to not break existing scripts */
-  if(open_data_buffer($3)) {
+  openBinaryData(*$3);
+  if(open_data_buffer($3, !_binary_data.empty())) {
     std::cout << "Reading initial values file " << *$3 << std::endl;
   }
   else {
@@ -346,12 +376,16 @@ parameters: PARAMETERS IN file_name {
 ;
 
 compile: COMPILE {
-    Jtry(console->compile(_data_table, 1, true));
-    print_unused_variables(_data_table, true);
+    doCompile(1, false);
 }
 | COMPILE ',' NCHAINS '(' INT ')' {
-    Jtry(console->compile(_data_table, $5, true));
-    print_unused_variables(_data_table, true);
+    doCompile($5, false);
+}
+| COMPILE ',' WORKLIST {
+    doCompile(1, true);
+}
+| COMPILE ',' NCHAINS '(' INT ')' ',' WORKLIST {
+    doCompile($5, true);
 }
 ;
 
@@ -378,25 +412,42 @@ adapt: ADAPT INT {
 
 update: UPDATE INT {
     long refresh = interactive ? $2/50 : 0;
-    updatestar($2, refresh, 50);
+    updatestar($2, refresh, 50, false);
 }
 | UPDATE INT ',' BY '(' INT ')' {
-  updatestar($2,$6, 50);
+  updatestar($2,$6, 50, false);
+}
+| UPDATE INT ',' PARALLEL {
+    long refresh = interactive ? $2/50 : 0;
+    updatestar($2, refresh, 50, true);
+}
+| UPDATE INT ',' BY '(' INT ')' ',' PARALLEL {
+  updatestar($2,$6, 50, true);
 }
 ;
 
 exit: EXIT { return 0; }
 ;
 
-var: NAME {
+var: var_name {
   $$ = new jags::ParseTree(jags::P_VAR); setName($$, $1);
 }
-| NAME '[' range_list ']' {
+| var_name '[' range_list ']' {
   $$ = new jags::ParseTree(jags::P_VAR); setName($$, $1);
   setParameters($$, $3);
 }
 ;
 
+/* Newer command keywords may also be used as variable names */
+var_name: NAME
+| PARALLEL { $$ = new std::string("parallel"); }
+| WORKLIST { $$ = new std::string("worklist"); }
+| BINARY { $$ = new std::string("binary"); }
+| CHECKPOINT { $$ = new std::string("checkpoint"); }
+| RESTORE { $$ = new std::string("restore"); }
+| FROM { $$ = new std::string("from"); }
+;
+
 range_list: range_element {
   $$ = new std::vector<jags::ParseTree*>(1, $1); 
 }
@@ -490,6 +541,18 @@ coda: CODA var {
 | CODA '*' ',' STEM '(' file_name ')' {
   doAllCoda (*$6); delete $6; 
 }
+| CODA var ',' BINARY {
+  doCoda ($2, "CODA", true); delete $2;
+}
+| CODA var ',' STEM '(' file_name ')' ',' BINARY {
+  doCoda ($2, *$6, true); delete $2; delete $6;
+}
+| CODA '*' ',' BINARY {
+  doAllCoda ("CODA", true); 
+}
+| CODA '*' ',' STEM '(' file_name ')' ',' BINARY {
+  doAllCoda (*$6, true); delete $6; 
+}
 ;
 
 load: LOAD file_name { loadModule(*$2); }
@@ -549,6 +612,20 @@ set_seed: SET SEED INT
 }
 ;
 
+checkpoint: CHECKPOINT TO file_name
+{
+    Jtry(console->checkpoint(ExpandFileName(($3)->c_str())));
+    delete $3;
+}
+;
+
+restore: RESTORE FROM file_name
+{
+    Jtry(console->restore(ExpandFileName(($3)->c_str())));
+    delete $3;
+}
+;
+
 /* Rules for scanning dumped R datasets */
 
 r_assignment_list: r_assignment {
@@ -795,12 +872,12 @@ void clearMonitor(jags::ParseTree const *var, std::string const &type)
     }
 }
 
-void doAllCoda (std::string const &stem)
+void doAllCoda (std::string const &stem, bool binary)
 {
-    console->coda(stem);
+    console->coda(stem, binary);
 }
 
-void doCoda (jags::ParseTree const *var, std::string const &stem)
+void doCoda (jags::ParseTree const *var, std::string const &stem, bool binary)
 {
     //FIXME: Allow list of several nodes
 
@@ -813,7 +890,7 @@ void doCoda (jags::ParseTree const *var, std::string const &stem)
 	/* Requesting subset of a multivariate node */
 	dmp.push_back(std::pair<std::string,jags::Range>(var->name(), getRange(var)));
     }
-    console->coda(dmp, stem);
+    console->coda(dmp, stem, binary);
 }
 
 /* Helper function for doDump that handles all the special cases
@@ -1068,7 +1145,7 @@ static void errordump()
     if (!interactive) exit(1);
 }
 
-static void updatestar(long niter, long refresh, int width)
+static void updatestar(long niter, long refresh, int width, bool parallel)
 {
     std::cout << "Updating " << niter << std::endl;
 
@@ -1086,7 +1163,7 @@ static void updatestar(long niter, long refresh, int width)
     }
 
     if (refresh == 0) {
-	Jtry_dump(console->update(niter/2));
+	Jtry_dump(console->update(niter/2, parallel));
 	bool status = true;
 	if (adapt) {
 	    if (!console->checkAdaptation(status)) {
@@ -1098,7 +1175,7 @@ static void updatestar(long niter, long refresh, int width)
 		return;
 	    }
 	}
-	Jtry_dump(console->update(niter - niter/2));
+	Jtry_dump(console->update(niter - niter/2, parallel));
 	if (!status) {
 	    std::cerr << "WARNING: Adaptation incomplete\n";
 	}
@@ -1134,7 +1211,7 @@ static void updatestar(long niter, long refresh, int width)
 	    }
 	}
 	long nupdate = std::min(n, refresh);
-	if(Jtry_dump(console->update(nupdate))) {
+	if(Jtry_dump(console->update(nupdate, parallel))) {
 	    std::cout << "*" << std::flush;
 	}
 	else {
@@ -1423,6 +1500,73 @@ static void delete_pvec(std::vector<jags::ParseTree*> *pv)
     delete pv;
 }
 
+static void openBinaryData(std::string const &name)
+{
+    /* 
+       A binary data file is read by the parser in a single pass,
+       rather than being tokenized by the scanner. The name is saved
+       here and the scanner is given an empty buffer.
+    */
+    std::string file = ExpandFileName(name.c_str());
+    _binary_data = isBinaryData(file) ? file : std::string();
+}
+
+static void setAllParameters(std::map<std::string, jags::SArray> &table,
+			     std::string const &rngname)
+{
+    /* Set all chains to the same state. If the user sets the
+       RNG state in addition to the parameter values then all
+       chains will be identical!
+    */
+    if (console->model() == 0) {
+	std::cout << "ERROR: Initial values ignored. "
+		  <<  "(You must compile the model first)" << std::endl;
+	if (!interactive) exit(1);
+    }
+    for (unsigned int i = 1; i <= console->nchain(); ++i) {
+	/* We have to set the name first, because the state or seed
+	   might be embedded in the parameter_table */
+	if (rngname.size() != 0) {
+	    Jtry(console->setRNGname(rngname, i));
+	}
+	Jtry(console->setParameters(table, i));
+    }
+    print_unused_variables(table, false);
+}
+
+static void setChainParameters(std::map<std::string, jags::SArray> &table,
+			       std::string const &rngname,
+			       unsigned int chain)
+{
+    /* We have to set the name first, because the state or seed
+       might be embedded in the parameter_table */
+    if (rngname.size() != 0) {
+        Jtry(console->setRNGname(rngname, chain));
+    }
+    Jtry(console->setParameters(table, chain));
+    print_unused_variables(table, false);
+}
+
+static void doCompile(unsigned int nchain, bool worklist)
+{
+    if (Jtry(console->compile(_data_table, nchain, true, worklist)) &&
+	interactive)
+    {
+	//Timings are not printed in batch mode, so that output from
+	//scripts is unchanged
+	std::vector<std::pair<std::string, double> > times;
+	if (console->dumpCompileTimes(times)) {
+	    std::cout << "Compilation times (seconds):\n";
+	    for (unsigned int i = 0; i < times.size(); ++i) {
+		std::cout << "   " << times[i].first << ": "
+			  << times[i].second << "\n";
+	    }
+	    std::cout << std::flush;
+	}
+    }
+    print_unused_variables(_data_table, true);
+}
+
 static void print_unused_variables(std::map<std::string, jags::SArray> const &table,
 				   bool data)
 {
@@ -40,6 +40,9 @@ chain                   zzlval.intval=CHAIN; return CHAIN;
 update			zzlval.intval=UPDATE; return UPDATE;
 adapt			zzlval.intval=ADAPT; return ADAPT;
 by                      zzlval.intval=BY; return BY;
+<INITIAL>"parallel"     zzlval.intval=PARALLEL; return PARALLEL;
+<INITIAL>"worklist"     zzlval.intval=WORKLIST; return WORKLIST;
+<INITIAL>"binary"       zzlval.intval=BINARY; return BINARY;
 autoadapt			zzlval.intval=AUTOADAPT; return AUTOADAPT;
 
 monitor			zzlval.intval=MONITOR; return MONITOR;
@@ -55,6 +58,10 @@ factory                 zzlval.intval=FACTORY; return FACTORY;
 factories               zzlval.intval=FACTORIES; return FACTORIES;
 seed                    zzlval.intval=SEED; return SEED;
 
+<INITIAL>"checkpoint"   zzlval.intval=CHECKPOINT; return CHECKPOINT;
+<INITIAL>"restore"      zzlval.intval=RESTORE; return RESTORE;
+<INITIAL>"from"         zzlval.intval=FROM; return FROM;
+
 coda			zzlval.intval=CODA; return CODA;
 stem			zzlval.intval=STEM; return STEM;
 
@@ -194,9 +201,14 @@ void pop_file() {
 }
 
 
-bool open_data_buffer(std::string const *name) {
+bool open_data_buffer(std::string const *name, bool binary) {
     FILE *file = fopen(ExpandFileName(name->c_str()).c_str(),"r");
     if (file) {
+	if (binary) {
+	    /* Binary data are read by the parser, so the scanner
+	       starts at the end of the file and returns ENDDATA */
+	    fseek(file, 0, SEEK_END);
+	}
 	zzpush_buffer_state(zz_create_buffer(file, YY_BUF_SIZE));
 	push_file(file);
         ++buffer_count;
@@ -0,0 +1,234 @@
+#include <config.h>
+#include "testreaddata.h"
+
+#include "ReadData.h"
+#include <sarray/SArray.h>
+#include <util/nainf.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <map>
+
+using std::string;
+using std::vector;
+using std::map;
+using jags::SArray;
+
+static char const *TEST_FILE = "testreaddata.tmp";
+
+/* Appends integers, values and padding in the binary data format */
+static void putUInt(vector<unsigned char> &buf, unsigned int x)
+{
+    for (int i = 0; i < 4; ++i) {
+	buf.push_back((x >> (8 * i)) & 0xff);
+    }
+}
+
+static void putDouble(vector<unsigned char> &buf, double x)
+{
+    unsigned long long bits;
+    std::memcpy(&bits, &x, sizeof(x));
+    for (int i = 0; i < 8; ++i) {
+	buf.push_back((bits >> (8 * i)) & 0xff);
+    }
+}
+
+static vector<unsigned char> header(unsigned int narray)
+{
+    vector<unsigned char> buf(8);
+    std::memcpy(&buf[0], "JAGSDATA", 8);
+    putUInt(buf, 1);
+    putUInt(buf, narray);
+    return buf;
+}
+
+/* Appends an array. Elements i with na[i] true are flagged as missing */
+static void putArray(vector<unsigned char> &buf, string const &name,
+		     vector<unsigned int> const &dim,
+		     vector<double> const &value,
+		     vector<bool> const &na = vector<bool>())
+{
+    putUInt(buf, name.size());
+    buf.insert(buf.end(), name.begin(), name.end());
+    putUInt(buf, dim.size());
+    for (unsigned int i = 0; i < dim.size(); ++i) {
+	putUInt(buf, dim[i]);
+    }
+    putUInt(buf, na.empty() ? 0 : 1);
+    while (buf.size() % 8 != 0) {
+	buf.push_back(0);
+    }
+    for (unsigned int i = 0; i < value.size(); ++i) {
+	putDouble(buf, value[i]);
+    }
+    if (!na.empty()) {
+	vector<unsigned char> bitmap((na.size() + 7) / 8, 0);
+	for (unsigned int i = 0; i < na.size(); ++i) {
+	    if (na[i]) bitmap[i / 8] |= 1 << (i % 8);
+	}
+	buf.insert(buf.end(), bitmap.begin(), bitmap.end());
+    }
+}
+
+/* Writes the first n bytes of buf to the test file and reads it */
+static bool readFile(vector<unsigned char> const &buf, unsigned long n,
+		     map<string, SArray> &table)
+{
+    FILE *fp = std::fopen(TEST_FILE, "wb");
+    CPPUNIT_ASSERT(fp);
+    if (n > 0) {
+	CPPUNIT_ASSERT_EQUAL(n,
+			     static_cast<unsigned long>(
+				 std::fwrite(&buf[0], 1, n, fp)));
+    }
+    std::fclose(fp);
+    return readBinaryData(TEST_FILE, table);
+}
+
+static bool readFile(vector<unsigned char> const &buf,
+		     map<string, SArray> &table)
+{
+    return readFile(buf, buf.size(), table);
+}
+
+void ReadDataTest::tearDown()
+{
+    std::remove(TEST_FILE);
+}
+
+void ReadDataTest::values()
+{
+    vector<unsigned char> buf = header(2);
+    double x[3] = {1.5, -2, 1E300};
+    putArray(buf, "x", vector<unsigned int>(1, 3), vector<double>(x, x + 3));
+    double y[4] = {1, 2, 3, 4};
+    vector<unsigned int> ydim(2, 2);
+    putArray(buf, "y", ydim, vector<double>(y, y + 4));
+
+    map<string, SArray> table;
+    CPPUNIT_ASSERT(readFile(buf, table));
+    CPPUNIT_ASSERT(isBinaryData(TEST_FILE));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), table.size());
+
+    SArray const &sx = table.find("x")->second;
+    CPPUNIT_ASSERT(sx.dim(false) == vector<unsigned int>(1, 3));
+    CPPUNIT_ASSERT(sx.value() == vector<double>(x, x + 3));
+
+    SArray const &sy = table.find("y")->second;
+    CPPUNIT_ASSERT(sy.dim(false) == ydim);
+    CPPUNIT_ASSERT(sy.value() == vector<double>(y, y + 4));
+}
+
+void ReadDataTest::missing()
+{
+    //The bitmap spans two bytes and is followed by another array
+    vector<double> value(10);
+    vector<bool> na(10, false);
+    for (unsigned int i = 0; i < 10; ++i) {
+	value[i] = i;
+    }
+    na[0] = na[7] = na[9] = true;
+
+    vector<unsigned char> buf = header(2);
+    putArray(buf, "a", vector<unsigned int>(1, 10), value, na);
+    putArray(buf, "b", vector<unsigned int>(1, 1), vector<double>(1, 3.25));
+
+    map<string, SArray> table;
+    CPPUNIT_ASSERT(readFile(buf, table));
+    vector<double> const &a = table.find("a")->second.value();
+    for (unsigned int i = 0; i < 10; ++i) {
+	CPPUNIT_ASSERT_EQUAL(na[i] ? JAGS_NA : value[i], a[i]);
+    }
+    CPPUNIT_ASSERT_EQUAL(3.25, table.find("b")->second.value()[0]);
+}
+
+void ReadDataTest::padding()
+{
+    //Names of length 1 to 8 give every amount of padding
+    vector<unsigned char> buf = header(8);
+    for (unsigned int n = 1; n <= 8; ++n) {
+	vector<double> value(n);
+	for (unsigned int i = 0; i < n; ++i) {
+	    value[i] = n + i / 10.0;
+	}
+	putArray(buf, string(n, 'p'), vector<unsigned int>(1, n), value);
+    }
+
+    map<string, SArray> table;
+    CPPUNIT_ASSERT(readFile(buf, table));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(8), table.size());
+    for (unsigned int n = 1; n <= 8; ++n) {
+	vector<double> const &value =
+	    table.find(string(n, 'p'))->second.value();
+	CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(n), value.size());
+	for (unsigned int i = 0; i < n; ++i) {
+	    CPPUNIT_ASSERT_EQUAL(n + i / 10.0, value[i]);
+	}
+    }
+}
+
+void ReadDataTest::truncated()
+{
+    vector<unsigned char> buf = header(2);
+    putArray(buf, "abc", vector<unsigned int>(2, 3), vector<double>(9, 1.0),
+	     vector<bool>(9, true));
+    putArray(buf, "d", vector<unsigned int>(1, 2), vector<double>(2, 2.0));
+
+    //Every proper prefix of the file is rejected
+    for (unsigned long n = 0; n < buf.size(); ++n) {
+	map<string, SArray> table;
+	CPPUNIT_ASSERT(!readFile(buf, n, table));
+    }
+    map<string, SArray> table;
+    CPPUNIT_ASSERT(readFile(buf, table));
+}
+
+void ReadDataTest::corrupt()
+{
+    map<string, SArray> table;
+    vector<double> one(1, 1.0);
+
+    //Bad magic number
+    vector<unsigned char> magic = header(1);
+    magic[0] = 'X';
+    putArray(magic, "x", vector<unsigned int>(1, 1), one);
+    CPPUNIT_ASSERT(!readFile(magic, table));
+    CPPUNIT_ASSERT(!isBinaryData(TEST_FILE));
+
+    //Unsupported version
+    vector<unsigned char> version = header(1);
+    version[8] = 2;
+    putArray(version, "x", vector<unsigned int>(1, 1), one);
+    CPPUNIT_ASSERT(!readFile(version, table));
+
+    //Empty name
+    vector<unsigned char> name = header(1);
+    putArray(name, "", vector<unsigned int>(1, 1), one);
+    CPPUNIT_ASSERT(!readFile(name, table));
+
+    //No dimensions
+    vector<unsigned char> ndim = header(1);
+    putArray(ndim, "x", vector<unsigned int>(), one);
+    CPPUNIT_ASSERT(!readFile(ndim, table));
+
+    //Zero dimension
+    vector<unsigned char> zero = header(1);
+    putArray(zero, "x", vector<unsigned int>(1, 0), vector<double>());
+    CPPUNIT_ASSERT(!readFile(zero, table));
+
+    //Length that does not fit in an unsigned int
+    vector<unsigned char> large = header(1);
+    putArray(large, "x", vector<unsigned int>(2, 65537), one);
+    CPPUNIT_ASSERT(!readFile(large, table));
+
+    //More arrays than the file contains
+    vector<unsigned char> narray = header(2);
+    putArray(narray, "x", vector<unsigned int>(1, 1), one);
+    CPPUNIT_ASSERT(!readFile(narray, table));
+
+    //Missing file
+    std::remove(TEST_FILE);
+    CPPUNIT_ASSERT(!readBinaryData(TEST_FILE, table));
+}
@@ -0,0 +1,25 @@
+#ifndef READ_DATA_TEST_H
+#define READ_DATA_TEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class ReadDataTest : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE( ReadDataTest );
+    CPPUNIT_TEST( values );
+    CPPUNIT_TEST( missing );
+    CPPUNIT_TEST( padding );
+    CPPUNIT_TEST( truncated );
+    CPPUNIT_TEST( corrupt );
+    CPPUNIT_TEST_SUITE_END();
+
+  public:
+    void tearDown();
+    void values();
+    void missing();
+    void padding();
+    void truncated();
+    void corrupt();
+};
+
+#endif  // READ_DATA_TEST_H
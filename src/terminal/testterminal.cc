@@ -0,0 +1,7 @@
+#include "testterminal.h"
+#include "testreaddata.h"
+#include <cppunit/extensions/HelperMacros.h>
+
+void init_terminal_test() {
+    CPPUNIT_TEST_SUITE_REGISTRATION( ReadDataTest );
+}
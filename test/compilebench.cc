@@ -0,0 +1,162 @@
+/**
+ * Benchmark of the lookup of logical nodes during compilation.
+ *
+ * The linear predictor of a regression model with n observations,
+ * mu[i] <- b0 + b1 * x[i], is built through a LogicalFactory, as the
+ * compiler does. Each covariate x[i] is a separate constant node, so
+ * that lookups of the product b1 * x[i] use the fuzzy comparison of
+ * values. The model is then built a second time with new constant
+ * nodes for the covariates, in which case every lookup finds an
+ * existing node.
+ *
+ * For comparison, the same lookups are done with an STL map using
+ * the fuzzy less than function for LogicalPair objects, which is
+ * what LogicalFactory used before it switched to an InternTable.
+ *
+ * This program is not run by "make check". Use "make compilebench"
+ * in the test directory to build it.
+ */
+
+#include <model/Model.h>
+#include <compiler/LogicalFactory.h>
+#include <graph/ConstantNode.h>
+#include <graph/LogicalNode.h>
+#include <graph/ScalarStochasticNode.h>
+
+#include <base/functions/Add.h>
+#include <base/functions/Multiply.h>
+#include <bugs/distributions/DNorm.h>
+
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+using std::vector;
+using std::map;
+
+using jags::Node;
+using jags::ConstantNode;
+using jags::LogicalNode;
+using jags::StochasticNode;
+using jags::ScalarStochasticNode;
+using jags::FunctionPtr;
+using jags::LogicalPair;
+using jags::fuzzy_less;
+
+typedef map<LogicalPair, Node*, fuzzy_less<LogicalPair> > LogicalMap;
+
+static double seconds(std::clock_t start)
+{
+    return static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+}
+
+/* Adds n covariates to the model */
+static vector<Node const *> covariates(jags::Model &model, unsigned int n)
+{
+    vector<Node const *> x(n);
+    for (unsigned int i = 0; i < n; ++i) {
+	ConstantNode *xi = new ConstantNode(i / 1024.0 + 0.1, 1, true);
+	model.addNode(xi);
+	x[i] = xi;
+    }
+    return x;
+}
+
+/* Builds the linear predictor with a LogicalFactory */
+static double buildFactory(jags::LogicalFactory &factory, jags::Model &model,
+			   FunctionPtr const &add, FunctionPtr const &mult,
+			   Node const *b0, Node const *b1,
+			   vector<Node const *> const &x)
+{
+    std::clock_t start = std::clock();
+    vector<Node const *> args(2);
+    for (unsigned int i = 0; i < x.size(); ++i) {
+	args[0] = b1;
+	args[1] = x[i];
+	Node *bx = factory.getNode(mult, args, model);
+	args[0] = b0;
+	args[1] = bx;
+	factory.getNode(add, args, model);
+    }
+    return seconds(start);
+}
+
+/* Looks up a logical node as LogicalFactory::getNode used to */
+static Node *getNode(LogicalMap &lmap, FunctionPtr const &func,
+		     vector<Node const *> const &args, jags::Model &model)
+{
+    LogicalPair lpair(func, args);
+    LogicalMap::iterator i = lmap.find(lpair);
+    if (i != lmap.end()) {
+	return i->second;
+    }
+    LogicalNode *lnode = jags::LogicalFactory::newNode(func, args, 1);
+    lmap[lpair] = lnode;
+    model.addNode(lnode);
+    return lnode;
+}
+
+/* Builds the linear predictor with an STL map */
+static double buildMap(LogicalMap &lmap, jags::Model &model,
+		       FunctionPtr const &add, FunctionPtr const &mult,
+		       Node const *b0, Node const *b1,
+		       vector<Node const *> const &x)
+{
+    std::clock_t start = std::clock();
+    vector<Node const *> args(2);
+    for (unsigned int i = 0; i < x.size(); ++i) {
+	args[0] = b1;
+	args[1] = x[i];
+	Node *bx = getNode(lmap, mult, args, model);
+	args[0] = b0;
+	args[1] = bx;
+	getNode(lmap, add, args, model);
+    }
+    return seconds(start);
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned int n = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+    jags::bugs::DNorm dnorm;
+    jags::base::Add add;
+    jags::base::Multiply mult;
+    FunctionPtr fadd(&add), fmult(&mult);
+
+    for (unsigned int k = 0; k < 2; ++k) {
+	jags::Model model(1);
+	ConstantNode *zero = new ConstantNode(0, 1, true);
+	ConstantNode *one = new ConstantNode(1, 1, true);
+	model.addNode(zero);
+	model.addNode(one);
+	vector<Node const *> prior(2);
+	prior[0] = zero;
+	prior[1] = one;
+	StochasticNode *b0 = new ScalarStochasticNode(&dnorm, 1, prior, 0, 0);
+	StochasticNode *b1 = new ScalarStochasticNode(&dnorm, 1, prior, 0, 0);
+	model.addNode(b0);
+	model.addNode(b1);
+
+	vector<Node const *> x1 = covariates(model, n);
+	vector<Node const *> x2 = covariates(model, n);
+	double tbuild = 0, tlookup = 0;
+	if (k == 0) {
+	    LogicalMap lmap;
+	    tbuild = buildMap(lmap, model, fadd, fmult, b0, b1, x1);
+	    tlookup = buildMap(lmap, model, fadd, fmult, b0, b1, x2);
+	}
+	else {
+	    jags::LogicalFactory factory;
+	    tbuild = buildFactory(factory, model, fadd, fmult, b0, b1, x1);
+	    tlookup = buildFactory(factory, model, fadd, fmult, b0, b1, x2);
+	}
+	std::printf("%-8s build %8.3f s  lookup %8.3f s  (%lu nodes)\n",
+		    k == 0 ? "map" : "table", tbuild, tlookup,
+		    static_cast<unsigned long>(model.nodes().size()));
+    }
+
+    return 0;
+}
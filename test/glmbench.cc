@@ -0,0 +1,139 @@
+/**
+ * Benchmark of the Cholesky factorizations used by the glm module.
+ *
+ * A spatial random effects model is built on an m x m lattice. Each
+ * lattice site has a random effect u[i] ~ dnorm(0, 1), and each
+ * pair of neighbouring sites (i, j) has an observation
+ * y ~ dnorm(u[i] + u[j], 1).  All random effects are sampled in a
+ * single block by the glm::Generic sampler, and the posterior
+ * precision has the sparsity pattern of the lattice.
+ *
+ * For each lattice size, the time per update is reported with a
+ * simplicial and a supernodal factorization. The crossover point
+ * was used to choose the default value of
+ * GLMMethod::supernodalLength.
+ *
+ * This program is not run by "make check". Use "make glmbench"
+ * in the test directory to build it.
+ */
+
+#include <model/Model.h>
+#include <graph/ConstantNode.h>
+#include <graph/ScalarStochasticNode.h>
+#include <graph/ScalarLogicalNode.h>
+
+#include <base/functions/Add.h>
+#include <base/rngs/MersenneTwisterRNG.h>
+#include <bugs/distributions/DNorm.h>
+#include <glm/samplers/GLMGenericFactory.h>
+
+#include <climits>
+#include <cmath>
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <utility>
+#include <vector>
+
+using std::vector;
+using std::list;
+using std::pair;
+
+using jags::Node;
+using jags::ConstantNode;
+using jags::StochasticNode;
+using jags::ScalarStochasticNode;
+using jags::ScalarLogicalNode;
+using jags::glm::GLMMethod;
+
+static void addObservation(jags::Model &model,
+			   jags::bugs::DNorm const *dnorm,
+			   jags::base::Add const *add, ConstantNode *tau,
+			   StochasticNode *u1, StochasticNode *u2, double y)
+{
+    vector<Node const *> args(2);
+    args[0] = u1;
+    args[1] = u2;
+    ScalarLogicalNode *mu = new ScalarLogicalNode(add, 1, args);
+    model.addNode(mu);
+
+    vector<Node const *> par(2);
+    par[0] = mu;
+    par[1] = tau;
+    StochasticNode *ynode = new ScalarStochasticNode(dnorm, 1, par, 0, 0);
+    ynode->setData(&y, 1);
+    model.addNode(ynode);
+}
+
+/* Returns the time, in seconds, per update of the lattice model */
+static double benchmark(unsigned int m, unsigned int niter)
+{
+    jags::bugs::DNorm dnorm;
+    jags::base::Add add;
+    jags::glm::GLMGenericFactory factory;
+    jags::base::MersenneTwisterRNG rng(1234, jags::KINDERMAN_RAMAGE);
+
+    jags::Model model(1);
+    ConstantNode *zero = new ConstantNode(0, 1, true);
+    ConstantNode *one = new ConstantNode(1, 1, true);
+    model.addNode(zero);
+    model.addNode(one);
+
+    vector<Node const *> prior(2);
+    prior[0] = zero;
+    prior[1] = one;
+    vector<StochasticNode *> u(m * m);
+    for (unsigned int i = 0; i < m * m; ++i) {
+	u[i] = new ScalarStochasticNode(&dnorm, 1, prior, 0, 0);
+	model.addNode(u[i]);
+    }
+
+    for (unsigned int r = 0; r < m; ++r) {
+	for (unsigned int c = 0; c < m; ++c) {
+	    unsigned int i = r * m + c;
+	    if (c + 1 < m) {
+		addObservation(model, &dnorm, &add, one, u[i], u[i + 1],
+			       std::sin(r + 0.5 * c));
+	    }
+	    if (r + 1 < m) {
+		addObservation(model, &dnorm, &add, one, u[i], u[i + m],
+			       std::cos(0.5 * r + c));
+	    }
+	}
+    }
+
+    model.setRNG(&rng, 0);
+    list<pair<jags::SamplerFactory *, bool> > &factories =
+	jags::Model::samplerFactories();
+    factories.push_front(pair<jags::SamplerFactory *, bool>(&factory, true));
+    model.initialize(true);
+    factories.pop_front();
+
+    model.update(1, false);
+    std::clock_t start = std::clock();
+    model.update(niter, false);
+    std::clock_t end = std::clock();
+
+    return static_cast<double>(end - start) / CLOCKS_PER_SEC / niter;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned int niter = argc > 1 ? std::atoi(argv[1]) : 20;
+    unsigned int const sizes[] = {5, 10, 15, 20, 30, 40, 60, 80, 120};
+
+    unsigned int default_length = GLMMethod::supernodalLength();
+    std::printf("%8s %12s %12s\n", "length", "simplicial", "supernodal");
+    for (unsigned int k = 0; k < sizeof(sizes)/sizeof(sizes[0]); ++k) {
+	unsigned int m = sizes[k];
+	GLMMethod::setSupernodalLength(UINT_MAX);
+	double t_simplicial = benchmark(m, niter);
+	GLMMethod::setSupernodalLength(0);
+	double t_supernodal = benchmark(m, niter);
+	std::printf("%8u %12.6f %12.6f\n", m * m, t_simplicial, t_supernodal);
+    }
+    GLMMethod::setSupernodalLength(default_length);
+
+    return 0;
+}